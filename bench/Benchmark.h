@@ -0,0 +1,275 @@
+#pragma once
+
+#include "core/Math.h"
+#include "effects/ColorLut.h"
+#include "effects/EffectGraph.h"
+#include "effects/Frame.h"
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace gamma {
+namespace bench {
+
+/**
+ * @brief Summary of repeated runs of one benchmark case
+ */
+struct Timing {
+    double minMs;
+    double medianMs;
+    double maxMs;
+    double p99Ms;           // 99th percentile: the slow frames a show would see
+};
+
+/**
+ * @brief Run a case once to warm up, then time it repeatedly
+ * @param function Work to time
+ * @param repetitions Number of timed runs
+ */
+inline Timing measure(const std::function<void()>& function, int repetitions) {
+    using Clock = std::chrono::steady_clock;
+
+    function();
+
+    std::vector<double> samples;
+    samples.reserve(repetitions);
+    for (int i = 0; i < repetitions; ++i) {
+        auto start = Clock::now();
+        function();
+        samples.push_back(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+    }
+
+    std::sort(samples.begin(), samples.end());
+    size_t p99 = std::min(samples.size() - 1, (samples.size() * 99 + 99) / 100 - 1);
+    return {samples.front(), samples[samples.size() / 2], samples.back(), samples[p99]};
+}
+
+/**
+ * @brief Chain slot with the given parameter values
+ * @param smoothing Slew time given to every parameter (0 = jump)
+ */
+inline effects::ChainSlot makeSlot(effects::EffectType type, std::initializer_list<float> parameters,
+                                   float smoothing = 0.0f) {
+    effects::ChainSlot slot;
+    slot.type = type;
+    for (float value : parameters) {
+        slot.smoothing[slot.parameterCount] = smoothing;
+        slot.parameters[slot.parameterCount++] = value;
+    }
+    return slot;
+}
+
+/**
+ * @brief The color grade most cases start from
+ */
+inline effects::ChainSlot makeGradeSlot() {
+    return makeSlot(effects::EffectType::ColorCorrection, {0.05f, 1.2f, 1.1f, 15.0f});
+}
+
+/**
+ * @brief Grade, chromatic aberration, motion blur and a mirror: the chain
+ * shared by suites that measure the engine rather than one effect
+ */
+inline std::vector<effects::ChainSlot> makeFixtureChain() {
+    return {
+        makeGradeSlot(),
+        makeSlot(effects::EffectType::ChromaticAberration, {0.6f, 12.0f, -12.0f}),
+        makeSlot(effects::EffectType::MotionBlur, {0.3f, 60.0f, 8.0f}),
+        makeSlot(effects::EffectType::Mirror, {3.0f, 0.5f, 0.5f})
+    };
+}
+
+/**
+ * @brief Settings that exercise an effect's full path (library defaults are mostly neutral)
+ * @param look Library index of the look Color LUT applies
+ */
+inline effects::ChainSlot makeEffectSlot(effects::EffectType type, int look = 0) {
+    using effects::EffectType;
+    switch (type) {
+        case EffectType::ColorCorrection:
+            return makeGradeSlot();
+        case EffectType::ChromaticAberration:
+            return makeSlot(type, {0.6f, 12.0f, -12.0f});
+        case EffectType::Datamosh:
+            return makeSlot(type, {0.3f, 8.0f, 0.5f});
+        case EffectType::MotionBlur:
+            return makeSlot(type, {0.3f, 60.0f, 8.0f});
+        case EffectType::Mirror:
+            return makeSlot(type, {3.0f, 0.5f, 0.5f});                  // Both axes
+        case EffectType::TimeEcho:
+            return makeSlot(type, {0.1f, 0.5f, 0.4f});
+        case EffectType::ColorLut:
+            return makeSlot(type, {static_cast<float>(look), 1.0f});
+        case EffectType::Kaleidoscope:
+            return makeSlot(type, {6.0f, 15.0f, 0.5f, 0.5f});
+        case EffectType::Polar:
+            return makeSlot(type, {1.0f, 0.0f, 1.0f});                   // To polar
+        case EffectType::Tile:
+            return makeSlot(type, {3.0f, 2.0f, 1.0f});                   // Mirrored
+        case EffectType::Warp:
+            return makeSlot(type, {0.5f, 3.0f, 0.0f});
+        case EffectType::Count:
+            break;
+    }
+    return makeSlot(type, {});
+}
+
+/**
+ * @brief Smooth look in the manner of a film emulation
+ *
+ * A toe and shoulder per channel with some cross-talk, so every
+ * tetrahedron has a different slope.
+ * @param size Lattice points per axis
+ */
+inline std::shared_ptr<effects::ColorLut> makeLook(int size) {
+    auto lut = std::make_shared<effects::ColorLut>(size);
+    for (int b = 0; b < size; ++b) {
+        for (int g = 0; g < size; ++g) {
+            for (int r = 0; r < size; ++r) {
+                const float red = lut->getLatticeValue(0, r);
+                const float green = lut->getLatticeValue(1, g);
+                const float blue = lut->getLatticeValue(2, b);
+                float* entry = lut->entry(r, g, b);
+                entry[0] = core::pow(0.9f * red + 0.1f * green, 0.8f);
+                entry[1] = green * green * (3.0f - 2.0f * green);
+                entry[2] = 0.8f * blue + 0.2f * red * green;
+            }
+        }
+    }
+    return lut;
+}
+
+/**
+ * @brief Peak signal-to-noise ratio of the color channels of two RGBA8 frames
+ * @param maxError If not null, receives the largest channel difference
+ * @return dB, 99 for identical frames
+ */
+inline double computePsnr(const effects::Frame& a, const effects::Frame& b, int* maxError = nullptr) {
+    double squared = 0.0;
+    int largest = 0;
+    for (int y = 0; y < a.getHeight(); ++y) {
+        const uint32_t* rowA = a.row(y);
+        const uint32_t* rowB = b.row(y);
+        for (int x = 0; x < a.getWidth(); ++x) {
+            for (int c = 0; c < 3; ++c) {
+                const int difference = static_cast<int>((rowA[x] >> (c * 8)) & 0xFF) -
+                                       static_cast<int>((rowB[x] >> (c * 8)) & 0xFF);
+                largest = std::max(largest, std::abs(difference));
+                squared += static_cast<double>(difference) * difference;
+            }
+        }
+    }
+    if (maxError) {
+        *maxError = largest;
+    }
+    const double mean = squared / (3.0 * a.getWidth() * a.getHeight());
+    return mean > 0.0 ? 10.0 * core::log10(255.0 * 255.0 / mean) : 99.0;
+}
+
+/**
+ * @brief Crush the range to a quarter, then stretch it back
+ *
+ * In RGBA8 the intermediate keeps 64 levels, so a ramp comes out banded.
+ * The mirror (mode none) keeps the two corrections from fusing into one
+ * RGBA32F tile, so the intermediate really is stored in the engine's format.
+ */
+inline std::vector<effects::ChainSlot> makeCrushChain() {
+    return {
+        makeSlot(effects::EffectType::ColorCorrection, {0.0f, 0.25f, 1.0f, 0.0f}),
+        makeSlot(effects::EffectType::Mirror, {0.0f, 0.5f, 0.5f}),
+        makeSlot(effects::EffectType::ColorCorrection, {0.0f, 4.0f, 1.0f, 0.0f})
+    };
+}
+
+/**
+ * @brief Fill a frame with a smooth gray ramp, black at the left to white at the right
+ */
+inline void renderRamp(effects::Frame& frame) {
+    const int width = frame.getWidth();
+    for (int y = 0; y < frame.getHeight(); ++y) {
+        uint32_t* row = frame.row(y);
+        for (int x = 0; x < width; ++x) {
+            uint32_t level = static_cast<uint32_t>(x) * 255u / static_cast<uint32_t>(std::max(1, width - 1));
+            row[x] = effects::packPixel(level, level, level);
+        }
+    }
+}
+
+/**
+ * @brief Distinct red levels across the middle row: 256 for a clean ramp at least 256 wide
+ */
+inline size_t countLevels(const effects::Frame& frame) {
+    std::set<uint32_t> levels;
+    const uint32_t* row = frame.row(frame.getHeight() / 2);
+    for (int x = 0; x < frame.getWidth(); ++x) {
+        levels.insert(row[x] & 0xFF);
+    }
+    return levels.size();
+}
+
+/**
+ * @brief One measured case, for the machine-readable report
+ */
+struct Record {
+    std::string suite;
+    std::string name;           // Effect or chain
+    int width;
+    int height;
+    int threads;
+    Timing timing;
+    double nsPerPixel;          // Median frame time per pixel
+    double gigabytesPerSecond;  // Pixel bytes read and written at the median frame time
+};
+
+/**
+ * @brief Keep a result for writeReport()
+ */
+void addRecord(const Record& record);
+
+/**
+ * @brief Write every record as JSON
+ * @return false if the file cannot be written
+ */
+bool writeReport(const std::string& path);
+
+/**
+ * @brief Print the speedup of every case found in both reports
+ * @param baselinePath Report written by writeReport() for the reference build
+ * @param candidatePath Report of the build being measured
+ * @return false if a report cannot be read or no case appears in both
+ *
+ * Speedup is the baseline p50 frame time over the candidate's, with a
+ * geometric mean per suite.
+ */
+bool compareReports(const std::string& baselinePath, const std::string& candidatePath);
+
+/**
+ * @brief MIDI log replayed by the workload suite (empty = fixed jog sweep)
+ */
+void setWorkloadReplayFile(const std::string& filename);
+
+// Benchmark suites (one translation unit each)
+void runJobSystemBenchmarks();
+void runEffectFusionBenchmarks();
+void runEffectScalingBenchmarks();
+void runEffectSpecializationBenchmarks();
+void runEffectMemoizationBenchmarks();
+void runEffectMixBenchmarks();
+void runEffectPreviewBenchmarks();
+void runEffectFormatBenchmarks();
+void runFramePoolBenchmarks();
+void runEffectLutBenchmarks();
+void runEffectRemapBenchmarks();
+void runEffectSuiteBenchmarks();
+void runReplayWorkloadBenchmarks();
+
+} // namespace bench
+} // namespace gamma
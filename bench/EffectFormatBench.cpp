@@ -0,0 +1,139 @@
+#include "Benchmark.h"
+#include "core/JobSystem.h"
+#include "effects/EffectEngine.h"
+#include "effects/TestPattern.h"
+#include "core/Math.h"
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace gamma {
+namespace bench {
+
+namespace {
+
+const int REPETITIONS = 20;
+const int WARMUP_FRAMES = 10;
+const int QUALITY_FRAMES = 12;     // Lets Time Echo build up its feedback before outputs are compared
+
+struct Resolution {
+    const char* name;
+    int width;
+    int height;
+};
+
+const Resolution RESOLUTIONS[] = {
+    {"1080p", 1920, 1080},
+    {"4K", 3840, 2160}
+};
+
+const effects::PixelFormat FORMATS[] = {
+    effects::PixelFormat::RGBA8,
+    effects::PixelFormat::RGBA16F,
+    effects::PixelFormat::RGBA32F
+};
+
+struct Case {
+    std::string name;
+    std::vector<effects::ChainSlot> chain;
+    int passes;         // Passes over the frame once fused: intermediates = passes - 1
+    bool ramp;          // Input: a smooth gray ramp instead of the test pattern
+};
+
+std::vector<Case> buildCases() {
+    std::vector<Case> cases;
+    cases.push_back({"grade chain", makeFixtureChain(), 4, false});
+
+    // Banded in RGBA8; the echo adds a temporal pass
+    std::vector<effects::ChainSlot> crush = makeCrushChain();
+    crush.push_back(makeSlot(effects::EffectType::TimeEcho, {0.05f, 0.6f, 0.5f}));
+    cases.push_back({"crush + expand", crush, 2, true});
+    return cases;
+}
+
+} // namespace
+
+void runEffectFormatBenchmarks() {
+    const unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    std::unique_ptr<core::JobSystem> jobs;
+    if (threads > 1) {
+        jobs = std::make_unique<core::JobSystem>(threads - 1);
+    }
+    const std::vector<Case> cases = buildCases();
+
+    std::cout << "Intermediate pixel formats, threads: " << threads << ", repetitions: " << REPETITIONS << std::endl;
+    std::cout << "Traffic counts each intermediate written and read once; PSNR is against RGBA32F" << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << std::left << std::setw(8) << "Res" << std::setw(17) << "Chain" << std::setw(9) << "Format"
+              << std::right << std::setw(9) << "p50 ms" << std::setw(12) << "MB/frame" << std::setw(8) << "GB/s"
+              << std::setw(10) << "PSNR dB" << std::setw(8) << "levels" << std::endl;
+
+    for (const auto& resolution : RESOLUTIONS) {
+        const double pixels = static_cast<double>(resolution.width) * resolution.height;
+        effects::Frame input(resolution.width, resolution.height);
+
+        for (const auto& entry : cases) {
+            // Quality first: the same frames through every format, compared to RGBA32F
+            effects::Frame results[3];
+            for (size_t f = 0; f < 3; ++f) {
+                effects::EffectEngine engine(jobs.get());
+                engine.setIntermediateFormat(FORMATS[f]);
+                effects::Frame output;
+                for (int i = 0; i < QUALITY_FRAMES; ++i) {
+                    if (entry.ramp) {
+                        renderRamp(input);
+                        input.setContentId(effects::makeContentId());
+                    } else {
+                        effects::renderTestPattern(input, i / 60.0);
+                    }
+                    results[f].copyFrom(engine.process(input, output, entry.chain, 1.0f, i / 60.0));
+                }
+            }
+
+            for (size_t f = 0; f < 3; ++f) {
+                effects::EffectEngine engine(jobs.get());
+                engine.setIntermediateFormat(FORMATS[f]);
+                effects::Frame output;
+                double time = 0.0;
+                auto step = [&]() {
+                    input.setContentId(effects::makeContentId());
+                    engine.process(input, output, entry.chain, 1.0f, time);
+                    time += 1.0 / 60.0;
+                };
+                for (int i = 0; i < WARMUP_FRAMES; ++i) {
+                    step();
+                }
+                Timing timing = measure(step, REPETITIONS);
+
+                // RGBA8 in and out, the format in between
+                const double pixelBytes = static_cast<double>(effects::getPixelBytes(FORMATS[f]));
+                const double frameBytes = pixels * (2.0 * sizeof(uint32_t) + 2.0 * pixelBytes * (entry.passes - 1));
+
+                Record record;
+                record.suite = "format";
+                record.name = entry.name + " " + effects::getPixelFormatName(FORMATS[f]);
+                record.width = resolution.width;
+                record.height = resolution.height;
+                record.threads = static_cast<int>(threads);
+                record.timing = timing;
+                record.nsPerPixel = timing.medianMs * 1e6 / pixels;
+                record.gigabytesPerSecond = timing.medianMs > 0.0 ? frameBytes / (timing.medianMs * 1e6) : 0.0;
+                addRecord(record);
+
+                std::cout << std::left << std::setw(8) << resolution.name << std::setw(17) << entry.name
+                          << std::setw(9) << effects::getPixelFormatName(FORMATS[f]) << std::right
+                          << std::setw(9) << timing.medianMs << std::setw(12) << frameBytes / 1e6
+                          << std::setw(8) << record.gigabytesPerSecond
+                          << std::setw(10) << computePsnr(results[f], results[2])
+                          << std::setw(8) << countLevels(results[f]) << std::endl;
+            }
+        }
+    }
+}
+
+} // namespace bench
+} // namespace gamma
@@ -0,0 +1,129 @@
+#include "Benchmark.h"
+#include "effects/EffectEngine.h"
+#include "effects/Kernels.h"
+#include "effects/TestPattern.h"
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+namespace gamma {
+namespace bench {
+
+namespace {
+
+const int REPETITIONS = 15;
+const int WARMUP_FRAMES = 20;   // Fills temporal history so no buffers are allocated while timing
+
+struct Resolution {
+    const char* name;
+    int width;
+    int height;
+};
+
+const Resolution RESOLUTIONS[] = {
+    {"1080p", 1920, 1080},
+    {"4K", 3840, 2160},
+    {"ultrawide", 3440, 1440}
+};
+
+effects::ChainSlot colorCorrection(float brightness, float contrast, float saturation, float hue) {
+    effects::ChainSlot slot;
+    slot.type = effects::EffectType::ColorCorrection;
+    slot.parameterCount = 4;
+    slot.parameters[0] = brightness;
+    slot.parameters[1] = contrast;
+    slot.parameters[2] = saturation;
+    slot.parameters[3] = hue;
+    return slot;
+}
+
+effects::ChainSlot timeEcho(float delay, float feedback, float mix) {
+    effects::ChainSlot slot;
+    slot.type = effects::EffectType::TimeEcho;
+    slot.parameterCount = 3;
+    slot.parameters[0] = delay;
+    slot.parameters[1] = feedback;
+    slot.parameters[2] = mix;
+    return slot;
+}
+
+struct Chain {
+    const char* name;
+    std::vector<effects::ChainSlot> slots;
+};
+
+std::vector<Chain> buildChains() {
+    return {
+        {"2x Color Correction", {
+            colorCorrection(0.1f, 1.2f, 1.1f, 10.0f),
+            colorCorrection(-0.05f, 0.9f, 1.3f, -20.0f)
+        }},
+        {"4x Color Correction", {
+            colorCorrection(0.1f, 1.2f, 1.1f, 10.0f),
+            colorCorrection(-0.05f, 0.9f, 1.3f, -20.0f),
+            colorCorrection(0.0f, 1.1f, 0.8f, 45.0f),
+            colorCorrection(0.02f, 1.0f, 1.0f, 5.0f)
+        }},
+        {"CC + Time Echo + CC", {
+            colorCorrection(0.1f, 1.2f, 1.1f, 10.0f),
+            timeEcho(0.1f, 0.5f, 0.5f),
+            colorCorrection(-0.05f, 0.9f, 1.3f, -20.0f)
+        }}
+    };
+}
+
+Timing runChain(effects::EffectEngine& engine, const effects::Frame& input, effects::Frame& output,
+                const Chain& chain) {
+    double time = 0.0;
+    for (int i = 0; i < WARMUP_FRAMES; ++i) {
+        engine.process(input, output, chain.slots, 1.0f, time);
+        time += 0.01;
+    }
+    return measure([&]() {
+        engine.process(input, output, chain.slots, 1.0f, time);
+        time += 0.01;
+    }, REPETITIONS);
+}
+
+} // namespace
+
+void runEffectFusionBenchmarks() {
+    std::cout << "Kernels: " << effects::getSimdLevelName(effects::getKernels().level)
+              << ", repetitions: " << REPETITIONS << std::endl;
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << std::left << std::setw(12) << "Resolution" << std::setw(24) << "Chain" << std::right
+              << std::setw(14) << "unfused (ms)" << std::setw(12) << "fused (ms)"
+              << std::setw(10) << "speedup" << std::setw(16) << "fused (GB/s)" << std::endl;
+
+    const std::vector<Chain> chains = buildChains();
+    for (const auto& resolution : RESOLUTIONS) {
+        effects::Frame input(resolution.width, resolution.height);
+        effects::Frame output;
+        effects::renderTestPattern(input, 0.0);
+
+        // One read of the input and one write of the output per fused pass
+        const double frameBytes = 2.0 * resolution.width * resolution.height * sizeof(uint32_t);
+
+        for (const auto& chain : chains) {
+            // Separate engines so temporal state does not carry over between modes;
+            // the input never changes, so the result cache is off to measure rendering
+            effects::EffectEngine unfusedEngine;
+            unfusedEngine.setFusionEnabled(false);
+            unfusedEngine.setMemoizationEnabled(false);
+            effects::EffectEngine fusedEngine;
+            fusedEngine.setMemoizationEnabled(false);
+
+            Timing unfused = runChain(unfusedEngine, input, output, chain);
+            Timing fused = runChain(fusedEngine, input, output, chain);
+
+            std::cout << std::left << std::setw(12) << resolution.name << std::setw(24) << chain.name << std::right
+                      << std::setw(14) << unfused.medianMs << std::setw(12) << fused.medianMs
+                      << std::setw(9) << (fused.medianMs > 0.0 ? unfused.medianMs / fused.medianMs : 0.0) << "x"
+                      << std::setw(16) << (fused.medianMs > 0.0 ? frameBytes / (fused.medianMs * 1e6) : 0.0)
+                      << std::endl;
+        }
+    }
+}
+
+} // namespace bench
+} // namespace gamma
@@ -0,0 +1,154 @@
+#include "Benchmark.h"
+#include "effects/ColorLut.h"
+#include "effects/EffectEngine.h"
+#include "effects/Effects.h"
+#include "effects/Kernels.h"
+#include "effects/TestPattern.h"
+#include "core/Math.h"
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace gamma {
+namespace bench {
+
+namespace {
+
+const int REPETITIONS = 15;
+const int WIDTH = 1920;
+const int HEIGHT = 1080;
+const int LOOK_SIZES[] = {17, 33, 65};
+
+struct ChainCase {
+    const char* name;
+    std::vector<effects::ChainSlot> chain;
+};
+
+void addLutRecord(const std::string& name, const Timing& timing, double bytesPerPixel) {
+    const double pixels = static_cast<double>(WIDTH) * HEIGHT;
+    Record record;
+    record.suite = "lut";
+    record.name = name;
+    record.width = WIDTH;
+    record.height = HEIGHT;
+    record.threads = 1;
+    record.timing = timing;
+    record.nsPerPixel = timing.medianMs * 1e6 / pixels;
+    record.gigabytesPerSecond = timing.medianMs > 0.0 ? pixels * bytesPerPixel / (timing.medianMs * 1e6) : 0.0;
+    addRecord(record);
+}
+
+} // namespace
+
+void runEffectLutBenchmarks() {
+    std::cout << WIDTH << "x" << HEIGHT << ", single thread, repetitions: " << REPETITIONS << std::endl;
+    std::cout << std::fixed << std::setprecision(3);
+
+    effects::Frame input(WIDTH, HEIGHT);
+    effects::Frame output(WIDTH, HEIGHT);
+    effects::renderTestPattern(input, 0.5);
+    const size_t count = static_cast<size_t>(WIDTH);
+
+    // Kernels alone, at every instruction set: a lookup per grid size
+    // against the matrix of one Color Correction, the direct math it replaces
+    std::vector<std::shared_ptr<effects::ColorLut>> looks;
+    for (int size : LOOK_SIZES) {
+        looks.push_back(makeLook(size));
+    }
+    const effects::ChainSlot grade = makeGradeSlot();
+    const effects::ColorMatrix matrix = effects::ColorCorrectionEffect::buildMatrix(
+        grade.parameters[0], grade.parameters[1], grade.parameters[2], grade.parameters[3]);
+
+    std::cout << std::left << std::setw(22) << "Kernel" << std::right;
+    const effects::SimdLevel previous = effects::getKernels().level;
+    const effects::SimdLevel supported = effects::getSupportedSimdLevel();
+    for (int level = 0; level <= static_cast<int>(supported); ++level) {
+        std::cout << std::setw(12) << effects::getSimdLevelName(static_cast<effects::SimdLevel>(level));
+    }
+    std::cout << "   (ns per pixel)" << std::endl;
+
+    auto printKernel = [&](const std::string& name, const std::function<void(const effects::KernelTable&)>& run) {
+        std::cout << std::left << std::setw(22) << name << std::right;
+        for (int level = 0; level <= static_cast<int>(supported); ++level) {
+            const effects::SimdLevel simd = effects::setSimdLevel(static_cast<effects::SimdLevel>(level));
+            const effects::KernelTable& kernels = effects::getKernels();
+            Timing timing = measure([&]() { run(kernels); }, REPETITIONS);
+            std::cout << std::setw(12) << timing.medianMs * 1e6 / (static_cast<double>(WIDTH) * HEIGHT);
+            addLutRecord(name + ", " + effects::getSimdLevelName(simd), timing, 8.0);
+        }
+        std::cout << std::endl;
+    };
+
+    printKernel("color matrix", [&](const effects::KernelTable& kernels) {
+        for (int y = 0; y < HEIGHT; ++y) {
+            kernels.colorMatrix(input.row(y), output.row(y), count, matrix);
+        }
+    });
+    for (const auto& look : looks) {
+        const std::string name = "LUT " + std::to_string(look->getSize()) + "^3";
+        printKernel(name, [&](const effects::KernelTable& kernels) {
+            for (int y = 0; y < HEIGHT; ++y) {
+                kernels.applyLut(input.row(y), output.row(y), count, look->getGrid());
+            }
+        });
+    }
+    effects::setSimdLevel(previous);
+
+    // Chains through the engine, direct against precomposed into one 33^3
+    // table; error is against the direct result, which rounds after every effect
+    effects::LutLibrary& library = effects::getLutLibrary();
+    const float look = static_cast<float>(library.add("bench 33", looks[1]));
+    const std::vector<ChainCase> cases = {
+        {"CC + CC", {makeGradeSlot(),
+                     makeSlot(effects::EffectType::ColorCorrection, {-0.05f, 0.9f, 1.3f, -30.0f})}},
+        {"LUT", {makeSlot(effects::EffectType::ColorLut, {look, 1.0f})}},
+        {"CC + LUT", {makeGradeSlot(),
+                      makeSlot(effects::EffectType::ColorLut, {look, 1.0f})}},
+        {"CC + LUT 80% + CC", {makeGradeSlot(),
+                               makeSlot(effects::EffectType::ColorLut, {look, 0.8f}),
+                               makeSlot(effects::EffectType::ColorCorrection, {-0.05f, 0.9f, 1.3f, -30.0f})}},
+        {"CC + CC + CC + LUT", {makeGradeSlot(),
+                                makeSlot(effects::EffectType::ColorCorrection, {0.0f, 1.0f, 0.8f, 40.0f}),
+                                makeSlot(effects::EffectType::ColorCorrection, {-0.05f, 0.9f, 1.3f, -30.0f}),
+                                makeSlot(effects::EffectType::ColorLut, {look, 1.0f})}}
+    };
+
+    std::cout << std::endl << "Kernels: " << effects::getSimdLevelName(effects::getKernels().level) << std::endl;
+    std::cout << std::left << std::setw(22) << "Chain" << std::right << std::setw(12) << "direct ms"
+              << std::setw(16) << "precomposed ms" << std::setw(10) << "speedup" << std::setw(10) << "max err"
+              << std::setw(10) << "PSNR dB" << std::endl;
+
+    effects::Frame direct;
+    effects::Frame precomposed;
+    for (const ChainCase& entry : cases) {
+        Timing timings[2];
+        for (int composed = 0; composed < 2; ++composed) {
+            // Memoization off: every repetition renders, as for a playing clip
+            effects::EffectEngine engine;
+            engine.setMemoizationEnabled(false);
+            engine.setColorPrecompositionEnabled(composed != 0);
+            effects::Frame& result = composed ? precomposed : direct;
+            double time = 0.0;
+            timings[composed] = measure([&]() {
+                engine.process(input, result, entry.chain, 1.0f, time);
+                time += 1.0 / 60.0;
+            }, REPETITIONS);
+            addLutRecord(std::string(entry.name) + (composed ? ", precomposed" : ", direct"), timings[composed], 8.0);
+        }
+
+        int maxError = 0;
+        const double psnr = computePsnr(direct, precomposed, &maxError);
+        std::cout << std::left << std::setw(22) << entry.name << std::right
+                  << std::setw(12) << timings[0].medianMs << std::setw(16) << timings[1].medianMs
+                  << std::setw(9) << (timings[1].medianMs > 0.0 ? timings[0].medianMs / timings[1].medianMs : 0.0)
+                  << "x" << std::setw(10) << maxError << std::setw(10) << std::setprecision(1) << psnr
+                  << std::setprecision(3) << std::endl;
+    }
+}
+
+} // namespace bench
+} // namespace gamma
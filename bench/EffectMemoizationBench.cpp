@@ -0,0 +1,91 @@
+#include "Benchmark.h"
+#include "effects/EffectEngine.h"
+#include "effects/TestPattern.h"
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+namespace gamma {
+namespace bench {
+
+namespace {
+
+const int REPETITIONS = 30;
+
+struct Resolution {
+    const char* name;
+    int width;
+    int height;
+};
+
+const Resolution RESOLUTIONS[] = {
+    {"1080p", 1920, 1080},
+    {"ultrawide", 3440, 1440}
+};
+
+enum class Scenario {
+    Uncached,       // Result cache off: every frame renders everything
+    Live,           // New input every frame: keys change, nothing is reused
+    Paused,         // Same input and parameters: the output is reused as is
+    EditLast        // Same input, last effect's parameter moving: only it renders
+};
+
+struct Case {
+    const char* name;
+    Scenario scenario;
+};
+
+const Case CASES[] = {
+    {"cache off", Scenario::Uncached},
+    {"live input", Scenario::Live},
+    {"paused", Scenario::Paused},
+    {"edit last effect", Scenario::EditLast}
+};
+
+} // namespace
+
+void runEffectMemoizationBenchmarks() {
+    std::cout << "Chain: color correction, chromatic aberration, motion blur, mirror; repetitions: "
+              << REPETITIONS << std::endl;
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << std::left << std::setw(12) << "Resolution" << std::setw(20) << "Case" << std::right
+              << std::setw(12) << "ms/frame" << std::setw(10) << "hits" << std::setw(10) << "misses" << std::endl;
+
+    for (const auto& resolution : RESOLUTIONS) {
+        effects::Frame input(resolution.width, resolution.height);
+        effects::Frame output;
+        effects::renderTestPattern(input, 0.0);
+
+        for (const auto& entry : CASES) {
+            // Stateless effects only: temporal ones render every frame regardless
+            std::vector<effects::ChainSlot> chain = makeFixtureChain();
+            effects::EffectEngine engine;
+            engine.setMemoizationEnabled(entry.scenario != Scenario::Uncached);
+
+            double time = 0.0;
+            int frame = 0;
+            engine.process(input, output, chain, 1.0f, time);
+            engine.resetCacheStats();
+
+            Timing timing = measure([&]() {
+                ++frame;
+                time += 0.01;
+                if (entry.scenario == Scenario::Live) {
+                    // Stands in for a decoder delivering a new frame
+                    input.setContentId(effects::makeContentId());
+                } else if (entry.scenario == Scenario::EditLast) {
+                    chain.back().parameters[1] = 12.0f + static_cast<float>(frame % 8);
+                }
+                engine.process(input, output, chain, 1.0f, time);
+            }, REPETITIONS);
+
+            const effects::EffectEngine::CacheStats& stats = engine.getCacheStats();
+            std::cout << std::left << std::setw(12) << resolution.name << std::setw(20) << entry.name << std::right
+                      << std::setw(12) << timing.medianMs << std::setw(10) << stats.hits
+                      << std::setw(10) << stats.misses << std::endl;
+        }
+    }
+}
+
+} // namespace bench
+} // namespace gamma
@@ -0,0 +1,89 @@
+#include "Benchmark.h"
+#include "effects/EffectEngine.h"
+#include "effects/TestPattern.h"
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+namespace gamma {
+namespace bench {
+
+namespace {
+
+const int REPETITIONS = 20;
+
+struct Resolution {
+    const char* name;
+    int width;
+    int height;
+};
+
+const Resolution RESOLUTIONS[] = {
+    {"1080p", 1920, 1080},
+    {"4K", 3840, 2160}
+};
+
+struct Case {
+    const char* name;
+    float mix;
+    bool separateBlend;     // Fusion off: the blend runs as its own pass over the frame
+    bool bypassed;          // Every effect disabled
+};
+
+const Case CASES[] = {
+    {"mix 1", 1.0f, false, false},
+    {"mix 0", 0.0f, false, false},
+    {"mix 0.5, blend pass", 0.5f, true, false},
+    {"mix 0.5, folded", 0.5f, false, false},
+    {"all bypassed", 1.0f, false, true}
+};
+
+struct Chain {
+    const char* name;
+    effects::ChainSlot slot;
+};
+
+// Single effects, so switching fusion off only separates the blend: one
+// point-wise, one reading neighbouring pixels
+const Chain CHAINS[] = {
+    {"Color Correction", makeGradeSlot()},
+    {"Chromatic Aberration", makeSlot(effects::EffectType::ChromaticAberration, {0.6f, 12.0f, -12.0f})}
+};
+
+} // namespace
+
+void runEffectMixBenchmarks() {
+    std::cout << "Master mix and bypass over one effect, repetitions: " << REPETITIONS << std::endl;
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << std::left << std::setw(12) << "Resolution" << std::setw(24) << "Effect" << std::setw(22) << "Case"
+              << std::right << std::setw(12) << "ms/frame" << std::endl;
+
+    for (const auto& resolution : RESOLUTIONS) {
+        effects::Frame input(resolution.width, resolution.height);
+        effects::Frame output;
+        effects::renderTestPattern(input, 0.0);
+
+        for (const auto& chainCase : CHAINS) {
+            for (const auto& entry : CASES) {
+                std::vector<effects::ChainSlot> chain = {chainCase.slot};
+                chain[0].enabled = !entry.bypassed;
+
+                // Every frame is a new input, so nothing is reused from the result cache
+                effects::EffectEngine engine;
+                engine.setFusionEnabled(!entry.separateBlend);
+                double time = 0.0;
+                Timing timing = measure([&]() {
+                    input.setContentId(effects::makeContentId());
+                    engine.process(input, output, chain, entry.mix, time);
+                    time += 0.01;
+                }, REPETITIONS);
+
+                std::cout << std::left << std::setw(12) << resolution.name << std::setw(24) << chainCase.name
+                          << std::setw(22) << entry.name << std::right << std::setw(12) << timing.medianMs << std::endl;
+            }
+        }
+    }
+}
+
+} // namespace bench
+} // namespace gamma
@@ -0,0 +1,149 @@
+#include "Benchmark.h"
+#include "core/JobSystem.h"
+#include "effects/ChainThumbnails.h"
+#include "effects/Downscale.h"
+#include "effects/EffectEngine.h"
+#include "effects/TestPattern.h"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace gamma {
+namespace bench {
+
+namespace {
+
+const int REPETITIONS = 30;
+const int WARMUP_FRAMES = 20;   // Lets the engine's smoothed preview time settle
+const int PREVIEW_FACTOR = 4;
+
+struct Resolution {
+    const char* name;
+    int width;
+    int height;
+};
+
+const Resolution RESOLUTIONS[] = {
+    {"1080p", 1920, 1080},
+    {"4K", 3840, 2160}
+};
+
+enum class PreviewSource {
+    None,
+    Tap,            // Engine's preview tap: the program output downscaled
+    LowResChain,    // Input downscaled, then the chain again at preview size
+    Thumbnails      // ChainThumbnails: the chain's state after every slot
+};
+
+struct Case {
+    const char* name;
+    PreviewSource source;
+};
+
+const Case CASES[] = {
+    {"program only", PreviewSource::None},
+    {"+ preview tap", PreviewSource::Tap},
+    {"+ low-res chain", PreviewSource::LowResChain},
+    {"+ slot thumbnails", PreviewSource::Thumbnails}
+};
+
+const char* getFactorLabel(PreviewSource source) {
+    switch (source) {
+        case PreviewSource::Tap:
+        case PreviewSource::LowResChain:
+            return "1/4";
+        case PreviewSource::Thumbnails:
+            return "1/8";
+        case PreviewSource::None:
+            break;
+    }
+    return "-";
+}
+
+} // namespace
+
+void runEffectPreviewBenchmarks() {
+    const unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    std::unique_ptr<core::JobSystem> jobs;
+    if (threads > 1) {
+        jobs = std::make_unique<core::JobSystem>(threads - 1);
+    }
+
+    // Every frame is a new input, so nothing is reused from the result caches
+    const std::vector<effects::ChainSlot> chain = makeFixtureChain();
+
+    std::cout << "Program output plus a preview, chain of " << chain.size() << " effects, threads: " << threads
+              << ", repetitions: " << REPETITIONS << std::endl;
+    std::cout << "Preview ms is the part spent on the preview, measured apart from the program" << std::endl;
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << std::left << std::setw(12) << "Resolution" << std::setw(20) << "Case" << std::setw(8) << "scale"
+              << std::right << std::setw(12) << "total ms" << std::setw(12) << "preview ms" << std::endl;
+
+    for (const auto& resolution : RESOLUTIONS) {
+        effects::Frame input(resolution.width, resolution.height);
+        effects::Frame output;
+        effects::renderTestPattern(input, 0.0);
+
+        for (const auto& entry : CASES) {
+            effects::EffectEngine engine(jobs.get());
+            engine.setPreviewFactor(entry.source == PreviewSource::Tap ? PREVIEW_FACTOR : 0);
+            effects::EffectEngine lowResEngine(jobs.get());
+            effects::Frame lowResInput;
+            effects::Frame lowResOutput;
+            effects::ChainThumbnails thumbnails(jobs.get());
+
+            std::vector<double> previewSamples;
+            double time = 0.0;
+            auto step = [&]() {
+                input.setContentId(effects::makeContentId());
+                engine.process(input, output, chain, 1.0f, time);
+
+                const auto start = std::chrono::steady_clock::now();
+                if (entry.source == PreviewSource::LowResChain) {
+                    effects::downscaleFrame(input, lowResInput, PREVIEW_FACTOR, jobs.get());
+                    lowResEngine.process(lowResInput, lowResOutput, chain, 1.0f, time);
+                } else if (entry.source == PreviewSource::Thumbnails) {
+                    thumbnails.render(input, chain, time);
+                }
+                double previewMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+                if (entry.source == PreviewSource::Tap) {
+                    // The tap runs inside process(); the engine times it on its own
+                    previewMs = engine.getPreviewTimeMs();
+                }
+                previewSamples.push_back(previewMs);
+                time += 1.0 / 60.0;
+            };
+            for (int i = 0; i < WARMUP_FRAMES; ++i) {
+                step();
+            }
+            previewSamples.clear();
+            Timing timing = measure(step, REPETITIONS);
+
+            std::sort(previewSamples.begin(), previewSamples.end());
+            const double previewMs = previewSamples[previewSamples.size() / 2];
+
+            const double pixels = static_cast<double>(resolution.width) * resolution.height;
+            Record record;
+            record.suite = "preview";
+            record.name = entry.name;
+            record.width = resolution.width;
+            record.height = resolution.height;
+            record.threads = static_cast<int>(threads);
+            record.timing = timing;
+            record.nsPerPixel = timing.medianMs * 1e6 / pixels;
+            record.gigabytesPerSecond = 0.0;
+            addRecord(record);
+
+            std::cout << std::left << std::setw(12) << resolution.name << std::setw(20) << entry.name
+                      << std::setw(8) << getFactorLabel(entry.source) << std::right << std::setw(12) << timing.medianMs
+                      << std::setw(12) << previewMs << std::endl;
+        }
+    }
+}
+
+} // namespace bench
+} // namespace gamma
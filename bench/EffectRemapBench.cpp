@@ -0,0 +1,212 @@
+#include "Benchmark.h"
+#include "effects/EffectEngine.h"
+#include "effects/Effects.h"
+#include "effects/Kernels.h"
+#include "effects/RemapGrid.h"
+#include "effects/TestPattern.h"
+#include "core/Math.h"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace gamma {
+namespace bench {
+
+namespace {
+
+const int REPETITIONS = 15;
+const int WIDTH = 1920;
+const int HEIGHT = 1080;
+
+struct EffectCase {
+    const char* name;
+    effects::ChainSlot slot;
+};
+
+// The map evaluated at every pixel of every frame, then sampled: what each
+// effect would cost without a grid
+void remapDirect(effects::RemapEffect& effect, const effects::Frame& input, effects::Frame& output) {
+    const size_t count = static_cast<size_t>(WIDTH);
+    std::vector<float> x(count);
+    std::vector<float> y(count);
+    const effects::KernelTable& kernels = effects::getKernels();
+    const effects::RemapSource source = {input.rowData(0), input.getStride(), WIDTH, HEIGHT, input.getFormat()};
+    for (int row = 0; row < HEIGHT; ++row) {
+        for (size_t i = 0; i < count; ++i) {
+            x[i] = static_cast<float>(i) + 0.5f;
+            y[i] = static_cast<float>(row) + 0.5f;
+        }
+        effect.mapPoints(x.data(), y.data(), count);
+        kernels.remap(source, x.data(), y.data(), output.row(row), count);
+    }
+}
+
+void addRemapRecord(const std::string& name, const Timing& timing) {
+    const double pixels = static_cast<double>(WIDTH) * HEIGHT;
+    Record record;
+    record.suite = "remap";
+    record.name = name;
+    record.width = WIDTH;
+    record.height = HEIGHT;
+    record.threads = 1;
+    record.timing = timing;
+    record.nsPerPixel = timing.medianMs * 1e6 / pixels;
+    record.gigabytesPerSecond = timing.medianMs > 0.0 ? pixels * 8.0 / (timing.medianMs * 1e6) : 0.0;
+    addRecord(record);
+}
+
+} // namespace
+
+void runEffectRemapBenchmarks() {
+    std::cout << WIDTH << "x" << HEIGHT << ", single thread, repetitions: " << REPETITIONS << std::endl;
+    std::cout << std::fixed << std::setprecision(3);
+
+    effects::Frame input(WIDTH, HEIGHT);
+    effects::Frame output(WIDTH, HEIGHT);
+    effects::renderTestPattern(input, 0.5);
+
+    const std::vector<EffectCase> cases = {
+        {"Kaleidoscope", makeSlot(effects::EffectType::Kaleidoscope, {6.0f, 15.0f, 0.5f, 0.5f})},
+        {"Polar (to polar)", makeSlot(effects::EffectType::Polar, {1.0f, 0.0f, 1.0f})},
+        {"Polar (to rect)", makeSlot(effects::EffectType::Polar, {2.0f, 30.0f, 1.5f})},
+        {"Tile 3x2 mirrored", makeSlot(effects::EffectType::Tile, {3.0f, 2.0f, 1.0f})},
+        {"Warp", makeSlot(effects::EffectType::Warp, {0.5f, 3.0f, 0.0f})}
+    };
+
+    // Sampling kernel alone, at every instruction set, along a kaleidoscope's rows
+    effects::RemapGrid grid;
+    {
+        auto effect = effects::createEffectProcessor(cases[0].slot.type);
+        effects::EffectContext context;
+        effect->prepare(input, cases[0].slot.parameters, context);
+        const effects::RemapEffect* remap = effect->asRemap();
+        grid.build(WIDTH, HEIGHT, [remap](float* x, float* y, size_t count) { remap->mapPoints(x, y, count); });
+    }
+    const size_t count = static_cast<size_t>(WIDTH);
+    std::vector<float> positions(count * static_cast<size_t>(HEIGHT) * 2);
+    for (int y = 0; y < HEIGHT; ++y) {
+        float* row = &positions[static_cast<size_t>(y) * count * 2];
+        grid.getRow(y, row, row + count);
+    }
+    effects::Frame floatOutput(WIDTH, HEIGHT, effects::PixelFormat::RGBA32F);
+    effects::Frame halfInput(WIDTH, HEIGHT, effects::PixelFormat::RGBA16F);
+    for (int y = 0; y < HEIGHT; ++y) {
+        effects::getKernels().unpackPixels(input.row(y), floatOutput.rowFloat(y), count);
+        effects::getKernels().floatToHalf(floatOutput.rowFloat(y), halfInput.rowHalf(y), count);
+    }
+
+    std::cout << std::left << std::setw(22) << "Kernel" << std::right;
+    const effects::SimdLevel previous = effects::getKernels().level;
+    const effects::SimdLevel supported = effects::getSupportedSimdLevel();
+    for (int level = 0; level <= static_cast<int>(supported); ++level) {
+        std::cout << std::setw(12) << effects::getSimdLevelName(static_cast<effects::SimdLevel>(level));
+    }
+    std::cout << "   (ns per pixel)" << std::endl;
+
+    auto printKernel = [&](const std::string& name, const effects::Frame& source, bool floatPixels) {
+        const effects::RemapSource view = {source.rowData(0), source.getStride(), WIDTH, HEIGHT, source.getFormat()};
+        std::cout << std::left << std::setw(22) << name << std::right;
+        for (int level = 0; level <= static_cast<int>(supported); ++level) {
+            const effects::SimdLevel simd = effects::setSimdLevel(static_cast<effects::SimdLevel>(level));
+            const effects::KernelTable& kernels = effects::getKernels();
+            Timing timing = measure([&]() {
+                for (int y = 0; y < HEIGHT; ++y) {
+                    const float* row = &positions[static_cast<size_t>(y) * count * 2];
+                    if (floatPixels) {
+                        kernels.remapFloat(view, row, row + count, floatOutput.rowFloat(y), count);
+                    } else {
+                        kernels.remap(view, row, row + count, output.row(y), count);
+                    }
+                }
+            }, REPETITIONS);
+            std::cout << std::setw(12) << timing.medianMs * 1e6 / (static_cast<double>(WIDTH) * HEIGHT);
+            addRemapRecord(name + ", " + effects::getSimdLevelName(simd), timing);
+        }
+        std::cout << std::endl;
+    };
+    printKernel("remap RGBA8", input, false);
+    printKernel("remapFloat RGBA16F", halfInput, true);
+    printKernel("remapFloat RGBA32F", floatOutput, true);
+    effects::setSimdLevel(previous);
+
+    // Each effect: its map evaluated per pixel against the engine sampling a
+    // cached grid, what building that grid costs when a parameter moves, and
+    // how far the grid's result is from the exact one
+    std::cout << std::endl << "Kernels: " << effects::getSimdLevelName(effects::getKernels().level) << std::endl;
+    std::cout << std::left << std::setw(22) << "Effect" << std::right << std::setw(12) << "direct ms"
+              << std::setw(10) << "grid ms" << std::setw(10) << "speedup" << std::setw(10) << "build ms"
+              << std::setw(10) << "dense %" << std::setw(10) << "exact %" << std::setw(10) << "grid KB"
+              << std::setw(10) << "PSNR dB" << std::endl;
+
+    effects::Frame direct(WIDTH, HEIGHT);
+    for (const EffectCase& entry : cases) {
+        auto effect = effects::createEffectProcessor(entry.slot.type);
+        effects::EffectContext context;
+        effect->prepare(input, entry.slot.parameters, context);
+        effects::RemapEffect& remap = *effect->asRemap();
+
+        const Timing directTiming = measure([&]() { remapDirect(remap, input, direct); }, REPETITIONS);
+        addRemapRecord(std::string(entry.name) + ", direct", directTiming);
+
+        // Memoization off: every repetition samples, as for a playing clip
+        effects::EffectEngine engine;
+        engine.setMemoizationEnabled(false);
+        const std::vector<effects::ChainSlot> chain = {entry.slot};
+        const Timing gridTiming = measure([&]() { engine.process(input, output, chain, 1.0f, 0.0); }, REPETITIONS);
+        addRemapRecord(std::string(entry.name) + ", grid", gridTiming);
+
+        effects::RemapGrid built;
+        const Timing buildTiming = measure([&]() {
+            built.build(WIDTH, HEIGHT, [&remap](float* x, float* y, size_t n) { remap.mapPoints(x, y, n); });
+        }, REPETITIONS);
+        addRemapRecord(std::string(entry.name) + ", grid build", buildTiming);
+
+        const double cells = static_cast<double>(built.getCellCount());
+        std::cout << std::left << std::setw(22) << entry.name << std::right
+                  << std::setw(12) << directTiming.medianMs << std::setw(10) << gridTiming.medianMs
+                  << std::setw(9) << (gridTiming.medianMs > 0.0 ? directTiming.medianMs / gridTiming.medianMs : 0.0)
+                  << "x" << std::setw(10) << buildTiming.medianMs
+                  << std::setprecision(1) << std::setw(10) << 100.0 * built.getDenseCellCount() / cells
+                  << std::setw(10) << 100.0 * built.getExactCellCount() / cells
+                  << std::setw(10) << built.getBytes() / 1024 << std::setw(10) << computePsnr(direct, output)
+                  << std::setprecision(3) << std::endl;
+    }
+
+    // Several geometry effects in a row: composed into one grid and sampled
+    // once, against a pass per effect; and a parameter sweeping every frame,
+    // where no grid is reused and the composed map is evaluated per pixel
+    const std::vector<effects::ChainSlot> chain = {
+        makeSlot(effects::EffectType::Warp, {0.5f, 3.0f, 0.0f}),
+        makeSlot(effects::EffectType::Kaleidoscope, {6.0f, 15.0f, 0.5f, 0.5f}),
+        makeSlot(effects::EffectType::Tile, {2.0f, 2.0f, 1.0f})
+    };
+    std::cout << std::endl << std::left << std::setw(34) << "Warp + Kaleidoscope + Tile" << std::right
+              << std::setw(12) << "p50 ms" << std::setw(12) << "p99 ms" << std::endl;
+    auto printChain = [&](const char* name, bool composed, bool sweep) {
+        effects::EffectEngine engine;
+        engine.setMemoizationEnabled(false);
+        engine.setFusionEnabled(composed);
+        std::vector<effects::ChainSlot> frameChain = chain;
+        int frame = 0;
+        const Timing timing = measure([&]() {
+            if (sweep) {
+                frameChain[0].parameters[2] = static_cast<float>(frame++ % 360);
+            }
+            engine.process(input, output, frameChain, 1.0f, 0.0);
+        }, REPETITIONS);
+        std::cout << std::left << std::setw(34) << name << std::right << std::setw(12) << timing.medianMs
+                  << std::setw(12) << timing.p99Ms << std::endl;
+        addRemapRecord(std::string("chain, ") + name, timing);
+    };
+    printChain("pass per effect", false, false);
+    printChain("composed", true, false);
+    printChain("pass per effect, phase sweeping", false, true);
+    printChain("composed, phase sweeping", true, true);
+}
+
+} // namespace bench
+} // namespace gamma
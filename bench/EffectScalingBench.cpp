@@ -0,0 +1,97 @@
+#include "Benchmark.h"
+#include "core/JobSystem.h"
+#include "effects/EffectEngine.h"
+#include "effects/Kernels.h"
+#include "effects/TestPattern.h"
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace gamma {
+namespace bench {
+
+namespace {
+
+const int REPETITIONS = 15;
+const int WARMUP_FRAMES = 20;
+
+struct Resolution {
+    const char* name;
+    int width;
+    int height;
+};
+
+const Resolution RESOLUTIONS[] = {
+    {"1080p", 1920, 1080},
+    {"ultrawide", 3440, 1440}
+};
+
+// Every library effect once, with neighbourhood reads (halos) in the middle
+std::vector<effects::ChainSlot> buildShowChain() {
+    return {
+        makeGradeSlot(),
+        makeSlot(effects::EffectType::ChromaticAberration, {0.6f, 12.0f, -12.0f}),
+        makeSlot(effects::EffectType::MotionBlur, {0.3f, 60.0f, 8.0f}),
+        makeSlot(effects::EffectType::Datamosh, {0.2f, 8.0f, 0.5f}),
+        makeSlot(effects::EffectType::Mirror, {1.0f, 0.5f, 0.5f}),
+        makeSlot(effects::EffectType::TimeEcho, {0.1f, 0.5f, 0.4f})
+    };
+}
+
+} // namespace
+
+void runEffectScalingBenchmarks() {
+    const unsigned hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+    std::cout << "Kernels: " << effects::getSimdLevelName(effects::getKernels().level)
+              << ", hardware threads: " << hardwareThreads << ", repetitions: " << REPETITIONS << std::endl;
+    std::cout << "Chain: all six effects (CC, chromatic aberration, motion blur, datamosh, mirror, time echo)" << std::endl;
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << std::left << std::setw(12) << "Resolution" << std::right << std::setw(8) << "threads"
+              << std::setw(12) << "ms/frame" << std::setw(10) << "fps" << std::setw(10) << "speedup"
+              << std::setw(12) << "efficiency" << std::endl;
+
+    const std::vector<effects::ChainSlot> chain = buildShowChain();
+
+    for (const auto& resolution : RESOLUTIONS) {
+        effects::Frame input(resolution.width, resolution.height);
+        effects::Frame output;
+        effects::renderTestPattern(input, 0.0);
+
+        double singleThreadMs = 0.0;
+        for (unsigned threads = 1; threads <= hardwareThreads; ++threads) {
+            // The calling thread takes part, so N threads = N - 1 workers
+            std::unique_ptr<core::JobSystem> jobs;
+            if (threads > 1) {
+                jobs = std::make_unique<core::JobSystem>(threads - 1);
+            }
+            effects::EffectEngine engine(jobs.get());
+            engine.setMemoizationEnabled(false);    // Same input every frame: measure rendering, not the cache
+
+            double time = 0.0;
+            for (int i = 0; i < WARMUP_FRAMES; ++i) {
+                engine.process(input, output, chain, 1.0f, time);
+                time += 0.01;
+            }
+            Timing timing = measure([&]() {
+                engine.process(input, output, chain, 1.0f, time);
+                time += 0.01;
+            }, REPETITIONS);
+
+            if (threads == 1) {
+                singleThreadMs = timing.medianMs;
+            }
+            double speedup = timing.medianMs > 0.0 ? singleThreadMs / timing.medianMs : 0.0;
+
+            std::cout << std::left << std::setw(12) << resolution.name << std::right << std::setw(8) << threads
+                      << std::setw(12) << timing.medianMs
+                      << std::setw(10) << (timing.medianMs > 0.0 ? 1000.0 / timing.medianMs : 0.0)
+                      << std::setw(9) << speedup << "x"
+                      << std::setw(11) << speedup / threads * 100.0 << "%" << std::endl;
+        }
+    }
+}
+
+} // namespace bench
+} // namespace gamma
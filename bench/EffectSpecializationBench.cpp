@@ -0,0 +1,88 @@
+#include "Benchmark.h"
+#include "effects/Effects.h"
+#include "effects/Kernels.h"
+#include "effects/TestPattern.h"
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace gamma {
+namespace bench {
+
+namespace {
+
+const int REPETITIONS = 15;
+const int WIDTH = 1920;
+const int HEIGHT = 1080;
+
+struct Case {
+    std::string name;
+    effects::EffectType type;
+    std::vector<float> parameters;
+};
+
+std::vector<Case> buildCases() {
+    std::vector<Case> cases;
+    for (int samples : {2, 4, 8, 16, 32}) {
+        cases.push_back({"Motion Blur " + std::to_string(samples) + " samples",
+                         effects::EffectType::MotionBlur, {0.5f, 20.0f, static_cast<float>(samples)}});
+    }
+    const char* modeNames[] = {"none", "horizontal", "vertical", "both"};
+    for (int mode = 0; mode < 4; ++mode) {
+        cases.push_back({std::string("Mirror ") + modeNames[mode],
+                         effects::EffectType::Mirror, {static_cast<float>(mode), 0.5f, 0.5f}});
+    }
+    return cases;
+}
+
+bool framesEqual(const effects::Frame& a, const effects::Frame& b) {
+    for (int y = 0; y < a.getHeight(); ++y) {
+        if (std::memcmp(a.row(y), b.row(y), static_cast<size_t>(a.getWidth()) * sizeof(uint32_t)) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+Timing runCase(const Case& entry, const effects::Frame& input, effects::Frame& output, bool specialized) {
+    effects::setKernelSpecialization(specialized);
+    auto processor = effects::createEffectProcessor(entry.type);
+    effects::EffectContext context;
+    return measure([&]() {
+        processor->process(input, output, entry.parameters.data(), context);
+    }, REPETITIONS);
+}
+
+} // namespace
+
+void runEffectSpecializationBenchmarks() {
+    std::cout << "Kernels: " << effects::getSimdLevelName(effects::getKernels().level)
+              << ", " << WIDTH << "x" << HEIGHT << ", repetitions: " << REPETITIONS << std::endl;
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << std::left << std::setw(28) << "Case" << std::right
+              << std::setw(14) << "generic (ms)" << std::setw(18) << "specialized (ms)"
+              << std::setw(10) << "speedup" << std::setw(10) << "output" << std::endl;
+
+    effects::Frame input(WIDTH, HEIGHT);
+    effects::Frame generic(WIDTH, HEIGHT);
+    effects::Frame specialized(WIDTH, HEIGHT);
+    effects::renderTestPattern(input, 0.5);
+
+    const bool previous = effects::isKernelSpecializationEnabled();
+    for (const Case& entry : buildCases()) {
+        Timing genericTiming = runCase(entry, input, generic, false);
+        Timing specializedTiming = runCase(entry, input, specialized, true);
+
+        std::cout << std::left << std::setw(28) << entry.name << std::right
+                  << std::setw(14) << genericTiming.medianMs
+                  << std::setw(18) << specializedTiming.medianMs
+                  << std::setw(9) << (specializedTiming.medianMs > 0.0 ? genericTiming.medianMs / specializedTiming.medianMs : 0.0)
+                  << "x" << std::setw(10) << (framesEqual(generic, specialized) ? "same" : "DIFFERS") << std::endl;
+    }
+    effects::setKernelSpecialization(previous);
+}
+
+} // namespace bench
+} // namespace gamma
@@ -0,0 +1,153 @@
+#include "Benchmark.h"
+#include "core/JobSystem.h"
+#include "effects/EffectEngine.h"
+#include "effects/Kernels.h"
+#include "effects/TestPattern.h"
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace gamma {
+namespace bench {
+
+namespace {
+
+const int REPETITIONS = 40;
+const int WARMUP_FRAMES = 10;
+const int LOOK_SIZE = 33;
+
+struct Resolution {
+    const char* name;
+    int width;
+    int height;
+};
+
+const Resolution RESOLUTIONS[] = {
+    {"720p", 1280, 720},
+    {"1080p", 1920, 1080},
+    {"ultrawide", 3440, 1440},
+    {"4K", 3840, 2160}
+};
+
+struct Case {
+    std::string name;
+    std::vector<effects::ChainSlot> chain;
+};
+
+/**
+ * @param look Library index of the look Color LUT applies
+ */
+std::vector<Case> buildCases(int look) {
+    using effects::EffectType;
+    std::vector<Case> cases;
+
+    // Every effect in the library on its own
+    for (int i = 0; i < static_cast<int>(EffectType::Count); ++i) {
+        EffectType type = static_cast<EffectType>(i);
+        cases.push_back({effects::getEffectTypeName(type), {makeEffectSlot(type, look)}});
+    }
+
+    // Representative chains
+    cases.push_back({"chain: grade", {makeEffectSlot(EffectType::ColorCorrection),
+                                      makeEffectSlot(EffectType::ChromaticAberration)}});
+    cases.push_back({"chain: geometry", {makeEffectSlot(EffectType::Mirror),
+                                         makeEffectSlot(EffectType::MotionBlur),
+                                         makeEffectSlot(EffectType::ColorCorrection)}});
+    cases.push_back({"chain: remaps", {makeEffectSlot(EffectType::Warp),
+                                       makeEffectSlot(EffectType::Kaleidoscope),
+                                       makeEffectSlot(EffectType::Tile)}});
+    cases.push_back({"chain: full show", {makeEffectSlot(EffectType::ColorCorrection),
+                                          makeEffectSlot(EffectType::ChromaticAberration),
+                                          makeEffectSlot(EffectType::MotionBlur),
+                                          makeEffectSlot(EffectType::Datamosh),
+                                          makeEffectSlot(EffectType::Mirror),
+                                          makeEffectSlot(EffectType::TimeEcho)}});
+    return cases;
+}
+
+// 1, 2, 4, ... up to the hardware threads, which are always included
+std::vector<unsigned> buildThreadCounts() {
+    const unsigned hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<unsigned> counts;
+    for (unsigned threads = 1; threads < hardwareThreads; threads *= 2) {
+        counts.push_back(threads);
+    }
+    counts.push_back(hardwareThreads);
+    return counts;
+}
+
+} // namespace
+
+void runEffectSuiteBenchmarks() {
+    // Without a look Color LUT would only copy its input
+    const int look = effects::getLutLibrary().add("bench 33", makeLook(LOOK_SIZE));
+    if (look < 0) {
+        std::cerr << "LUT library full: the Color LUT case only copies its input" << std::endl;
+    }
+    const std::vector<Case> cases = buildCases(look);
+    const std::vector<unsigned> threadCounts = buildThreadCounts();
+
+    std::cout << "Kernels: " << effects::getSimdLevelName(effects::getKernels().level)
+              << ", hardware threads: " << threadCounts.back() << ", frames per case: " << REPETITIONS << std::endl;
+    std::cout << "GB/s counts one read and one write of every pixel per effect" << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << std::left << std::setw(11) << "Resolution" << std::setw(24) << "Case" << std::right
+              << std::setw(8) << "threads" << std::setw(10) << "p50 ms" << std::setw(10) << "p99 ms"
+              << std::setw(10) << "ns/px" << std::setw(9) << "GB/s"
+              << std::setw(10) << "fps p50" << std::setw(10) << "fps p99" << std::endl;
+
+    for (const auto& resolution : RESOLUTIONS) {
+        const double pixels = static_cast<double>(resolution.width) * resolution.height;
+        effects::Frame input(resolution.width, resolution.height);
+        effects::Frame output;
+        effects::renderTestPattern(input, 0.0);
+
+        for (unsigned threads : threadCounts) {
+            std::unique_ptr<core::JobSystem> jobs;
+            if (threads > 1) {
+                jobs = std::make_unique<core::JobSystem>(threads - 1);
+            }
+
+            for (const auto& entry : cases) {
+                // A fresh engine per case, so temporal effects start from empty history.
+                // Every frame gets a new content id, as from a decoder, so no
+                // result is reused from the engine's cache
+                effects::EffectEngine engine(jobs.get());
+                double time = 0.0;
+                auto step = [&]() {
+                    input.setContentId(effects::makeContentId());
+                    engine.process(input, output, entry.chain, 1.0f, time);
+                    time += 1.0 / 60.0;
+                };
+                for (int i = 0; i < WARMUP_FRAMES; ++i) {
+                    step();
+                }
+                Timing timing = measure(step, REPETITIONS);
+
+                const double frameBytes = 2.0 * pixels * sizeof(uint32_t) * static_cast<double>(entry.chain.size());
+                Record record;
+                record.suite = "effects";
+                record.name = entry.name;
+                record.width = resolution.width;
+                record.height = resolution.height;
+                record.threads = static_cast<int>(threads);
+                record.timing = timing;
+                record.nsPerPixel = timing.medianMs * 1e6 / pixels;
+                record.gigabytesPerSecond = timing.medianMs > 0.0 ? frameBytes / (timing.medianMs * 1e6) : 0.0;
+                addRecord(record);
+
+                std::cout << std::left << std::setw(11) << resolution.name << std::setw(24) << entry.name << std::right
+                          << std::setw(8) << threads << std::setw(10) << timing.medianMs << std::setw(10) << timing.p99Ms
+                          << std::setw(10) << record.nsPerPixel << std::setw(9) << record.gigabytesPerSecond
+                          << std::setw(10) << (timing.medianMs > 0.0 ? 1000.0 / timing.medianMs : 0.0)
+                          << std::setw(10) << (timing.p99Ms > 0.0 ? 1000.0 / timing.p99Ms : 0.0) << std::endl;
+            }
+        }
+    }
+}
+
+} // namespace bench
+} // namespace gamma
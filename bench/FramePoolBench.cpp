@@ -0,0 +1,160 @@
+#include "Benchmark.h"
+#include "core/JobSystem.h"
+#include "effects/EffectEngine.h"
+#include "effects/FramePool.h"
+#include "effects/TestPattern.h"
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+namespace gamma {
+namespace bench {
+
+namespace {
+
+const int REPETITIONS = 20;
+const int WIDTH = 3440;     // Ultrawide: about 20 MB per RGBA8 frame
+const int HEIGHT = 1440;
+
+struct Case {
+    const char* name;
+    effects::HugePageMode hugePages;
+    bool prefault;
+    bool pooled;        // Keep released buffers (false: trim after every step)
+};
+
+const Case CASES[] = {
+    {"fresh, first touch", effects::HugePageMode::Off, false, false},
+    {"fresh, prefault", effects::HugePageMode::Off, true, false},
+    {"fresh, THP + prefault", effects::HugePageMode::Transparent, true, false},
+    {"pooled", effects::HugePageMode::Transparent, true, true}
+};
+
+// Minor page faults of the process so far (0 where not available)
+long getPageFaults() {
+#ifndef _WIN32
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_minflt;
+#else
+    return 0;
+#endif
+}
+
+void printRow(const char* scenario, const Case& entry, const Timing& timing, double faults) {
+    std::cout << std::left << std::setw(22) << scenario << std::setw(24) << entry.name << std::right
+              << std::setw(10) << timing.medianMs << std::setw(10) << timing.p99Ms
+              << std::setw(12) << faults << std::endl;
+}
+
+void addPoolRecord(const std::string& name, const Timing& timing, int threads) {
+    const double pixels = static_cast<double>(WIDTH) * HEIGHT;
+    Record record;
+    record.suite = "pool";
+    record.name = name;
+    record.width = WIDTH;
+    record.height = HEIGHT;
+    record.threads = threads;
+    record.timing = timing;
+    record.nsPerPixel = timing.medianMs * 1e6 / pixels;
+    record.gigabytesPerSecond = 0.0;
+    addRecord(record);
+}
+
+} // namespace
+
+void runFramePoolBenchmarks() {
+    const unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    std::unique_ptr<core::JobSystem> jobs;
+    if (threads > 1) {
+        jobs = std::make_unique<core::JobSystem>(threads - 1);
+    }
+
+    std::cout << "Frame pool at " << WIDTH << "x" << HEIGHT << ", threads: " << threads
+              << ", repetitions: " << REPETITIONS << std::endl;
+    std::cout << "Fresh cases give every buffer back to the OS after each step; faults are minor page faults per step"
+              << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << std::left << std::setw(22) << "Scenario" << std::setw(24) << "Case" << std::right
+              << std::setw(10) << "p50 ms" << std::setw(10) << "p99 ms" << std::setw(12) << "faults" << std::endl;
+
+    // A frame's storage taken, filled once and given back: what a subsystem
+    // allocating per frame pays
+    const effects::PixelFormat formats[] = {effects::PixelFormat::RGBA8, effects::PixelFormat::RGBA32F};
+    for (effects::PixelFormat format : formats) {
+        const size_t bytes = static_cast<size_t>(WIDTH) * HEIGHT * effects::getPixelBytes(format);
+        const std::string scenario = std::string("fill ") + effects::getPixelFormatName(format);
+        for (const auto& entry : CASES) {
+            effects::FramePool pool;
+            pool.setHugePageMode(entry.hugePages);
+            pool.setPrefault(entry.prefault);
+            long faults = 0;
+            auto step = [&]() {
+                const long before = getPageFaults();
+                size_t capacity = 0;
+                void* buffer = pool.acquire(bytes, capacity);
+                std::memset(buffer, 0x40, bytes);
+                pool.release(buffer);
+                if (!entry.pooled) {
+                    pool.trim();
+                }
+                faults += getPageFaults() - before;
+            };
+            Timing timing = measure(step, REPETITIONS);
+            printRow(scenario.c_str(), entry, timing, static_cast<double>(faults) / (REPETITIONS + 1));
+            addPoolRecord(scenario + ", " + entry.name, timing, static_cast<int>(threads));
+        }
+    }
+
+    // A new engine's first frame (a chain rebuilt, a thumbnail engine
+    // created): every scratch and history frame is new. Runs on the shared
+    // pool, as the engine's frames do
+    std::vector<effects::ChainSlot> chain = makeFixtureChain();
+    chain.push_back(makeSlot(effects::EffectType::TimeEcho, {0.2f, 0.5f, 0.5f}));
+    effects::Frame input(WIDTH, HEIGHT);
+    effects::renderTestPattern(input, 0.0);
+
+    effects::FramePool& shared = effects::getFramePool();
+    const effects::HugePageMode sharedMode = shared.getHugePageMode();
+    const bool sharedPrefault = shared.getPrefault();
+    for (const auto& entry : CASES) {
+        shared.setHugePageMode(entry.hugePages);
+        shared.setPrefault(entry.prefault);
+        shared.trim();
+        long faults = 0;
+        auto step = [&]() {
+            const long before = getPageFaults();
+            {
+                effects::EffectEngine engine(jobs.get());
+                effects::Frame output;
+                input.setContentId(effects::makeContentId());
+                engine.process(input, output, chain, 1.0f, 0.0);
+            }
+            if (!entry.pooled) {
+                shared.trim();
+            }
+            faults += getPageFaults() - before;
+        };
+        Timing timing = measure(step, REPETITIONS);
+        printRow("new engine, 1st frame", entry, timing, static_cast<double>(faults) / (REPETITIONS + 1));
+        addPoolRecord(std::string("new engine, ") + entry.name, timing, static_cast<int>(threads));
+    }
+
+    const effects::FramePoolStats stats = shared.getStats();
+    std::cout << "Shared pool: " << stats.liveBuffers << " live, peak " << (stats.peakLiveBytes >> 20) << " MB, "
+              << stats.pooledBuffers << " pooled (" << (stats.pooledBytes >> 20) << " MB), "
+              << stats.systemAllocations << " OS allocations, " << stats.reuses << " reuses" << std::endl;
+    shared.setHugePageMode(sharedMode);
+    shared.setPrefault(sharedPrefault);
+}
+
+} // namespace bench
+} // namespace gamma
@@ -0,0 +1,245 @@
+#include "Benchmark.h"
+#include "core/JobSystem.h"
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace gamma {
+namespace bench {
+
+namespace {
+
+/**
+ * @brief Baseline: one shared queue behind a mutex, no stealing, no priorities
+ */
+class NaiveThreadPool {
+public:
+    explicit NaiveThreadPool(unsigned workerCount)
+        : _running(true), _pending(0) {
+        for (unsigned i = 0; i < workerCount; ++i) {
+            _threads.emplace_back([this]() { workerLoop(); });
+        }
+    }
+
+    ~NaiveThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _running = false;
+        }
+        _condition.notify_all();
+        for (auto& thread : _threads) {
+            thread.join();
+        }
+    }
+
+    void submit(std::function<void()> task) {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _tasks.push(std::move(task));
+            ++_pending;
+        }
+        _condition.notify_one();
+    }
+
+    void waitIdle() {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _idleCondition.wait(lock, [this]() { return _pending == 0; });
+    }
+
+    void parallelFor(size_t begin, size_t end, size_t grainSize,
+                     const std::function<void(size_t, size_t)>& body) {
+        for (size_t chunk = begin; chunk < end; chunk += grainSize) {
+            size_t chunkEnd = std::min(end, chunk + grainSize);
+            submit([&body, chunk, chunkEnd]() { body(chunk, chunkEnd); });
+        }
+        waitIdle();
+    }
+
+private:
+    void workerLoop() {
+        for (;;) {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _condition.wait(lock, [this]() { return !_running || !_tasks.empty(); });
+                if (!_running && _tasks.empty()) {
+                    return;
+                }
+                task = std::move(_tasks.front());
+                _tasks.pop();
+            }
+
+            task();
+
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (--_pending == 0) {
+                _idleCondition.notify_all();
+            }
+        }
+    }
+
+    std::vector<std::thread> _threads;
+    std::queue<std::function<void()>> _tasks;
+    std::mutex _mutex;
+    std::condition_variable _condition;
+    std::condition_variable _idleCondition;
+    bool _running;
+    size_t _pending;
+};
+
+const int REPETITIONS = 7;
+const size_t ARRAY_SIZE = 8 * 1024 * 1024;
+const int SPAWN_DEPTH = 15;           // 2^15 leaf tasks
+const size_t TINY_TASK_COUNT = 100000;
+
+inline float kernel(float x) {
+    // A few dependent flops per element, enough to be compute- not launch-bound
+    for (int i = 0; i < 8; ++i) {
+        x = x * 0.999f + 0.5f;
+    }
+    return x;
+}
+
+void spawnTree(core::JobSystem& jobs, int depth, std::atomic<size_t>& leaves) {
+    if (depth == 0) {
+        leaves.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    jobs.submit([&jobs, depth, &leaves]() { spawnTree(jobs, depth - 1, leaves); });
+    jobs.submit([&jobs, depth, &leaves]() { spawnTree(jobs, depth - 1, leaves); });
+}
+
+void spawnTree(NaiveThreadPool& pool, int depth, std::atomic<size_t>& leaves) {
+    if (depth == 0) {
+        leaves.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    pool.submit([&pool, depth, &leaves]() { spawnTree(pool, depth - 1, leaves); });
+    pool.submit([&pool, depth, &leaves]() { spawnTree(pool, depth - 1, leaves); });
+}
+
+void waitForCount(const std::atomic<size_t>& counter, size_t expected) {
+    while (counter.load(std::memory_order_acquire) < expected) {
+        std::this_thread::yield();
+    }
+}
+
+void printRow(const char* name, const Timing& naive, const Timing& stealing) {
+    std::cout << std::left << std::setw(28) << name << std::right
+              << std::setw(12) << naive.medianMs
+              << std::setw(14) << stealing.medianMs
+              << std::setw(10) << (stealing.medianMs > 0.0 ? naive.medianMs / stealing.medianMs : 0.0)
+              << "x" << std::endl;
+}
+
+} // namespace
+
+void runJobSystemBenchmarks() {
+    core::JobSystem jobs;
+    // Same number of threads on both sides; the job system's caller also helps
+    NaiveThreadPool pool(jobs.getWorkerCount() + 1);
+
+    std::cout << "Workers: " << jobs.getWorkerCount() << " (+ caller), repetitions: " << REPETITIONS << std::endl;
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << std::left << std::setw(28) << "Case" << std::right
+              << std::setw(12) << "naive (ms)" << std::setw(14) << "stealing (ms)"
+              << std::setw(11) << "speedup" << std::endl;
+
+    // 1. Parallel-for over a large array
+    std::vector<float> input(ARRAY_SIZE, 1.0f);
+    std::vector<float> output(ARRAY_SIZE, 0.0f);
+    auto body = [&input, &output](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            output[i] = kernel(input[i]);
+        }
+    };
+    const size_t grain = 16 * 1024;
+    Timing naiveFor = measure([&]() { pool.parallelFor(0, ARRAY_SIZE, grain, body); }, REPETITIONS);
+    Timing jobsFor = measure([&]() { jobs.parallelFor(0, ARRAY_SIZE, grain, body); }, REPETITIONS);
+    printRow("parallelFor 8M floats", naiveFor, jobsFor);
+
+    // 2. Many tiny independent tasks submitted from the main thread
+    std::atomic<size_t> counter(0);
+    Timing naiveTiny = measure([&]() {
+        counter = 0;
+        for (size_t i = 0; i < TINY_TASK_COUNT; ++i) {
+            pool.submit([&counter]() { counter.fetch_add(1, std::memory_order_relaxed); });
+        }
+        pool.waitIdle();
+    }, REPETITIONS);
+    Timing jobsTiny = measure([&]() {
+        counter = 0;
+        std::vector<core::JobSystem::TaskHandle> handles;
+        handles.reserve(TINY_TASK_COUNT);
+        for (size_t i = 0; i < TINY_TASK_COUNT; ++i) {
+            handles.push_back(jobs.submit([&counter]() { counter.fetch_add(1, std::memory_order_relaxed); }));
+        }
+        jobs.waitAll(handles);
+    }, REPETITIONS);
+    printRow("100k tiny tasks", naiveTiny, jobsTiny);
+
+    // 3. Recursive fan-out: tasks spawning tasks (work stays on the spawning worker)
+    const size_t leafCount = size_t(1) << SPAWN_DEPTH;
+    Timing naiveTree = measure([&]() {
+        counter = 0;
+        spawnTree(pool, SPAWN_DEPTH, counter);
+        waitForCount(counter, leafCount);
+        pool.waitIdle();
+    }, REPETITIONS);
+    Timing jobsTree = measure([&]() {
+        counter = 0;
+        spawnTree(jobs, SPAWN_DEPTH, counter);
+        waitForCount(counter, leafCount);
+    }, REPETITIONS);
+    printRow("recursive spawn 32k leaves", naiveTree, jobsTree);
+
+    // 4. Frame-critical work submitted while background work saturates the pool
+    jobs.resetStats();
+    std::atomic<bool> stopBackground(false);
+    std::vector<core::JobSystem::TaskHandle> background;
+    for (unsigned i = 0; i < jobs.getWorkerCount() * 4; ++i) {
+        background.push_back(jobs.submit([&stopBackground]() {
+            while (!stopBackground.load(std::memory_order_relaxed)) {
+                std::this_thread::sleep_for(std::chrono::microseconds(200));
+            }
+        }, core::TaskPriority::Background));
+    }
+    Timing critical = measure([&]() {
+        jobs.parallelFor(0, ARRAY_SIZE / 8, grain, body, core::TaskPriority::FrameCritical);
+    }, REPETITIONS);
+    stopBackground = true;
+    jobs.waitAll(background);
+    std::cout << std::left << std::setw(28) << "critical under bg load" << std::right
+              << std::setw(12) << "-" << std::setw(14) << critical.medianMs << std::endl;
+
+    // 5. Dependency graph: diamond continuations (A -> B, C -> D) x 1000
+    Timing diamonds = measure([&]() {
+        std::vector<core::JobSystem::TaskHandle> tails;
+        tails.reserve(1000);
+        for (int i = 0; i < 1000; ++i) {
+            auto a = jobs.submit([]() {});
+            auto b = jobs.then(a, []() {});
+            auto c = jobs.then(a, []() {});
+            tails.push_back(jobs.submitAfter({b, c}, []() {}));
+        }
+        jobs.waitAll(tails);
+    }, REPETITIONS);
+    std::cout << std::left << std::setw(28) << "1000 diamond DAGs" << std::right
+              << std::setw(12) << "-" << std::setw(14) << diamonds.medianMs << std::endl;
+
+    std::cout << std::endl << "Worker utilization (last two cases):" << std::endl;
+    auto stats = jobs.getWorkerStats();
+    for (size_t i = 0; i < stats.size(); ++i) {
+        std::cout << "  worker " << i << ": " << std::setprecision(1) << stats[i].utilization * 100.0 << "% busy, "
+                  << stats[i].tasksExecuted << " tasks, " << stats[i].tasksStolen << " stolen" << std::endl;
+    }
+}
+
+} // namespace bench
+} // namespace gamma
@@ -0,0 +1,214 @@
+#include "Benchmark.h"
+#include "core/JobSystem.h"
+#include "core/Math.h"
+#include "effects/EffectEngine.h"
+#include "effects/TestPattern.h"
+#ifdef GAMMA_HAS_MIDI
+#include "midi/MidiManager.h"
+#include "midi/MidiReplay.h"
+#endif
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace gamma {
+namespace bench {
+
+namespace {
+
+const int WIDTH = 1920;
+const int HEIGHT = 1080;
+const int FRAMES = 600;                     // Ten seconds of show at 60 fps
+const double FRAME_TIME = 1.0 / 60.0;       // Fixed step: runs do not depend on the machine's speed
+const float MASTER_MIX = 0.85f;
+const float SMOOTHING = 0.05f;              // Parameter slew, as the app gives controller moves
+
+std::string g_replayFile;
+
+enum ShowSlot {
+    SLOT_COLOR = 0,
+    SLOT_ABERRATION,
+    SLOT_BLUR,
+    SLOT_DATAMOSH,
+    SLOT_MIRROR,
+    SLOT_ECHO
+};
+
+// Every library effect, in ShowSlot order
+std::vector<effects::ChainSlot> buildShowChain() {
+    return {
+        makeSlot(effects::EffectType::ColorCorrection, {0.05f, 1.2f, 1.1f, 0.0f}, SMOOTHING),
+        makeSlot(effects::EffectType::ChromaticAberration, {0.6f, 12.0f, -12.0f}, SMOOTHING),
+        makeSlot(effects::EffectType::MotionBlur, {0.3f, 0.0f, 8.0f}, SMOOTHING),
+        makeSlot(effects::EffectType::Datamosh, {0.3f, 8.0f, 0.5f}, SMOOTHING),
+        makeSlot(effects::EffectType::Mirror, {3.0f, 0.5f, 0.5f}, SMOOTHING),
+        makeSlot(effects::EffectType::TimeEcho, {0.1f, 0.5f, 0.4f}, SMOOTHING)
+    };
+}
+
+/**
+ * @brief Show controls turned by the jog wheels
+ *
+ * Deck 1 turns the hue and the motion blur angle, deck 2 spreads the
+ * chromatic aberration.
+ */
+struct ShowState {
+    float hue = 0.0f;
+    float blurAngle = 0.0f;
+    float aberration = 12.0f;
+
+    void jog(int channel, float degrees) {
+        if (channel == 1) {
+            hue = core::fmod(hue + degrees + 540.0f, 360.0f) - 180.0f;
+            blurAngle = core::fmod(blurAngle + degrees + 360.0f, 360.0f);
+        } else {
+            aberration = std::min(50.0f, std::max(-50.0f, aberration + degrees * 0.25f));
+        }
+    }
+
+    void apply(std::vector<effects::ChainSlot>& chain) const {
+        chain[SLOT_COLOR].parameters[3] = hue;
+        chain[SLOT_BLUR].parameters[1] = blurAngle;
+        chain[SLOT_ABERRATION].parameters[1] = aberration;
+        chain[SLOT_ABERRATION].parameters[2] = -aberration;
+    }
+};
+
+/**
+ * @brief Jog wheel input for the workload
+ *
+ * Replays the MIDI log through MidiManager, the same dispatch path as a
+ * connected controller, looping it for as long as the run lasts. Without
+ * a log (or a core built without MIDI) the wheels follow a fixed sweep.
+ */
+class JogInput {
+public:
+    explicit JogInput(ShowState& state)
+        : _state(state)
+        , _replaying(false)
+        , _loopStart(0.0)
+        , _messages(0) {
+#ifdef GAMMA_HAS_MIDI
+        _manager.setConsoleEcho(false);
+        _manager.setJogWheelCallback([this](int channel, float degrees) {
+            _state.jog(channel, degrees);
+        });
+#endif
+    }
+
+    bool loadReplay(const std::string& filename) {
+#ifdef GAMMA_HAS_MIDI
+        _replaying = _replay.load(filename) && _replay.getDuration() > 0.0;
+#else
+        (void)filename;
+        std::cerr << "Built without MIDI - the workload uses a fixed jog sweep" << std::endl;
+#endif
+        return _replaying;
+    }
+
+    void advance(double time, int frame) {
+#ifdef GAMMA_HAS_MIDI
+        if (_replaying) {
+            _messages += _replay.advance(time - _loopStart,
+                [this](const std::vector<unsigned char>& message, double timestamp) {
+                    _manager.injectMessage(message, timestamp);
+                });
+            if (_replay.isFinished()) {
+                _replay.rewind();
+                _loopStart = time;
+            }
+            return;
+        }
+#endif
+        (void)time;
+        _state.jog(1 + frame % 2, 4.0f * core::sin(static_cast<float>(frame) * 0.05f));
+    }
+
+    bool isReplaying() const { return _replaying; }
+    size_t getMessageCount() const { return _messages; }
+
+private:
+    ShowState& _state;
+    bool _replaying;
+    double _loopStart;
+    size_t _messages;
+#ifdef GAMMA_HAS_MIDI
+    midi::MidiManager _manager;
+    midi::MidiReplay _replay;
+#endif
+};
+
+} // namespace
+
+void setWorkloadReplayFile(const std::string& filename) {
+    g_replayFile = filename;
+}
+
+void runReplayWorkloadBenchmarks() {
+    const unsigned hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<unsigned> threadCounts = {1};
+    if (hardwareThreads > 1) {
+        threadCounts.push_back(hardwareThreads);
+    }
+
+    std::cout << "Show chain of every effect at " << WIDTH << "x" << HEIGHT << ", " << FRAMES
+              << " frames at a fixed 60 fps step" << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << std::left << std::setw(20) << "Case" << std::right << std::setw(8) << "threads"
+              << std::setw(10) << "p50 ms" << std::setw(10) << "p99 ms"
+              << std::setw(10) << "fps p50" << std::setw(15) << "MIDI messages" << std::endl;
+
+    const double pixels = static_cast<double>(WIDTH) * HEIGHT;
+
+    for (unsigned threads : threadCounts) {
+        std::unique_ptr<core::JobSystem> jobs;
+        if (threads > 1) {
+            jobs = std::make_unique<core::JobSystem>(threads - 1);
+        }
+
+        // Everything starts fresh per run, so each run sees the same frames
+        effects::EffectEngine engine(jobs.get());
+        effects::Frame input(WIDTH, HEIGHT);
+        effects::Frame output;
+        std::vector<effects::ChainSlot> chain = buildShowChain();
+        ShowState state;
+        JogInput jogs(state);
+        if (!g_replayFile.empty()) {
+            jogs.loadReplay(g_replayFile);
+        }
+
+        double time = 0.0;
+        int frame = 0;
+        Timing timing = measure([&]() {
+            jogs.advance(time, frame);
+            state.apply(chain);
+            effects::renderTestPattern(input, time);
+            engine.process(input, output, chain, MASTER_MIX, time);
+            time += FRAME_TIME;
+            ++frame;
+        }, FRAMES - 1);
+
+        const double frameBytes = 2.0 * pixels * sizeof(uint32_t) * static_cast<double>(chain.size());
+        Record record;
+        record.suite = "workload";
+        record.name = jogs.isReplaying() ? "show: midi replay" : "show: jog sweep";
+        record.width = WIDTH;
+        record.height = HEIGHT;
+        record.threads = static_cast<int>(threads);
+        record.timing = timing;
+        record.nsPerPixel = timing.medianMs * 1e6 / pixels;
+        record.gigabytesPerSecond = timing.medianMs > 0.0 ? frameBytes / (timing.medianMs * 1e6) : 0.0;
+        addRecord(record);
+
+        std::cout << std::left << std::setw(20) << record.name << std::right << std::setw(8) << threads
+                  << std::setw(10) << timing.medianMs << std::setw(10) << timing.p99Ms
+                  << std::setw(10) << (timing.medianMs > 0.0 ? 1000.0 / timing.medianMs : 0.0)
+                  << std::setw(15) << jogs.getMessageCount() << std::endl;
+    }
+}
+
+} // namespace bench
+} // namespace gamma
@@ -0,0 +1,198 @@
+#include "Benchmark.h"
+#include "effects/Kernels.h"
+#include "core/Math.h"
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
+namespace gamma {
+namespace bench {
+
+namespace {
+    std::vector<Record> g_records;
+
+    // Names are fixed ASCII labels; only quotes and backslashes need escaping
+    std::string quote(const std::string& text) {
+        std::string quoted = "\"";
+        for (char c : text) {
+            if (c == '"' || c == '\\') {
+                quoted += '\\';
+            }
+            quoted += c;
+        }
+        return quoted + "\"";
+    }
+
+    // Position just past `"key": ` in a result line, or npos
+    size_t findValue(const std::string& line, const char* key) {
+        const std::string pattern = std::string("\"") + key + "\": ";
+        size_t position = line.find(pattern);
+        return position == std::string::npos ? position : position + pattern.size();
+    }
+
+    std::string readString(const std::string& line, const char* key) {
+        size_t position = findValue(line, key);
+        std::string text;
+        if (position == std::string::npos || line[position] != '"') {
+            return text;
+        }
+        for (size_t i = position + 1; i < line.size() && line[i] != '"'; ++i) {
+            if (line[i] == '\\' && i + 1 < line.size()) {
+                ++i;
+            }
+            text += line[i];
+        }
+        return text;
+    }
+
+    double readNumber(const std::string& line, const char* key) {
+        size_t position = findValue(line, key);
+        return position == std::string::npos ? 0.0 : std::strtod(line.c_str() + position, nullptr);
+    }
+
+    // Reads reports written by writeReport(): one result object per line
+    bool readReport(const std::string& path, std::vector<Record>& records) {
+        std::ifstream file(path);
+        if (!file) {
+            std::cerr << "Cannot read benchmark report: " << path << std::endl;
+            return false;
+        }
+
+        std::string line;
+        while (std::getline(file, line)) {
+            if (findValue(line, "suite") == std::string::npos) {
+                continue;
+            }
+            Record record;
+            record.suite = readString(line, "suite");
+            record.name = readString(line, "name");
+            record.width = static_cast<int>(readNumber(line, "width"));
+            record.height = static_cast<int>(readNumber(line, "height"));
+            record.threads = static_cast<int>(readNumber(line, "threads"));
+            record.timing.minMs = readNumber(line, "msMin");
+            record.timing.medianMs = readNumber(line, "msP50");
+            record.timing.p99Ms = readNumber(line, "msP99");
+            record.timing.maxMs = readNumber(line, "msMax");
+            record.nsPerPixel = readNumber(line, "nsPerPixel");
+            record.gigabytesPerSecond = readNumber(line, "gbPerSecond");
+            records.push_back(record);
+        }
+        return true;
+    }
+
+    bool isSameCase(const Record& a, const Record& b) {
+        return a.suite == b.suite && a.name == b.name && a.width == b.width &&
+               a.height == b.height && a.threads == b.threads;
+    }
+}
+
+void addRecord(const Record& record) {
+    g_records.push_back(record);
+}
+
+bool writeReport(const std::string& path) {
+    std::ofstream file(path);
+    if (!file) {
+        std::cerr << "Cannot write benchmark report: " << path << std::endl;
+        return false;
+    }
+
+    file << std::fixed << std::setprecision(4);
+    file << "{\n";
+    file << "  \"kernels\": " << quote(effects::getSimdLevelName(effects::getKernels().level)) << ",\n";
+    file << "  \"hardwareThreads\": " << std::thread::hardware_concurrency() << ",\n";
+    file << "  \"results\": [";
+
+    for (size_t i = 0; i < g_records.size(); ++i) {
+        const Record& record = g_records[i];
+        const double fpsMedian = record.timing.medianMs > 0.0 ? 1000.0 / record.timing.medianMs : 0.0;
+        const double fpsP99 = record.timing.p99Ms > 0.0 ? 1000.0 / record.timing.p99Ms : 0.0;
+
+        file << (i == 0 ? "\n" : ",\n");
+        file << "    {\"suite\": " << quote(record.suite)
+             << ", \"name\": " << quote(record.name)
+             << ", \"width\": " << record.width
+             << ", \"height\": " << record.height
+             << ", \"threads\": " << record.threads
+             << ", \"msMin\": " << record.timing.minMs
+             << ", \"msP50\": " << record.timing.medianMs
+             << ", \"msP99\": " << record.timing.p99Ms
+             << ", \"msMax\": " << record.timing.maxMs
+             << ", \"fpsP50\": " << fpsMedian
+             << ", \"fpsP99\": " << fpsP99
+             << ", \"nsPerPixel\": " << record.nsPerPixel
+             << ", \"gbPerSecond\": " << record.gigabytesPerSecond << "}";
+    }
+
+    file << "\n  ]\n}\n";
+    std::cout << "Wrote " << g_records.size() << " results to " << path << std::endl;
+    return static_cast<bool>(file);
+}
+
+bool compareReports(const std::string& baselinePath, const std::string& candidatePath) {
+    std::vector<Record> baseline;
+    std::vector<Record> candidate;
+    if (!readReport(baselinePath, baseline) || !readReport(candidatePath, candidate)) {
+        return false;
+    }
+
+    std::cout << "Baseline:  " << baselinePath << std::endl;
+    std::cout << "Candidate: " << candidatePath << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << std::left << std::setw(10) << "Suite" << std::setw(24) << "Case" << std::setw(11) << "Size"
+              << std::right << std::setw(8) << "threads" << std::setw(12) << "base p50" << std::setw(12) << "new p50"
+              << std::setw(10) << "speedup" << std::endl;
+
+    // Geometric mean per suite, in order of first appearance
+    std::vector<std::string> suites;
+    std::vector<double> logSums;
+    std::vector<int> counts;
+
+    for (const Record& before : baseline) {
+        const Record* after = nullptr;
+        for (const Record& record : candidate) {
+            if (isSameCase(before, record)) {
+                after = &record;
+                break;
+            }
+        }
+        if (!after || before.timing.medianMs <= 0.0 || after->timing.medianMs <= 0.0) {
+            continue;
+        }
+
+        const double speedup = before.timing.medianMs / after->timing.medianMs;
+        const std::string size = std::to_string(before.width) + "x" + std::to_string(before.height);
+        std::cout << std::left << std::setw(10) << before.suite << std::setw(24) << before.name << std::setw(11) << size
+                  << std::right << std::setw(8) << before.threads << std::setw(12) << before.timing.medianMs
+                  << std::setw(12) << after->timing.medianMs << std::setw(9) << speedup << "x" << std::endl;
+
+        size_t suite = 0;
+        while (suite < suites.size() && suites[suite] != before.suite) {
+            ++suite;
+        }
+        if (suite == suites.size()) {
+            suites.push_back(before.suite);
+            logSums.push_back(0.0);
+            counts.push_back(0);
+        }
+        logSums[suite] += core::log(speedup);
+        ++counts[suite];
+    }
+
+    if (suites.empty()) {
+        std::cerr << "The reports have no case in common" << std::endl;
+        return false;
+    }
+
+    std::cout << "Geometric mean speedup:" << std::endl;
+    for (size_t suite = 0; suite < suites.size(); ++suite) {
+        std::cout << "  " << std::left << std::setw(10) << suites[suite] << std::right
+                  << core::exp(logSums[suite] / counts[suite]) << "x over " << counts[suite] << " cases" << std::endl;
+    }
+    return true;
+}
+
+} // namespace bench
+} // namespace gamma
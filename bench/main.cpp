@@ -0,0 +1,79 @@
+#include "Benchmark.h"
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+    struct Suite {
+        const char* name;
+        void (*run)();
+    };
+
+    const Suite SUITES[] = {
+        {"jobs", &gamma::bench::runJobSystemBenchmarks},
+        {"fusion", &gamma::bench::runEffectFusionBenchmarks},
+        {"scaling", &gamma::bench::runEffectScalingBenchmarks},
+        {"specialization", &gamma::bench::runEffectSpecializationBenchmarks},
+        {"memoization", &gamma::bench::runEffectMemoizationBenchmarks},
+        {"mix", &gamma::bench::runEffectMixBenchmarks},
+        {"preview", &gamma::bench::runEffectPreviewBenchmarks},
+        {"format", &gamma::bench::runEffectFormatBenchmarks},
+        {"pool", &gamma::bench::runFramePoolBenchmarks},
+        {"lut", &gamma::bench::runEffectLutBenchmarks},
+        {"remap", &gamma::bench::runEffectRemapBenchmarks},
+        {"effects", &gamma::bench::runEffectSuiteBenchmarks},
+        {"workload", &gamma::bench::runReplayWorkloadBenchmarks},
+    };
+}
+
+// Usage: gamma_bench [suite...] [--json report.json] [--replay midi_log.csv]
+//        gamma_bench --compare baseline.json candidate.json
+int main(int argc, char* argv[]) {
+    std::cout << "=== Gamma Array Benchmarks ===" << std::endl;
+
+    std::vector<std::string> selectedSuites;
+    std::string reportPath;
+    for (int i = 1; i < argc; ++i) {
+        std::string argument = argv[i];
+        if (argument == "--json" && i + 1 < argc) {
+            reportPath = argv[++i];
+        } else if (argument == "--replay" && i + 1 < argc) {
+            gamma::bench::setWorkloadReplayFile(argv[++i]);
+        } else if (argument == "--compare" && i + 2 < argc) {
+            return gamma::bench::compareReports(argv[i + 1], argv[i + 2]) ? 0 : 1;
+        } else {
+            selectedSuites.push_back(argument);
+        }
+    }
+
+    bool ranAny = false;
+    for (const auto& suite : SUITES) {
+        bool selected = selectedSuites.empty();
+        for (const auto& name : selectedSuites) {
+            if (name == suite.name) {
+                selected = true;
+            }
+        }
+
+        if (selected) {
+            std::cout << std::endl << "--- " << suite.name << " ---" << std::endl;
+            suite.run();
+            ranAny = true;
+        }
+    }
+
+    if (!ranAny) {
+        std::cerr << "No matching suite. Available:";
+        for (const auto& suite : SUITES) {
+            std::cerr << " " << suite.name;
+        }
+        std::cerr << std::endl;
+        return 1;
+    }
+
+    if (!reportPath.empty() && !gamma::bench::writeReport(reportPath)) {
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstdint>
+
+namespace gamma {
+namespace core {
+
+/**
+ * @brief Counts heap allocations made through global operator new
+ *
+ * The application replaces the global operator new (see
+ * AllocationCounter.cpp) and counts every call, so frame loops can report
+ * how many heap allocations each frame performed.
+ */
+class AllocationCounter {
+public:
+    /**
+     * @brief Allocations made by the calling thread since it started
+     */
+    static uint64_t getThreadAllocations();
+
+    /**
+     * @brief Allocations made by all threads since process start
+     */
+    static uint64_t getTotalAllocations();
+};
+
+} // namespace core
+} // namespace gamma
@@ -1,6 +1,16 @@
 #pragma once
 
+#include "core/JobSystem.h"
+#include "core/StartupProfiler.h"
+#include "effects/ChainThumbnails.h"
+#include "effects/EffectChain.h"
+#include "effects/EffectEngine.h"
+#include "effects/ParameterBlock.h"
+#include <cstdint>
+#include <functional>
 #include <memory>
+#include <string>
+#include <vector>
 
 // Forward declarations
 struct GLFWwindow;
@@ -11,10 +21,26 @@ class WorkspaceManager;
 }
 namespace midi {
 class MidiManager;
+class MidiReplay;
 }
 
 namespace core {
 
+/**
+ * @brief Settings for running the application without a window
+ * 
+ * Headless mode skips window, OpenGL and ImGui setup and drives update()
+ * directly so the non-GUI pipeline can be profiled on render-less machines.
+ * The effect engine runs the test pattern through the given chain, as the
+ * Effects panel's chain does in a windowed run.
+ */
+struct HeadlessOptions {
+    float updateRate = 0.0f;   // Target update rate in Hz (0 = as fast as possible)
+    float duration = 10.0f;    // Run duration in seconds (0 = until replay finishes)
+    std::string replayFile;    // Optional MIDI CSV log to replay during the run
+    std::vector<gamma::effects::EffectType> effects;   // Chain run on the test pattern (empty = Color Correction)
+};
+
 /**
  * @brief Main application class managing the lifecycle of Gamma Array
  * 
@@ -33,6 +59,13 @@ public:
      */
     bool initialize(bool fullscreen = true);
 
+    /**
+     * @brief Initialize only the non-GUI subsystems for a headless run
+     * @param options Update rate, run duration and replay input
+     * @return true if initialization succeeds, false otherwise
+     */
+    bool initializeHeadless(const HeadlessOptions& options);
+
     /**
      * @brief Main application loop
      * 
@@ -52,33 +85,141 @@ public:
      */
     bool shouldRun() const;
 
+    /**
+     * @brief Check if the application runs without window and UI
+     */
+    bool isHeadless() const { return _headless; }
+
+    /**
+     * @brief Choose the pixel format effects pass between each other
+     *
+     * Call before initialize(); see EffectEngine::setIntermediateFormat.
+     */
+    void setEffectPixelFormat(gamma::effects::PixelFormat format) { _effectFormat = format; }
+
     /**
      * @brief Get MIDI manager instance
      * @return pointer to MIDI manager or nullptr if not initialized
      */
     gamma::midi::MidiManager* getMidiManager() const { return _midiManager.get(); }
 
+    /**
+     * @brief Get the shared task scheduler used by all engine subsystems
+     * @return pointer to the job system or nullptr if not initialized
+     */
+    JobSystem* getJobSystem() const { return _jobSystem.get(); }
+
+    /**
+     * @brief Get the CPU effect engine
+     * @return pointer to the effect engine or nullptr if not initialized
+     */
+    const gamma::effects::EffectEngine* getEffectEngine() const { return _effectEngine.get(); }
+
+    /**
+     * @brief Last frame produced by the effect chain
+     */
+    const gamma::effects::Frame& getEffectOutput() const { return *_effectResult; }
+
+    /**
+     * @brief Reduced copy of the last effect output, for the on-screen monitor
+     *
+     * Only valid with an effect engine (see getEffectEngine). Its cost is
+     * EffectEngine::getPreviewTimeMs().
+     */
+    const gamma::effects::Frame& getEffectPreview() const { return _effectEngine->getPreview(); }
+
+    /**
+     * @brief Small renders of the chain after each of its slots
+     */
+    const gamma::effects::ChainThumbnails& getEffectThumbnails() const { return _effectThumbnails; }
+
+    /**
+     * @brief Heap allocations made by the main thread during the last frame
+     */
+    uint64_t getLastFrameAllocations() const { return _lastFrameAllocations; }
+
+    /**
+     * @brief Queue work to run on the main thread once the first frame is presented
+     * @param name Phase name shown in the startup report (string literal)
+     * @param task Work that is not needed to draw the first frame
+     */
+    void deferUntilFirstFrame(const char* name, std::function<void()> task);
+
 private:
     bool _initialized;
     bool _shouldRun;
     bool _fullscreen;
+    bool _headless;
     GLFWwindow* _window;
     
+    // Headless run configuration
+    HeadlessOptions _headlessOptions;
+    std::unique_ptr<gamma::midi::MidiReplay> _midiReplay;
+    
     // UI Manager
     std::unique_ptr<gamma::ui::WorkspaceManager> _workspaceManager;
     
     // MIDI Manager
     std::unique_ptr<gamma::midi::MidiManager> _midiManager;
 
+    // Effect processing: test-pattern source through the EffectsPanel chain
+    // (or, headless, through _headlessChain)
+    std::unique_ptr<gamma::effects::EffectEngine> _effectEngine;
+    gamma::effects::Frame _effectSource;
+    gamma::effects::Frame _effectOutput;
+    const gamma::effects::Frame* _effectResult;        // _effectOutput, or _effectSource passed through
+    gamma::effects::PixelFormat _effectFormat;         // Intermediate format, applied when the engine is created
+    gamma::effects::ChainThumbnails _effectThumbnails;
+    gamma::effects::ParameterBlock _effectParameters;  // EffectsPanel -> engine, published once per frame
+    gamma::effects::EffectChain _headlessChain;        // Stands in for the EffectsPanel's chain when headless
+    double _effectTime;
+    double _lastEffectMs;                               // Engine and thumbnail wall times of the last frame
+    double _lastThumbnailMs;
+
+    // Shared parallel executor (created first, destroyed last)
+    std::unique_ptr<JobSystem> _jobSystem;
+
+    // Startup: concurrent init tasks, work deferred past the first frame, timings
+    struct DeferredTask {
+        const char* name;
+        std::function<void()> task;
+    };
+    StartupProfiler _startupProfiler;
+    JobSystem::TaskHandle _midiInitTask;
+    JobSystem::TaskHandle _panelTask;
+    bool _midiInitSucceeded;
+    std::vector<DeferredTask> _deferredTasks;
+    bool _firstFramePresented;
+
+    // Heap allocations of the last complete frame (main thread)
+    uint64_t _lastFrameAllocations;
+
     // Core subsystem initialization methods
     bool initializeWindow();
     bool initializeOpenGL();
     bool initializeImGui();
     bool initializeSubsystems();
+    void initializeEffects();
+    void waitForStartupTasks();
+    void onFirstFramePresented();
+
+    // Measurements of a headless run, per frame in milliseconds
+    struct HeadlessStats {
+        std::vector<double> frameTimes;     // Replay injection + update
+        std::vector<double> effectTimes;    // Effect engine: program output and preview tap
+        std::vector<double> thumbnailTimes; // Chain thumbnails
+        size_t replayedMessages = 0;
+        uint64_t totalAllocations = 0;
+        uint64_t maxFrameAllocations = 0;
+    };
 
     // Main loop methods
+    void runHeadless();
+    void printHeadlessSummary(HeadlessStats& stats, double wallTime) const;
     void processEvents();
     void update(float deltaTime);
+    void processEffects(float deltaTime);
+    void publishEffectChain();
     void render();
     void renderNavigationBar();
     void toggleFullscreen();
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace gamma {
+namespace core {
+
+/**
+ * @brief Bump-pointer allocator for data that only lives for one frame
+ *
+ * Panels use it for throwaway labels and scratch arrays instead of building
+ * heap strings every frame. Everything allocated is released at once by
+ * reset(). If a frame overflows the first block, extra blocks are chained and
+ * merged into a single larger block on the next reset, so steady-state
+ * frames never touch the heap. Not thread-safe: owned by the UI thread.
+ */
+class FrameArena {
+public:
+    /**
+     * @param blockSize Initial capacity in bytes
+     */
+    explicit FrameArena(size_t blockSize = 64 * 1024);
+    ~FrameArena();
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    /**
+     * @brief Release everything allocated this frame
+     */
+    void reset();
+
+    /**
+     * @brief Allocate raw memory valid until the next reset()
+     * @param size Bytes to allocate
+     * @param alignment Power-of-two alignment
+     */
+    void* allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+    /**
+     * @brief Allocate an uninitialized array of trivially destructible objects
+     */
+    template<typename T>
+    T* allocateArray(size_t count) {
+        static_assert(std::is_trivially_destructible<T>::value,
+                      "FrameArena never runs destructors");
+        return static_cast<T*>(allocate(sizeof(T) * count, alignof(T)));
+    }
+
+    /**
+     * @brief printf-style formatting into the arena
+     * @return null-terminated string valid until the next reset()
+     */
+    const char* format(const char* fmt, ...)
+#if defined(__GNUC__) || defined(__clang__)
+        __attribute__((format(printf, 2, 3)))
+#endif
+        ;
+
+    /**
+     * @brief Copy a string into the arena
+     * @return null-terminated copy valid until the next reset()
+     */
+    const char* copy(const char* text, size_t length);
+
+    /**
+     * @brief Bytes handed out since the last reset
+     */
+    size_t getBytesUsed() const { return _bytesUsed; }
+
+    /**
+     * @brief Largest getBytesUsed() seen at any reset
+     */
+    size_t getPeakBytesUsed() const { return _peakBytesUsed; }
+
+    /**
+     * @brief Total bytes reserved from the heap
+     */
+    size_t getCapacity() const;
+
+private:
+    struct Block {
+        char* data;
+        size_t size;
+    };
+
+    void addBlock(size_t minimumSize);
+    void releaseBlocks();
+
+    std::vector<Block> _blocks;
+    size_t _currentBlock;
+    size_t _offset;
+    size_t _blockSize;
+    size_t _bytesUsed;
+    size_t _peakBytesUsed;
+};
+
+/**
+ * @brief Arena for the frame being built on the UI thread
+ *
+ * Reset by Application at the start of every frame.
+ */
+FrameArena& getFrameArena();
+
+} // namespace core
+} // namespace gamma
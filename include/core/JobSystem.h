@@ -0,0 +1,202 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace gamma {
+namespace core {
+
+/**
+ * @brief Scheduling class of a task
+ *
+ * Frame-critical work (effects for the frame being built) is always picked
+ * before background work (decoding ahead, waveform analysis, thumbnails).
+ */
+enum class TaskPriority {
+    FrameCritical = 0,
+    Background = 1
+};
+
+/**
+ * @brief Work-stealing task scheduler shared by all engine subsystems
+ *
+ * Each worker owns one deque per priority. Workers push and pop their own
+ * work LIFO (cache-warm) and steal FIFO from other workers when idle. Tasks
+ * submitted from non-worker threads go to a shared injection queue.
+ * Tasks can depend on other tasks; a task is queued once all of its
+ * dependencies have completed. Threads waiting on a task help execute
+ * frame-critical work instead of blocking.
+ */
+class JobSystem {
+public:
+    using TaskFunction = std::function<void()>;
+    using RangeFunction = std::function<void(size_t begin, size_t end)>;
+
+    class Task;
+    using TaskHandle = std::shared_ptr<Task>;
+
+    /**
+     * @brief Per-worker counters for utilization monitoring
+     */
+    struct WorkerStats {
+        uint64_t tasksExecuted;
+        uint64_t tasksStolen;
+        double busySeconds;
+        double utilization;    // Busy time / wall time since last reset (0-1)
+    };
+
+    /**
+     * @brief Start the worker threads
+     * @param workerCount Number of workers (0 = hardware threads - 1, at least 1)
+     */
+    explicit JobSystem(unsigned workerCount = 0);
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    /**
+     * @brief Queue a task for execution
+     * @param function Work to run
+     * @param priority Scheduling class
+     * @return handle to wait on or to chain continuations from
+     */
+    TaskHandle submit(TaskFunction function, TaskPriority priority = TaskPriority::FrameCritical);
+
+    /**
+     * @brief Queue a task that runs once all dependencies have completed
+     * @param dependencies Tasks that must finish first (null handles are ignored)
+     * @param function Work to run
+     * @param priority Scheduling class
+     */
+    TaskHandle submitAfter(const std::vector<TaskHandle>& dependencies, TaskFunction function,
+                           TaskPriority priority = TaskPriority::FrameCritical);
+
+    /**
+     * @brief Queue a continuation of a single task
+     */
+    TaskHandle then(const TaskHandle& dependency, TaskFunction function,
+                    TaskPriority priority = TaskPriority::FrameCritical) {
+        return submitAfter({dependency}, std::move(function), priority);
+    }
+
+    /**
+     * @brief Block until a task has completed, executing other work meanwhile
+     */
+    void wait(const TaskHandle& task);
+
+    /**
+     * @brief Block until all given tasks have completed
+     */
+    void waitAll(const std::vector<TaskHandle>& tasks);
+
+    /**
+     * @brief Check if a task has completed (null handles count as completed)
+     */
+    static bool isDone(const TaskHandle& task);
+
+    /**
+     * @brief Run body over [begin, end) split into chunks across all workers
+     * @param begin First index
+     * @param end One past the last index
+     * @param grainSize Indices per chunk (0 = pick automatically)
+     * @param body Called with [chunkBegin, chunkEnd) for each chunk
+     * @param priority Scheduling class of the helper tasks
+     *
+     * The calling thread participates and the call returns once every chunk is done.
+     */
+    void parallelFor(size_t begin, size_t end, size_t grainSize, const RangeFunction& body,
+                     TaskPriority priority = TaskPriority::FrameCritical);
+
+    /**
+     * @brief Number of worker threads (excluding threads that only help while waiting)
+     */
+    unsigned getWorkerCount() const { return static_cast<unsigned>(_workers.size()); }
+
+    /**
+     * @brief Index of the calling worker (0..getWorkerCount()-1), or -1 on any other thread
+     *
+     * Lets tasks pick per-thread scratch memory without locking.
+     */
+    int getCurrentWorkerIndex() const;
+
+    /**
+     * @brief Snapshot of per-worker utilization since the last reset
+     */
+    std::vector<WorkerStats> getWorkerStats() const;
+
+    /**
+     * @brief Reset utilization counters and the measurement window
+     */
+    void resetStats();
+
+private:
+    static constexpr int PRIORITY_COUNT = 2;
+
+    // Mutex-guarded deque; owner works at the back, thieves take from the front
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<TaskHandle> tasks;
+
+        void pushBack(TaskHandle task);
+        TaskHandle popBack();
+        TaskHandle popFront();
+    };
+
+    struct Worker {
+        std::thread thread;
+        WorkQueue queues[PRIORITY_COUNT];
+        std::atomic<uint64_t> tasksExecuted{0};
+        std::atomic<uint64_t> tasksStolen{0};
+        std::atomic<uint64_t> busyNanoseconds{0};
+    };
+
+    void workerLoop(unsigned workerIndex);
+    void schedule(const TaskHandle& task);
+    TaskHandle findTask(int workerIndex, int maxPriority);
+    void execute(const TaskHandle& task, int workerIndex);
+    void complete(const TaskHandle& task);
+    void releaseDependency(const TaskHandle& task);
+
+    std::vector<std::unique_ptr<Worker>> _workers;
+    WorkQueue _injectionQueues[PRIORITY_COUNT];
+
+    std::atomic<bool> _running;
+    std::atomic<int64_t> _queuedTasks;
+    std::atomic<int> _sleepingWorkers;
+    std::mutex _sleepMutex;
+    std::condition_variable _sleepCondition;
+
+    std::atomic<int64_t> _statsStartNanoseconds;
+};
+
+/**
+ * @brief Internal task state, shared between the scheduler and handles
+ */
+class JobSystem::Task {
+public:
+    explicit Task(TaskFunction taskFunction, TaskPriority taskPriority)
+        : function(std::move(taskFunction)), priority(taskPriority), pendingDependencies(1), done(false) {}
+
+private:
+    friend class JobSystem;
+
+    TaskFunction function;
+    TaskPriority priority;
+    std::atomic<int> pendingDependencies;   // Starts at 1 as a guard while dependencies are wired up
+    std::atomic<bool> done;
+    std::mutex continuationMutex;
+    std::vector<TaskHandle> continuations;
+};
+
+} // namespace core
+} // namespace gamma
@@ -0,0 +1,63 @@
+#pragma once
+
+/**
+ * @file Math.h
+ * @brief The <cmath> functions the project uses, without <cmath>
+ *
+ * glibc's <math.h> declares a legacy global function named gamma(), which
+ * collides with the project namespace, so translation units inside namespace
+ * gamma must not include <cmath> (or <math.h>) on Linux. These forward to the
+ * compiler's builtins instead, which compile to the same instructions or libm
+ * calls. Call them as core::sin() and so on; float arguments stay float.
+ */
+
+#if defined(_MSC_VER)
+#include <cmath>
+#endif
+
+namespace gamma {
+namespace core {
+
+#if defined(_MSC_VER)
+#define GAMMA_MATH_UNARY(name) \
+    inline float name(float x) { return std::name(x); } \
+    inline double name(double x) { return std::name(x); }
+#define GAMMA_MATH_BINARY(name) \
+    inline float name(float x, float y) { return std::name(x, y); } \
+    inline double name(double x, double y) { return std::name(x, y); }
+#else
+#define GAMMA_MATH_UNARY(name) \
+    inline float name(float x) { return __builtin_##name##f(x); } \
+    inline double name(double x) { return __builtin_##name(x); }
+#define GAMMA_MATH_BINARY(name) \
+    inline float name(float x, float y) { return __builtin_##name##f(x, y); } \
+    inline double name(double x, double y) { return __builtin_##name(x, y); }
+#endif
+
+GAMMA_MATH_UNARY(sin)
+GAMMA_MATH_UNARY(cos)
+GAMMA_MATH_UNARY(sqrt)
+GAMMA_MATH_UNARY(exp)
+GAMMA_MATH_UNARY(log)
+GAMMA_MATH_UNARY(log10)
+GAMMA_MATH_UNARY(floor)
+GAMMA_MATH_UNARY(fabs)
+GAMMA_MATH_BINARY(atan2)
+GAMMA_MATH_BINARY(fmod)
+GAMMA_MATH_BINARY(pow)
+
+#undef GAMMA_MATH_UNARY
+#undef GAMMA_MATH_BINARY
+
+#if defined(_MSC_VER)
+inline long lround(float x) { return std::lround(x); }
+inline long lround(double x) { return std::lround(x); }
+#else
+inline long lround(float x) { return __builtin_lroundf(x); }
+inline long lround(double x) { return __builtin_lround(x); }
+#endif
+
+constexpr double PI = 3.14159265358979323846;
+
+} // namespace core
+} // namespace gamma
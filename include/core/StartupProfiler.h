@@ -0,0 +1,92 @@
+#pragma once
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace gamma {
+namespace core {
+
+/**
+ * @brief Records per-phase startup timings and time-to-first-frame
+ *
+ * Phases may be recorded from any thread (subsystems initialize concurrently).
+ * The report is printed once the first frame has been presented.
+ */
+class StartupProfiler {
+public:
+    StartupProfiler();
+
+    /**
+     * @brief Reset the time origin (call as early as possible on launch)
+     */
+    void start();
+
+    /**
+     * @brief Begin timing a phase
+     * @param name Phase name (string literal)
+     * @return phase id to pass to endPhase()
+     */
+    size_t beginPhase(const char* name);
+
+    /**
+     * @brief Finish timing a phase
+     * @param phaseId Id returned by beginPhase()
+     */
+    void endPhase(size_t phaseId);
+
+    /**
+     * @brief Record the moment the first frame was presented
+     */
+    void markFirstFrame();
+
+    /**
+     * @brief Check if the first frame has been presented
+     */
+    bool hasFirstFrame() const { return _firstFrameMs >= 0.0; }
+
+    /**
+     * @brief Print the per-phase report to stdout
+     */
+    void printReport() const;
+
+    /**
+     * @brief RAII helper timing a scope as one phase
+     */
+    class ScopedPhase {
+    public:
+        ScopedPhase(StartupProfiler& profiler, const char* name)
+            : _profiler(profiler), _phaseId(profiler.beginPhase(name)) {}
+        ~ScopedPhase() { _profiler.endPhase(_phaseId); }
+
+        ScopedPhase(const ScopedPhase&) = delete;
+        ScopedPhase& operator=(const ScopedPhase&) = delete;
+
+    private:
+        StartupProfiler& _profiler;
+        size_t _phaseId;
+    };
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Phase {
+        const char* name;
+        bool onMainThread;
+        double startMs;
+        double endMs;
+    };
+
+    double elapsedMs() const;
+
+    Clock::time_point _origin;
+    std::thread::id _mainThread;
+    std::vector<Phase> _phases;
+    mutable std::mutex _mutex;
+    double _firstFrameMs;
+};
+
+} // namespace core
+} // namespace gamma
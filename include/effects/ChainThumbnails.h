@@ -0,0 +1,120 @@
+#pragma once
+
+#include "effects/EffectEngine.h"
+#include "effects/Frame.h"
+#include <memory>
+#include <vector>
+
+namespace gamma {
+namespace effects {
+
+/**
+ * @brief Low-resolution renders of a chain after each of its effects
+ *
+ * Gives the state of the picture at every slot, for thumbnails next to the
+ * chain. The input is box-filtered down once (see downscaleFrame), then each
+ * slot runs in an engine of its own on the previous slot's thumbnail, so the
+ * whole chain costs one pass per effect at thumbnail size and temporal
+ * effects keep separate histories. Bypassed slots pass the previous
+ * thumbnail on without a copy, and unchanged results are reused through
+ * each engine's cache (a still input renders nothing). Engines follow their
+ * slot by ChainSlot::id, so removing an effect keeps the histories and
+ * cached results of the ones after it.
+ *
+ * Thumbnails approximate the program output: parameters measured in pixels
+ * (ParameterDescriptor::pixels, such as aberration offsets) are divided by
+ * the factor to keep their size relative to the frame, within their range.
+ * Slot engines take the program engine's job system and intermediate format
+ * (see setJobSystem, setIntermediateFormat); the thumbnail handed from one
+ * slot to the next is RGBA8 like any engine output, so a chain that only
+ * bands in RGBA8 still bands a little in its thumbnails.
+ */
+class ChainThumbnails {
+public:
+    static constexpr int DEFAULT_FACTOR = 8;
+
+    /**
+     * @param jobSystem Workers for the downscale and every slot's engine (nullptr = calling thread only)
+     */
+    explicit ChainThumbnails(core::JobSystem* jobSystem = nullptr);
+    ~ChainThumbnails();
+
+    ChainThumbnails(const ChainThumbnails&) = delete;
+    ChainThumbnails& operator=(const ChainThumbnails&) = delete;
+
+    /**
+     * @brief Change the workers used from the next render on
+     */
+    void setJobSystem(core::JobSystem* jobSystem);
+
+    /**
+     * @brief Format slot engines pass between their passes (see EffectEngine::setIntermediateFormat)
+     */
+    void setIntermediateFormat(PixelFormat format);
+    PixelFormat getIntermediateFormat() const { return _format; }
+
+    /**
+     * @brief Reduction of the input per axis, 2..MAX_DOWNSCALE_FACTOR
+     */
+    void setFactor(int factor);
+    int getFactor() const { return _factor; }
+
+    /**
+     * @brief Render one thumbnail per chain slot
+     * @param input Full-resolution source frame
+     * @param chain Effects in order, as for EffectEngine::process()
+     * @param time Seconds on the caller's clock, used by temporal effects
+     */
+    void render(const Frame& input, const std::vector<ChainSlot>& chain, double time);
+
+    /**
+     * @brief Thumbnails from the last render(), one per slot
+     */
+    size_t getCount() const { return _results.size(); }
+
+    /**
+     * @brief The chain's result after a slot (valid until the next render())
+     */
+    const Frame& getThumbnail(size_t slot) const { return *_results[slot]; }
+
+    /**
+     * @brief Downscaled input the first slot reads
+     */
+    const Frame& getInput() const { return _input; }
+
+    /**
+     * @brief Smoothed wall time of a whole render() in milliseconds
+     */
+    double getRenderTimeMs() const { return _renderTimeMs; }
+
+    /**
+     * @brief Drop every slot's engine and its state
+     */
+    void reset();
+
+private:
+    struct Stage {
+        uint32_t id = 0;                // ChainSlot::id of the slot this engine renders
+        std::unique_ptr<EffectEngine> engine;
+        std::vector<ChainSlot> chain;   // Just this slot
+        Frame output;
+    };
+
+    /**
+     * @brief Divide parameters measured in pixels by the factor
+     */
+    void scalePixelParameters(ChainSlot& slot) const;
+
+    core::JobSystem* _jobSystem;
+    PixelFormat _format;                // Given to every slot's engine
+    int _factor;
+    Frame _input;
+    uint64_t _inputSourceId;            // Content id of the frame _input was reduced from
+    std::vector<Stage> _stages;         // In chain order
+    std::vector<Stage> _previousStages; // Last render's stages, while matching them to slots
+    std::vector<const Frame*> _results;
+    double _renderTimeMs;
+};
+
+} // namespace effects
+} // namespace gamma
@@ -0,0 +1,143 @@
+#pragma once
+
+#include "effects/Kernels.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace gamma {
+namespace effects {
+
+/**
+ * @brief 3D color lookup table: a look, loaded from a .cube file or baked
+ *
+ * Entries are four floats (RGB plus padding) in float pixel units, red
+ * varying fastest as in the .cube format, so one 16-byte load fetches a
+ * corner and the cells of neighbouring colors sit next to each other. The
+ * kernels interpolate tetrahedrally (KernelTable::applyLut), which needs four
+ * corners per pixel instead of trilinear's eight and keeps gray axes neutral.
+ */
+class ColorLut {
+public:
+    static constexpr int MIN_SIZE = 2;
+    static constexpr int MAX_SIZE = 65;     // Largest grid looks are delivered in
+
+    /**
+     * @brief Identity grid of the given size (clamped to MIN_SIZE..MAX_SIZE)
+     */
+    explicit ColorLut(int size = 33);
+
+    /**
+     * @brief Load an Adobe/Resolve .cube file (3D tables only)
+     * @return false if the file cannot be read or is malformed; the table is unchanged
+     */
+    bool loadCube(const std::string& path);
+
+    /**
+     * @brief Parse .cube text; name is only used in error messages
+     */
+    bool parseCube(const std::string& text, const std::string& name);
+
+    /**
+     * @brief Reset to the identity over a grid of size (clamped to MIN_SIZE..MAX_SIZE)
+     */
+    void resize(int size);
+
+    int getSize() const { return _size; }
+    const std::string& getTitle() const { return _title; }
+
+    /**
+     * @brief Entry at lattice point (r, g, b): three floats, 1.0 = 255
+     */
+    float* entry(int r, int g, int b) { return &_entries[index(r, g, b)]; }
+    const float* entry(int r, int g, int b) const { return &_entries[index(r, g, b)]; }
+
+    /**
+     * @brief Input value a lattice coordinate stands for (along any axis)
+     */
+    float getLatticeValue(int channel, int i) const;
+
+    /**
+     * @brief View for KernelTable::applyLut
+     */
+    const LutGrid& getGrid() const { return _grid; }
+
+    /**
+     * @brief Distinct for every table loaded or resized (never 0); writes
+     * through entry() keep it, so bake into a fresh table
+     */
+    uint64_t getId() const { return _id; }
+
+private:
+    size_t index(int r, int g, int b) const {
+        return ((static_cast<size_t>(b) * _size + g) * _size + r) * 4;
+    }
+    void updateGrid(const float* domainMin, const float* domainMax);
+
+    std::vector<float> _entries;
+    int _size;
+    float _domainMin[3];
+    float _domainMax[3];
+    std::string _title;
+    LutGrid _grid;
+    uint64_t _id;
+};
+
+/**
+ * @brief Looks the Color LUT effect can select, by index
+ *
+ * Loaded from .cube files, usually a directory at startup. Effects hold the
+ * table they picked by shared pointer for the frame, so a look can be
+ * replaced while the engine runs. Thread-safe.
+ */
+class LutLibrary {
+public:
+    static constexpr int MAX_LOOKS = 32;    // The effect's Look parameter range
+
+    /**
+     * @brief Load every .cube file of a directory, in file name order
+     * @return Number of looks added
+     */
+    int loadDirectory(const std::string& directory);
+
+    /**
+     * @brief Load one .cube file; its name is the file name without extension
+     * @return Index of the look, -1 on error or when the library is full
+     */
+    int load(const std::string& path);
+
+    /**
+     * @brief Add a table (replaces the look of the same name)
+     * @return Index of the look, -1 when the library is full
+     */
+    int add(const std::string& name, std::shared_ptr<const ColorLut> lut);
+
+    /**
+     * @brief Look at index (nullptr if none)
+     */
+    std::shared_ptr<const ColorLut> get(int index) const;
+
+    std::string getName(int index) const;
+    int getCount() const;
+    void clear();
+
+private:
+    struct Look {
+        std::string name;
+        std::shared_ptr<const ColorLut> lut;
+    };
+
+    mutable std::mutex _mutex;
+    std::vector<Look> _looks;
+};
+
+/**
+ * @brief Library shared by every Color LUT effect
+ */
+LutLibrary& getLutLibrary();
+
+} // namespace effects
+} // namespace gamma
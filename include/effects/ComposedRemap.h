@@ -0,0 +1,41 @@
+#pragma once
+
+#include "effects/EffectProcessor.h"
+#include "effects/RemapGrid.h"
+#include "core/JobSystem.h"
+#include <memory>
+#include <vector>
+
+namespace gamma {
+namespace effects {
+
+/**
+ * @brief One coordinate grid for a run of remap effects applied in turn
+ *
+ * An output position goes back through each effect of the run, last first,
+ * to the run's input, so sampling the input once at the composed positions
+ * renders the whole run. Grids are cached by the maps' keys (see
+ * RemapEffect::getMapKey), so a run whose maps hold still is never rebuilt.
+ */
+class ComposedRemap {
+public:
+    /**
+     * @brief Grid of the run's maps, built if they changed
+     * @param maps The run's effects in chain order; those that pass through are left out
+     * @return The composed grid, or null if every map passes through
+     */
+    std::shared_ptr<const RemapGrid> compose(const std::vector<const RemapEffect*>& maps, int width, int height,
+                                             core::JobSystem* jobSystem = nullptr);
+
+    /**
+     * @brief Grids built since this run was created
+     */
+    uint64_t getBuildCount() const { return _grids.getBuildCount(); }
+
+private:
+    std::vector<const RemapEffect*> _active;    // Maps that move positions, last first
+    RemapGridCache _grids;
+};
+
+} // namespace effects
+} // namespace gamma
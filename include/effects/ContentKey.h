@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+namespace gamma {
+namespace effects {
+
+/**
+ * @brief Starting value of a key built with combineKey()
+ */
+constexpr uint64_t KEY_SEED = 0x6A09E667F3BCC909ull;
+
+/**
+ * @brief Order-dependent 64-bit mix (splitmix64 finalizer over the combined value)
+ */
+inline uint64_t combineKey(uint64_t key, uint64_t value) {
+    key ^= value + 0x9E3779B97F4A7C15ull + (key << 6) + (key >> 2);
+    key ^= key >> 30;
+    key *= 0xBF58476D1CE4E5B9ull;
+    key ^= key >> 27;
+    key *= 0x94D049BB133111EBull;
+    key ^= key >> 31;
+    return key;
+}
+
+/**
+ * @brief Bit pattern of a float, for keys that change with any change of value
+ */
+inline uint64_t floatBits(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+} // namespace effects
+} // namespace gamma
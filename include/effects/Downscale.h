@@ -0,0 +1,49 @@
+#pragma once
+
+#include "effects/Frame.h"
+
+namespace gamma {
+namespace core { class JobSystem; }
+}
+
+namespace gamma {
+namespace effects {
+
+/**
+ * @brief Largest reduction downscaleFrame() takes per axis
+ */
+constexpr int MAX_DOWNSCALE_FACTOR = 16;    // 16 * 255 still fits the 16-bit sums
+
+/**
+ * @brief Size of a frame reduced by an integer factor (rounded down)
+ */
+inline int getDownscaledSize(int size, int factor) {
+    return factor > 0 ? size / factor : 0;
+}
+
+/**
+ * @brief Box-filter rows of a frame down by an integer factor
+ *
+ * Each destination pixel is the average of a factor x factor block of the
+ * source: the block's rows are summed with the box filter kernel (see
+ * KernelTable::boxFilter), then each run of factor pixels of that row.
+ * Source pixels past the last whole block are ignored.
+ * @param source Frame to reduce
+ * @param destination Already sized by getDownscaledSize()
+ * @param factor 2..MAX_DOWNSCALE_FACTOR
+ * @param yBegin First destination row
+ * @param yEnd One past the last destination row
+ */
+void downscaleRows(const Frame& source, Frame& destination, int factor, int yBegin, int yEnd);
+
+/**
+ * @brief Box-filter a whole frame down by an integer factor
+ *
+ * Resizes destination and stamps it with a new content id. With a job
+ * system, rows are spread across its workers.
+ * @param factor 2..MAX_DOWNSCALE_FACTOR; anything else leaves destination empty
+ */
+void downscaleFrame(const Frame& source, Frame& destination, int factor, core::JobSystem* jobSystem = nullptr);
+
+} // namespace effects
+} // namespace gamma
@@ -0,0 +1,118 @@
+#pragma once
+
+#include "effects/EffectDescriptor.h"
+#include "effects/EffectEngine.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace gamma {
+namespace effects {
+
+/**
+ * @brief Live state of an effect chain, stored as parallel arrays
+ *
+ * A slot is just its EffectType, its flags and its values; names, ranges and
+ * defaults come from the shared EffectDescriptor. Parameter p of slot i sits
+ * at i * MAX_EFFECT_PARAMETERS + p in each value array, so the values of the
+ * whole chain are contiguous and reading one is a single indexed load.
+ * Capacity is fixed: adding and removing effects moves values within the
+ * arrays and never allocates.
+ */
+class EffectChain {
+public:
+    static constexpr size_t MAX_SLOTS = 32;
+
+    EffectChain();
+
+    size_t size() const { return _size; }
+    bool empty() const { return _size == 0; }
+    bool full() const { return _size == MAX_SLOTS; }
+
+    /**
+     * @brief Append an effect with default values
+     * @return false if the chain is full
+     */
+    bool add(EffectType type, bool active);
+
+    /**
+     * @brief Remove a slot; later slots move up one
+     */
+    void remove(size_t slot);
+
+    void clear() { _size = 0; }
+
+    EffectType getType(size_t slot) const { return _types[slot]; }
+
+    /**
+     * @brief Identity of a slot, unique within this chain and kept when other slots are removed
+     */
+    uint32_t getId(size_t slot) const { return _ids[slot]; }
+    const EffectDescriptor& getDescriptor(size_t slot) const { return getEffectDescriptor(_types[slot]); }
+
+    bool isActive(size_t slot) const { return (_flags[slot] & FLAG_ACTIVE) != 0; }
+    bool isBypassed(size_t slot) const { return (_flags[slot] & FLAG_BYPASSED) != 0; }
+    void setActive(size_t slot, bool active) { setFlag(slot, FLAG_ACTIVE, active); }
+    void setBypassed(size_t slot, bool bypassed) { setFlag(slot, FLAG_BYPASSED, bypassed); }
+
+    /**
+     * @brief Live value of a parameter (editable in place)
+     */
+    float& value(size_t slot, int parameter) { return _values[index(slot, parameter)]; }
+    float getValue(size_t slot, int parameter) const { return _values[index(slot, parameter)]; }
+
+    /**
+     * @brief Slew time of a parameter in seconds (editable in place)
+     */
+    float& smoothing(size_t slot, int parameter) { return _smoothing[index(slot, parameter)]; }
+
+    /**
+     * @brief Disabled parameters are held at their default value
+     */
+    bool isParameterEnabled(size_t slot, int parameter) const { return _parameterEnabled[index(slot, parameter)] != 0; }
+    void setParameterEnabled(size_t slot, int parameter, bool enabled) {
+        _parameterEnabled[index(slot, parameter)] = enabled ? 1 : 0;
+    }
+
+    /**
+     * @brief Back to the descriptor's default value
+     */
+    void resetParameter(size_t slot, int parameter);
+
+    /**
+     * @brief Describe the chain for the effect engine
+     *
+     * One ChainSlot per slot, including inactive and bypassed ones (marked
+     * disabled), so engine timings line up with slot indices.
+     */
+    void buildSlots(std::vector<ChainSlot>& slots) const;
+
+private:
+    static constexpr uint8_t FLAG_ACTIVE = 0x1;
+    static constexpr uint8_t FLAG_BYPASSED = 0x2;
+    static constexpr size_t VALUE_COUNT = MAX_SLOTS * MAX_EFFECT_PARAMETERS;
+
+    static size_t index(size_t slot, int parameter) {
+        return slot * MAX_EFFECT_PARAMETERS + static_cast<size_t>(parameter);
+    }
+
+    void setFlag(size_t slot, uint8_t flag, bool set) {
+        _flags[slot] = set ? static_cast<uint8_t>(_flags[slot] | flag) : static_cast<uint8_t>(_flags[slot] & ~flag);
+    }
+
+    // Per slot
+    EffectType _types[MAX_SLOTS];
+    uint32_t _ids[MAX_SLOTS];
+    uint8_t _flags[MAX_SLOTS];
+
+    // Per parameter, MAX_EFFECT_PARAMETERS entries per slot
+    float _values[VALUE_COUNT];
+    float _smoothing[VALUE_COUNT];
+    uint8_t _parameterEnabled[VALUE_COUNT];
+
+    size_t _size;
+    uint32_t _nextId;
+};
+
+} // namespace effects
+} // namespace gamma
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "effects/EffectProcessor.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace gamma {
+namespace effects {
+
+/**
+ * @brief Library sections the effects are grouped into
+ */
+enum class EffectCategory {
+    Color = 0,
+    Distortion,
+    Blur,
+    Geometry,
+    Time,
+    Count
+};
+
+/**
+ * @brief Index of a parameter in the table of all effect parameters
+ */
+using ParameterId = uint16_t;
+
+/**
+ * @brief Static description of one effect parameter
+ */
+struct ParameterDescriptor {
+    const char* name;
+    float minValue;
+    float maxValue;
+    float defaultValue;
+    float smoothing;        // Default slew time in seconds (0 = jump)
+    bool discrete;          // Whole numbers only (modes, counts); never smoothed
+    bool pixels = false;    // A length in pixels of the frame being processed
+};
+
+/**
+ * @brief Static description of an effect: name, category and parameters
+ *
+ * Descriptors are immutable and shared by the library and every chain slot;
+ * slots refer to them by EffectType and hold nothing but their live values.
+ * An effect's parameters are consecutive in the parameter table, in the
+ * order its processor expects them.
+ */
+struct EffectDescriptor {
+    EffectType type;
+    const char* name;
+    EffectCategory category;
+    ParameterId firstParameter;
+    int parameterCount;
+
+    const ParameterDescriptor& getParameter(int index) const;
+};
+
+const EffectDescriptor& getEffectDescriptor(EffectType type);
+
+const ParameterDescriptor& getParameterDescriptor(ParameterId id);
+
+/**
+ * @brief Number of entries in the parameter table (valid ids are below it)
+ */
+size_t getParameterDescriptorCount();
+
+const char* getEffectCategoryName(EffectCategory category);
+
+} // namespace effects
+} // namespace gamma
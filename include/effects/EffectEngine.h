@@ -0,0 +1,322 @@
+#pragma once
+
+#include "effects/ComposedRemap.h"
+#include "effects/EffectGraph.h"
+#include "effects/EffectPlan.h"
+#include "effects/EffectProcessor.h"
+#include "effects/FrameHistory.h"
+#include "effects/Frame.h"
+#include "effects/PrecomposedColorRun.h"
+#include "core/JobSystem.h"
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+namespace gamma {
+namespace effects {
+
+/**
+ * @brief Runs an effect graph over RGBA frames on the CPU
+ *
+ * The graph is described from scratch every frame (see EffectGraph, and
+ * EffectsPanel::buildChain for the linear chain); the engine keeps one
+ * processor per node and only recreates it when the effect at that index
+ * changes, so temporal effects keep their history. Each node is timed, which
+ * is what the CPU meter shows. Parameters with a smoothing time approach new
+ * values exponentially, frame by frame, instead of jumping, so stepped input
+ * (a MIDI knob) sweeps smoothly.
+ *
+ * Each frame the graph is compiled into stages in topological order (see
+ * EffectPlan): a single node, or a run of point-wise effects (see
+ * PointwiseEffect) where each feeds only the next, fused into one pass. A fused stage walks its rows in tiles
+ * small enough to stay in cache, and each tile passes through the whole run
+ * before the next is loaded. Disabled effects and blends at mix 0 or 1 pass
+ * their input through, and nodes that do not reach the output are skipped:
+ * a bypassed effect costs nothing, master mix 1 writes the chain straight
+ * to the output and master mix 0 skips the chain. A blend at any other mix
+ * is folded into the pass producing its layer when nothing else reads that
+ * result: each row is mixed with the base in place right after it is written,
+ * while still in cache, instead of in a separate pass over the whole frame.
+ *
+ * Intermediate results live in pooled scratch frames assigned by lifetime: a
+ * frame returns to the pool after the last stage reading it, so a chain
+ * ping-pongs between two frames and a graph needs only as many as it has
+ * results alive at once. The stage producing the output writes it directly.
+ *
+ * Results are memoized per stage, keyed by the content ids of the sources (see
+ * Frame::getContentId) and everything that shaped the result since: node
+ * kinds, effect types, smoothed parameters and blend mixes. A stage whose key
+ * matches its cached result is skipped, along with everything only it reads;
+ * when the output's key is unchanged (a paused clip), nothing runs at all.
+ * Editing a parameter changes the key of that node and of all downstream, and
+ * temporal effects (EffectProcessor::isTemporal) and sources without an id
+ * are never cached.
+ *
+ * Within a fused run, consecutive color transforms (see
+ * PointwiseEffect::isColorTransform) whose parameters have held still for a
+ * few frames are precomposed into one 3D LUT, baked between frames and
+ * applied in a single lookup per pixel while they stay unchanged.
+ *
+ * Geometry effects built on RemapEffect join a stage of their own kind the
+ * same way: a run of them is composed into one coordinate grid, kept on the
+ * run's first node for as long as the maps stay the same, and the input is
+ * sampled once for the whole run. Effects that pass through are left out of
+ * the composition. Grids are built split across the workers. An effect whose
+ * map changed on its last frame (a swept or modulated parameter) is kept out
+ * of the runs, so only its own grid is rebuilt each frame while its
+ * neighbours' composed grid stays cached.
+ *
+ * Besides the full-resolution program output, the engine can keep a preview
+ * tap: the result box-filtered down by an integer factor once the chain has
+ * run (see setPreviewFactor), for monitors that do not need every pixel. It
+ * is timed apart from the chain and only redone when the result changes.
+ *
+ * With a job system, every stage is split into row bands and each (stage, band)
+ * becomes a task that only waits for the bands it actually depends on: the
+ * rows it reads (plus the effect's halo, getInputHalo) from the stages that
+ * wrote them, and the rows whose readers must finish before a recycled scratch
+ * frame is overwritten. Stages on independent branches therefore run
+ * concurrently, and stage N can run on one band while stage N+1 already runs
+ * on another.
+ */
+class EffectEngine {
+public:
+    /**
+     * @param jobSystem Workers to spread bands across (nullptr = calling thread only)
+     */
+    explicit EffectEngine(core::JobSystem* jobSystem = nullptr);
+    ~EffectEngine();
+
+    EffectEngine(const EffectEngine&) = delete;
+    EffectEngine& operator=(const EffectEngine&) = delete;
+
+    /**
+     * @brief Change the workers used from the next frame on
+     */
+    void setJobSystem(core::JobSystem* jobSystem) { _jobSystem = jobSystem; }
+
+    /**
+     * @brief Process one frame through a linear chain
+     * @param input Source frame
+     * @param output Receives the result, resized to match input
+     * @param chain Effects in order; disabled slots are skipped
+     * @param masterMix 0 = input only, 1 = fully processed
+     * @param time Seconds on the caller's clock, used by temporal effects
+     * @return The result: output, or input itself when nothing applies to it
+     *         (master mix 0, every effect bypassed), which is then not copied
+     */
+    const Frame& process(const Frame& input, Frame& output, const std::vector<ChainSlot>& chain,
+                         float masterMix, double time);
+
+    /**
+     * @brief Process one frame through an effect graph
+     * @param sources Frames for the graph's source nodes, all the same size
+     * @param output Receives the output node's result, resized to match the sources
+     * @param graph Nodes and edges (see EffectGraph::validate)
+     * @param time Seconds on the caller's clock, used by temporal effects
+     * @param result If given, receives the frame holding the result: output, or
+     *        the source the output node passes through unchanged, which is then
+     *        not copied into output. Without it, output always holds the result
+     * @return false if the graph cannot run (cycle, unconnected port, bad source)
+     */
+    bool processGraph(const std::vector<const Frame*>& sources, Frame& output,
+                      const EffectGraph& graph, double time, const Frame** result = nullptr);
+
+    /**
+     * @brief Smoothed CPU time of a node (chain slot) in milliseconds, summed over threads (0 if skipped)
+     */
+    double getSlotTimeMs(size_t slot) const;
+
+    /**
+     * @brief Smoothed wall time of a whole process() call in milliseconds
+     */
+    double getProcessTimeMs() const { return _processTimeMs; }
+
+    /**
+     * @brief Keep a preview tap of every result, reduced by an integer factor per axis
+     * @param factor 2..MAX_DOWNSCALE_FACTOR (larger is clamped), or 0/1 for no preview
+     */
+    void setPreviewFactor(int factor);
+    int getPreviewFactor() const { return _previewFactor; }
+
+    /**
+     * @brief Preview of the last result (empty without a preview tap)
+     *
+     * Its content id changes whenever it is redrawn, so viewers can skip
+     * uploading an unchanged preview.
+     */
+    const Frame& getPreview() const { return _preview; }
+
+    /**
+     * @brief Smoothed wall time of the preview tap in milliseconds (not part of getProcessTimeMs)
+     */
+    double getPreviewTimeMs() const { return _previewTimeMs; }
+
+    /**
+     * @brief Fraction of the time between process() calls spent processing
+     */
+    double getLoad() const;
+
+    /**
+     * @brief Counters of the result cache, since the last reset
+     */
+    using CacheStats = effects::CacheStats;
+
+    const CacheStats& getCacheStats() const { return _plan.getCacheStats(); }
+    void resetCacheStats() { _plan.resetCacheStats(); }
+
+    /**
+     * @brief Pixel format of intermediate results and history frames (RGBA8 by default)
+     *
+     * Sources and the output stay RGBA8. With a float format, effects work on
+     * float rows (see EffectProcessor::setFloatPixels): the first pass converts
+     * the source as it reads it, the last converts back as it writes the
+     * output, and everything between keeps its full range and precision, so
+     * a chain that crushes and then expands a range does not band. Fused runs
+     * use RGBA32F tiles whatever the format, as they stay in cache. RGBA16F
+     * halves the memory traffic of RGBA32F for 11 significant bits. Changing
+     * it drops cached results and recorded history.
+     */
+    void setIntermediateFormat(PixelFormat format);
+    PixelFormat getIntermediateFormat() const { return _plan.getFormat(); }
+
+    /**
+     * @brief Reuse unchanged results (on by default; off releases the cached frames)
+     */
+    void setMemoizationEnabled(bool enabled) { _plan.setMemoizationEnabled(enabled); }
+    bool isMemoizationEnabled() const { return _plan.isMemoizationEnabled(); }
+
+    /**
+     * @brief Bytes held by cached results
+     */
+    size_t getCacheBytes() const { return _plan.getCacheBytes(); }
+
+    /**
+     * @brief Scratch frames allocated for intermediate results (peak needed at once)
+     */
+    size_t getScratchFrameCount() const { return _plan.getScratchFrameCount(); }
+
+    /**
+     * @brief Drop all processors and their state
+     */
+    void reset();
+
+    /**
+     * @brief Fuse runs of point-wise effects (on by default; off for comparisons)
+     */
+    void setFusionEnabled(bool enabled) { _plan.setFusionEnabled(enabled); }
+    bool isFusionEnabled() const { return _plan.isFusionEnabled(); }
+
+    /**
+     * @brief Precompose static runs of color transforms into a 3D LUT (on by default)
+     *
+     * A run is baked when it holds a table lookup (a Color LUT effect) and at
+     * least one more color transform: the baked table then costs a single
+     * lookup, where two matrices alone are cheaper than one. RGBA8
+     * intermediate format only, as the baked table clamps to the 8-bit range
+     * between effects. For smooth looks the baked result is within a few
+     * 8-bit steps of the direct one: the direct path rounds after every
+     * effect, the table samples the whole run on its grid.
+     */
+    void setColorPrecompositionEnabled(bool enabled);
+    bool isColorPrecompositionEnabled() const { return _colorPrecompositionEnabled; }
+
+    /**
+     * @brief Past frames kept for the temporal effects of this engine
+     */
+    FrameHistory& getFrameHistory() { return _history; }
+    const FrameHistory& getFrameHistory() const { return _history; }
+
+private:
+    using Clock = std::chrono::steady_clock;
+    using Stage = EffectPlan::Stage;
+    using StageKind = EffectPlan::StageKind;
+    using Dependency = EffectPlan::Dependency;
+    using ColorRun = EffectPlan::ColorRun;
+    static constexpr int MIX_BASE_INPUT = EffectPlan::MIX_BASE_INPUT;
+    static constexpr int MIX_MATTE_INPUT = EffectPlan::MIX_MATTE_INPUT;
+
+    // Bytes of one fused tile; two tiles plus the rows being streamed fit in L2
+    static constexpr size_t TILE_BYTES = 64 * 1024;
+    // Bands per participating thread: enough slack for stealing to balance
+    static constexpr int BANDS_PER_THREAD = 4;
+    static constexpr int MIN_BAND_ROWS = 16;
+
+    struct Slot {
+        NodeKind kind = NodeKind::Effect;
+        EffectType type = EffectType::ColorCorrection;
+        std::unique_ptr<EffectProcessor> processor;  // Effect nodes only
+        double timeMs = 0.0;
+        float values[MAX_EFFECT_PARAMETERS] = {};  // Smoothed parameters handed to prepare()
+        bool primed = false;                        // values hold last frame's state
+        PrecomposedColorRun colorRun;               // Color run starting at this node (see precomposeColorRuns)
+        std::unique_ptr<ComposedRemap> remapRun;    // Remap run starting here
+        uint64_t mapKey = 0;                        // Own map's key on its last frame (remap effects)
+        bool mapMoving = false;                     // That key changed from the frame before
+    };
+
+    struct TileScratch {
+        Frame tiles[2];
+    };
+
+    void syncSlots(const EffectGraph& graph);
+    void smoothParameters(const EffectGraph& graph, float deltaTime);
+
+    void executeSerial(int height);
+    void executeParallel(int height, int bandRows);
+    void runStage(size_t stageIndex, int yBegin, int yEnd);
+    void precomposeColorRuns(Stage& stage);
+    void composeRemaps(Stage& stage);
+    void runFused(const Stage& stage, int yBegin, int yEnd);
+    void runFusedFloat(const Stage& stage, int yBegin, int yEnd);
+    void mixRows(const Stage& stage, const Frame& base, const Frame& layer, const Frame* matte,
+                 int yBegin, int yEnd);
+    void mixRowFloat(const Stage& stage, const Frame& base, const float* layer, const Frame* matte, int y);
+    TileScratch& getTileScratch();
+    void addSlotTime(size_t slot, Clock::time_point start);
+    void updatePreview(const Frame& result);
+
+    core::JobSystem* _jobSystem;
+    FrameHistory _history;          // Declared before _slots: processors release their tracks into it
+    std::vector<Slot> _slots;
+    std::vector<PlanNode> _planNodes;   // What the plan sees of each slot
+    EffectPlan _plan;                   // Stages, buffers and cached results; holds the intermediate format
+    bool _colorPrecompositionEnabled;
+
+    // process() describes the chain as a graph here
+    EffectGraph _chainGraph;
+    std::vector<const Frame*> _chainSources;
+
+    int _width;
+    int _height;
+
+    // Scratch of precomposeColorRuns and composeRemaps
+    std::vector<PointwiseEffect*> _colorRunEffects;
+    std::vector<const RemapEffect*> _remapEffects;
+
+    // Parallel execution
+    int _bandRows;
+    std::vector<std::vector<core::JobSystem::TaskHandle>> _bandTasks;
+    std::vector<core::JobSystem::TaskHandle> _dependencies;
+    std::vector<TileScratch> _tileScratch;  // One per worker, plus one for the calling thread
+    std::unique_ptr<std::atomic<int64_t>[]> _slotNanoseconds;
+    size_t _slotNanosecondsCapacity;
+
+    // Preview tap
+    int _previewFactor;                 // 0 = none
+    Frame _preview;
+    uint64_t _previewSourceId;          // Content id of the result the preview shows
+
+    // Timing
+    uint64_t _frameIndex;
+    double _lastTime;
+    double _processTimeMs;
+    double _previewTimeMs;
+    double _intervalMs;
+    Clock::time_point _lastProcessStart;
+    bool _hasProcessed;
+};
+
+} // namespace effects
+} // namespace gamma
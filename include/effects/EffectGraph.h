@@ -0,0 +1,144 @@
+#pragma once
+
+#include "effects/EffectProcessor.h"
+#include <vector>
+
+namespace gamma {
+namespace effects {
+
+/**
+ * @brief One entry of the chain handed to the engine each frame
+ */
+struct ChainSlot {
+    EffectType type = EffectType::ColorCorrection;
+    uint32_t id = 0;                // Follows the slot when others are removed (0 = not assigned)
+    bool enabled = true;            // False for inactive or bypassed effects
+    int parameterCount = 0;
+    float parameters[MAX_EFFECT_PARAMETERS] = {};
+    float smoothing[MAX_EFFECT_PARAMETERS] = {};    // Seconds to close ~63% of a jump (0 = jump)
+};
+
+/**
+ * @brief What a graph node does
+ */
+enum class NodeKind {
+    Source = 0,     // One of the frames passed to EffectEngine::process()
+    Effect,         // An EffectProcessor: image in, image out
+    Blend,          // Mix of a base and a layer image, optionally weighted by a matte
+    Matte           // Luminance of an image, as a per-pixel blend weight
+};
+
+/**
+ * @brief Kind of frame carried by an edge
+ *
+ * Both are RGBA frames in memory; the type keeps a matte from being wired
+ * where a picture is expected and the other way round.
+ */
+enum class EdgeType {
+    Image = 0,
+    Matte
+};
+
+/**
+ * @brief Most inputs a node takes
+ */
+const int MAX_NODE_INPUTS = 3;
+
+/**
+ * @brief Input ports of a blend node
+ */
+enum BlendPort {
+    BLEND_BASE = 0,     // Image shown at mix 0
+    BLEND_LAYER = 1,    // Image shown at mix 1
+    BLEND_MATTE = 2     // Optional matte scaling the mix per pixel
+};
+
+using NodeId = int;
+const NodeId INVALID_NODE = -1;
+
+struct GraphNode {
+    NodeKind kind = NodeKind::Effect;
+    NodeId inputs[MAX_NODE_INPUTS] = {INVALID_NODE, INVALID_NODE, INVALID_NODE};
+    ChainSlot effect;               // Effect nodes
+    float mix = 1.0f;               // Blend nodes: 0 = base, 1 = layer
+    int sourceIndex = 0;            // Source nodes: index into the engine's sources
+};
+
+/**
+ * @brief Effects wired into a directed acyclic graph
+ *
+ * Nodes are effects, blends, mattes and source frames, connected by typed
+ * edges from a node's output to an input port of another node; one node is
+ * the graph's output. Like the chain, the graph is described every frame and
+ * the engine keeps one processor per node index, so an effect keeps its
+ * state as long as it stays at the same index.
+ *
+ * A linear chain is the trivial graph: source, effects in order, and a blend
+ * with the source for the master mix (see buildFromChain()).
+ */
+class EffectGraph {
+public:
+    EffectGraph();
+
+    /**
+     * @brief Remove all nodes (keeps their storage)
+     */
+    void clear();
+
+    NodeId addSource(int sourceIndex = 0);
+    NodeId addEffect(const ChainSlot& effect);
+    NodeId addBlend(float mix);
+    NodeId addMatte();
+
+    /**
+     * @brief Feed the output of one node into an input port of another
+     * @return false if a node or port does not exist or the edge types differ
+     */
+    bool connect(NodeId from, NodeId to, int port = 0);
+
+    void setOutput(NodeId node) { _output = node; }
+    NodeId getOutput() const { return _output; }
+
+    size_t getNodeCount() const { return _nodeCount; }
+    const GraphNode& getNode(NodeId node) const { return _nodes[static_cast<size_t>(node)]; }
+    GraphNode& getNode(NodeId node) { return _nodes[static_cast<size_t>(node)]; }
+
+    /**
+     * @brief Rebuild as the trivial graph of a linear chain
+     *
+     * Chain slot i becomes node i, so engine timings keep lining up with slot
+     * indices; the source and the master mix blend follow the effects.
+     */
+    void buildFromChain(const std::vector<ChainSlot>& chain, float masterMix);
+
+    /**
+     * @brief Check that every required port is connected and there is no cycle
+     * @return false (with a message on stderr) if the graph cannot run
+     */
+    bool validate() const;
+
+    /**
+     * @brief Order nodes so every node follows its inputs
+     * @return false on a cycle or a dangling edge
+     */
+    bool sortTopologically(std::vector<NodeId>& order) const;
+
+    static int getInputCount(NodeKind kind);
+    static bool isInputRequired(NodeKind kind, int port);
+    static EdgeType getInputType(NodeKind kind, int port);
+    static EdgeType getOutputType(NodeKind kind);
+
+private:
+    NodeId addNode(NodeKind kind);
+
+    std::vector<GraphNode> _nodes;
+    size_t _nodeCount;
+    NodeId _output;
+
+    // Scratch for sortTopologically()
+    mutable std::vector<int> _pending;
+    mutable std::vector<NodeId> _ready;
+};
+
+} // namespace effects
+} // namespace gamma
@@ -0,0 +1,247 @@
+#pragma once
+
+#include "effects/EffectGraph.h"
+#include "effects/Frame.h"
+#include "effects/PixelFormat.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace gamma {
+namespace effects {
+
+class ColorLut;
+class RemapGrid;
+
+/**
+ * @brief What a plan needs to know of a node's processor (effect nodes only)
+ */
+struct PlanNode {
+    bool pointwise = false;         // A PointwiseEffect: may fuse into its input's stage
+    bool remap = false;             // A RemapEffect: may compose with its input's stage
+    bool mapMoving = false;         // Its map changed on its last frame: it stays out of remap runs
+    bool temporal = false;          // Its result depends on past frames, so is never cached
+    const float* values = nullptr;  // Smoothed parameters, MAX_EFFECT_PARAMETERS of them
+};
+
+/**
+ * @brief Counters of the result cache, since the last reset
+ */
+struct CacheStats {
+    uint64_t hits = 0;          // Results reused (the whole output counts once)
+    uint64_t misses = 0;        // Cacheable results rendered
+    uint64_t uncached = 0;      // Results rendered that cannot be cached
+};
+
+/**
+ * @brief Stages, buffers and cached results of an effect graph, planned each frame
+ *
+ * compile() resolves nodes that pass their input through (disabled effects,
+ * blends at mix 0 or 1), drops those that do not reach the output and groups
+ * the rest into stages in topological order: a single node, a run of
+ * point-wise effects where each feeds only the next (fused into one pass), or
+ * a run of remap effects (sampled once through a composed grid).
+ *
+ * Results are memoized per node, keyed by the content ids of the sources (see
+ * Frame::getContentId) and everything that shaped the result since: node
+ * kinds, effect types, smoothed parameters and blend mixes (computeKeys). A
+ * stage whose key matches its cached result is skipped, along with
+ * everything only it reads (skipCachedStages). Temporal effects and sources
+ * without an id are never cached.
+ *
+ * A blend is folded into the stage producing its layer when nothing else
+ * reads that result (foldBlends). Intermediate results then get pooled
+ * scratch frames by lifetime: a frame returns to the pool after the last
+ * stage reading it, and the stage producing the output writes it directly
+ * (assignBuffers). For banded execution, each stage lists the earlier stages
+ * whose rows it must wait for, with the halo it reads beyond its own rows
+ * (addDependencies).
+ *
+ * The plan does not run anything: EffectEngine executes its stages.
+ */
+class EffectPlan {
+public:
+    enum class StageKind {
+        Effect,
+        Fused,
+        Blend,
+        Matte,
+        Remap
+    };
+
+    // A stage waits for rows of an earlier stage: those it covers, plus halo
+    struct Dependency {
+        size_t stage;
+        int halo;
+    };
+
+    // Inputs of an effect stage with a blend folded in (port 0 is the effect's input)
+    static constexpr int MIX_BASE_INPUT = 1;
+    static constexpr int MIX_MATTE_INPUT = 2;
+
+    // Fused nodes [first, first + count) replaced by one table lookup
+    struct ColorRun {
+        size_t first;
+        size_t count;
+        const ColorLut* lut;
+    };
+
+    struct Stage {
+        StageKind kind = StageKind::Effect;
+        std::vector<NodeId> nodes;      // Several when fused; the producer of the result last
+        NodeId mixNode = INVALID_NODE;  // Blend folded into an effect stage: its result is the stage's
+        NodeId inputNodes[MAX_NODE_INPUTS];     // Nodes whose results are read (INVALID_NODE if unconnected)
+        int inputBuffers[MAX_NODE_INPUTS];
+        int targetBuffer = -1;
+        const Frame* inputs[MAX_NODE_INPUTS];
+        Frame* target = nullptr;
+        int halo = 0;                   // Rows of inputs read beyond each band (set by the caller)
+        uint32_t mixWeight = 256;       // Blend stages and folded blends, 0..256
+        size_t lastUse = 0;             // Last stage reading the result
+        uint64_t key = 0;               // Result key, 0 if it cannot be cached
+        bool needed = false;            // Read by a stage that renders, or the output
+        bool cached = false;            // Result already in the node's cache
+        std::vector<Dependency> dependencies;
+        std::vector<ColorRun> colorRuns;    // Precomposed runs of a fused stage, in order (set by the caller)
+        std::shared_ptr<const RemapGrid> grid;  // Composed map of a remap stage (null: identity)
+
+        /**
+         * @brief Node whose result the stage writes
+         */
+        NodeId getResultNode() const { return mixNode != INVALID_NODE ? mixNode : nodes.back(); }
+    };
+
+    EffectPlan();
+
+    /**
+     * @brief Fuse point-wise runs, compose remap runs and fold blends (on by default)
+     */
+    void setFusionEnabled(bool enabled) { _fusionEnabled = enabled; }
+    bool isFusionEnabled() const { return _fusionEnabled; }
+
+    /**
+     * @brief Reuse unchanged results (on by default; off releases the cached frames)
+     */
+    void setMemoizationEnabled(bool enabled);
+    bool isMemoizationEnabled() const { return _memoizationEnabled; }
+
+    /**
+     * @brief Format of cached results and scratch frames; changing it drops them
+     */
+    void setFormat(PixelFormat format);
+    PixelFormat getFormat() const { return _format; }
+
+    /**
+     * @brief Resolve pass-through nodes and group the live ones into stages
+     * @param sources Frames for the graph's source nodes, all the same size
+     * @param nodes One per graph node
+     * @return false if the graph cannot run (cycle, unconnected port, bad source)
+     */
+    bool compile(const EffectGraph& graph, const std::vector<const Frame*>& sources,
+                 const std::vector<PlanNode>& nodes);
+
+    /**
+     * @brief Key every live node's result (0 for those that cannot be cached)
+     *
+     * Reads the nodes' values, so runs after they are smoothed for the frame.
+     */
+    void computeKeys(const EffectGraph& graph, const std::vector<const Frame*>& sources,
+                     const std::vector<PlanNode>& nodes);
+
+    /**
+     * @brief Drop the stages whose results are cached or not needed, counting hits and misses
+     */
+    void skipCachedStages();
+
+    /**
+     * @brief Fold blends into the stages producing their layers
+     */
+    void foldBlends();
+
+    /**
+     * @brief Give every stage its input frames and its target
+     */
+    void assignBuffers(const EffectGraph& graph, const std::vector<const Frame*>& sources, Frame& output);
+
+    /**
+     * @brief Find the earlier stages a stage waits for (stages in order, after their halos are set)
+     */
+    void addDependencies(size_t stageIndex);
+
+    /**
+     * @brief Node whose result is the output
+     */
+    NodeId getResult() const { return _result; }
+    uint64_t getResultKey() const { return _nodeKeys[static_cast<size_t>(_result)]; }
+
+    size_t getStageCount() const { return _stageCount; }
+    Stage& getStage(size_t stage) { return _stages[stage]; }
+    const Stage& getStage(size_t stage) const { return _stages[stage]; }
+
+    /**
+     * @brief Stage writing the output (once there are stages to run)
+     */
+    size_t getOutputStage() const { return static_cast<size_t>(_nodeStage[static_cast<size_t>(_result)]); }
+
+    /**
+     * @brief Forget a node's cached result, as a different node now has its index
+     */
+    void forgetResult(size_t node);
+
+    const CacheStats& getCacheStats() const { return _cacheStats; }
+    void resetCacheStats() { _cacheStats = CacheStats(); }
+
+    /**
+     * @brief Count a frame whose whole output was reused
+     */
+    void countOutputHit() { ++_cacheStats.hits; }
+
+    /**
+     * @brief Bytes held by cached results
+     */
+    size_t getCacheBytes() const;
+
+    /**
+     * @brief Scratch frames allocated for intermediate results (peak needed at once)
+     */
+    size_t getScratchFrameCount() const { return _scratch.size(); }
+
+private:
+    struct NodeCache {
+        Frame frame;                // Last result of the stage ending at the node
+        uint64_t key = 0;           // Key of frame's contents (0 = none)
+    };
+
+    Stage& addStage(StageKind kind, NodeId node, const GraphNode& graphNode);
+    int acquireScratch();
+
+    bool _fusionEnabled;
+    bool _memoizationEnabled;
+    PixelFormat _format;
+    CacheStats _cacheStats;
+    int _width;
+    int _height;
+
+    std::vector<NodeCache> _caches;     // One per node
+    std::vector<std::unique_ptr<Frame>> _scratch;
+
+    std::vector<NodeId> _order;         // Topological
+    std::vector<NodeId> _alias;         // Node whose result a node passes on (itself if it renders)
+    std::vector<uint8_t> _live;         // Result reaches the output
+    std::vector<int> _consumers;        // Live stages reading a node's result
+    std::vector<int> _nodeStage;        // Stage producing a node's result, -1 for sources and cached results
+    std::vector<uint64_t> _nodeKeys;    // Result keys, 0 if not cacheable
+    std::vector<Stage> _stages;
+    size_t _stageCount;
+    NodeId _result;
+
+    // Buffers: sources, the output, each node's cache, then scratch frames
+    std::vector<const Frame*> _buffers;
+    std::vector<int> _freeScratch;
+    std::vector<int> _bufferWriter;                     // Last stage writing each buffer, -1 if none
+    std::vector<std::vector<Dependency>> _bufferReaders; // Stages reading it since then
+};
+
+} // namespace effects
+} // namespace gamma
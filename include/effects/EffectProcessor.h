@@ -0,0 +1,251 @@
+#pragma once
+
+#include "effects/Frame.h"
+#include "effects/RemapGrid.h"
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace gamma {
+namespace effects {
+
+/**
+ * @brief Effects the engine can run (matches the EffectsPanel library)
+ */
+enum class EffectType {
+    ColorCorrection = 0,
+    ChromaticAberration,
+    Datamosh,
+    MotionBlur,
+    Mirror,
+    TimeEcho,
+    ColorLut,
+    Kaleidoscope,
+    Polar,
+    Tile,
+    Warp,
+    Count
+};
+
+/**
+ * @brief Most parameters any effect takes
+ */
+const int MAX_EFFECT_PARAMETERS = 8;
+
+class FrameHistory;
+
+/**
+ * @brief Per-frame information passed to every effect
+ */
+struct EffectContext {
+    double time = 0.0;          // Seconds since the engine started
+    float deltaTime = 0.0f;     // Seconds since the previous frame
+    uint64_t frameIndex = 0;
+    FrameHistory* history = nullptr;    // Engine's shared history (null: temporal effects pass through)
+    PixelFormat format = PixelFormat::RGBA8;    // Engine's intermediate format (history frames use it too)
+};
+
+class PointwiseEffect;
+class RemapEffect;
+
+/**
+ * @brief One effect instance in a chain
+ *
+ * Parameters arrive as a flat array in the order the EffectsPanel lists them.
+ * Temporal effects (Datamosh, Time Echo) keep state between frames, so an
+ * instance belongs to a single chain slot.
+ *
+ * Work is split into a per-frame prepare() and processRows() over row bands,
+ * so the engine can spread a frame across worker threads. Bands of one frame
+ * may run concurrently and in any order; an effect must not write anything
+ * shared between bands in processRows().
+ */
+class EffectProcessor {
+public:
+    virtual ~EffectProcessor() = default;
+
+    /**
+     * @brief Compute per-frame constants; called once before any processRows()
+     * @param input Frame the effect reads (only its size is reliable: earlier
+     *              effects may still be running on it)
+     */
+    virtual void prepare(const Frame& input, const float* parameters, const EffectContext& context) = 0;
+
+    /**
+     * @brief Render rows [yBegin, yEnd) of output from input
+     *
+     * output is sized like input and never aliases it. Rows of input outside
+     * the band may be read up to getInputHalo() rows away.
+     */
+    virtual void processRows(const Frame& input, Frame& output, int yBegin, int yEnd) = 0;
+
+    /**
+     * @brief Rows above and below a band that processRows() reads (after prepare())
+     * @return 0 for effects that only read their own rows, height if any row may be read
+     */
+    virtual int getInputHalo(int /*height*/) const { return 0; }
+
+    /**
+     * @brief True if the output also depends on state carried between frames
+     *
+     * The engine reuses a cached result when an effect's input and parameters
+     * are unchanged; temporal effects (history frames, per-frame randomness)
+     * are rendered every frame, and so is everything downstream of them.
+     */
+    virtual bool isTemporal() const { return false; }
+
+    /**
+     * @brief Drop any state carried between frames
+     */
+    virtual void reset() {}
+
+    /**
+     * @brief Non-null if each output pixel depends only on the same input pixel
+     *
+     * The engine fuses consecutive point-wise effects into one tiled pass.
+     */
+    virtual PointwiseEffect* asPointwise() { return nullptr; }
+
+    /**
+     * @brief Non-null if each output pixel is the input sampled at a position
+     * that depends only on the parameters
+     *
+     * The engine composes consecutive remaps into one sampling pass.
+     */
+    virtual RemapEffect* asRemap() { return nullptr; }
+
+    /**
+     * @brief Work on float pixels (see PixelFormat); set before prepare()
+     *
+     * Off, every frame an effect sees is RGBA8 and it uses its integer path.
+     * On, the engine keeps intermediate results and history frames in a float
+     * format while sources and the output may still be RGBA8: effects read and
+     * write rows through PixelRows.h, which converts as it goes, so the
+     * conversion happens in the first and last passes only.
+     */
+    void setFloatPixels(bool enabled) { _floatPixels = enabled; }
+    bool usesFloatPixels() const { return _floatPixels; }
+
+    /**
+     * @brief Whole frame on the calling thread: prepare() then all rows
+     *
+     * Uses float pixels when the context's format is not RGBA8.
+     */
+    void process(const Frame& input, Frame& output, const float* parameters, const EffectContext& context);
+
+private:
+    bool _floatPixels = false;
+};
+
+/**
+ * @brief Effect that maps every pixel independently of its neighbours
+ *
+ * Works one row at a time, so the engine can run several of them back to
+ * back on a cache-resident tile instead of streaming the whole frame through
+ * memory once per effect.
+ */
+class PointwiseEffect : public EffectProcessor {
+public:
+    void processRows(const Frame& input, Frame& output, int yBegin, int yEnd) override;
+
+    PointwiseEffect* asPointwise() override { return this; }
+
+    /**
+     * @brief Process one row; src and dst never alias
+     * @param y Row index in the frame, for effects that keep per-pixel state
+     */
+    virtual void processRow(const uint32_t* src, uint32_t* dst, int width, int y) = 0;
+
+    /**
+     * @brief processRow() on float pixels (see usesFloatPixels()); src and dst never alias
+     */
+    virtual void processRowFloat(const float* src, float* dst, int width, int y) = 0;
+
+    /**
+     * @brief True if, for the frame, output RGB is a function of input RGB alone
+     * and alpha passes through
+     *
+     * The engine may then precompose a run of such effects into one 3D LUT
+     * while their parameters hold still (see EffectEngine::setColorPrecompositionEnabled).
+     */
+    virtual bool isColorTransform() const { return false; }
+
+    /**
+     * @brief Identifies what shapes a color transform besides its parameters
+     * (a loaded table); 0 if nothing does. Valid after prepare()
+     */
+    virtual uint64_t getColorStateId() const { return 0; }
+};
+
+/**
+ * @brief Effect that moves pixels around: the output samples the input at mapped positions
+ *
+ * Subclasses describe the map (mapPoints); sampling is shared. The map is
+ * evaluated into a RemapGrid once per set of parameters and frame size, and
+ * every frame samples the input bilinearly at the grid's positions in one
+ * vectorized pass (KernelTable::remap), so the map's own math never runs per
+ * pixel. Recent grids are kept (RemapGridCache), so a parameter moving back
+ * and forth does not rebuild them. The engine composes a run of remap effects
+ * into a single grid and samples the input once for the whole run.
+ */
+class RemapEffect : public EffectProcessor {
+public:
+    void prepare(const Frame& input, const float* parameters, const EffectContext& context) override;
+    void processRows(const Frame& input, Frame& output, int yBegin, int yEnd) override;
+    int getInputHalo(int height) const override;
+
+    RemapEffect* asRemap() override { return this; }
+
+    /**
+     * @brief Replace output positions with the input positions they sample (after prepare())
+     *
+     * Positions are in pixels, with the center of pixel (x, y) at (x + 0.5, y + 0.5).
+     */
+    virtual void mapPoints(float* x, float* y, size_t count) const = 0;
+
+    /**
+     * @brief Identifies the current map, frame size included; 0 if it is the identity
+     */
+    uint64_t getMapKey() const { return _mapKey; }
+
+protected:
+    /**
+     * @brief Take the frame's parameters for mapPoints()
+     * @return Key of the map (see hashMap), 0 for the identity
+     */
+    virtual uint64_t prepareMap(int width, int height, const float* parameters) = 0;
+
+    /**
+     * @brief Key of a map from its name, frame size and the values shaping it (never 0)
+     */
+    static uint64_t hashMap(const char* name, int width, int height, std::initializer_list<float> values);
+
+private:
+    uint64_t _mapKey = 0;
+    int _width = 0;
+    int _height = 0;
+
+    // Grid for processRows(), found on first use: inside the engine's
+    // composed runs it is never needed
+    RemapGridCache _grids;
+    std::mutex _gridMutex;
+    std::shared_ptr<const RemapGrid> _grid;
+};
+
+/**
+ * @brief Create a processor for an effect type
+ */
+std::unique_ptr<EffectProcessor> createEffectProcessor(EffectType type);
+
+/**
+ * @brief Look up an effect type by its display name ("Color Correction", ...)
+ * @return false if no effect has that name
+ */
+bool findEffectType(const std::string& name, EffectType& type);
+
+const char* getEffectTypeName(EffectType type);
+
+} // namespace effects
+} // namespace gamma
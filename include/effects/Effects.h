@@ -0,0 +1,298 @@
+#pragma once
+
+#include "effects/ColorLut.h"
+#include "effects/EffectProcessor.h"
+#include "effects/FrameHistory.h"
+#include "effects/Kernels.h"
+#include <vector>
+
+namespace gamma {
+namespace effects {
+
+/**
+ * @brief Brightness, contrast, saturation and hue shift
+ *
+ * All four are linear in RGB, so they are folded into one 3x4 matrix per
+ * frame and applied in a single pass.
+ * Parameters: Brightness (-1..1), Contrast (0..3), Saturation (0..2), Hue Shift (degrees).
+ */
+class ColorCorrectionEffect : public PointwiseEffect {
+public:
+    void prepare(const Frame& input, const float* parameters, const EffectContext& context) override;
+    void processRow(const uint32_t* src, uint32_t* dst, int width, int y) override;
+    void processRowFloat(const float* src, float* dst, int width, int y) override;
+    bool isColorTransform() const override { return true; }
+
+    /**
+     * @brief Matrix equivalent of the four parameters
+     */
+    static ColorMatrix buildMatrix(float brightness, float contrast, float saturation, float hueDegrees);
+
+private:
+    ColorMatrix _matrix = {};
+    bool _identity = true;
+    const KernelTable* _kernels = nullptr;
+};
+
+/**
+ * @brief Horizontal offset of the red and blue channels
+ *
+ * Parameters: Strength (0..1), Red Offset and Blue Offset (pixels, scaled by strength).
+ */
+class ChromaticAberrationEffect : public EffectProcessor {
+public:
+    void prepare(const Frame& input, const float* parameters, const EffectContext& context) override;
+    void processRows(const Frame& input, Frame& output, int yBegin, int yEnd) override;
+
+private:
+    void processRowsFloat(const Frame& input, Frame& output, int yBegin, int yEnd) const;
+
+    int _redShift = 0;
+    int _blueShift = 0;
+    const KernelTable* _kernels = nullptr;
+};
+
+/**
+ * @brief Block smearing from the previous output frame
+ *
+ * Each block is either taken from the input or, with a probability set by
+ * Intensity, copied from the previous output at a random displacement scaled
+ * by Chaos. Block Size is in units of 4 pixels. Outputs are recorded into the
+ * engine's frame history, which keeps the previous one readable while bands
+ * record this frame.
+ * Parameters: Intensity (0..1), Block Size (1..32), Chaos (0..1).
+ */
+class DatamoshEffect : public EffectProcessor {
+public:
+    void prepare(const Frame& input, const float* parameters, const EffectContext& context) override;
+    void processRows(const Frame& input, Frame& output, int yBegin, int yEnd) override;
+    bool isTemporal() const override { return true; }
+    void reset() override;
+
+private:
+    void processRowsFloat(const Frame& input, Frame& output, int yBegin, int yEnd) const;
+
+    HistoryTrack _history;
+
+    // Set by prepare() for the current frame
+    const Frame* _previous = nullptr;   // Null: nothing to smear from
+    Frame* _recorded = nullptr;
+
+    float _intensity = 0.0f;
+    int _blockSize = 1;
+    int _maxDisplacement = 0;
+    uint32_t _frame = 0;
+};
+
+/**
+ * @brief Directional box blur
+ *
+ * Samples are spread along the blur direction over up to 5% of the frame
+ * width. With kernel specialization on, the columns whose samples all stay in
+ * the row go through the box filter built for the current sample count;
+ * otherwise samples are summed in 16-bit accumulators one row at a time.
+ * Float pixels go through a float box filter, except RGBA8 input, which
+ * keeps the exact integer sums.
+ * Parameters: Amount (0..1), Angle (degrees), Samples (1..32).
+ */
+class MotionBlurEffect : public EffectProcessor {
+public:
+    static constexpr int MAX_SAMPLES = MAX_BOX_FILTER_TAPS;
+
+    void prepare(const Frame& input, const float* parameters, const EffectContext& context) override;
+    void processRows(const Frame& input, Frame& output, int yBegin, int yEnd) override;
+    int getInputHalo(int height) const override;
+
+private:
+    struct SampleOffset {
+        int dx;
+        int dy;
+    };
+
+    void filterRows(const Frame& input, Frame& output, int yBegin, int yEnd) const;
+    void accumulateRows(const Frame& input, Frame& output, int yBegin, int yEnd) const;
+    void filterRowsFloat(const Frame& input, Frame& output, int yBegin, int yEnd) const;
+
+    SampleOffset _offsets[MAX_SAMPLES] = {};
+    int _samples = 1;
+    uint32_t _scale = 0;
+    bool _passThrough = true;
+    BoxFilterFunction _boxFilter = nullptr;     // Null: generic accumulator path
+    int _interiorBegin = 0;                     // Columns where no sample is clamped
+    int _interiorEnd = 0;
+    const KernelTable* _kernels = nullptr;
+};
+
+/**
+ * @brief Reflect the frame about a vertical and/or horizontal axis
+ *
+ * With kernel specialization on, each mode has its own row loop with the
+ * mode resolved at compile time, chosen in prepare().
+ * Parameters: Mode (0 none, 1 horizontal, 2 vertical, 3 both), Center X, Center Y (0..1).
+ */
+class MirrorEffect : public EffectProcessor {
+public:
+    void prepare(const Frame& input, const float* parameters, const EffectContext& context) override;
+    void processRows(const Frame& input, Frame& output, int yBegin, int yEnd) override;
+    int getInputHalo(int height) const override;
+
+private:
+    using RowsFunction = void (MirrorEffect::*)(const Frame& input, Frame& output, int yBegin, int yEnd) const;
+
+    template<bool Horizontal, bool Vertical>
+    void mirrorRows(const Frame& input, Frame& output, int yBegin, int yEnd) const;
+
+    void mirrorRowsFloat(const Frame& input, Frame& output, int yBegin, int yEnd) const;
+
+    bool _horizontal = false;
+    bool _vertical = false;
+    int _axisX = 1;
+    int _axisY = 1;
+    RowsFunction _rowsFunction = nullptr;       // Null: generic path
+    const KernelTable* _kernels = nullptr;
+};
+
+/**
+ * @brief Blend the frame with a delayed copy of itself
+ *
+ * Recorded frames include the echo scaled by Feedback, so repeats decay.
+ * They live in the engine's frame history, which records every frame while
+ * the delay fits the history budget and spreads the recordings over the delay
+ * otherwise. Point-wise: the echo of a pixel is the same pixel of an older frame.
+ * Parameters: Delay (seconds), Feedback (0..0.95), Mix (0..1).
+ */
+class TimeEchoEffect : public PointwiseEffect {
+public:
+    void prepare(const Frame& input, const float* parameters, const EffectContext& context) override;
+    void processRow(const uint32_t* src, uint32_t* dst, int width, int y) override;
+    void processRowFloat(const float* src, float* dst, int width, int y) override;
+    bool isTemporal() const override { return true; }
+    void reset() override;
+
+private:
+    HistoryTrack _history;
+
+    // Set by prepare() for the current frame
+    const Frame* _delayed = nullptr;
+    Frame* _recorded = nullptr;
+    float _mix = 0.0f;
+    float _feedback = 0.0f;
+    uint32_t _mixWeight = 0;        // 8.8 fixed point, for RGBA8 rows
+    uint32_t _feedbackWeight = 0;
+    const KernelTable* _kernels = nullptr;
+};
+
+/**
+ * @brief Grade through a 3D LUT from the LUT library
+ *
+ * Look selects a table of getLutLibrary() by index; with none loaded there
+ * the effect passes through. The table is held for the frame, so the library
+ * can replace it meanwhile. Amount mixes the graded pixel with the original.
+ * Parameters: Look (0..31), Amount (0..1).
+ */
+class ColorLutEffect : public PointwiseEffect {
+public:
+    void prepare(const Frame& input, const float* parameters, const EffectContext& context) override;
+    void processRow(const uint32_t* src, uint32_t* dst, int width, int y) override;
+    void processRowFloat(const float* src, float* dst, int width, int y) override;
+    bool isColorTransform() const override { return true; }
+    uint64_t getColorStateId() const override { return _lut ? _lut->getId() : 0; }
+
+private:
+    std::shared_ptr<const ColorLut> _lut;      // Null: pass through
+    float _amount = 1.0f;
+    uint32_t _amountWeight = 256;               // 8.8 fixed point, for RGBA8 rows
+    const KernelTable* _kernels = nullptr;
+};
+
+/**
+ * @brief Fold the frame into mirrored wedges around a center
+ *
+ * Every wedge shows the same half-wedge of the input, alternately reflected,
+ * so the pattern is seamless. Distances are in pixels, so wedges keep their
+ * angles on any aspect ratio.
+ * Parameters: Segments (1..16, 1 passes through), Rotation (degrees), Center X, Center Y (0..1).
+ */
+class KaleidoscopeEffect : public RemapEffect {
+public:
+    void mapPoints(float* x, float* y, size_t count) const override;
+
+protected:
+    uint64_t prepareMap(int width, int height, const float* parameters) override;
+
+private:
+    float _centerX = 0.0f;
+    float _centerY = 0.0f;
+    float _rotation = 0.0f;     // Radians
+    float _sector = 0.0f;       // Angle of one wedge
+};
+
+/**
+ * @brief Convert between rectangular and polar coordinates about the frame center
+ *
+ * To polar unrolls the frame: across is the angle, down the distance from
+ * the center. To rectangular wraps it around the center instead, its top
+ * edge at the middle. Distances are relative to the half diagonal.
+ * Parameters: Mode (0 none, 1 to polar, 2 to rectangular), Rotation (degrees), Zoom (0.25..4).
+ */
+class PolarEffect : public RemapEffect {
+public:
+    void mapPoints(float* x, float* y, size_t count) const override;
+
+protected:
+    uint64_t prepareMap(int width, int height, const float* parameters) override;
+
+private:
+    int _mode = 0;
+    float _width = 0.0f;
+    float _height = 0.0f;
+    float _rotation = 0.0f;     // Radians
+    float _radius = 0.0f;       // Half diagonal over Zoom
+};
+
+/**
+ * @brief Repeat the frame in a grid of smaller copies
+ *
+ * With Mirror on, every other copy is reflected so neighbours meet at
+ * matching edges.
+ * Parameters: Tiles X, Tiles Y (1..16), Mirror (0 off, 1 on).
+ */
+class TileEffect : public RemapEffect {
+public:
+    void mapPoints(float* x, float* y, size_t count) const override;
+
+protected:
+    uint64_t prepareMap(int width, int height, const float* parameters) override;
+
+private:
+    float _width = 0.0f;
+    float _height = 0.0f;
+    float _tilesX = 1.0f;
+    float _tilesY = 1.0f;
+    bool _mirror = false;
+};
+
+/**
+ * @brief Ripple the frame with a sine displacement along both axes
+ *
+ * Rows shift sideways with a wave running down the frame and columns shift
+ * vertically with one running across it. Amount 1 displaces by 5% of the
+ * shorter side; sweeping Phase animates the waves.
+ * Parameters: Amount (0..1), Frequency (waves per frame), Phase (degrees).
+ */
+class WarpEffect : public RemapEffect {
+public:
+    void mapPoints(float* x, float* y, size_t count) const override;
+
+protected:
+    uint64_t prepareMap(int width, int height, const float* parameters) override;
+
+private:
+    float _amplitude = 0.0f;    // Pixels
+    float _waveX = 0.0f;        // Radians per pixel across
+    float _waveY = 0.0f;        // Radians per pixel down
+    float _phase = 0.0f;        // Radians
+};
+
+} // namespace effects
+} // namespace gamma
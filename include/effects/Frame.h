@@ -0,0 +1,132 @@
+#pragma once
+
+#include "effects/PixelFormat.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace gamma {
+namespace effects {
+
+/**
+ * @brief Image buffer processed by the effect engine
+ *
+ * RGBA8 by default: pixels are packed 32-bit words with red in the lowest
+ * byte. The engine can keep its intermediate results in a float format
+ * instead (see PixelFormat), four halves or floats per pixel. Rows start on
+ * 64-byte boundaries and the stride is padded to a whole number of cache
+ * lines, so SIMD kernels can stream rows without split loads. Storage comes
+ * from the shared FramePool (see getFramePool) and goes back to it.
+ */
+class Frame {
+public:
+    Frame();
+    Frame(int width, int height, PixelFormat format = PixelFormat::RGBA8);
+    ~Frame();
+
+    Frame(Frame&& other) noexcept;
+    Frame& operator=(Frame&& other) noexcept;
+    Frame(const Frame&) = delete;
+    Frame& operator=(const Frame&) = delete;
+
+    /**
+     * @brief Change dimensions; contents are undefined afterwards
+     *
+     * Storage is only reallocated when the new size needs more memory.
+     */
+    void resize(int width, int height);
+
+    /**
+     * @brief Change dimensions and pixel format; contents are undefined afterwards
+     */
+    void resize(int width, int height, PixelFormat format);
+
+    /**
+     * @brief Copy pixels from a frame, resizing this one to match (format included)
+     */
+    void copyFrom(const Frame& other);
+
+    int getWidth() const { return _width; }
+    int getHeight() const { return _height; }
+    bool empty() const { return _width == 0 || _height == 0; }
+
+    PixelFormat getFormat() const { return _format; }
+    size_t getPixelBytes() const { return effects::getPixelBytes(_format); }
+
+    /**
+     * @brief Distance between rows in pixels
+     */
+    size_t getStride() const { return _stride; }
+
+    /**
+     * @brief Bytes of pixel storage in use (stride times height)
+     */
+    size_t getByteSize() const { return _stride * static_cast<size_t>(_height) * getPixelBytes(); }
+
+    /**
+     * @brief Row of an RGBA8 frame
+     */
+    uint32_t* row(int y) { return reinterpret_cast<uint32_t*>(rowData(y)); }
+    const uint32_t* row(int y) const { return reinterpret_cast<const uint32_t*>(rowData(y)); }
+
+    /**
+     * @brief Row of an RGBA16F frame: four halves per pixel
+     */
+    uint16_t* rowHalf(int y) { return reinterpret_cast<uint16_t*>(rowData(y)); }
+    const uint16_t* rowHalf(int y) const { return reinterpret_cast<const uint16_t*>(rowData(y)); }
+
+    /**
+     * @brief Row of an RGBA32F frame: four floats per pixel
+     */
+    float* rowFloat(int y) { return reinterpret_cast<float*>(rowData(y)); }
+    const float* rowFloat(int y) const { return reinterpret_cast<const float*>(rowData(y)); }
+
+    void* rowData(int y) { return _bytes + static_cast<size_t>(y) * _stride * getPixelBytes(); }
+    const void* rowData(int y) const { return _bytes + static_cast<size_t>(y) * _stride * getPixelBytes(); }
+
+    /**
+     * @brief Pixels of an RGBA8 frame
+     */
+    uint32_t* data() { return reinterpret_cast<uint32_t*>(_bytes); }
+    const uint32_t* data() const { return reinterpret_cast<const uint32_t*>(_bytes); }
+
+    /**
+     * @brief Identity of the current contents (0 = unknown)
+     *
+     * Whoever fills a frame stamps it: equal non-zero ids mean equal pixels,
+     * which lets the effect engine reuse results for a frame it has already
+     * processed (a paused clip). Writers that do not track identity set 0.
+     * copyFrom() copies the id; a resize to other dimensions or another
+     * format clears it.
+     */
+    uint64_t getContentId() const { return _contentId; }
+    void setContentId(uint64_t id) { _contentId = id; }
+
+private:
+    void release();
+
+    uint8_t* _bytes;
+    int _width;
+    int _height;
+    size_t _stride;
+    size_t _capacity;      // Bytes of the buffer (its FramePool size class)
+    uint64_t _contentId;
+    PixelFormat _format;
+};
+
+/**
+ * @brief New content id, distinct from every id returned before
+ *
+ * Ids handed out stay below 2^63; sources deriving ids from their own state
+ * (see renderTestPattern) use the upper half.
+ */
+uint64_t makeContentId();
+
+/**
+ * @brief Pack 8-bit channels into a pixel word
+ */
+inline uint32_t packPixel(uint32_t r, uint32_t g, uint32_t b, uint32_t a = 255) {
+    return r | (g << 8) | (b << 16) | (a << 24);
+}
+
+} // namespace effects
+} // namespace gamma
@@ -0,0 +1,179 @@
+#pragma once
+
+#include "effects/Frame.h"
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace gamma {
+namespace effects {
+
+class HistoryTrack;
+
+/**
+ * @brief Pool of past frames shared by the temporal effects of one engine
+ *
+ * Every temporal effect records into its own track (see HistoryTrack): a
+ * time-ordered list of frames. All tracks draw their buffers from one pool,
+ * so a frame a track no longer needs goes to the next recording of any track
+ * instead of back to the heap, and steady-state frames allocate nothing.
+ *
+ * A track declares how far back it reads (its span). When it records, frames
+ * older than the one a lookup at the full span returns are recycled. The pool
+ * grows to what the spans need, within a byte budget: if a span needs more
+ * frames than a track's share of the budget, the track records at an interval
+ * instead of every frame.
+ *
+ * Frames are handed out by pointer, never copied. Only used from the thread
+ * running EffectEngine::process(); the frames themselves are written and read
+ * by band tasks, which the engine orders.
+ */
+class FrameHistory {
+public:
+    static constexpr size_t DEFAULT_BUDGET_BYTES = 512u * 1024 * 1024;
+
+    explicit FrameHistory(size_t budgetBytes = DEFAULT_BUDGET_BYTES);
+    ~FrameHistory();
+
+    FrameHistory(const FrameHistory&) = delete;
+    FrameHistory& operator=(const FrameHistory&) = delete;
+
+    /**
+     * @brief Start a frame; called by the engine before any effect is prepared
+     * @param format Pixel format of recorded frames (the engine's intermediate format)
+     *
+     * A new frame size or format, or a clock that went backwards, drops every
+     * recorded frame.
+     */
+    void beginFrame(int width, int height, double time, PixelFormat format = PixelFormat::RGBA8);
+
+    /**
+     * @brief Memory the pool may hold, in bytes (takes effect on later recordings)
+     */
+    void setBudgetBytes(size_t budgetBytes) { _budgetBytes = budgetBytes; }
+    size_t getBudgetBytes() const { return _budgetBytes; }
+
+    /**
+     * @brief Frames currently allocated, recorded or free
+     */
+    size_t getFrameCount() const { return _frameCount; }
+
+    /**
+     * @brief Bytes held by allocated frames
+     */
+    size_t getAllocatedBytes() const { return _frameCount * _frameBytes; }
+
+    /**
+     * @brief Tracks currently in use
+     */
+    size_t getTrackCount() const { return _activeTracks; }
+
+private:
+    friend class HistoryTrack;
+
+    // Fewest frames a track is given however small its budget share
+    static constexpr size_t MIN_TRACK_FRAMES = 4;
+
+    struct Entry {
+        std::unique_ptr<Frame> frame;
+        double time;
+    };
+
+    struct Track {
+        bool active = false;
+        double span = 0.0;
+        std::vector<Entry> entries;         // Oldest first
+        const Frame* readFrame = nullptr;   // Handed out this frame: never recycled before the next
+    };
+
+    int createTrack();
+    void releaseTrack(int track);
+    void clearTrack(int track);
+    void setSpan(int track, double seconds);
+    bool isRecordDue(int track) const;
+    const Frame* findByAge(int track, double age);
+    Frame* record(int track);
+
+    void recycle(Entry& entry);
+    double getNeededFrames(const Track& track) const;
+    double getTrackShare() const;
+
+    std::vector<Track> _tracks;
+    std::vector<std::unique_ptr<Frame>> _freeFrames;
+    size_t _activeTracks;
+    size_t _frameCount;
+    size_t _frameBytes;
+    size_t _budgetBytes;
+
+    int _width;
+    int _height;
+    PixelFormat _format;
+    double _time;
+    double _frameInterval;      // Smoothed seconds between frames
+    bool _hasFrame;
+};
+
+/**
+ * @brief A temporal effect's track in the engine's FrameHistory
+ *
+ * Bound on first use from EffectContext::history and released when the
+ * effect is destroyed. All calls belong in prepare().
+ */
+class HistoryTrack {
+public:
+    HistoryTrack() = default;
+    ~HistoryTrack();
+
+    HistoryTrack(const HistoryTrack&) = delete;
+    HistoryTrack& operator=(const HistoryTrack&) = delete;
+
+    /**
+     * @brief Attach to a history, moving to it if it changed
+     * @return false if history is null (the effect should pass through)
+     */
+    bool bind(FrameHistory* history);
+
+    /**
+     * @brief Drop recorded frames (keeps the track)
+     */
+    void clear();
+
+    /**
+     * @brief Oldest age in seconds that findByAge() will be asked for
+     */
+    void setSpan(double seconds);
+
+    /**
+     * @brief True if the track is empty or the record interval has passed
+     */
+    bool isRecordDue() const;
+
+    /**
+     * @brief Newest frame at least age seconds old, else the oldest one recorded
+     * @return nullptr if nothing is recorded; valid until the next frame
+     */
+    const Frame* findByAge(double age);
+
+    /**
+     * @brief Newest recorded frame (nullptr if none)
+     */
+    const Frame* getNewest() { return findByAge(0.0); }
+
+    /**
+     * @brief Buffer to record the current frame into, stamped with the frame time
+     *
+     * Contents are undefined until written. Never a frame handed out by
+     * findByAge() this frame.
+     * @return nullptr if the budget is exhausted and nothing can be recycled
+     */
+    Frame* record();
+
+private:
+    void release();
+
+    FrameHistory* _history = nullptr;
+    int _track = -1;
+};
+
+} // namespace effects
+} // namespace gamma
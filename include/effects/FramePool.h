@@ -0,0 +1,159 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace gamma {
+namespace effects {
+
+/**
+ * @brief How the pool backs buffers of at least HUGE_PAGE_BYTES
+ *
+ * Transparent maps them 2 MB-aligned and asks the kernel to use huge pages
+ * (Linux madvise); Explicit takes them from the reserved huge page pool
+ * (Linux MAP_HUGETLB, Windows large pages). Where a mode is unavailable the
+ * pool warns once and uses the next one down, so the setting is always safe.
+ */
+enum class HugePageMode {
+    Off = 0,
+    Transparent,
+    Explicit
+};
+
+const char* getHugePageModeName(HugePageMode mode);
+
+/**
+ * @brief Look up a mode by name ("off", "transparent", "explicit")
+ * @return false if no mode has that name
+ */
+bool findHugePageMode(const char* name, HugePageMode& mode);
+
+/**
+ * @brief Counters of a FramePool; bytes are size-class bytes
+ */
+struct FramePoolStats {
+    size_t liveBuffers = 0;         // Handed out and not yet released
+    size_t liveBytes = 0;
+    size_t peakLiveBytes = 0;
+    size_t pooledBuffers = 0;       // Released and kept for reuse
+    size_t pooledBytes = 0;
+    size_t hugePageBytes = 0;       // Live and pooled bytes backed by huge pages
+    uint64_t systemAllocations = 0; // Buffers taken from the OS
+    uint64_t reuses = 0;            // Requests served from the pool
+    uint64_t overBudget = 0;        // Requests that had to exceed the budget
+};
+
+/**
+ * @brief Allocator of pixel storage shared by every Frame
+ *
+ * A 4K frame is tens of megabytes; allocating one on every resize fragments
+ * the heap, and the first write to fresh memory faults in every page of it
+ * while an effect is running. The pool rounds requests up to size classes
+ * (quarter steps between powers of two, so at most a quarter is wasted) and
+ * keeps released buffers per class, so frames that come and go - history,
+ * scratch, thumbnails after a chain edit - reuse memory that is already
+ * mapped. Buffers are 64-byte aligned; large ones can be backed by huge pages
+ * to cut TLB misses, and are prefaulted when the pool grows so the faults
+ * happen at allocation instead of mid-frame.
+ *
+ * The budget bounds live plus pooled bytes. Pooled buffers are freed to make
+ * room; a request that still does not fit is served anyway (a frame cannot
+ * fail) and counted in FramePoolStats::overBudget. Thread-safe; requests are
+ * rare, as frames keep their storage while their size does not grow.
+ */
+class FramePool {
+public:
+    static constexpr size_t ALIGNMENT = 64;
+    static constexpr size_t HUGE_PAGE_BYTES = 2u * 1024 * 1024;
+    static constexpr size_t DEFAULT_BUDGET_BYTES = 4ull * 1024 * 1024 * 1024;
+
+    FramePool();
+    ~FramePool();
+
+    FramePool(const FramePool&) = delete;
+    FramePool& operator=(const FramePool&) = delete;
+
+    /**
+     * @brief Get a buffer of at least bytes
+     * @param capacity Receives the usable size (the size class)
+     * @return 64-byte-aligned storage; contents are undefined
+     */
+    void* acquire(size_t bytes, size_t& capacity);
+
+    /**
+     * @brief Return a buffer from acquire(); it is pooled or freed
+     */
+    void release(void* buffer);
+
+    /**
+     * @brief Free every pooled buffer
+     */
+    void trim();
+
+    /**
+     * @brief Backing for buffers taken from the OS from now on
+     */
+    void setHugePageMode(HugePageMode mode);
+    HugePageMode getHugePageMode() const;
+
+    /**
+     * @brief Touch every page of a buffer taken from the OS (on by default)
+     */
+    void setPrefault(bool prefault);
+    bool getPrefault() const;
+
+    /**
+     * @brief Bytes the pool may hold, live and pooled; frees pooled buffers above it
+     */
+    void setBudgetBytes(size_t budgetBytes);
+    size_t getBudgetBytes() const;
+
+    FramePoolStats getStats() const;
+
+    /**
+     * @brief Size class a request of bytes is rounded up to
+     */
+    static size_t getClassBytes(size_t bytes);
+
+private:
+    enum class Backing : uint8_t {
+        Heap,
+        Mapped,         // Transparent huge pages
+        HugeTlb         // Explicit huge pages
+    };
+
+    struct Block {
+        size_t classBytes;
+        size_t classIndex;
+        size_t mappedBytes;     // Length given to the OS (mapped backings)
+        Backing backing;
+        bool huge;              // Counted in hugePageBytes
+    };
+
+    void* allocateBlock(size_t classBytes, Block& block);
+    void freeBlock(void* buffer, const Block& block);
+    bool evictPooled(size_t neededBytes);
+    void freePooledLocked();
+
+    mutable std::mutex _mutex;
+    std::unordered_map<void*, Block> _blocks;       // Live and pooled
+    std::vector<std::vector<void*>> _pooled;        // Per class index
+    FramePoolStats _stats;
+    size_t _budgetBytes;
+    HugePageMode _hugePageMode;
+    bool _prefault;
+    bool _warnedBudget;
+    bool _warnedHugePages;
+};
+
+/**
+ * @brief Pool used by Frame; never destroyed, so frames in static storage
+ * can release into it at exit
+ */
+FramePool& getFramePool();
+
+} // namespace effects
+} // namespace gamma
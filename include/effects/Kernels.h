@@ -0,0 +1,217 @@
+#pragma once
+
+#include "effects/PixelFormat.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace gamma {
+namespace effects {
+
+/**
+ * @brief Instruction sets the pixel kernels are built for
+ */
+enum class SimdLevel {
+    Scalar = 0,
+    SSE2,
+    AVX2
+};
+
+/**
+ * @brief Affine color transform in 0..255 units: out = m[c][0..2] * rgb + m[c][3]
+ */
+struct ColorMatrix {
+    float m[3][4];
+};
+
+/**
+ * @brief View of a 3D color LUT for the kernels (see ColorLut)
+ *
+ * entries holds size^3 RGBA float entries with red varying fastest: entry
+ * (r, g, b) starts at ((b * size + g) * size + r) * 4. Entries and inputs are
+ * in float pixel units (1.0 = 255); an input channel x maps to the grid
+ * coordinate clamp(x * scale + offset, 0, size - 1).
+ */
+struct LutGrid {
+    const float* entries;
+    int size;               // 2..ColorLut::MAX_SIZE
+    float scale[3];
+    float offset[3];
+};
+
+/**
+ * @brief Frame a remap kernel samples (see KernelTable::remap)
+ */
+struct RemapSource {
+    const void* pixels;     // Row 0
+    size_t stride;          // Pixels between rows
+    int width;
+    int height;
+    PixelFormat format;
+};
+
+/**
+ * @brief Most taps a specialized box filter takes (see KernelTable::boxFilter)
+ */
+constexpr int MAX_BOX_FILTER_TAPS = 32;     // 32 * 255 still fits 16-bit sums
+
+/**
+ * @brief Box filter over a fixed number of source spans
+ */
+using BoxFilterFunction = void (*)(const uint32_t* const* sources, uint32_t* dst, size_t count, uint32_t scale);
+
+/**
+ * @brief Row kernels shared by the effects
+ *
+ * The integer kernels work on spans of packed RGBA8 pixels (see Frame), the
+ * float ones on the intermediate formats; none makes alignment assumptions. Effects look the table up once per frame through
+ * getKernels(), so the instruction set is chosen at runtime: the AVX2 variants
+ * live in their own translation unit compiled with AVX2 and F16C enabled, and
+ * are only selected on CPUs that report both.
+ */
+struct KernelTable {
+    SimdLevel level;
+
+    /**
+     * @brief dst = clamp(matrix * src.rgb), alpha copied
+     */
+    void (*colorMatrix)(const uint32_t* src, uint32_t* dst, size_t count, const ColorMatrix& matrix);
+
+    /**
+     * @brief dst = red channel of red[i], green/alpha of green[i], blue of blue[i]
+     */
+    void (*mergeChannels)(const uint32_t* red, const uint32_t* green, const uint32_t* blue,
+                          uint32_t* dst, size_t count);
+
+    /**
+     * @brief dst[i] = src[count - 1 - i]
+     */
+    void (*reverseCopy)(const uint32_t* src, uint32_t* dst, size_t count);
+
+    /**
+     * @brief Add each channel into 16-bit accumulators (4 per pixel)
+     */
+    void (*accumulate)(const uint32_t* src, uint16_t* accumulators, size_t count);
+
+    /**
+     * @brief dst = (accumulators * scale) >> 16 per channel
+     * @param scale Fixed-point reciprocal of the sample count, at most 32768
+     */
+    void (*resolve)(const uint16_t* accumulators, uint32_t* dst, size_t count, uint32_t scale);
+
+    /**
+     * @brief dst = (a * (256 - weight) + b * weight) >> 8 per channel
+     * @param weight Blend weight, 0..256
+     *
+     * dst may be a or b (the engine blends a pass's output in place).
+     */
+    void (*blend)(const uint32_t* a, const uint32_t* b, uint32_t* dst, size_t count, uint32_t weight);
+
+    // Float pixels (see PixelFormat): four floats per pixel, 1.0 = 255.
+    // Counts are in pixels.
+
+    /**
+     * @brief dst = src / 255 per channel
+     */
+    void (*unpackPixels)(const uint32_t* src, float* dst, size_t count);
+
+    /**
+     * @brief dst = clamp(src * 255) per channel, rounded half up
+     */
+    void (*packPixels)(const float* src, uint32_t* dst, size_t count);
+
+    /**
+     * @brief Half floats (RGBA16F) to floats
+     */
+    void (*halfToFloat)(const uint16_t* src, float* dst, size_t count);
+
+    /**
+     * @brief Floats to half floats, rounded to nearest even
+     */
+    void (*floatToHalf)(const float* src, uint16_t* dst, size_t count);
+
+    /**
+     * @brief colorMatrix() on float pixels, not clamped (offsets stay in 0..255 units)
+     */
+    void (*colorMatrixFloat)(const float* src, float* dst, size_t count, const ColorMatrix& matrix);
+
+    /**
+     * @brief dst = a + (b - a) * weight; dst may be a or b
+     */
+    void (*blendFloat)(const float* a, const float* b, float* dst, size_t count, float weight);
+
+    /**
+     * @brief dst = (sum of sources[t][i] over taps) * scale, with the sums kept in registers
+     * @param taps 1..MAX_BOX_FILTER_TAPS
+     */
+    void (*boxFilterFloat)(const float* const* sources, int taps, float* dst, size_t count, float scale);
+
+    /**
+     * @brief dst.rgb = lut(src.rgb) by tetrahedral interpolation, rounded half up; alpha copied
+     */
+    void (*applyLut)(const uint32_t* src, uint32_t* dst, size_t count, const LutGrid& lut);
+
+    /**
+     * @brief applyLut() on float pixels, not clamped beyond the grid's own range
+     */
+    void (*applyLutFloat)(const float* src, float* dst, size_t count, const LutGrid& lut);
+
+    /**
+     * @brief dst[i] = source bilinearly sampled at (x[i], y[i]), rounded half up
+     *
+     * Positions are in pixels, with the center of pixel (x, y) at
+     * (x + 0.5, y + 0.5); beyond the frame the edge pixels extend. RGBA8 sources only.
+     */
+    void (*remap)(const RemapSource& source, const float* x, const float* y, uint32_t* dst, size_t count);
+
+    /**
+     * @brief remap() into float pixels, from a source of any format
+     */
+    void (*remapFloat)(const RemapSource& source, const float* x, const float* y, float* dst, size_t count);
+
+    /**
+     * @brief dst = (sum of sources[t][i] over all taps * scale) >> 16 per channel
+     *
+     * Indexed by tap count, 2..MAX_BOX_FILTER_TAPS (lower entries are null).
+     * Each entry is instantiated for its count, so the tap loop is unrolled
+     * and the sums stay in registers. Gives the same result as accumulate()
+     * over every source followed by resolve().
+     */
+    BoxFilterFunction boxFilter[MAX_BOX_FILTER_TAPS + 1];
+};
+
+/**
+ * @brief Table for the active instruction set
+ */
+const KernelTable& getKernels();
+
+/**
+ * @brief Best instruction set both compiled in and supported by this CPU
+ */
+SimdLevel getSupportedSimdLevel();
+
+/**
+ * @brief Select the kernels used from now on (benchmarks compare levels)
+ * @return Level actually applied, capped at getSupportedSimdLevel()
+ */
+SimdLevel setSimdLevel(SimdLevel level);
+
+const char* getSimdLevelName(SimdLevel level);
+
+/**
+ * @brief Let effects pick kernels specialized for their current parameters
+ *
+ * On by default. Effects check it in prepare(); turning it off makes them use
+ * their generic paths, which benchmarks compare against.
+ */
+void setKernelSpecialization(bool enabled);
+
+bool isKernelSpecializationEnabled();
+
+// Per-instruction-set tables, each defined in its own translation unit.
+// Return nullptr when that variant is not compiled in.
+const KernelTable* getScalarKernels();
+const KernelTable* getSse2Kernels();
+const KernelTable* getAvx2Kernels();
+
+} // namespace effects
+} // namespace gamma
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "effects/EffectEngine.h"
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace gamma {
+namespace effects {
+
+/**
+ * @brief One frame's chain description as published by the UI
+ */
+struct ChainParameters {
+    std::vector<ChainSlot> slots;
+    float masterMix = 1.0f;
+    uint64_t sequence = 0;      // Increments with every publish
+};
+
+/**
+ * @brief Lock-free hand-off of chain parameters from the UI to the engine
+ *
+ * The UI edits its own copy of every value and publishes a complete snapshot
+ * once per frame; the engine picks up the newest snapshot when it starts a
+ * frame. Neither side ever sees the other's half-written state and neither
+ * ever blocks: besides the front (engine) and back (UI) buffers there is a
+ * spare, swapped with an atomic exchange, so a publish never has to wait for
+ * the engine to finish reading. Buffers keep their capacity, so steady-state
+ * publishing does not allocate.
+ *
+ * One producer thread and one consumer thread.
+ */
+class ParameterBlock {
+public:
+    ParameterBlock();
+
+    ParameterBlock(const ParameterBlock&) = delete;
+    ParameterBlock& operator=(const ParameterBlock&) = delete;
+
+    /**
+     * @brief Producer: buffer to fill for the next publish (contents are stale)
+     */
+    ChainParameters& beginWrite() { return _buffers[_back]; }
+
+    /**
+     * @brief Producer: make the buffer from beginWrite() the newest snapshot
+     */
+    void publish();
+
+    /**
+     * @brief Consumer: newest published snapshot
+     *
+     * Stays valid and unchanged until the next acquire(). Returns the previous
+     * snapshot again if nothing new was published.
+     */
+    const ChainParameters& acquire();
+
+private:
+    static constexpr uint8_t INDEX_MASK = 0x3;
+    static constexpr uint8_t FRESH = 0x4;   // Set on _spare when it holds an unread snapshot
+
+    ChainParameters _buffers[3];
+    uint8_t _back;                  // Producer only
+    uint8_t _front;                 // Consumer only
+    std::atomic<uint8_t> _spare;
+    uint64_t _sequence;             // Producer only
+};
+
+} // namespace effects
+} // namespace gamma
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace gamma {
+namespace effects {
+
+/**
+ * @brief Storage of a frame's pixels
+ *
+ * RGBA8 packs 8-bit channels into a 32-bit word (red lowest), as sources and
+ * displays use. The float formats hold four channels scaled so 1.0 is 255 in
+ * RGBA8; values are not clamped between effects, so a contrast cut followed
+ * by a boost keeps its gradations. RGBA16F stores IEEE half floats (11
+ * significant bits), RGBA32F single floats.
+ */
+enum class PixelFormat {
+    RGBA8 = 0,
+    RGBA16F,
+    RGBA32F,
+    Count
+};
+
+inline size_t getPixelBytes(PixelFormat format) {
+    switch (format) {
+        case PixelFormat::RGBA16F: return 8;
+        case PixelFormat::RGBA32F: return 16;
+        default: return 4;
+    }
+}
+
+const char* getPixelFormatName(PixelFormat format);
+
+/**
+ * @brief Look up a format by name ("RGBA8", "RGBA16F", "RGBA32F", case-insensitive)
+ * @return false if no format has that name
+ */
+bool findPixelFormat(const std::string& name, PixelFormat& format);
+
+} // namespace effects
+} // namespace gamma
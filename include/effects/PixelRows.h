@@ -0,0 +1,53 @@
+#pragma once
+
+#include "effects/Frame.h"
+#include <cstddef>
+
+namespace gamma {
+namespace effects {
+
+// Float access to rows of any format, for effects running on float pixels
+// (see EffectProcessor::usesFloatPixels). Pixels are four floats, 1.0 = 255;
+// RGBA8 and RGBA16F rows are converted with the active kernels, RGBA32F rows
+// are used in place where possible.
+
+/**
+ * @brief Thread-local float buffer of at least count pixels
+ * @param index Which of the thread's buffers, 0..ROW_BUFFER_COUNT - 1: 0 and
+ *              1 belong to whoever calls processRowFloat(), 2 and 3 to the
+ *              effect itself
+ */
+float* getRowBuffer(int index, size_t count);
+
+constexpr int ROW_BUFFER_COUNT = 4;
+
+/**
+ * @brief Convert count pixels of a row, starting at x, into dst
+ */
+void readPixels(const Frame& frame, int x, int y, size_t count, float* dst);
+
+/**
+ * @brief Float view of count pixels of a row, starting at x
+ * @param scratch Space for count pixels, used unless the frame is RGBA32F
+ */
+const float* loadPixels(const Frame& frame, int x, int y, size_t count, float* scratch);
+
+/**
+ * @brief Where to build pixels bound for (x, y): the frame itself if it is RGBA32F, else scratch
+ */
+float* getStoreTarget(Frame& frame, int x, int y, float* scratch);
+
+/**
+ * @brief Write count float pixels into a row at x, converting to the frame's format
+ *
+ * Nothing happens when src is already that spot (see getStoreTarget).
+ */
+void writePixels(const float* src, Frame& frame, int x, int y, size_t count);
+
+/**
+ * @brief Copy a whole row between frames of any formats (a plain copy when they match)
+ */
+void copyRow(const Frame& source, int sourceY, Frame& destination, int y);
+
+} // namespace effects
+} // namespace gamma
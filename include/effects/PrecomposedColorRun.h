@@ -0,0 +1,56 @@
+#pragma once
+
+#include "effects/ColorLut.h"
+#include "effects/EffectProcessor.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace gamma {
+namespace effects {
+
+/**
+ * @brief A run of color transforms baked into one 3D LUT while it holds still
+ *
+ * Followed frame by frame through the run's key: once the key has held for
+ * STABLE_FRAMES frames the run is baked, and the table is reused for as long
+ * as the key stays the same. Each row of the grid (red varying) goes through
+ * the run as a row of float pixels, clamped between effects to match the
+ * 8-bit frames of the direct path.
+ */
+class PrecomposedColorRun {
+public:
+    // Grid of the baked table: entries of a 33^3 table fit in L2
+    static constexpr int LUT_SIZE = 33;
+    // Frames a run must hold still before it is baked
+    static constexpr int STABLE_FRAMES = 2;
+
+    /**
+     * @brief Add one effect of a run to the run's key (start from KEY_SEED)
+     */
+    static uint64_t addToKey(uint64_t key, EffectType type, const PointwiseEffect& effect, const float* values);
+
+    /**
+     * @brief Follow the run this frame
+     * @param key The run's key, from addToKey() over its effects in order
+     * @param effects The run's color transforms, in order
+     * @return The baked table, or nullptr while the run is still changing
+     */
+    const ColorLut* update(uint64_t key, PointwiseEffect* const* effects, size_t count);
+
+    /**
+     * @brief Forget the run and release its table
+     */
+    void reset();
+
+private:
+    static void bake(PointwiseEffect* const* effects, size_t count, ColorLut& lut);
+
+    uint64_t _key = 0;              // Run's key last frame
+    int _stableFrames = 0;          // Frames it has had that key
+    std::unique_ptr<ColorLut> _lut;
+    uint64_t _lutKey = 0;           // Key _lut was baked for
+};
+
+} // namespace effects
+} // namespace gamma
@@ -0,0 +1,138 @@
+#pragma once
+
+#include "effects/Frame.h"
+#include "core/JobSystem.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace gamma {
+namespace effects {
+
+/**
+ * @brief Maps output positions to the input positions they sample, in place
+ *
+ * Positions are in pixels with the center of pixel (x, y) at (x + 0.5, y + 0.5),
+ * as KernelTable::remap takes them.
+ */
+using RemapFunction = std::function<void(float* x, float* y, size_t count)>;
+
+/**
+ * @brief Sparse coordinate grid of a geometric map, built once per set of parameters
+ *
+ * The map is evaluated at the pixel centers of a grid every SPACING pixels
+ * and interpolated bilinearly between them, so generating a frame's
+ * coordinates costs a few multiply-adds per pixel instead of the map's own
+ * math (trigonometry, divisions). Cells where interpolation strays more than
+ * TOLERANCE pixels from the map at any of a set of check points are stored
+ * dense instead, a position per pixel: interpolated from nodes every
+ * REFINED_SPACING pixels where the map is smooth but bends too much (a strong
+ * warp), evaluated exactly where even those do not fit (a seam where a
+ * kaleidoscope or tiling folds, a polar singularity).
+ */
+class RemapGrid {
+public:
+    static constexpr int SPACING = 16;
+    static constexpr int REFINED_SPACING = 4;
+    static constexpr float TOLERANCE = 0.25f;
+
+    /**
+     * @brief Evaluate map for a width x height output
+     * @param jobSystem Workers to split the map's batches and the per-cell
+     *        checks across (nullptr = calling thread only); map must then be
+     *        safe to call concurrently on disjoint points
+     */
+    void build(int width, int height, const RemapFunction& map, core::JobSystem* jobSystem = nullptr);
+
+    /**
+     * @brief Input positions of output row y (width of them each)
+     */
+    void getRow(int y, float* x, float* yOut) const;
+
+    int getWidth() const { return _width; }
+    int getHeight() const { return _height; }
+    size_t getCellCount() const { return _cellIndex.size(); }
+    size_t getDenseCellCount() const { return _denseCount; }
+
+    /**
+     * @brief Dense cells holding the map evaluated at every pixel
+     */
+    size_t getExactCellCount() const { return _exactCount; }
+
+    /**
+     * @brief Memory held by the nodes and dense cells
+     */
+    size_t getBytes() const;
+
+private:
+    int _width = 0;
+    int _height = 0;
+    int _columns = 0;               // Nodes per row, one past the last pixel
+    int _rows = 0;
+    std::vector<float> _nodeX;
+    std::vector<float> _nodeY;
+    std::vector<int32_t> _cellIndex;    // Per cell: dense cell index, -1 if interpolated
+    std::vector<float> _denseX;         // SPACING * SPACING positions per dense cell
+    std::vector<float> _denseY;
+    size_t _denseCount = 0;
+    size_t _exactCount = 0;
+};
+
+/**
+ * @brief The few most recent grids of one map, by key
+ *
+ * Parameters a knob sweeps back and forth, or a clip cutting between two
+ * settings, find their grid still built. Thread-safe.
+ */
+class RemapGridCache {
+public:
+    static constexpr size_t CAPACITY = 4;
+
+    /**
+     * @brief Grid for key (never 0), built with map if it is not cached
+     *
+     * The grid is held by the caller for as long as it samples it, so it
+     * survives being evicted meanwhile. The build runs outside the cache's
+     * lock (see RemapGrid::build for jobSystem).
+     */
+    std::shared_ptr<const RemapGrid> get(uint64_t key, int width, int height, const RemapFunction& map,
+                                         core::JobSystem* jobSystem = nullptr);
+
+    /**
+     * @brief Grid for key if it is cached, null otherwise
+     */
+    std::shared_ptr<const RemapGrid> find(uint64_t key, int width, int height);
+
+    void clear();
+
+    /**
+     * @brief Grids built since the cache was created
+     */
+    uint64_t getBuildCount() const { return _builds; }
+
+private:
+    struct Entry {
+        uint64_t key;
+        std::shared_ptr<const RemapGrid> grid;
+    };
+
+    std::shared_ptr<const RemapGrid> findLocked(uint64_t key, int width, int height);
+
+    std::mutex _mutex;
+    std::vector<Entry> _entries;    // Most recently used first
+    uint64_t _builds = 0;
+};
+
+/**
+ * @brief Sample rows [yBegin, yEnd) of output from input at the grid's positions
+ * @param grid Null for the identity: rows are copied
+ * @param floatPixels Use the float kernel and PixelRows conversions (see
+ *        EffectProcessor::usesFloatPixels); otherwise both frames are RGBA8
+ */
+void remapRows(const RemapGrid* grid, const Frame& input, Frame& output, int yBegin, int yEnd, bool floatPixels);
+
+} // namespace effects
+} // namespace gamma
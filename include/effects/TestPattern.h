@@ -0,0 +1,21 @@
+#pragma once
+
+#include "effects/Frame.h"
+
+namespace gamma {
+namespace effects {
+
+/**
+ * @brief Fill a frame with animated color bars
+ *
+ * Stands in for a video source until clips can be decoded: color bars over a
+ * gray ramp, with a white bar sweeping across so temporal effects have motion
+ * to work with. Cost is about one row fill plus a memcpy per row. The frame's
+ * content id only changes when the pattern does (see Frame::getContentId).
+ * @param frame Destination, already sized
+ * @param time Seconds; the sweep takes four seconds per pass
+ */
+void renderTestPattern(Frame& frame, double time);
+
+} // namespace effects
+} // namespace gamma
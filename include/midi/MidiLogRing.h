@@ -0,0 +1,101 @@
+#pragma once
+
+#include "midi/MidiManager.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace gamma {
+namespace midi {
+
+/**
+ * @brief Fixed-capacity ring of formatted MIDI log lines, indexed by message type
+ *
+ * Each message is formatted a single time on append. Text that does not fit
+ * an entry's inline buffer (long SysEx dumps) is kept whole in a heap string
+ * owned by the entry, reused when the slot is overwritten. Each message type
+ * keeps its own index ring, so filtering is a lookup rather than a scan.
+ * Needs no MIDI backend or UI, so it is part of the core library.
+ */
+class MidiLogRing {
+public:
+    enum MessageType {
+        TYPE_NOTE = 0,
+        TYPE_CONTROL_CHANGE,
+        TYPE_PITCH_BEND,
+        TYPE_SYSTEM,
+        TYPE_OTHER,          // Status lines (connect/disconnect) and unknown messages
+        TYPE_COUNT
+    };
+
+    static const size_t TEXT_CAPACITY = 72;
+
+    struct Entry {
+        char text[TEXT_CAPACITY];   // "[timestamp] description", if it fits
+        uint32_t length = 0;        // Of the whole text; TEXT_CAPACITY or more: it is in overflow
+        uint8_t type = TYPE_OTHER;
+        std::unique_ptr<std::string> overflow;  // Longer text, kept for reuse once allocated
+
+        const char* getText() const { return length < TEXT_CAPACITY ? text : overflow->c_str(); }
+    };
+
+    /**
+     * @param capacity Number of entries kept before the oldest are overwritten
+     */
+    explicit MidiLogRing(size_t capacity = 128 * 1024);
+
+    /**
+     * @brief Format and store a message, overwriting the oldest entry when full
+     */
+    void append(const MidiMessage& message);
+
+    /**
+     * @brief Drop all entries, keeping their storage
+     */
+    void clear();
+
+    /**
+     * @brief Number of entries currently held
+     */
+    size_t size() const { return _entryCount; }
+
+    size_t getCapacity() const { return _capacity; }
+
+    /**
+     * @brief Number of entries held of one type (-1 = all types)
+     */
+    size_t getCount(int type) const { return type < 0 ? _entryCount : _typeIndex[type].count; }
+
+    /**
+     * @brief Entry by recency within one type (-1 = all types)
+     * @param fromNewest 0 is the newest entry; must be below getCount(type)
+     */
+    const Entry& getNewest(int type, size_t fromNewest) const;
+
+    static MessageType classify(const MidiMessage& message);
+
+private:
+    // Ring of entry sequence numbers, oldest first; grows on demand
+    struct IndexRing {
+        std::vector<uint64_t> slots;
+        size_t head = 0;
+        size_t count = 0;
+
+        void push(uint64_t sequence);
+        void popFront();
+        uint64_t at(size_t index) const { return slots[(head + index) % slots.size()]; }
+    };
+
+    const Entry& entryAt(uint64_t sequence) const { return _entries[sequence % _capacity]; }
+
+    size_t _capacity;
+    std::vector<Entry> _entries;    // Grows up to _capacity, then wraps
+    uint64_t _nextSequence;         // Sequence number of the next appended entry
+    size_t _entryCount;
+    IndexRing _typeIndex[TYPE_COUNT];
+};
+
+} // namespace midi
+} // namespace gamma
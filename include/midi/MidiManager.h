@@ -4,6 +4,7 @@
 #include <string>
 #include <vector>
 #include <functional>
+#include <cstdint>
 #include <deque>
 #include <mutex>
 
@@ -96,6 +97,22 @@ public:
      */
     std::vector<MidiMessage> getRecentMessages(size_t maxMessages = 50);
 
+    /**
+     * @brief Copy messages logged since a previous call
+     * @param sequence Value returned by the previous call (0 on the first call)
+     * @param out Receives the new messages (appended, oldest first)
+     * @return sequence number to pass on the next call
+     *
+     * Lets views keep their own history and only pick up new messages each
+     * frame. Messages already trimmed from the internal log are skipped.
+     */
+    uint64_t getMessagesSince(uint64_t sequence, std::vector<MidiMessage>& out);
+
+    /**
+     * @brief Number of times the log has been cleared (views compare this to drop their history)
+     */
+    uint64_t getLogClearCount();
+
     /**
      * @brief Clear the message log
      */
@@ -124,16 +141,33 @@ public:
      */
     bool exportToCSV(const std::string& filename = "");
 
+    /**
+     * @brief Feed a message through the same path as live device input
+     * @param message Raw MIDI bytes
+     * @param timestamp Delta time in seconds (as reported by RtMidi)
+     * 
+     * Used by MidiReplay to drive the MIDI pipeline without a controller.
+     */
+    void injectMessage(const std::vector<unsigned char>& message, double timestamp);
+
+    /**
+     * @brief Enable or disable echoing of incoming messages to stdout
+     */
+    void setConsoleEcho(bool enabled) { _consoleEcho = enabled; }
+
 private:
     std::unique_ptr<RtMidiIn> _midiIn;
     bool _isInitialized;
     bool _isConnected;
     std::string _connectedDeviceName;
     int _connectedDeviceIndex;
+    bool _consoleEcho;
 
     // Message logging
     std::deque<MidiMessage> _messageLog;
     std::mutex _messageLogMutex;
+    uint64_t _messagesLogged;      // Total messages ever appended (sequence of the next message)
+    uint64_t _logClearCount;
     static const size_t MAX_LOG_SIZE = 1000;
 
     // Callbacks
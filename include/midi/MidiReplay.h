@@ -0,0 +1,85 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <functional>
+#include <istream>
+
+namespace gamma {
+namespace midi {
+
+/**
+ * @brief Replays a MIDI log exported by MidiManager::exportToCSV
+ *
+ * Messages are handed back (usually to MidiManager::injectMessage) with the
+ * same relative timing they were recorded with, so the MIDI pipeline can be
+ * exercised without a controller attached (headless profiling, regression
+ * runs). Parsing and timing need no MIDI backend, so this builds without RtMidi.
+ */
+class MidiReplay {
+public:
+    /**
+     * @brief Receives a replayed message: raw bytes and the recorded delta time
+     */
+    using InjectFunction = std::function<void(const std::vector<unsigned char>& message, double timestamp)>;
+
+    MidiReplay();
+
+    /**
+     * @brief Load a CSV log file
+     * @param filename Path to a CSV file in the MidiManager export format
+     * @return true if at least one message was loaded
+     */
+    bool load(const std::string& filename);
+
+    /**
+     * @brief Read a log in the MidiManager export format from a stream
+     *
+     * Rows without a quoted byte field, and connection entries with no
+     * bytes, are skipped.
+     * @return true if at least one message was read
+     */
+    bool parse(std::istream& input);
+
+    /**
+     * @brief Inject all messages that are due at the given playback time
+     * @param elapsedSeconds Time since replay start in seconds
+     * @param inject Called once per message, in recorded order
+     * @return number of messages injected by this call
+     */
+    size_t advance(double elapsedSeconds, const InjectFunction& inject);
+
+    /**
+     * @brief Restart playback from the first message
+     */
+    void rewind() { _nextEvent = 0; }
+
+    /**
+     * @brief Check if all messages have been injected
+     */
+    bool isFinished() const { return _nextEvent >= _events.size(); }
+
+    /**
+     * @brief Get number of messages in the loaded log
+     */
+    size_t getMessageCount() const { return _events.size(); }
+
+    /**
+     * @brief Get total playback length in seconds
+     */
+    double getDuration() const { return _events.empty() ? 0.0 : _events.back().time; }
+
+private:
+    struct ReplayEvent {
+        double time;                     // Absolute playback time in seconds
+        double delta;                    // Recorded delta time (RtMidi timestamp)
+        std::vector<unsigned char> data; // Raw MIDI bytes
+    };
+
+    std::vector<ReplayEvent> _events;
+    size_t _nextEvent;
+};
+
+} // namespace midi
+} // namespace gamma
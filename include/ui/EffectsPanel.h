@@ -1,36 +1,46 @@
 #pragma once
 
 #include "WorkspacePanel.h"
+#include "effects/EffectChain.h"
+#include "effects/EffectEngine.h"
+#include "effects/ParameterBlock.h"
 #include <vector>
-#include <string>
-#include <map>
 
 namespace gamma {
 namespace ui {
 
-struct EffectParameter {
-    std::string name;
-    float value;
-    float minValue;
-    float maxValue;
-    float defaultValue;
-    bool isEnabled;
-};
-
-struct Effect {
-    std::string name;
-    std::string category;
-    bool isActive;
-    bool isBypassed;
-    std::vector<EffectParameter> parameters;
-};
-
 class EffectsPanel : public WorkspacePanel {
 public:
     EffectsPanel();
     
     void render() override;
     void update(float deltaTime) override;
+
+    /**
+     * @brief Engine whose timings drive the CPU meter and per-effect costs
+     */
+    void setEffectEngine(const gamma::effects::EffectEngine* engine) { _effectEngine = engine; }
+
+    /**
+     * @brief Describe the current chain for the effect engine
+     *
+     * Slots map one-to-one onto the chain list, including inactive and
+     * bypassed effects (marked disabled), so engine timings line up with rows.
+     */
+    void buildChain(std::vector<gamma::effects::ChainSlot>& chain) const;
+
+    /**
+     * @brief Publish the chain and master mix for the engine's next frame
+     *
+     * Called once per frame on the UI thread, after all edits; the engine
+     * only ever reads published snapshots, never the panel's own values.
+     */
+    void publishChain(gamma::effects::ParameterBlock& block) const;
+
+    /**
+     * @brief Master mix to process with (0 while Bypass All is on)
+     */
+    float getMasterMix() const { return _bypassAll ? 0.0f : _masterMix; }
     
 private:
     void renderEffectControls();
@@ -38,19 +48,18 @@ private:
     void renderEffectLibrary();
     void renderParameterControls();
     
-    // Effect management
-    std::vector<Effect> _activeEffects;
-    std::vector<Effect> _availableEffects;
+    // Effect management: live values only, names and ranges come from the descriptors
+    gamma::effects::EffectChain _chain;
     int _selectedEffect;
     
-    // Categories
-    std::vector<std::string> _categories;
-    std::string _selectedCategory;
+    // Library filter (-1 = all categories)
+    int _selectedCategory;
     
     // Performance
     bool _bypassAll;
     float _masterMix;
     float _cpuUsage;
+    const gamma::effects::EffectEngine* _effectEngine;
 };
 
 } // namespace ui
@@ -15,6 +15,14 @@ struct MediaItem {
     bool isLoaded;
 };
 
+/**
+ * @brief Media library and file browser
+ *
+ * Updates on change only (UpdatePolicy::OnChange): update() rebuilds the
+ * filtered library list, the loaded count and the browser's labels, and the
+ * edits that change them (search text, loading, removing, navigating) mark
+ * the panel dirty. render() draws what update() prepared.
+ */
 class ImportPanel : public WorkspacePanel {
 public:
     ImportPanel();
@@ -31,6 +39,7 @@ private:
     // Media library
     std::vector<MediaItem> _mediaItems;
     int _selectedItem;
+    char _searchBuffer[256];
     
     // File explorer
     std::string _currentPath;
@@ -40,6 +49,11 @@ private:
     bool _autoLoadMedia;
     bool _showPreview;
     float _previewVolume;
+    
+    // Prepared by update() for render()
+    std::vector<int> _visibleItems;             // Library items matching the search, in order
+    int _loadedCount;
+    std::vector<std::string> _directoryLabels;  // "[DIR] name" / "[FILE] name", per directory entry
 };
 
 } // namespace ui
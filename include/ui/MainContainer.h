@@ -1,14 +1,19 @@
 #pragma once
 
 #include "ui/WorkspacePanel.h"
+#include <cstdint>
+#include <vector>
 
 namespace gamma {
 namespace core { class Application; }
+namespace effects { class Frame; }
 }
 
 namespace gamma {
 namespace ui {
 
+class MidiViewModel;
+
 /**
  * @brief Main Container for the central workspace area
  * 
@@ -20,7 +25,7 @@ namespace ui {
 class MainContainer : public WorkspacePanel {
 public:
     MainContainer();
-    virtual ~MainContainer() = default;
+    virtual ~MainContainer();
 
     /**
      * @brief Set reference to the application for accessing subsystems
@@ -28,6 +33,11 @@ public:
      */
     void setApplication(gamma::core::Application* app);
 
+    /**
+     * @brief Set the shared MIDI state shown in the MIDI setup tab
+     */
+    void setMidiViewModel(MidiViewModel* viewModel);
+
     /**
      * @brief Render the main container UI
      * Shows video output, waveform overlay, and monitoring info
@@ -49,16 +59,26 @@ private:
     bool _showMonitoring;
     float _outputLevel;
     
-    // MIDI state
-    int _selectedDevice;
-    bool _isConnected;
-    
-    // Jog wheel state
-    float _jogWheelLeftRotation;   // Left jog wheel rotation in degrees (0-360)
-    float _jogWheelRightRotation;  // Right jog wheel rotation in degrees (0-360)
+    // Shared MIDI state (owned by the workspace manager)
+    MidiViewModel* _midiViewModel;
+
+    // GL texture showing an effect frame, re-uploaded when the frame changes
+    struct FrameTexture {
+        unsigned int id = 0;
+        int width = 0;
+        int height = 0;
+        uint64_t contentId = 0;
+    };
+
+    FrameTexture _previewTexture;                  // Engine's preview tap
+    std::vector<FrameTexture> _thumbnailTextures;  // Chain state after each slot
+
+    void uploadFrame(FrameTexture& texture, const gamma::effects::Frame& frame);
+    void releaseTextures();
     
     // UI helpers - output functionality
     void renderVideoOutput();
+    void renderThumbnails(float left, float top, float right, float bottom);
     void renderWaveformOverlay();
     void renderMonitoringInfo();
     void renderOutputControls();
@@ -66,16 +86,6 @@ private:
     // Tab rendering methods
     void renderOutputTab();
     void renderMidiSetupTab();
-    
-    // MIDI UI helpers
-    void renderMidiDeviceSelection();
-    void renderMidiControlMapping();
-    void renderMidiStatus();
-    void renderMidiSignalLog();
-    void renderMidiConfigButtons();
-    
-    // Jog wheel control
-    void updateJogWheelRotation(int channel, float deltaRotation); // channel 1=left, 2=right
 };
 
 } // namespace ui
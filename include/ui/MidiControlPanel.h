@@ -2,14 +2,11 @@
 
 #include "ui/WorkspacePanel.h"
 
-namespace gamma {
-namespace core { class Application; }
-namespace midi { class MidiManager; }
-}
-
 namespace gamma {
 namespace ui {
 
+class MidiViewModel;
+
 /**
  * @brief MIDI Control Panel for MIDI device management and control mapping
  * 
@@ -23,10 +20,10 @@ public:
     virtual ~MidiControlPanel() = default;
 
     /**
-     * @brief Set reference to the application for accessing MIDI subsystem
-     * @param app Pointer to the main application instance
+     * @brief Set the shared MIDI state this panel displays
+     * @param viewModel View-model owned by the workspace manager
      */
-    void setApplication(gamma::core::Application* app);
+    void setMidiViewModel(MidiViewModel* viewModel);
 
     /**
      * @brief Render the MIDI control panel UI
@@ -41,26 +38,8 @@ public:
     void update(float deltaTime) override;
 
 private:
-    // Application reference for accessing MIDI subsystem
-    gamma::core::Application* _application;
-    
-    // MIDI state
-    int _selectedDevice;
-    bool _isConnected;
-    
-    // Jog wheel state
-    float _jogWheelLeftRotation;   // Left jog wheel rotation in degrees (0-360)
-    float _jogWheelRightRotation;  // Right jog wheel rotation in degrees (0-360)
-    
-    // MIDI UI rendering methods
-    void renderMidiDeviceSelection();
-    void renderMidiControlMapping();
-    void renderMidiStatus();
-    void renderMidiSignalLog();
-    void renderMidiConfigButtons();
-    
-    // Jog wheel control
-    void updateJogWheelRotation(int channel, float deltaRotation); // channel 1=left, 2=right
+    // Shared MIDI state (owned by the workspace manager)
+    MidiViewModel* _midiViewModel;
 };
 
 } // namespace ui
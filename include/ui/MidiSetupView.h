@@ -0,0 +1,30 @@
+#pragma once
+
+#include "ui/MidiViewModel.h"
+
+namespace gamma {
+namespace ui {
+
+/**
+ * @brief MIDI setup layout shared by MainContainer and MidiControlPanel
+ *
+ * Stateless: everything it shows comes from the MidiViewModel, and user
+ * actions are forwarded to it.
+ */
+class MidiSetupView {
+public:
+    /**
+     * @brief Draw device selection, jog wheels, status and the signal log
+     */
+    static void render(MidiViewModel& viewModel);
+
+private:
+    static void renderDeviceSelection(MidiViewModel& viewModel);
+    static void renderJogWheels(const MidiViewModel& viewModel);
+    static void renderJogWheel(const char* label, float angleDegrees, unsigned int lineColor, unsigned int tipColor);
+    static void renderStatus(const MidiViewModel& viewModel);
+    static void renderConfigButtons(MidiViewModel& viewModel);
+};
+
+} // namespace ui
+} // namespace gamma
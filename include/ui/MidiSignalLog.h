@@ -0,0 +1,68 @@
+#pragma once
+
+#include "midi/MidiLogRing.h"
+#include "midi/MidiManager.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace gamma {
+namespace ui {
+
+/**
+ * @brief Scrolling MIDI signal log shared by the MIDI panels
+ *
+ * New messages are pulled from the MidiManager once per frame (by the
+ * MidiViewModel, however many panels show the log) and formatted
+ * a single time into a MidiLogRing, whose per-type index makes filtering a
+ * lookup rather than a scan. Rendering goes through ImGuiListClipper so
+ * only visible rows are laid out. Per-frame cost is independent of how
+ * many entries are held.
+ */
+class MidiSignalLog {
+public:
+    /**
+     * @param capacity Number of entries kept before the oldest are overwritten
+     */
+    explicit MidiSignalLog(size_t capacity = 128 * 1024);
+
+    /**
+     * @brief Draw the log (header, filter, rows)
+     * @param midiAvailable False shows a "not available" notice instead
+     */
+    void render(bool midiAvailable);
+
+    /**
+     * @brief Pull messages logged since the last call
+     */
+    void update(gamma::midi::MidiManager& midiManager);
+
+    /**
+     * @brief Drop all entries
+     */
+    void clear();
+
+    /**
+     * @brief Number of entries currently held
+     */
+    size_t size() const { return _ring.size(); }
+
+    /**
+     * @brief Messages the MidiManager has logged so far (including ones trimmed before being seen)
+     */
+    uint64_t getMessagesSeen() const { return _managerSequence; }
+
+private:
+    gamma::midi::MidiLogRing _ring;
+
+    // Source tracking
+    uint64_t _managerSequence;
+    uint64_t _managerClearCount;
+    std::vector<gamma::midi::MidiMessage> _incoming;   // Reused between frames
+
+    // View state
+    int _filter;                    // -1 = all types
+};
+
+} // namespace ui
+} // namespace gamma
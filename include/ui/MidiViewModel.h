@@ -0,0 +1,103 @@
+#pragma once
+
+#include "ui/MidiSignalLog.h"
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace gamma {
+namespace midi { class MidiManager; }
+}
+
+namespace gamma {
+namespace ui {
+
+/**
+ * @brief MIDI state shared by every panel that displays MIDI
+ *
+ * Updated once per frame by the workspace manager; panels only read it and
+ * route user actions (connect, refresh, clear) through it. Device
+ * enumeration, log polling and jog integration therefore cost the same no
+ * matter how many panels show MIDI.
+ */
+class MidiViewModel {
+public:
+    MidiViewModel();
+    ~MidiViewModel();
+
+    MidiViewModel(const MidiViewModel&) = delete;
+    MidiViewModel& operator=(const MidiViewModel&) = delete;
+
+    /**
+     * @brief Attach to the MIDI subsystem (null detaches)
+     * Installs the jog wheel callback on the manager.
+     */
+    void setMidiManager(gamma::midi::MidiManager* midiManager);
+
+    /**
+     * @brief Pull new state from the MIDI subsystem (call once per frame)
+     * @param deltaTime Time elapsed since the last update in seconds
+     */
+    void update(float deltaTime);
+
+    // Read-only state
+    bool isAvailable() const { return _midiManager != nullptr; }
+    bool isConnected() const { return _isConnected; }
+    const std::string& getConnectedDeviceName() const { return _connectedDeviceName; }
+    const std::vector<std::string>& getDeviceNames() const { return _deviceNames; }
+    const char* const* getDeviceNameList() const { return _deviceNameList.data(); }
+    int getDeviceCount() const { return static_cast<int>(_deviceNameList.size()); }
+    bool hasDevices() const { return !_deviceNames.empty(); }
+    float getJogAngle(int channel) const;               // channel 1=left, 2=right, degrees 0-360
+    uint64_t getJogTicks(int channel) const;
+    uint64_t getMessagesReceived() const { return _messagesReceived; }
+    float getMessageRate() const { return _messageRate; }   // Messages per second
+    MidiSignalLog& getSignalLog() { return _signalLog; }
+
+    // Device selection shared by all MIDI views
+    int getSelectedDevice() const { return _selectedDevice; }
+    void setSelectedDevice(int index) { _selectedDevice = index; }
+
+    // Actions
+    void connectSelectedDevice();
+    void disconnect();
+    void refreshDevices();
+    void clearLog();
+    void exportLog();
+
+private:
+    static const int JOG_CHANNELS = 2;
+
+    void onJogWheel(int channel, float deltaRotation);  // MIDI input thread
+    void queryDevices();
+
+    gamma::midi::MidiManager* _midiManager;
+
+    // Devices
+    std::vector<std::string> _deviceNames;
+    std::vector<const char*> _deviceNameList;           // Combo items; placeholder when empty
+    float _devicePollTimer;
+    int _selectedDevice;
+
+    // Connection
+    bool _isConnected;
+    std::string _connectedDeviceName;
+
+    // Jog wheels: deltas arrive on the MIDI thread and are applied in update()
+    std::mutex _jogMutex;
+    float _pendingJogDelta[JOG_CHANNELS];
+    uint64_t _pendingJogTicks[JOG_CHANNELS];
+    float _jogAngle[JOG_CHANNELS];
+    uint64_t _jogTicks[JOG_CHANNELS];
+
+    // Log and counters
+    MidiSignalLog _signalLog;
+    uint64_t _messagesReceived;
+    uint64_t _rateWindowStartCount;
+    float _rateWindowTime;
+    float _messageRate;
+};
+
+} // namespace ui
+} // namespace gamma
@@ -6,6 +6,7 @@
 #include "MidiControlPanel.h"
 #include "ImportPanel.h"
 #include "EffectsPanel.h"
+#include "MidiViewModel.h"
 #include <memory>
 
 namespace gamma {
@@ -20,6 +21,20 @@ public:
     WorkspaceManager();
     ~WorkspaceManager();
     
+    /**
+     * @brief Construct the panels and link them to the manager and the MIDI view-model
+     *
+     * Touches neither ImGui nor the application, so it may run on a worker
+     * while the window and ImGui are set up.
+     */
+    void createPanels();
+
+    /**
+     * @brief Connect the panels to the application and MIDI, and lay them out
+     *
+     * Main thread, with ImGui initialized; creates the panels first if
+     * createPanels() has not run.
+     */
     void initialize(gamma::core::Application* application = nullptr);
     void render();
     void update(float deltaTime);
@@ -31,6 +46,7 @@ public:
     MidiControlPanel& getMidiControlPanel() { return *_midiControlPanel; }
     ImportPanel& getImportPanel() { return *_importPanel; }
     EffectsPanel& getEffectsPanel() { return *_effectsPanel; }
+    MidiViewModel& getMidiViewModel() { return _midiViewModel; }
     
     // Layout management
     void setFullscreen(bool fullscreen);
@@ -46,6 +62,11 @@ private:
     void calculateLayout();
     void updatePanelSizes();
     void renderWorkspaceOverlay();
+    void updatePanel(WorkspacePanel* panel, float deltaTime);
+    void renderPanel(WorkspacePanel* panel);
+    
+    // MIDI state shared by all MIDI panels, updated once per frame
+    MidiViewModel _midiViewModel;
     
     // Panel instances
     std::unique_ptr<TimelinePanel> _timelinePanel;
@@ -1,20 +1,46 @@
 #pragma once
 
+#include <cstdint>
+
 namespace gamma {
 namespace ui {
 
 // Forward declaration
 class WorkspaceManager;
 
+/**
+ * @brief How often the workspace manager calls a panel's update()
+ */
+enum class UpdatePolicy {
+    EveryFrame,     // Every frame while visible
+    OnChange,       // Only after markDirty() or being shown
+    FixedRate       // At most N times per second while visible
+};
+
 /**
  * @brief Base class for workspace panels in the VJing interface
  * 
  * Provides a common interface for the main workspace panels:
  * Timeline, Output, Import, and Effects. Each panel is modular
  * and handles its own rendering and event processing.
+ *
+ * The workspace manager schedules update() according to the panel's
+ * update policy and skips it while the panel is hidden or occluded
+ * (collapsed or fully clipped), unless the panel opts in with
+ * setUpdateWhenHidden().
  */
 class WorkspacePanel {
 public:
+    /**
+     * @brief Per-panel cost, smoothed over recent frames
+     */
+    struct Timing {
+        float updateMs = 0.0f;          // Average cost of an update() call
+        float renderMs = 0.0f;          // Average cost of a render() call
+        uint64_t updatesRun = 0;
+        uint64_t updatesSkipped = 0;
+    };
+
     WorkspacePanel(const char* name);
     virtual ~WorkspacePanel() = default;
 
@@ -26,7 +52,7 @@ public:
 
     /**
      * @brief Update panel state
-     * @param deltaTime Time elapsed since last frame in seconds
+     * @param deltaTime Time elapsed since the panel's previous update in seconds
      */
     virtual void update(float deltaTime);
 
@@ -43,18 +69,73 @@ public:
     /**
      * @brief Set panel visibility
      */
-    void setVisible(bool visible) { _visible = visible; }
+    void setVisible(bool visible);
     
+    /**
+     * @brief Check if the panel's window was collapsed or clipped away last frame
+     */
+    bool isOccluded() const { return _occluded; }
+
     /**
      * @brief Set workspace manager reference for layout coordination
      */
     void setWorkspaceManager(WorkspaceManager* manager) { _workspaceManager = manager; }
 
+    /**
+     * @brief Choose when update() runs
+     * @param policy Scheduling policy
+     * @param rateHz Updates per second for UpdatePolicy::FixedRate
+     */
+    void setUpdatePolicy(UpdatePolicy policy, float rateHz = 0.0f);
+
+    /**
+     * @brief Keep updating while hidden (for state that must advance regardless, e.g. playback)
+     */
+    void setUpdateWhenHidden(bool enabled) { _updateWhenHidden = enabled; }
+
+    /**
+     * @brief Request an update on the next frame (for UpdatePolicy::OnChange)
+     */
+    void markDirty() { _dirty = true; }
+
+    /**
+     * @brief Decide whether update() is due and consume the pending time
+     * @param deltaTime Frame time in seconds
+     * @param updateDelta Receives the time since the panel's previous update
+     * @return true if update() should be called this frame
+     */
+    bool scheduleUpdate(float deltaTime, float& updateDelta);
+
+    /**
+     * @brief Timing statistics maintained by the workspace manager
+     */
+    const Timing& getTiming() const { return _timing; }
+    void recordUpdateTime(float milliseconds);
+    void recordRenderTime(float milliseconds);
+    void recordSkippedUpdate() { ++_timing.updatesSkipped; }
+
 protected:
+    /**
+     * @brief ImGui::Begin for the panel window; also tracks occlusion
+     * @param title Window title
+     * @param flags ImGuiWindowFlags
+     * @return ImGui::Begin result (ImGui::End must be called either way)
+     */
+    bool beginWindow(const char* title, int flags);
+
     const char* _name;
     bool _visible;
     WorkspaceManager* _workspaceManager;
+
+private:
+    UpdatePolicy _updatePolicy;
+    float _updateInterval;          // Seconds between updates for FixedRate
+    float _pendingTime;             // Time accumulated since the last update
+    bool _updateWhenHidden;
+    bool _dirty;
+    bool _occluded;
+    Timing _timing;
 };
 
 } // namespace ui
-} // namespace gamma
\ No newline at end of file
+} // namespace gamma
@@ -0,0 +1,85 @@
+#!/usr/bin/env bash
+# Profile-guided + link-time optimized release build, measured against a
+# plain release build on the benchmark suites.
+#
+#   scripts/pgo_build.sh [build-root]
+#
+# Builds three configurations under build-root (default: build-pgo):
+#   baseline/   Release, no LTO, no PGO
+#   lto/        Release with LTO
+#   optimized/  Release with LTO and PGO, trained on the replay workload
+#
+# Training runs the gamma_bench "workload" suite (MIDI log replay driving a
+# chain of every effect at a fixed 60 fps step) and, when the app was built,
+# a headless replay of the same log. The measured speedups are written to
+# build-root/speedup.txt.
+#
+# Environment: SUITES (default "effects workload"), JOBS (default: all cores)
+# and CMAKE_ARGS (extra configure arguments, e.g. -G Ninja).
+
+set -euo pipefail
+
+SOURCE_DIR="$(cd "$(dirname "$0")/.." && pwd)"
+BUILD_ROOT="$(mkdir -p "${1:-$SOURCE_DIR/build-pgo}" && cd "${1:-$SOURCE_DIR/build-pgo}" && pwd)"
+SUITES="${SUITES:-effects workload}"
+JOBS="${JOBS:-$(nproc 2>/dev/null || echo 4)}"
+REPLAY="$SOURCE_DIR/midi_log_20250912_151132.csv"
+read -r -a EXTRA_ARGS <<< "${CMAKE_ARGS:-}"
+
+configure() {
+    local dir="$1"
+    shift
+    cmake -S "$SOURCE_DIR" -B "$BUILD_ROOT/$dir" -DCMAKE_BUILD_TYPE=Release "${EXTRA_ARGS[@]}" "$@"
+}
+
+build() {
+    cmake --build "$BUILD_ROOT/$1" --parallel "$JOBS"
+}
+
+bench() {
+    local dir="$1"
+    # shellcheck disable=SC2086
+    "$BUILD_ROOT/$dir/bin/gamma_bench" $SUITES --replay "$REPLAY" --json "$BUILD_ROOT/$dir.json"
+}
+
+echo "=== Baseline: Release without LTO or PGO ==="
+configure baseline -DGAMMA_LTO=OFF -DGAMMA_PGO=OFF
+build baseline
+
+echo "=== LTO ==="
+configure lto -DGAMMA_LTO=ON -DGAMMA_PGO=OFF
+build lto
+
+echo "=== PGO: instrumented build ==="
+PROFILE_DIR="$BUILD_ROOT/optimized/pgo"
+rm -rf "$PROFILE_DIR"
+configure optimized -DGAMMA_LTO=ON -DGAMMA_PGO=GENERATE -DGAMMA_PGO_DIR="$PROFILE_DIR"
+build optimized
+
+echo "=== PGO: training run ==="
+"$BUILD_ROOT/optimized/bin/gamma_bench" workload --replay "$REPLAY"
+if [ -x "$BUILD_ROOT/optimized/bin/GammaArray" ]; then
+    "$BUILD_ROOT/optimized/bin/GammaArray" --headless --replay "$REPLAY" --duration 0
+fi
+
+COMPILER_ID="$(sed -n 's/^CMAKE_CXX_COMPILER_ID:[A-Z]*=//p' "$BUILD_ROOT/optimized/CMakeCache.txt")"
+if [[ "$COMPILER_ID" == *Clang* ]]; then
+    llvm-profdata merge -output="$PROFILE_DIR/gamma.profdata" "$PROFILE_DIR"/*.profraw
+fi
+
+echo "=== PGO: optimized build ==="
+configure optimized -DGAMMA_PGO=USE
+build optimized
+
+echo "=== Measuring ==="
+for dir in baseline lto optimized; do
+    bench "$dir"
+done
+
+{
+    echo "--- LTO vs baseline ---"
+    "$BUILD_ROOT/baseline/bin/gamma_bench" --compare "$BUILD_ROOT/baseline.json" "$BUILD_ROOT/lto.json"
+    echo
+    echo "--- LTO + PGO vs baseline ---"
+    "$BUILD_ROOT/baseline/bin/gamma_bench" --compare "$BUILD_ROOT/baseline.json" "$BUILD_ROOT/optimized.json"
+} | tee "$BUILD_ROOT/speedup.txt"
@@ -0,0 +1,87 @@
+#include "core/AllocationCounter.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace gamma {
+namespace core {
+
+namespace {
+    // Plain integers only: these are touched from inside operator new, so
+    // they must not need dynamic initialization or allocate themselves
+    thread_local uint64_t t_threadAllocations = 0;
+    std::atomic<uint64_t> g_totalAllocations(0);
+}
+
+uint64_t AllocationCounter::getThreadAllocations() {
+    return t_threadAllocations;
+}
+
+uint64_t AllocationCounter::getTotalAllocations() {
+    return g_totalAllocations.load(std::memory_order_relaxed);
+}
+
+} // namespace core
+} // namespace gamma
+
+// Every non-aligned form of new/delete is replaced so that allocation and
+// release always pair up. Over-aligned new keeps the library implementation
+// and is not counted.
+void* operator new(std::size_t size) {
+    ++gamma::core::t_threadAllocations;
+    gamma::core::g_totalAllocations.fetch_add(1, std::memory_order_relaxed);
+
+    if (size == 0) {
+        size = 1;
+    }
+    for (;;) {
+        if (void* memory = std::malloc(size)) {
+            return memory;
+        }
+        std::new_handler handler = std::get_new_handler();
+        if (!handler) {
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+}
+
+void* operator new[](std::size_t size) {
+    return ::operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    try {
+        return ::operator new(size);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return ::operator new(size, std::nothrow);
+}
+
+void operator delete(void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete[](void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept {
+    std::free(memory);
+}
+
+void operator delete[](void* memory, std::size_t) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, const std::nothrow_t&) noexcept {
+    std::free(memory);
+}
+
+void operator delete[](void* memory, const std::nothrow_t&) noexcept {
+    std::free(memory);
+}
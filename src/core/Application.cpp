@@ -1,8 +1,15 @@
 #include "core/Application.h"
+#include "core/AllocationCounter.h"
+#include "core/FrameArena.h"
 #include "ui/WorkspaceManager.h"
 #include "midi/MidiManager.h"
+#include "midi/MidiReplay.h"
+#include "effects/TestPattern.h"
 #include <iostream>
+#include <iomanip>
 #include <chrono>
+#include <thread>
+#include <algorithm>
 
 // Include GLFW first which includes OpenGL headers correctly
 #include <GLFW/glfw3.h>
@@ -16,6 +23,12 @@ namespace gamma {
 namespace core {
 
 namespace {
+    // Resolution the effect chain runs at until real clips are decoded
+    const int EFFECT_FRAME_WIDTH = 1280;
+    const int EFFECT_FRAME_HEIGHT = 720;
+    // The output monitor shows a half-size preview; the program output stays full size
+    const int EFFECT_PREVIEW_FACTOR = 2;
+
     // Static callback for GLFW error handling
     void glfwErrorCallback(int error, const char* description) {
         std::cerr << "GLFW Error " << error << ": " << description << std::endl;
@@ -44,9 +57,19 @@ Application::Application()
     : _initialized(false)
     , _shouldRun(false)
     , _fullscreen(false)  // Default to windowed mode
+    , _headless(false)
     , _window(nullptr)
     , _workspaceManager(nullptr)
-    , _midiManager(nullptr) {
+    , _midiManager(nullptr)
+    , _effectResult(&_effectOutput)
+    , _effectFormat(gamma::effects::PixelFormat::RGBA8)
+    , _effectTime(0.0)
+    , _lastEffectMs(0.0)
+    , _lastThumbnailMs(0.0)
+    , _jobSystem(nullptr)
+    , _midiInitSucceeded(false)
+    , _firstFramePresented(false)
+    , _lastFrameAllocations(0) {
 }
 
 Application::~Application() {
@@ -61,6 +84,8 @@ bool Application::initialize(bool fullscreen) {
         return true;
     }
 
+    _startupProfiler.start();
+
     // Force windowed mode (fullscreen capability disabled)
     _fullscreen = false;  // Always windowed regardless of parameter
     if (fullscreen) {
@@ -68,20 +93,63 @@ bool Application::initialize(bool fullscreen) {
     }
     std::cout << "Initializing Gamma Array in windowed mode..." << std::endl;
 
+    // Shared executor first - startup tasks already run on it
+    _jobSystem = std::make_unique<JobSystem>();
+    std::cout << "Job system started with " << _jobSystem->getWorkerCount() << " workers" << std::endl;
+
+    // MIDI does not depend on the Window → OpenGL → ImGui chain, so it starts on a
+    // worker right away. initializeSubsystems() joins it before panels register callbacks.
+    _midiManager = std::make_unique<gamma::midi::MidiManager>();
+    gamma::midi::MidiManager* midiManager = _midiManager.get();
+    _midiInitTask = _jobSystem->submit([this, midiManager]() {
+        StartupProfiler::ScopedPhase phase(_startupProfiler, "MIDI init");
+        _midiInitSucceeded = midiManager->initialize();
+    });
+
+    // Panel constructors touch neither ImGui nor MIDI, so the panels are built
+    // on a worker while the window, GL context and ImGui come up
+    _panelTask = _jobSystem->submit([this]() {
+        StartupProfiler::ScopedPhase phase(_startupProfiler, "Panel construction");
+        auto workspaceManager = std::make_unique<gamma::ui::WorkspaceManager>();
+        workspaceManager->createPanels();
+        _workspaceManager = std::move(workspaceManager);
+    });
+
     // Initialize in order: Window → OpenGL → ImGui → Subsystems
-    if (!initializeWindow()) {
+    bool windowReady = false;
+    {
+        StartupProfiler::ScopedPhase phase(_startupProfiler, "Window");
+        windowReady = initializeWindow();
+    }
+    if (!windowReady) {
         std::cerr << "Failed to initialize window system" << std::endl;
+        waitForStartupTasks();
+        cleanupSubsystems();
         return false;
     }
 
-    if (!initializeOpenGL()) {
+    bool openGLReady = false;
+    {
+        StartupProfiler::ScopedPhase phase(_startupProfiler, "OpenGL");
+        openGLReady = initializeOpenGL();
+    }
+    if (!openGLReady) {
         std::cerr << "Failed to initialize OpenGL" << std::endl;
+        waitForStartupTasks();
+        cleanupSubsystems();
         cleanupWindow();
         return false;
     }
 
-    if (!initializeImGui()) {
+    bool imGuiReady = false;
+    {
+        StartupProfiler::ScopedPhase phase(_startupProfiler, "ImGui");
+        imGuiReady = initializeImGui();
+    }
+    if (!imGuiReady) {
         std::cerr << "Failed to initialize ImGui" << std::endl;
+        waitForStartupTasks();
+        cleanupSubsystems();
         cleanupOpenGL();
         cleanupWindow();
         return false;
@@ -89,6 +157,8 @@ bool Application::initialize(bool fullscreen) {
 
     if (!initializeSubsystems()) {
         std::cerr << "Failed to initialize subsystems" << std::endl;
+        waitForStartupTasks();
+        cleanupSubsystems();
         cleanupImGui();
         cleanupOpenGL();
         cleanupWindow();
@@ -102,12 +172,93 @@ bool Application::initialize(bool fullscreen) {
     return true;
 }
 
+bool Application::initializeHeadless(const HeadlessOptions& options) {
+    if (_initialized) {
+        std::cout << "Application already initialized" << std::endl;
+        return true;
+    }
+
+    _startupProfiler.start();
+
+    _headless = true;
+    _headlessOptions = options;
+    std::cout << "Initializing Gamma Array in headless mode (no window, OpenGL or ImGui)..." << std::endl;
+
+    _jobSystem = std::make_unique<JobSystem>();
+    std::cout << "Job system started with " << _jobSystem->getWorkerCount() << " workers" << std::endl;
+
+    // Only the non-GUI subsystems: MIDI and the effect engine
+    _midiManager = std::make_unique<gamma::midi::MidiManager>();
+    bool midiReady = false;
+    {
+        StartupProfiler::ScopedPhase phase(_startupProfiler, "MIDI init");
+        midiReady = _midiManager->initialize();
+    }
+    if (!midiReady) {
+        std::cerr << "Warning: MIDI system initialization failed" << std::endl;
+        // Replay still works without a MIDI backend
+    }
+
+    if (!options.replayFile.empty()) {
+        StartupProfiler::ScopedPhase phase(_startupProfiler, "Load MIDI replay");
+        _midiReplay = std::make_unique<gamma::midi::MidiReplay>();
+        if (!_midiReplay->load(options.replayFile)) {
+            std::cerr << "Failed to load MIDI replay: " << options.replayFile << std::endl;
+            _midiReplay.reset();
+            _midiManager->shutdown();
+            _midiManager.reset();
+            return false;
+        }
+
+        // Console echo per message would dominate the measurements
+        _midiManager->setConsoleEcho(false);
+    }
+
+    {
+        StartupProfiler::ScopedPhase phase(_startupProfiler, "Effect engine");
+        initializeEffects();
+    }
+
+    // The chain the Effects panel would publish: the requested effects, or the
+    // panel's own starting chain
+    if (options.effects.empty()) {
+        _headlessChain.add(gamma::effects::EffectType::ColorCorrection, true);
+    }
+    for (gamma::effects::EffectType type : options.effects) {
+        if (!_headlessChain.add(type, true)) {
+            std::cerr << "Warning: effect chain is full - ignoring the rest" << std::endl;
+            break;
+        }
+    }
+    std::cout << "Effect chain:";
+    for (size_t i = 0; i < _headlessChain.size(); ++i) {
+        std::cout << (i == 0 ? " " : " -> ") << _headlessChain.getDescriptor(i).name;
+    }
+    std::cout << std::endl;
+
+    if (_headlessOptions.duration <= 0.0f && !_midiReplay) {
+        std::cout << "No run duration or replay given - defaulting to 10s" << std::endl;
+        _headlessOptions.duration = 10.0f;
+    }
+
+    _initialized = true;
+    _shouldRun = true;
+
+    std::cout << "Gamma Array initialized successfully (headless)" << std::endl;
+    return true;
+}
+
 void Application::run() {
     if (!_initialized) {
         std::cerr << "Cannot run uninitialized application" << std::endl;
         return;
     }
 
+    if (_headless) {
+        runHeadless();
+        return;
+    }
+
     std::cout << "Starting main application loop..." << std::endl;
 
     auto lastTime = std::chrono::high_resolution_clock::now();
@@ -119,10 +270,14 @@ void Application::run() {
         float deltaTime = duration.count() / 1000000.0f; // Convert to seconds
         lastTime = currentTime;
 
+        uint64_t allocationsBefore = AllocationCounter::getThreadAllocations();
+
         // Main loop steps
         processEvents();
         update(deltaTime);
         render();
+
+        _lastFrameAllocations = AllocationCounter::getThreadAllocations() - allocationsBefore;
     }
 
     std::cout << "Main loop ended" << std::endl;
@@ -139,18 +294,176 @@ void Application::shutdown() {
 
     // Cleanup in reverse order: Subsystems → ImGui → OpenGL → Window
     cleanupSubsystems();
-    cleanupImGui();
-    cleanupOpenGL();
-    cleanupWindow();
+    if (!_headless) {
+        cleanupImGui();
+        cleanupOpenGL();
+        cleanupWindow();
+    }
 
     _initialized = false;
     std::cout << "Gamma Array shutdown complete" << std::endl;
 }
 
 bool Application::shouldRun() const {
+    if (_headless) {
+        return _shouldRun;
+    }
     return _shouldRun && _window && !glfwWindowShouldClose(_window);
 }
 
+void Application::runHeadless() {
+    using Clock = std::chrono::steady_clock;
+
+    const float rate = _headlessOptions.updateRate;
+    const double duration = _headlessOptions.duration;
+
+    std::cout << "Starting headless loop (rate: ";
+    if (rate > 0.0f) {
+        std::cout << rate << " Hz";
+    } else {
+        std::cout << "unthrottled";
+    }
+    std::cout << ", duration: ";
+    if (duration > 0.0) {
+        std::cout << duration << "s";
+    } else {
+        std::cout << "until replay ends";
+    }
+    std::cout << ")" << std::endl;
+
+    HeadlessStats stats;
+    const size_t expectedFrames = (rate > 0.0f && duration > 0.0) ? static_cast<size_t>(rate * duration) + 1 : (1 << 16);
+    stats.frameTimes.reserve(expectedFrames);
+    stats.effectTimes.reserve(expectedFrames);
+    stats.thumbnailTimes.reserve(expectedFrames);
+
+    const auto frameInterval = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(rate > 0.0f ? 1.0 / rate : 0.0));
+
+    const auto startTime = Clock::now();
+    auto lastTime = startTime;
+    auto nextFrameTime = startTime;
+
+    while (shouldRun()) {
+        auto currentTime = Clock::now();
+        double elapsed = std::chrono::duration<double>(currentTime - startTime).count();
+        if (duration > 0.0 && elapsed >= duration) {
+            break;
+        }
+
+        float deltaTime = std::chrono::duration<float>(currentTime - lastTime).count();
+        lastTime = currentTime;
+
+        getFrameArena().reset();
+        uint64_t allocationsBefore = AllocationCounter::getThreadAllocations();
+
+        auto workStart = Clock::now();
+        if (_midiReplay && _midiManager) {
+            stats.replayedMessages += _midiReplay->advance(elapsed,
+                [this](const std::vector<unsigned char>& message, double timestamp) {
+                    _midiManager->injectMessage(message, timestamp);
+                });
+        }
+        update(deltaTime);
+        auto workEnd = Clock::now();
+
+        // Counted before push_back so the vector's own growth is not attributed to the frame
+        _lastFrameAllocations = AllocationCounter::getThreadAllocations() - allocationsBefore;
+        stats.totalAllocations += _lastFrameAllocations;
+        stats.maxFrameAllocations = std::max(stats.maxFrameAllocations, _lastFrameAllocations);
+
+        stats.frameTimes.push_back(std::chrono::duration<double, std::milli>(workEnd - workStart).count());
+        stats.effectTimes.push_back(_lastEffectMs);
+        stats.thumbnailTimes.push_back(_lastThumbnailMs);
+
+        if (!_firstFramePresented) {
+            onFirstFramePresented();
+        }
+
+        if (duration <= 0.0 && _midiReplay && _midiReplay->isFinished()) {
+            break;
+        }
+
+        // Pace to the requested rate; fall back to "now" when running behind
+        if (rate > 0.0f) {
+            nextFrameTime += frameInterval;
+            if (nextFrameTime > Clock::now()) {
+                std::this_thread::sleep_until(nextFrameTime);
+            } else {
+                nextFrameTime = Clock::now();
+            }
+        }
+    }
+
+    double wallTime = std::chrono::duration<double>(Clock::now() - startTime).count();
+    printHeadlessSummary(stats, wallTime);
+
+    _shouldRun = false;
+    std::cout << "Headless loop ended" << std::endl;
+}
+
+void Application::printHeadlessSummary(HeadlessStats& stats, double wallTime) const {
+    std::ios::fmtflags oldFlags = std::cout.flags();
+    std::streamsize oldPrecision = std::cout.precision();
+    std::vector<double>& frameTimes = stats.frameTimes;
+
+    std::cout << "=== Headless Timing Summary ===" << std::endl;
+    std::cout << "Frames:           " << frameTimes.size() << std::endl;
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "Wall time:        " << wallTime << " s" << std::endl;
+
+    if (frameTimes.empty()) {
+        std::cout << "===============================" << std::endl;
+        std::cout.flags(oldFlags);
+        std::cout.precision(oldPrecision);
+        return;
+    }
+
+    // avg | min | p50 | p99 | max of per-frame times; sorts them
+    auto printTimes = [](const char* label, std::vector<double>& times) {
+        double total = 0.0;
+        for (double t : times) {
+            total += t;
+        }
+        std::sort(times.begin(), times.end());
+        auto percentile = [&times](double p) {
+            size_t index = static_cast<size_t>(p * (times.size() - 1) + 0.5);
+            return times[index];
+        };
+        std::cout << label << "avg " << total / times.size()
+                  << " | min " << times.front()
+                  << " | p50 " << percentile(0.50)
+                  << " | p99 " << percentile(0.99)
+                  << " | max " << times.back() << std::endl;
+        return total;
+    };
+
+    std::cout << "Update rate:      " << frameTimes.size() / wallTime << " Hz" << std::endl;
+    std::cout << "MIDI replayed:    " << stats.replayedMessages << " messages" << std::endl;
+    const double total = printTimes("Frame work (ms):  ", frameTimes);
+    std::cout << "Busy fraction:    " << (total / 1000.0) / wallTime * 100.0 << " %" << std::endl;
+    std::cout << "Heap allocs:      avg " << static_cast<double>(stats.totalAllocations) / frameTimes.size()
+              << " | max " << stats.maxFrameAllocations << " per frame" << std::endl;
+
+    // Part of the frame work above: the engine's share, and where it goes
+    if (_effectEngine) {
+        printTimes("Effects (ms):     ", stats.effectTimes);
+        printTimes("Thumbnails (ms):  ", stats.thumbnailTimes);
+        std::cout << "Preview tap:      " << _effectEngine->getPreviewTimeMs() << " ms (smoothed, in Effects)" << std::endl;
+        const gamma::effects::EffectEngine::CacheStats& cache = _effectEngine->getCacheStats();
+        std::cout << "Result cache:     " << cache.hits << " hits | " << cache.misses << " misses | "
+                  << cache.uncached << " uncached" << std::endl;
+        std::cout << "Effect CPU time (ms, smoothed, summed over threads):" << std::endl;
+        for (size_t i = 0; i < _headlessChain.size(); ++i) {
+            std::cout << "  " << std::left << std::setw(22) << _headlessChain.getDescriptor(i).name << std::right
+                      << _effectEngine->getSlotTimeMs(i) << std::endl;
+        }
+    }
+    std::cout << "===============================" << std::endl;
+    std::cout.flags(oldFlags);
+    std::cout.precision(oldPrecision);
+}
+
 bool Application::initializeWindow() {
     std::cout << "Initializing window system..." << std::endl;
 
@@ -280,6 +593,14 @@ bool Application::initializeImGui() {
     
     // Enable keyboard navigation
     io.ConfigFlags |= ImGuiConfigFlags_NavEnableKeyboard;
+
+    // Rasterized here rather than on a worker: the atlas allocates through
+    // ImGui::MemAlloc, whose allocation counters in the context are not atomic
+    // and are updated by everything the main thread does with ImGui meanwhile
+    {
+        StartupProfiler::ScopedPhase phase(_startupProfiler, "Font atlas build");
+        io.Fonts->Build();
+    }
     
     // Setup Dear ImGui style (Adobe-like dark theme)
     ImGui::StyleColorsDark();
@@ -308,12 +629,14 @@ bool Application::initializeImGui() {
     // Setup Platform/Renderer backends
     if (!ImGui_ImplGlfw_InitForOpenGL(_window, true)) {
         std::cerr << "Failed to initialize ImGui GLFW backend" << std::endl;
+        ImGui::DestroyContext();
         return false;
     }
     
     if (!ImGui_ImplOpenGL3_Init("#version 330")) {
         std::cerr << "Failed to initialize ImGui OpenGL3 backend" << std::endl;
         ImGui_ImplGlfw_Shutdown();
+        ImGui::DestroyContext();
         return false;
     }
 
@@ -324,16 +647,44 @@ bool Application::initializeImGui() {
 bool Application::initializeSubsystems() {
     std::cout << "Initializing subsystems..." << std::endl;
 
-    // Initialize MIDI system first (required by UI panels)
-    _midiManager = std::make_unique<gamma::midi::MidiManager>();
-    if (!_midiManager->initialize()) {
-        std::cerr << "Warning: MIDI system initialization failed" << std::endl;
-        // Continue without MIDI - not a fatal error
+    // MIDI was started on a worker in initialize(); panels register MIDI
+    // callbacks, so it has to be finished before they are wired up
+    if (_midiInitTask) {
+        StartupProfiler::ScopedPhase phase(_startupProfiler, "Wait for MIDI init");
+        _jobSystem->wait(_midiInitTask);
+        _midiInitTask.reset();
+        if (!_midiInitSucceeded) {
+            std::cerr << "Warning: MIDI system initialization failed" << std::endl;
+            // Continue without MIDI - not a fatal error
+        }
     }
 
-    // Initialize workspace manager (after MIDI for callback registration)
-    _workspaceManager = std::make_unique<gamma::ui::WorkspaceManager>();
-    _workspaceManager->initialize(this);
+    // Panels were constructed on a worker in initialize(); wiring them to the
+    // application and MIDI and laying them out uses ImGui, so happens here
+    if (_panelTask) {
+        StartupProfiler::ScopedPhase phase(_startupProfiler, "Wait for panels");
+        _jobSystem->wait(_panelTask);
+        _panelTask.reset();
+    }
+    {
+        StartupProfiler::ScopedPhase phase(_startupProfiler, "Panel setup");
+        _workspaceManager->initialize(this);
+    }
+
+    // Device enumeration is not needed to draw the first frame
+    deferUntilFirstFrame("MIDI device scan", [this]() {
+        if (_midiManager) {
+            std::vector<std::string> devices = _midiManager->getAvailableDevices();
+            std::cout << "MIDI devices detected: " << devices.size() << std::endl;
+            for (const auto& device : devices) {
+                std::cout << "  - " << device << std::endl;
+            }
+        }
+    });
+
+    // Effect engine; the EffectsPanel reads its timings for the CPU meter
+    initializeEffects();
+    _workspaceManager->getEffectsPanel().setEffectEngine(_effectEngine.get());
 
     // TODO: Initialize rendering engine
     // TODO: Initialize audio engine  
@@ -342,6 +693,48 @@ bool Application::initializeSubsystems() {
     return true;
 }
 
+void Application::initializeEffects() {
+    _effectEngine = std::make_unique<gamma::effects::EffectEngine>(_jobSystem.get());
+    _effectSource.resize(EFFECT_FRAME_WIDTH, EFFECT_FRAME_HEIGHT);
+    _effectOutput.resize(EFFECT_FRAME_WIDTH, EFFECT_FRAME_HEIGHT);
+    _effectEngine->setPreviewFactor(EFFECT_PREVIEW_FACTOR);
+    _effectEngine->setIntermediateFormat(_effectFormat);
+    _effectThumbnails.setJobSystem(_jobSystem.get());
+    _effectThumbnails.setIntermediateFormat(_effectFormat);
+}
+
+void Application::waitForStartupTasks() {
+    if (!_jobSystem) {
+        return;
+    }
+    _jobSystem->wait(_midiInitTask);
+    _jobSystem->wait(_panelTask);
+    _midiInitTask.reset();
+    _panelTask.reset();
+}
+
+void Application::deferUntilFirstFrame(const char* name, std::function<void()> task) {
+    if (_firstFramePresented) {
+        // Already past the first frame - nothing to defer
+        task();
+        return;
+    }
+    _deferredTasks.push_back({name, std::move(task)});
+}
+
+void Application::onFirstFramePresented() {
+    _firstFramePresented = true;
+    _startupProfiler.markFirstFrame();
+
+    for (auto& deferred : _deferredTasks) {
+        StartupProfiler::ScopedPhase phase(_startupProfiler, deferred.name);
+        deferred.task();
+    }
+    _deferredTasks.clear();
+
+    _startupProfiler.printReport();
+}
+
 void Application::processEvents() {
     // Poll for and process events
     glfwPollEvents();
@@ -358,10 +751,49 @@ void Application::update(float deltaTime) {
         _midiManager->update();
     }
 
+    processEffects(deltaTime);
+
     // TODO: Update audio processing
 }
 
+void Application::processEffects(float deltaTime) {
+    if (!_effectEngine) {
+        return;
+    }
+
+    _effectTime += deltaTime;
+
+    publishEffectChain();
+
+    using Clock = std::chrono::steady_clock;
+    const gamma::effects::ChainParameters& parameters = _effectParameters.acquire();
+    gamma::effects::renderTestPattern(_effectSource, _effectTime);
+    const auto engineStart = Clock::now();
+    _effectResult = &_effectEngine->process(_effectSource, _effectOutput, parameters.slots,
+                                            parameters.masterMix, _effectTime);
+    const auto thumbnailStart = Clock::now();
+    _effectThumbnails.render(_effectSource, parameters.slots, _effectTime);
+    _lastEffectMs = std::chrono::duration<double, std::milli>(thumbnailStart - engineStart).count();
+    _lastThumbnailMs = std::chrono::duration<double, std::milli>(Clock::now() - thumbnailStart).count();
+}
+
+void Application::publishEffectChain() {
+    if (_workspaceManager) {
+        _workspaceManager->getEffectsPanel().publishChain(_effectParameters);
+        return;
+    }
+
+    // Headless: the fixed chain, fully mixed
+    gamma::effects::ChainParameters& parameters = _effectParameters.beginWrite();
+    _headlessChain.buildSlots(parameters.slots);
+    parameters.masterMix = 1.0f;
+    _effectParameters.publish();
+}
+
 void Application::render() {
+    // Nothing from the previous frame may reference arena memory past this point
+    getFrameArena().reset();
+
     // Clear the screen
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
@@ -388,6 +820,10 @@ void Application::render() {
     if (_window) {
         glfwSwapBuffers(_window);
     }
+
+    if (!_firstFramePresented) {
+        onFirstFramePresented();
+    }
 }
 
 void Application::renderNavigationBar() {
@@ -421,6 +857,8 @@ void Application::renderNavigationBar() {
             ImGui::SetCursorPosX(ImGui::GetWindowWidth() * 0.5f - 50);
             ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(0.6f, 0.6f, 0.6f, 1.0f)); // Gray text
             ImGui::Text("VJ Application");
+            ImGui::SameLine();
+            ImGui::Text("| %llu allocs/frame", static_cast<unsigned long long>(_lastFrameAllocations));
             ImGui::PopStyleColor();
             
             // Right side - Window controls (minimize and exit only - fullscreen disabled)
@@ -528,20 +966,26 @@ void Application::cleanupImGui() {
 void Application::cleanupSubsystems() {
     std::cout << "Cleaning up subsystems..." << std::endl;
     
+    // Cleanup workspace manager (the UI holds callbacks into the MIDI system)
+    if (_workspaceManager) {
+        _workspaceManager->shutdown();
+        _workspaceManager.reset();
+    }
+    
     // Cleanup MIDI system
+    _midiReplay.reset();
     if (_midiManager) {
         _midiManager->shutdown();
         _midiManager.reset();
     }
-    
-    // Cleanup workspace manager
-    if (_workspaceManager) {
-        _workspaceManager->shutdown();
-        _workspaceManager.reset();
-    }
+
+    _effectEngine.reset();
 
     // TODO: Cleanup audio engine
     // TODO: Cleanup rendering engine
+
+    // Job system last - subsystems above may still have work in flight
+    _jobSystem.reset();
 }
 
 void Application::cleanupOpenGL() {
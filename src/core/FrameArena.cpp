@@ -0,0 +1,127 @@
+#include "core/FrameArena.h"
+#include <algorithm>
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+
+namespace gamma {
+namespace core {
+
+FrameArena::FrameArena(size_t blockSize)
+    : _currentBlock(0)
+    , _offset(0)
+    , _blockSize(std::max<size_t>(blockSize, 256))
+    , _bytesUsed(0)
+    , _peakBytesUsed(0) {
+    addBlock(_blockSize);
+}
+
+FrameArena::~FrameArena() {
+    releaseBlocks();
+}
+
+void FrameArena::reset() {
+    _peakBytesUsed = std::max(_peakBytesUsed, _bytesUsed);
+
+    // The last frame spilled into extra blocks: replace them with one block
+    // big enough for the whole frame so the next frames stay allocation-free
+    if (_blocks.size() > 1) {
+        size_t capacity = getCapacity();
+        releaseBlocks();
+        addBlock(capacity);
+    }
+
+    _currentBlock = 0;
+    _offset = 0;
+    _bytesUsed = 0;
+}
+
+void* FrameArena::allocate(size_t size, size_t alignment) {
+    for (;;) {
+        Block& block = _blocks[_currentBlock];
+        uintptr_t base = reinterpret_cast<uintptr_t>(block.data);
+        uintptr_t aligned = (base + _offset + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1);
+        size_t newOffset = static_cast<size_t>(aligned - base) + size;
+
+        if (newOffset <= block.size) {
+            _bytesUsed += newOffset - _offset;
+            _offset = newOffset;
+            return reinterpret_cast<void*>(aligned);
+        }
+
+        if (_currentBlock + 1 < _blocks.size()) {
+            ++_currentBlock;
+        } else {
+            addBlock(size + alignment);
+            _currentBlock = _blocks.size() - 1;
+        }
+        _offset = 0;
+    }
+}
+
+const char* FrameArena::format(const char* fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    va_list retryArgs;
+    va_copy(retryArgs, args);
+
+    // Try to format straight into the remaining space of the current block
+    Block& block = _blocks[_currentBlock];
+    size_t available = block.size - _offset;
+    char* destination = block.data + _offset;
+    int length = std::vsnprintf(destination, available, fmt, args);
+    va_end(args);
+
+    if (length < 0) {
+        va_end(retryArgs);
+        return "";
+    }
+
+    const char* result = destination;
+    if (static_cast<size_t>(length) < available) {
+        _offset += static_cast<size_t>(length) + 1;
+        _bytesUsed += static_cast<size_t>(length) + 1;
+    } else {
+        char* buffer = static_cast<char*>(allocate(static_cast<size_t>(length) + 1, 1));
+        std::vsnprintf(buffer, static_cast<size_t>(length) + 1, fmt, retryArgs);
+        result = buffer;
+    }
+
+    va_end(retryArgs);
+    return result;
+}
+
+const char* FrameArena::copy(const char* text, size_t length) {
+    char* buffer = static_cast<char*>(allocate(length + 1, 1));
+    std::memcpy(buffer, text, length);
+    buffer[length] = '\0';
+    return buffer;
+}
+
+size_t FrameArena::getCapacity() const {
+    size_t capacity = 0;
+    for (const auto& block : _blocks) {
+        capacity += block.size;
+    }
+    return capacity;
+}
+
+void FrameArena::addBlock(size_t minimumSize) {
+    size_t size = std::max(minimumSize, _blockSize);
+    _blocks.push_back({new char[size], size});
+}
+
+void FrameArena::releaseBlocks() {
+    for (auto& block : _blocks) {
+        delete[] block.data;
+    }
+    _blocks.clear();
+}
+
+FrameArena& getFrameArena() {
+    static FrameArena arena;
+    return arena;
+}
+
+} // namespace core
+} // namespace gamma
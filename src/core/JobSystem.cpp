@@ -0,0 +1,354 @@
+#include "core/JobSystem.h"
+#include <algorithm>
+#include <exception>
+#include <iostream>
+
+namespace gamma {
+namespace core {
+
+namespace {
+    // Identifies the worker running on the current thread (-1 for non-worker threads)
+    thread_local const JobSystem* t_owner = nullptr;
+    thread_local int t_workerIndex = -1;
+
+    int64_t nowNanoseconds() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+}
+
+void JobSystem::WorkQueue::pushBack(TaskHandle task) {
+    std::lock_guard<std::mutex> lock(mutex);
+    tasks.push_back(std::move(task));
+}
+
+JobSystem::TaskHandle JobSystem::WorkQueue::popBack() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (tasks.empty()) {
+        return nullptr;
+    }
+    TaskHandle task = std::move(tasks.back());
+    tasks.pop_back();
+    return task;
+}
+
+JobSystem::TaskHandle JobSystem::WorkQueue::popFront() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (tasks.empty()) {
+        return nullptr;
+    }
+    TaskHandle task = std::move(tasks.front());
+    tasks.pop_front();
+    return task;
+}
+
+JobSystem::JobSystem(unsigned workerCount)
+    : _running(true)
+    , _queuedTasks(0)
+    , _sleepingWorkers(0)
+    , _statsStartNanoseconds(nowNanoseconds()) {
+    if (workerCount == 0) {
+        unsigned hardwareThreads = std::thread::hardware_concurrency();
+        // The main thread helps while waiting, so leave one hardware thread for it
+        workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+    }
+
+    _workers.reserve(workerCount);
+    for (unsigned i = 0; i < workerCount; ++i) {
+        _workers.push_back(std::make_unique<Worker>());
+    }
+    for (unsigned i = 0; i < workerCount; ++i) {
+        _workers[i]->thread = std::thread(&JobSystem::workerLoop, this, i);
+    }
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(_sleepMutex);
+        _running = false;
+    }
+    _sleepCondition.notify_all();
+
+    for (auto& worker : _workers) {
+        if (worker->thread.joinable()) {
+            worker->thread.join();
+        }
+    }
+}
+
+JobSystem::TaskHandle JobSystem::submit(TaskFunction function, TaskPriority priority) {
+    TaskHandle task = std::make_shared<Task>(std::move(function), priority);
+    releaseDependency(task);
+    return task;
+}
+
+JobSystem::TaskHandle JobSystem::submitAfter(const std::vector<TaskHandle>& dependencies,
+                                             TaskFunction function, TaskPriority priority) {
+    TaskHandle task = std::make_shared<Task>(std::move(function), priority);
+
+    for (const auto& dependency : dependencies) {
+        if (!dependency) {
+            continue;
+        }
+        std::lock_guard<std::mutex> lock(dependency->continuationMutex);
+        if (!dependency->done.load(std::memory_order_acquire)) {
+            task->pendingDependencies.fetch_add(1, std::memory_order_relaxed);
+            dependency->continuations.push_back(task);
+        }
+    }
+
+    // Drop the setup guard; schedules immediately if nothing is pending
+    releaseDependency(task);
+    return task;
+}
+
+void JobSystem::releaseDependency(const TaskHandle& task) {
+    if (task->pendingDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        schedule(task);
+    }
+}
+
+void JobSystem::schedule(const TaskHandle& task) {
+    int priority = static_cast<int>(task->priority);
+
+    if (t_owner == this && t_workerIndex >= 0) {
+        _workers[t_workerIndex]->queues[priority].pushBack(task);
+    } else {
+        _injectionQueues[priority].pushBack(task);
+    }
+
+    // Pairs with the check in workerLoop: either we see a sleeper or it sees the task
+    _queuedTasks.fetch_add(1, std::memory_order_seq_cst);
+    if (_sleepingWorkers.load(std::memory_order_seq_cst) > 0) {
+        std::lock_guard<std::mutex> lock(_sleepMutex);
+        _sleepCondition.notify_one();
+    }
+}
+
+JobSystem::TaskHandle JobSystem::findTask(int workerIndex, int maxPriority) {
+    const int workerCount = static_cast<int>(_workers.size());
+
+    for (int priority = 0; priority <= maxPriority; ++priority) {
+        // 1. Own deque, newest first
+        if (workerIndex >= 0) {
+            if (TaskHandle task = _workers[workerIndex]->queues[priority].popBack()) {
+                return task;
+            }
+        }
+
+        // 2. Work submitted from outside the pool
+        if (TaskHandle task = _injectionQueues[priority].popFront()) {
+            return task;
+        }
+
+        // 3. Steal the oldest work from the other workers
+        int start = workerIndex >= 0 ? workerIndex + 1 : 0;
+        for (int offset = 0; offset < workerCount; ++offset) {
+            int victim = (start + offset) % workerCount;
+            if (victim == workerIndex) {
+                continue;
+            }
+            if (TaskHandle task = _workers[victim]->queues[priority].popFront()) {
+                if (workerIndex >= 0) {
+                    _workers[workerIndex]->tasksStolen.fetch_add(1, std::memory_order_relaxed);
+                }
+                return task;
+            }
+        }
+    }
+
+    return nullptr;
+}
+
+void JobSystem::execute(const TaskHandle& task, int workerIndex) {
+    _queuedTasks.fetch_sub(1, std::memory_order_relaxed);
+
+    try {
+        if (task->function) {
+            task->function();
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Job system task failed: " << e.what() << std::endl;
+    } catch (...) {
+        std::cerr << "Job system task failed with unknown error" << std::endl;
+    }
+
+    if (workerIndex >= 0) {
+        _workers[workerIndex]->tasksExecuted.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    complete(task);
+}
+
+void JobSystem::complete(const TaskHandle& task) {
+    // Release captured state before anyone can observe completion;
+    // handles may outlive the task for a long time
+    task->function = nullptr;
+
+    std::vector<TaskHandle> continuations;
+    {
+        std::lock_guard<std::mutex> lock(task->continuationMutex);
+        task->done.store(true, std::memory_order_release);
+        continuations.swap(task->continuations);
+    }
+
+    for (const auto& continuation : continuations) {
+        releaseDependency(continuation);
+    }
+}
+
+void JobSystem::workerLoop(unsigned workerIndex) {
+    t_owner = this;
+    t_workerIndex = static_cast<int>(workerIndex);
+
+    Worker& worker = *_workers[workerIndex];
+    const int lowestPriority = PRIORITY_COUNT - 1;
+
+    // Busy time is accumulated per run of back-to-back tasks rather than per
+    // task, keeping clock reads off the hot path; flushed every few tasks so
+    // stats stay current while a worker never goes idle
+    const int BUSY_FLUSH_INTERVAL = 64;
+    int64_t busyStart = 0;
+    int tasksSinceFlush = 0;
+
+    while (_running.load(std::memory_order_acquire)) {
+        if (TaskHandle task = findTask(t_workerIndex, lowestPriority)) {
+            if (busyStart == 0) {
+                busyStart = nowNanoseconds();
+            }
+            execute(task, t_workerIndex);
+
+            if (++tasksSinceFlush >= BUSY_FLUSH_INTERVAL) {
+                int64_t now = nowNanoseconds();
+                worker.busyNanoseconds.fetch_add(static_cast<uint64_t>(now - busyStart), std::memory_order_relaxed);
+                busyStart = now;
+                tasksSinceFlush = 0;
+            }
+            continue;
+        }
+
+        if (busyStart != 0) {
+            worker.busyNanoseconds.fetch_add(static_cast<uint64_t>(nowNanoseconds() - busyStart), std::memory_order_relaxed);
+            busyStart = 0;
+            tasksSinceFlush = 0;
+        }
+
+        std::unique_lock<std::mutex> lock(_sleepMutex);
+        _sleepingWorkers.fetch_add(1, std::memory_order_seq_cst);
+        _sleepCondition.wait(lock, [this]() {
+            return !_running.load(std::memory_order_acquire) ||
+                   _queuedTasks.load(std::memory_order_seq_cst) > 0;
+        });
+        _sleepingWorkers.fetch_sub(1, std::memory_order_seq_cst);
+    }
+
+    t_owner = nullptr;
+    t_workerIndex = -1;
+}
+
+bool JobSystem::isDone(const TaskHandle& task) {
+    return !task || task->done.load(std::memory_order_acquire);
+}
+
+void JobSystem::wait(const TaskHandle& task) {
+    int workerIndex = (t_owner == this) ? t_workerIndex : -1;
+    int idleSpins = 0;
+
+    while (!isDone(task)) {
+        // Help with frame-critical work only, so a long background task
+        // never delays the thread that is waiting
+        if (TaskHandle other = findTask(workerIndex, static_cast<int>(TaskPriority::FrameCritical))) {
+            execute(other, workerIndex);
+            idleSpins = 0;
+        } else if (++idleSpins < 1000) {
+            std::this_thread::yield();
+        } else {
+            // Long wait (e.g. background work) - stop burning a core
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+    }
+}
+
+void JobSystem::waitAll(const std::vector<TaskHandle>& tasks) {
+    for (const auto& task : tasks) {
+        wait(task);
+    }
+}
+
+void JobSystem::parallelFor(size_t begin, size_t end, size_t grainSize, const RangeFunction& body,
+                            TaskPriority priority) {
+    if (end <= begin) {
+        return;
+    }
+
+    const size_t count = end - begin;
+    const size_t participants = _workers.size() + 1;
+    if (grainSize == 0) {
+        // A few chunks per participant keeps the load balanced without much overhead
+        grainSize = std::max<size_t>(1, count / (participants * 4));
+    }
+
+    const size_t chunkCount = (count + grainSize - 1) / grainSize;
+    if (chunkCount == 1) {
+        body(begin, end);
+        return;
+    }
+
+    // Chunks are claimed from a shared counter by the caller and by helper tasks
+    std::atomic<size_t> nextChunk(0);
+    auto drain = [&]() {
+        for (;;) {
+            size_t chunk = nextChunk.fetch_add(1, std::memory_order_relaxed);
+            if (chunk >= chunkCount) {
+                break;
+            }
+            size_t chunkBegin = begin + chunk * grainSize;
+            size_t chunkEnd = std::min(end, chunkBegin + grainSize);
+            body(chunkBegin, chunkEnd);
+        }
+    };
+
+    size_t helperCount = std::min(chunkCount - 1, _workers.size());
+    std::vector<TaskHandle> helpers;
+    helpers.reserve(helperCount);
+    for (size_t i = 0; i < helperCount; ++i) {
+        helpers.push_back(submit(drain, priority));
+    }
+
+    drain();
+
+    // Helpers reference this stack frame, so all of them must have finished
+    waitAll(helpers);
+}
+
+int JobSystem::getCurrentWorkerIndex() const {
+    return (t_owner == this) ? t_workerIndex : -1;
+}
+
+std::vector<JobSystem::WorkerStats> JobSystem::getWorkerStats() const {
+    double wallSeconds = (nowNanoseconds() - _statsStartNanoseconds.load(std::memory_order_relaxed)) * 1e-9;
+
+    std::vector<WorkerStats> stats;
+    stats.reserve(_workers.size());
+    for (const auto& worker : _workers) {
+        WorkerStats entry;
+        entry.tasksExecuted = worker->tasksExecuted.load(std::memory_order_relaxed);
+        entry.tasksStolen = worker->tasksStolen.load(std::memory_order_relaxed);
+        entry.busySeconds = worker->busyNanoseconds.load(std::memory_order_relaxed) * 1e-9;
+        entry.utilization = wallSeconds > 0.0 ? std::min(1.0, entry.busySeconds / wallSeconds) : 0.0;
+        stats.push_back(entry);
+    }
+    return stats;
+}
+
+void JobSystem::resetStats() {
+    for (auto& worker : _workers) {
+        worker->tasksExecuted.store(0, std::memory_order_relaxed);
+        worker->tasksStolen.store(0, std::memory_order_relaxed);
+        worker->busyNanoseconds.store(0, std::memory_order_relaxed);
+    }
+    _statsStartNanoseconds.store(nowNanoseconds(), std::memory_order_relaxed);
+}
+
+} // namespace core
+} // namespace gamma
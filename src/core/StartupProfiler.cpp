@@ -0,0 +1,82 @@
+#include "core/StartupProfiler.h"
+#include <iostream>
+#include <iomanip>
+
+namespace gamma {
+namespace core {
+
+StartupProfiler::StartupProfiler()
+    : _origin(Clock::now())
+    , _mainThread(std::this_thread::get_id())
+    , _firstFrameMs(-1.0) {
+}
+
+void StartupProfiler::start() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _origin = Clock::now();
+    _mainThread = std::this_thread::get_id();
+    _phases.clear();
+    _firstFrameMs = -1.0;
+}
+
+size_t StartupProfiler::beginPhase(const char* name) {
+    double now = elapsedMs();
+    std::lock_guard<std::mutex> lock(_mutex);
+    _phases.push_back({name, std::this_thread::get_id() == _mainThread, now, -1.0});
+    return _phases.size() - 1;
+}
+
+void StartupProfiler::endPhase(size_t phaseId) {
+    double now = elapsedMs();
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (phaseId < _phases.size()) {
+        _phases[phaseId].endMs = now;
+    }
+}
+
+void StartupProfiler::markFirstFrame() {
+    double now = elapsedMs();
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_firstFrameMs < 0.0) {
+        _firstFrameMs = now;
+    }
+}
+
+double StartupProfiler::elapsedMs() const {
+    return std::chrono::duration<double, std::milli>(Clock::now() - _origin).count();
+}
+
+void StartupProfiler::printReport() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    std::ios::fmtflags oldFlags = std::cout.flags();
+    std::streamsize oldPrecision = std::cout.precision();
+
+    std::cout << "=== Startup Timing Report ===" << std::endl;
+    std::cout << std::left << std::setw(30) << "Phase" << std::setw(8) << "Thread"
+              << std::right << std::setw(12) << "Start (ms)" << std::setw(14) << "Duration (ms)" << std::endl;
+    std::cout << std::fixed << std::setprecision(1);
+
+    for (const auto& phase : _phases) {
+        std::cout << std::left << std::setw(30) << phase.name
+                  << std::setw(8) << (phase.onMainThread ? "main" : "worker")
+                  << std::right << std::setw(12) << phase.startMs;
+        if (phase.endMs >= 0.0) {
+            std::cout << std::setw(14) << (phase.endMs - phase.startMs);
+        } else {
+            std::cout << std::setw(14) << "running";
+        }
+        std::cout << std::endl;
+    }
+
+    if (_firstFrameMs >= 0.0) {
+        std::cout << "Time to first frame: " << _firstFrameMs << " ms" << std::endl;
+    }
+    std::cout << "=============================" << std::endl;
+
+    std::cout.flags(oldFlags);
+    std::cout.precision(oldPrecision);
+}
+
+} // namespace core
+} // namespace gamma
@@ -0,0 +1,122 @@
+#include "effects/ChainThumbnails.h"
+#include "effects/Downscale.h"
+#include "effects/EffectDescriptor.h"
+#include <algorithm>
+#include <chrono>
+
+namespace gamma {
+namespace effects {
+
+namespace {
+    const double SMOOTHING = 0.1;   // Weight of the newest sample in the moving average
+}
+
+ChainThumbnails::ChainThumbnails(core::JobSystem* jobSystem)
+    : _jobSystem(jobSystem)
+    , _format(PixelFormat::RGBA8)
+    , _factor(DEFAULT_FACTOR)
+    , _inputSourceId(0)
+    , _renderTimeMs(0.0) {
+}
+
+ChainThumbnails::~ChainThumbnails() = default;
+
+void ChainThumbnails::setJobSystem(core::JobSystem* jobSystem) {
+    _jobSystem = jobSystem;
+    for (Stage& stage : _stages) {
+        stage.engine->setJobSystem(jobSystem);
+    }
+}
+
+void ChainThumbnails::setIntermediateFormat(PixelFormat format) {
+    if (format == PixelFormat::Count || format == _format) {
+        return;
+    }
+    _format = format;
+    for (Stage& stage : _stages) {
+        stage.engine->setIntermediateFormat(format);
+    }
+}
+
+void ChainThumbnails::setFactor(int factor) {
+    factor = std::max(2, std::min(MAX_DOWNSCALE_FACTOR, factor));
+    if (factor != _factor) {
+        _factor = factor;
+        reset();
+    }
+}
+
+void ChainThumbnails::render(const Frame& input, const std::vector<ChainSlot>& chain, double time) {
+    const auto start = std::chrono::steady_clock::now();
+
+    const uint64_t sourceId = input.getContentId();
+    if (sourceId == 0 || sourceId != _inputSourceId || _input.empty()) {
+        downscaleFrame(input, _input, _factor, _jobSystem);
+        _inputSourceId = sourceId;
+    }
+
+    // Take each slot's engine from wherever its slot was last time; slots
+    // without an id keep the engine at their position
+    std::swap(_stages, _previousStages);
+    _stages.clear();
+    _stages.reserve(chain.size());     // Outputs must not move while later stages read them
+    _results.resize(chain.size());
+    const Frame* previous = &_input;
+    for (size_t i = 0; i < chain.size(); ++i) {
+        const uint32_t id = chain[i].id;
+        Stage* match = nullptr;
+        if (id != 0) {
+            for (Stage& candidate : _previousStages) {
+                if (candidate.engine && candidate.id == id) {
+                    match = &candidate;
+                    break;
+                }
+            }
+        } else if (i < _previousStages.size() && _previousStages[i].engine && _previousStages[i].id == 0) {
+            match = &_previousStages[i];
+        }
+
+        if (match) {
+            _stages.push_back(std::move(*match));
+        } else {
+            _stages.emplace_back();
+            _stages.back().id = id;
+            _stages.back().engine = std::make_unique<EffectEngine>(_jobSystem);
+            _stages.back().engine->setIntermediateFormat(_format);
+        }
+
+        Stage& stage = _stages.back();
+        stage.chain.assign(1, chain[i]);
+        scalePixelParameters(stage.chain[0]);
+        previous = &stage.engine->process(*previous, stage.output, stage.chain, 1.0f, time);
+        _results[i] = previous;
+    }
+
+    const double elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    _renderTimeMs += (elapsedMs - _renderTimeMs) * SMOOTHING;
+
+    // Engines of removed slots go with their state
+    _previousStages.clear();
+}
+
+void ChainThumbnails::scalePixelParameters(ChainSlot& slot) const {
+    const EffectDescriptor& descriptor = getEffectDescriptor(slot.type);
+    const float scale = 1.0f / static_cast<float>(_factor);
+    for (int p = 0; p < std::min(slot.parameterCount, descriptor.parameterCount); ++p) {
+        const ParameterDescriptor& parameter = descriptor.getParameter(p);
+        if (parameter.pixels) {
+            slot.parameters[p] = std::max(parameter.minValue, std::min(parameter.maxValue, slot.parameters[p] * scale));
+        }
+    }
+}
+
+void ChainThumbnails::reset() {
+    _stages.clear();
+    _previousStages.clear();
+    _results.clear();
+    _input = Frame();
+    _inputSourceId = 0;
+}
+
+} // namespace effects
+} // namespace gamma
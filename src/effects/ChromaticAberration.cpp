@@ -0,0 +1,109 @@
+#include "effects/Effects.h"
+#include "effects/PixelRows.h"
+#include "core/Math.h"
+#include <algorithm>
+
+namespace gamma {
+namespace effects {
+
+void ChromaticAberrationEffect::prepare(const Frame& input, const float* parameters,
+                                        const EffectContext& /*context*/) {
+    float strength = parameters[0];
+    const int width = input.getWidth();
+
+    // Offsets are whole pixels; red takes its value from x + redShift
+    _redShift = static_cast<int>(core::lround(parameters[1] * strength));
+    _blueShift = static_cast<int>(core::lround(parameters[2] * strength));
+    _redShift = std::max(-width + 1, std::min(width - 1, _redShift));
+    _blueShift = std::max(-width + 1, std::min(width - 1, _blueShift));
+    _kernels = &getKernels();
+}
+
+void ChromaticAberrationEffect::processRows(const Frame& input, Frame& output, int yBegin, int yEnd) {
+    const int width = input.getWidth();
+    const int redShift = _redShift;
+    const int blueShift = _blueShift;
+
+    if (redShift == 0 && blueShift == 0) {
+        for (int y = yBegin; y < yEnd; ++y) {
+            copyRow(input, y, output, y);
+        }
+        return;
+    }
+    if (usesFloatPixels()) {
+        processRowsFloat(input, output, yBegin, yEnd);
+        return;
+    }
+
+    // Columns where both shifted reads stay inside the row run through the
+    // kernel; the few edge columns clamp their reads
+    const int interiorBegin = std::max(0, std::max(-redShift, -blueShift));
+    const int interiorEnd = std::min(width, std::min(width - redShift, width - blueShift));
+
+    for (int y = yBegin; y < yEnd; ++y) {
+        const uint32_t* src = input.row(y);
+        uint32_t* dst = output.row(y);
+
+        auto mergeClamped = [&](int x) {
+            int redX = std::max(0, std::min(width - 1, x + redShift));
+            int blueX = std::max(0, std::min(width - 1, x + blueShift));
+            dst[x] = (src[redX] & 0x000000FFu) | (src[x] & 0xFF00FF00u) | (src[blueX] & 0x00FF0000u);
+        };
+
+        if (interiorBegin >= interiorEnd) {
+            for (int x = 0; x < width; ++x) {
+                mergeClamped(x);
+            }
+            continue;
+        }
+
+        for (int x = 0; x < interiorBegin; ++x) {
+            mergeClamped(x);
+        }
+        _kernels->mergeChannels(src + interiorBegin + redShift, src + interiorBegin, src + interiorBegin + blueShift,
+                                dst + interiorBegin, static_cast<size_t>(interiorEnd - interiorBegin));
+        for (int x = interiorEnd; x < width; ++x) {
+            mergeClamped(x);
+        }
+    }
+}
+
+void ChromaticAberrationEffect::processRowsFloat(const Frame& input, Frame& output, int yBegin, int yEnd) const {
+    const int width = input.getWidth();
+    const size_t count = static_cast<size_t>(width);
+    float* source = getRowBuffer(0, count);
+    float* result = getRowBuffer(1, count);
+
+    const int interiorBegin = std::max(0, std::max(-_redShift, -_blueShift));
+    const int interiorEnd = std::max(interiorBegin, std::min(width, std::min(width - _redShift, width - _blueShift)));
+
+    for (int y = yBegin; y < yEnd; ++y) {
+        const float* src = loadPixels(input, 0, y, count, source);
+        float* dst = getStoreTarget(output, 0, y, result);
+
+        auto merge = [&](int x, int redX, int blueX) {
+            float* pixel = dst + static_cast<size_t>(x) * 4;
+            pixel[0] = src[static_cast<size_t>(redX) * 4];
+            pixel[1] = src[static_cast<size_t>(x) * 4 + 1];
+            pixel[2] = src[static_cast<size_t>(blueX) * 4 + 2];
+            pixel[3] = src[static_cast<size_t>(x) * 4 + 3];
+        };
+        auto mergeClamped = [&](int x) {
+            merge(x, std::max(0, std::min(width - 1, x + _redShift)), std::max(0, std::min(width - 1, x + _blueShift)));
+        };
+
+        for (int x = 0; x < std::min(interiorBegin, width); ++x) {
+            mergeClamped(x);
+        }
+        for (int x = interiorBegin; x < interiorEnd; ++x) {
+            merge(x, x + _redShift, x + _blueShift);
+        }
+        for (int x = std::max(interiorEnd, interiorBegin); x < width; ++x) {
+            mergeClamped(x);
+        }
+        writePixels(dst, output, 0, y, count);
+    }
+}
+
+} // namespace effects
+} // namespace gamma
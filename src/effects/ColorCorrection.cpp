@@ -0,0 +1,87 @@
+#include "effects/Effects.h"
+#include "core/Math.h"
+#include <cstring>
+
+namespace gamma {
+namespace effects {
+
+namespace {
+    const float PI = 3.14159265358979f;
+
+    // Rec. 709 luma weights, shared by saturation and hue rotation so both keep gray gray
+    const float LUMA_R = 0.2126f;
+    const float LUMA_G = 0.7152f;
+    const float LUMA_B = 0.0722f;
+}
+
+ColorMatrix ColorCorrectionEffect::buildMatrix(float brightness, float contrast, float saturation, float hueDegrees) {
+    // Saturation: lerp between the luma vector and identity
+    float sat[3][3];
+    const float luma[3] = {LUMA_R, LUMA_G, LUMA_B};
+    for (int row = 0; row < 3; ++row) {
+        for (int col = 0; col < 3; ++col) {
+            sat[row][col] = (1.0f - saturation) * luma[col] + (row == col ? saturation : 0.0f);
+        }
+    }
+
+    // Hue: rotation about the gray axis
+    float angle = hueDegrees * PI / 180.0f;
+    float c = core::cos(angle);
+    float s = core::sin(angle);
+    const float hue[3][3] = {
+        {LUMA_R + c * (1.0f - LUMA_R) - s * LUMA_R, LUMA_G - c * LUMA_G - s * LUMA_G, LUMA_B - c * LUMA_B + s * (1.0f - LUMA_B)},
+        {LUMA_R - c * LUMA_R + s * 0.143f,          LUMA_G + c * (1.0f - LUMA_G) + s * 0.140f, LUMA_B - c * LUMA_B - s * 0.283f},
+        {LUMA_R - c * LUMA_R - s * (1.0f - LUMA_R), LUMA_G - c * LUMA_G + s * LUMA_G, LUMA_B + c * (1.0f - LUMA_B) + s * LUMA_B}
+    };
+
+    // Brightness and contrast act equally on all channels; since both matrices
+    // above map gray to itself, they reduce to a scale and an offset:
+    // out = contrast * (hue * sat * rgb) + contrast * 255 * brightness + 127.5 * (1 - contrast)
+    float offset = contrast * 255.0f * brightness + 127.5f * (1.0f - contrast);
+
+    ColorMatrix matrix;
+    for (int row = 0; row < 3; ++row) {
+        for (int col = 0; col < 3; ++col) {
+            float sum = 0.0f;
+            for (int k = 0; k < 3; ++k) {
+                sum += hue[row][k] * sat[k][col];
+            }
+            matrix.m[row][col] = contrast * sum;
+        }
+        matrix.m[row][3] = offset;
+    }
+    return matrix;
+}
+
+void ColorCorrectionEffect::prepare(const Frame& /*input*/, const float* parameters,
+                                    const EffectContext& /*context*/) {
+    float brightness = parameters[0];
+    float contrast = parameters[1];
+    float saturation = parameters[2];
+    float hueDegrees = parameters[3];
+
+    _identity = (brightness == 0.0f && contrast == 1.0f && saturation == 1.0f && hueDegrees == 0.0f);
+    if (!_identity) {
+        _matrix = buildMatrix(brightness, contrast, saturation, hueDegrees);
+    }
+    _kernels = &getKernels();
+}
+
+void ColorCorrectionEffect::processRow(const uint32_t* src, uint32_t* dst, int width, int /*y*/) {
+    if (_identity) {
+        std::memcpy(dst, src, static_cast<size_t>(width) * sizeof(uint32_t));
+        return;
+    }
+    _kernels->colorMatrix(src, dst, static_cast<size_t>(width), _matrix);
+}
+
+void ColorCorrectionEffect::processRowFloat(const float* src, float* dst, int width, int /*y*/) {
+    if (_identity) {
+        std::memcpy(dst, src, static_cast<size_t>(width) * 4 * sizeof(float));
+        return;
+    }
+    _kernels->colorMatrixFloat(src, dst, static_cast<size_t>(width), _matrix);
+}
+
+} // namespace effects
+} // namespace gamma
@@ -0,0 +1,264 @@
+#include "effects/ColorLut.h"
+#include "effects/Frame.h"
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace gamma {
+namespace effects {
+
+namespace {
+    const float DEFAULT_DOMAIN_MIN[3] = {0.0f, 0.0f, 0.0f};
+    const float DEFAULT_DOMAIN_MAX[3] = {1.0f, 1.0f, 1.0f};
+
+    // Reads up to count floats; false if fewer are present or one is not a number
+    bool parseFloats(const std::string& text, float* values, int count) {
+        const char* cursor = text.c_str();
+        for (int i = 0; i < count; ++i) {
+            char* end = nullptr;
+            values[i] = std::strtof(cursor, &end);
+            if (end == cursor) {
+                return false;
+            }
+            cursor = end;
+        }
+        return true;
+    }
+}
+
+ColorLut::ColorLut(int size)
+    : _size(0)
+    , _grid()
+    , _id(0) {
+    resize(size);
+}
+
+void ColorLut::resize(int size) {
+    _size = std::max(MIN_SIZE, std::min(MAX_SIZE, size));
+    _entries.assign(static_cast<size_t>(_size) * _size * _size * 4, 0.0f);
+    _title.clear();
+    updateGrid(DEFAULT_DOMAIN_MIN, DEFAULT_DOMAIN_MAX);
+    for (int b = 0; b < _size; ++b) {
+        for (int g = 0; g < _size; ++g) {
+            for (int r = 0; r < _size; ++r) {
+                float* value = entry(r, g, b);
+                value[0] = getLatticeValue(0, r);
+                value[1] = getLatticeValue(1, g);
+                value[2] = getLatticeValue(2, b);
+            }
+        }
+    }
+}
+
+float ColorLut::getLatticeValue(int channel, int i) const {
+    return _domainMin[channel] + (_domainMax[channel] - _domainMin[channel]) * static_cast<float>(i) /
+           static_cast<float>(_size - 1);
+}
+
+void ColorLut::updateGrid(const float* domainMin, const float* domainMax) {
+    _grid.entries = _entries.data();
+    _grid.size = _size;
+    for (int c = 0; c < 3; ++c) {
+        _domainMin[c] = domainMin[c];
+        _domainMax[c] = domainMax[c];
+        _grid.scale[c] = static_cast<float>(_size - 1) / (domainMax[c] - domainMin[c]);
+        _grid.offset[c] = -domainMin[c] * _grid.scale[c];
+    }
+    _id = makeContentId();
+}
+
+bool ColorLut::loadCube(const std::string& path) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "Failed to open LUT file: " << path << std::endl;
+        return false;
+    }
+    std::stringstream text;
+    text << file.rdbuf();
+    return parseCube(text.str(), path);
+}
+
+bool ColorLut::parseCube(const std::string& text, const std::string& name) {
+    int size = 0;
+    std::string title;
+    float domainMin[3] = {0.0f, 0.0f, 0.0f};
+    float domainMax[3] = {1.0f, 1.0f, 1.0f};
+    std::vector<float> entries;
+    size_t expected = 0;
+
+    auto fail = [&name](const std::string& reason) {
+        std::cerr << "Failed to load LUT " << name << ": " << reason << std::endl;
+        return false;
+    };
+
+    std::istringstream lines(text);
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(lines, line)) {
+        ++lineNumber;
+        const size_t comment = line.find('#');
+        if (comment != std::string::npos) {
+            line.erase(comment);
+        }
+        const size_t start = line.find_first_not_of(" \t\r");
+        if (start == std::string::npos) {
+            continue;
+        }
+        line.erase(0, start);
+
+        // Table rows: three values, red varying fastest, after the size is known
+        const char first = line[0];
+        if ((first >= '0' && first <= '9') || first == '-' || first == '+' || first == '.') {
+            if (size == 0) {
+                return fail("values before LUT_3D_SIZE (line " + std::to_string(lineNumber) + ")");
+            }
+            float rgb[3];
+            if (!parseFloats(line, rgb, 3)) {
+                return fail("bad table row (line " + std::to_string(lineNumber) + ")");
+            }
+            if (entries.size() / 4 >= expected) {
+                return fail("more rows than LUT_3D_SIZE^3");
+            }
+            entries.insert(entries.end(), {rgb[0], rgb[1], rgb[2], 0.0f});
+            continue;
+        }
+
+        std::istringstream words(line);
+        std::string keyword;
+        words >> keyword;
+        std::string rest;
+        std::getline(words, rest);
+        if (keyword == "TITLE") {
+            const size_t open = rest.find('"');
+            const size_t close = open == std::string::npos ? open : rest.find('"', open + 1);
+            title = close == std::string::npos ? rest : rest.substr(open + 1, close - open - 1);
+        } else if (keyword == "LUT_3D_SIZE") {
+            size = std::atoi(rest.c_str());
+            if (size < MIN_SIZE || size > MAX_SIZE) {
+                return fail("LUT_3D_SIZE " + std::to_string(size) + " outside " + std::to_string(MIN_SIZE) +
+                            ".." + std::to_string(MAX_SIZE));
+            }
+            expected = static_cast<size_t>(size) * size * size;
+            entries.reserve(expected * 4);
+        } else if (keyword == "LUT_1D_SIZE") {
+            return fail("1D LUTs are not supported");
+        } else if (keyword == "DOMAIN_MIN") {
+            if (!parseFloats(rest, domainMin, 3)) {
+                return fail("bad DOMAIN_MIN");
+            }
+        } else if (keyword == "DOMAIN_MAX") {
+            if (!parseFloats(rest, domainMax, 3)) {
+                return fail("bad DOMAIN_MAX");
+            }
+        } else if (keyword == "LUT_3D_INPUT_RANGE") {
+            // Resolve's shorthand for the same range on every channel
+            float range[2];
+            if (!parseFloats(rest, range, 2)) {
+                return fail("bad LUT_3D_INPUT_RANGE");
+            }
+            std::fill(domainMin, domainMin + 3, range[0]);
+            std::fill(domainMax, domainMax + 3, range[1]);
+        }
+        // Other keywords (LUT_1D_INPUT_RANGE, vendor tags) do not affect a 3D table
+    }
+
+    if (size == 0) {
+        return fail("no LUT_3D_SIZE");
+    }
+    if (entries.size() / 4 != expected) {
+        return fail(std::to_string(entries.size() / 4) + " rows, expected " + std::to_string(expected));
+    }
+    for (int c = 0; c < 3; ++c) {
+        if (!(domainMax[c] > domainMin[c])) {
+            return fail("empty domain");
+        }
+    }
+
+    _size = size;
+    _entries = std::move(entries);
+    _title = title;
+    updateGrid(domainMin, domainMax);
+    return true;
+}
+
+int LutLibrary::loadDirectory(const std::string& directory) {
+    std::error_code error;
+    std::vector<std::filesystem::path> files;
+    for (const auto& item : std::filesystem::directory_iterator(directory, error)) {
+        std::string extension = item.path().extension().string();
+        std::transform(extension.begin(), extension.end(), extension.begin(),
+                       [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        if (item.is_regular_file(error) && extension == ".cube") {
+            files.push_back(item.path());
+        }
+    }
+    if (error) {
+        std::cerr << "Failed to read LUT directory " << directory << ": " << error.message() << std::endl;
+        return 0;
+    }
+
+    std::sort(files.begin(), files.end());
+    int loaded = 0;
+    for (const auto& file : files) {
+        if (load(file.string()) >= 0) {
+            ++loaded;
+        }
+    }
+    std::cout << "Loaded " << loaded << " LUT(s) from " << directory << std::endl;
+    return loaded;
+}
+
+int LutLibrary::load(const std::string& path) {
+    auto lut = std::make_shared<ColorLut>();
+    if (!lut->loadCube(path)) {
+        return -1;
+    }
+    return add(std::filesystem::path(path).stem().string(), std::move(lut));
+}
+
+int LutLibrary::add(const std::string& name, std::shared_ptr<const ColorLut> lut) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (size_t i = 0; i < _looks.size(); ++i) {
+        if (_looks[i].name == name) {
+            _looks[i].lut = std::move(lut);
+            return static_cast<int>(i);
+        }
+    }
+    if (_looks.size() >= static_cast<size_t>(MAX_LOOKS)) {
+        std::cerr << "LUT library full (" << MAX_LOOKS << " looks), skipping " << name << std::endl;
+        return -1;
+    }
+    _looks.push_back({name, std::move(lut)});
+    return static_cast<int>(_looks.size() - 1);
+}
+
+std::shared_ptr<const ColorLut> LutLibrary::get(int index) const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return index >= 0 && static_cast<size_t>(index) < _looks.size() ? _looks[static_cast<size_t>(index)].lut : nullptr;
+}
+
+std::string LutLibrary::getName(int index) const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return index >= 0 && static_cast<size_t>(index) < _looks.size() ? _looks[static_cast<size_t>(index)].name : std::string();
+}
+
+int LutLibrary::getCount() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return static_cast<int>(_looks.size());
+}
+
+void LutLibrary::clear() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _looks.clear();
+}
+
+LutLibrary& getLutLibrary() {
+    static LutLibrary library;
+    return library;
+}
+
+} // namespace effects
+} // namespace gamma
@@ -0,0 +1,41 @@
+#include "effects/Effects.h"
+#include <algorithm>
+#include <cstring>
+
+namespace gamma {
+namespace effects {
+
+void ColorLutEffect::prepare(const Frame& /*input*/, const float* parameters, const EffectContext& /*context*/) {
+    const int look = static_cast<int>(parameters[0] + 0.5f);
+    _amount = std::max(0.0f, std::min(1.0f, parameters[1]));
+    _amountWeight = static_cast<uint32_t>(_amount * 256.0f + 0.5f);
+    _lut = _amountWeight > 0 ? getLutLibrary().get(look) : nullptr;
+    _kernels = &getKernels();
+}
+
+void ColorLutEffect::processRow(const uint32_t* src, uint32_t* dst, int width, int /*y*/) {
+    const size_t count = static_cast<size_t>(width);
+    if (!_lut) {
+        std::memcpy(dst, src, count * sizeof(uint32_t));
+        return;
+    }
+    _kernels->applyLut(src, dst, count, _lut->getGrid());
+    if (_amountWeight < 256) {
+        _kernels->blend(src, dst, dst, count, _amountWeight);
+    }
+}
+
+void ColorLutEffect::processRowFloat(const float* src, float* dst, int width, int /*y*/) {
+    const size_t count = static_cast<size_t>(width);
+    if (!_lut) {
+        std::memcpy(dst, src, count * 4 * sizeof(float));
+        return;
+    }
+    _kernels->applyLutFloat(src, dst, count, _lut->getGrid());
+    if (_amount < 1.0f) {
+        _kernels->blendFloat(src, dst, dst, count, _amount);
+    }
+}
+
+} // namespace effects
+} // namespace gamma
@@ -0,0 +1,29 @@
+#include "effects/ComposedRemap.h"
+#include "effects/ContentKey.h"
+
+namespace gamma {
+namespace effects {
+
+std::shared_ptr<const RemapGrid> ComposedRemap::compose(const std::vector<const RemapEffect*>& maps,
+                                                        int width, int height, core::JobSystem* jobSystem) {
+    _active.clear();
+    uint64_t key = KEY_SEED;
+    for (auto it = maps.rbegin(); it != maps.rend(); ++it) {
+        if ((*it)->getMapKey() != 0) {
+            _active.push_back(*it);
+            key = combineKey(key, (*it)->getMapKey());
+        }
+    }
+    if (_active.empty()) {
+        return nullptr;
+    }
+
+    return _grids.get(key != 0 ? key : 1, width, height, [this](float* x, float* y, size_t count) {
+        for (const RemapEffect* effect : _active) {
+            effect->mapPoints(x, y, count);
+        }
+    }, jobSystem);
+}
+
+} // namespace effects
+} // namespace gamma
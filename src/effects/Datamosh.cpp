@@ -0,0 +1,144 @@
+#include "effects/Effects.h"
+#include "effects/PixelRows.h"
+#include <algorithm>
+#include <cstring>
+
+namespace gamma {
+namespace effects {
+
+namespace {
+    const int BLOCK_UNIT = 4;   // Block Size parameter is in units of 4 pixels
+
+    // Stateless per-block random numbers: same block, same frame, same result
+    uint32_t hashBlock(uint32_t x, uint32_t y, uint32_t frame, uint32_t salt) {
+        uint32_t h = x * 0x8DA6B343u ^ y * 0xD8163841u ^ frame * 0xCB1AB31Fu ^ salt;
+        h ^= h >> 16;
+        h *= 0x7FEB352Du;
+        h ^= h >> 15;
+        h *= 0x846CA68Bu;
+        h ^= h >> 16;
+        return h;
+    }
+
+    float toUnit(uint32_t hash) {
+        return static_cast<float>(hash >> 8) * (1.0f / 16777216.0f);
+    }
+}
+
+void DatamoshEffect::prepare(const Frame& /*input*/, const float* parameters, const EffectContext& context) {
+    _intensity = std::max(0.0f, std::min(1.0f, parameters[0]));
+    _blockSize = std::max(1, static_cast<int>(parameters[1] + 0.5f)) * BLOCK_UNIT;
+    float chaos = std::max(0.0f, std::min(1.0f, parameters[2]));
+    _maxDisplacement = static_cast<int>(chaos * static_cast<float>(_blockSize));
+    _frame = static_cast<uint32_t>(context.frameIndex);
+
+    // Last frame's output is read while this one is recorded into another buffer
+    _previous = nullptr;
+    _recorded = nullptr;
+    if (_history.bind(context.history)) {
+        _history.setSpan(0.0);
+        _previous = _history.getNewest();
+        _recorded = _history.record();
+    }
+    if (_intensity <= 0.0f) {
+        _previous = nullptr;
+    }
+}
+
+void DatamoshEffect::processRows(const Frame& input, Frame& output, int yBegin, int yEnd) {
+    if (usesFloatPixels()) {
+        processRowsFloat(input, output, yBegin, yEnd);
+        return;
+    }
+
+    const int width = input.getWidth();
+    const int height = input.getHeight();
+    const size_t rowBytes = static_cast<size_t>(width) * sizeof(uint32_t);
+
+    for (int y = yBegin; y < yEnd; ++y) {
+        uint32_t* dst = output.row(y);
+
+        if (!_previous) {
+            std::memcpy(dst, input.row(y), rowBytes);
+        } else {
+            // Decisions are per block, so every row of a block agrees even
+            // when the block straddles two bands
+            const int blockY = y - y % _blockSize;
+            const int blockRows = std::min(_blockSize, height - blockY);
+            const uint32_t by = static_cast<uint32_t>(blockY / _blockSize);
+
+            for (int blockX = 0; blockX < width; blockX += _blockSize) {
+                const int columns = std::min(_blockSize, width - blockX);
+                const size_t blockBytes = static_cast<size_t>(columns) * sizeof(uint32_t);
+                const uint32_t bx = static_cast<uint32_t>(blockX / _blockSize);
+
+                if (toUnit(hashBlock(bx, by, _frame, 0)) >= _intensity) {
+                    std::memcpy(dst + blockX, input.row(y) + blockX, blockBytes);
+                    continue;
+                }
+
+                // Smear: reuse the previous output, displaced but kept inside the frame
+                int dx = static_cast<int>((toUnit(hashBlock(bx, by, _frame, 1)) * 2.0f - 1.0f) * _maxDisplacement);
+                int dy = static_cast<int>((toUnit(hashBlock(bx, by, _frame, 2)) * 2.0f - 1.0f) * _maxDisplacement);
+                int sourceX = std::max(0, std::min(width - columns, blockX + dx));
+                int sourceY = std::max(0, std::min(height - blockRows, blockY + dy));
+
+                std::memcpy(dst + blockX, _previous->row(sourceY + (y - blockY)) + sourceX, blockBytes);
+            }
+        }
+
+        if (_recorded) {
+            std::memcpy(_recorded->row(y), dst, rowBytes);
+        }
+    }
+}
+
+void DatamoshEffect::processRowsFloat(const Frame& input, Frame& output, int yBegin, int yEnd) const {
+    const int width = input.getWidth();
+    const int height = input.getHeight();
+    const size_t count = static_cast<size_t>(width);
+    float* result = getRowBuffer(1, count);
+
+    // Same block decisions as the RGBA8 path; the row is built in float and
+    // converted once for the output and once for the recording
+    for (int y = yBegin; y < yEnd; ++y) {
+        float* dst = getStoreTarget(output, 0, y, result);
+        readPixels(input, 0, y, count, dst);
+
+        if (_previous) {
+            const int blockY = y - y % _blockSize;
+            const int blockRows = std::min(_blockSize, height - blockY);
+            const uint32_t by = static_cast<uint32_t>(blockY / _blockSize);
+
+            for (int blockX = 0; blockX < width; blockX += _blockSize) {
+                const int columns = std::min(_blockSize, width - blockX);
+                const uint32_t bx = static_cast<uint32_t>(blockX / _blockSize);
+                if (toUnit(hashBlock(bx, by, _frame, 0)) >= _intensity) {
+                    continue;
+                }
+
+                int dx = static_cast<int>((toUnit(hashBlock(bx, by, _frame, 1)) * 2.0f - 1.0f) * _maxDisplacement);
+                int dy = static_cast<int>((toUnit(hashBlock(bx, by, _frame, 2)) * 2.0f - 1.0f) * _maxDisplacement);
+                int sourceX = std::max(0, std::min(width - columns, blockX + dx));
+                int sourceY = std::max(0, std::min(height - blockRows, blockY + dy));
+
+                readPixels(*_previous, sourceX, sourceY + (y - blockY), static_cast<size_t>(columns),
+                           dst + static_cast<size_t>(blockX) * 4);
+            }
+        }
+
+        writePixels(dst, output, 0, y, count);
+        if (_recorded) {
+            writePixels(dst, *_recorded, 0, y, count);
+        }
+    }
+}
+
+void DatamoshEffect::reset() {
+    _history.clear();
+    _previous = nullptr;
+    _recorded = nullptr;
+}
+
+} // namespace effects
+} // namespace gamma
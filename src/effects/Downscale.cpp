@@ -0,0 +1,76 @@
+#include "effects/Downscale.h"
+#include "effects/Kernels.h"
+#include "core/JobSystem.h"
+#include <vector>
+
+namespace gamma {
+namespace effects {
+
+static_assert(MAX_DOWNSCALE_FACTOR <= MAX_BOX_FILTER_TAPS, "Block rows are summed by the box filter kernels");
+
+namespace {
+    const size_t MIN_ROWS_PER_TASK = 8;
+
+    // dst[i] = average of src[i * factor .. i * factor + factor - 1], per channel
+    void reduceRow(const uint32_t* src, uint32_t* dst, size_t count, int factor, uint32_t scale) {
+        for (size_t i = 0; i < count; ++i) {
+            const uint32_t* block = src + i * static_cast<size_t>(factor);
+            uint32_t redBlue = 0;
+            uint32_t greenAlpha = 0;
+            for (int t = 0; t < factor; ++t) {
+                redBlue += block[t] & 0x00FF00FFu;
+                greenAlpha += (block[t] >> 8) & 0x00FF00FFu;
+            }
+            dst[i] = (((redBlue & 0xFFFF) * scale) >> 16)
+                   | ((((greenAlpha & 0xFFFF) * scale) >> 16) << 8)
+                   | ((((redBlue >> 16) * scale) >> 16) << 16)
+                   | ((((greenAlpha >> 16) * scale) >> 16) << 24);
+        }
+    }
+}
+
+void downscaleRows(const Frame& source, Frame& destination, int factor, int yBegin, int yEnd) {
+    const BoxFilterFunction boxFilter = getKernels().boxFilter[factor];
+    const uint32_t scale = (65536u + static_cast<uint32_t>(factor) - 1) / static_cast<uint32_t>(factor);
+    const size_t width = static_cast<size_t>(destination.getWidth());
+    const size_t blockWidth = width * static_cast<size_t>(factor);
+
+    // Column sums of one block row, reused across calls on this thread
+    thread_local std::vector<uint32_t> columns;
+    columns.resize(blockWidth);
+
+    const uint32_t* rows[MAX_DOWNSCALE_FACTOR];
+    for (int y = yBegin; y < yEnd; ++y) {
+        for (int t = 0; t < factor; ++t) {
+            rows[t] = source.row(y * factor + t);
+        }
+        boxFilter(rows, columns.data(), blockWidth, scale);
+        reduceRow(columns.data(), destination.row(y), width, factor, scale);
+    }
+}
+
+void downscaleFrame(const Frame& source, Frame& destination, int factor, core::JobSystem* jobSystem) {
+    if (factor < 2 || factor > MAX_DOWNSCALE_FACTOR) {
+        destination.resize(0, 0);
+        return;
+    }
+
+    const int width = getDownscaledSize(source.getWidth(), factor);
+    const int height = getDownscaledSize(source.getHeight(), factor);
+    destination.resize(width, height);
+    destination.setContentId(makeContentId());
+    if (destination.empty()) {
+        return;
+    }
+
+    if (jobSystem && static_cast<size_t>(height) > MIN_ROWS_PER_TASK) {
+        jobSystem->parallelFor(0, static_cast<size_t>(height), MIN_ROWS_PER_TASK, [&](size_t begin, size_t end) {
+            downscaleRows(source, destination, factor, static_cast<int>(begin), static_cast<int>(end));
+        });
+    } else {
+        downscaleRows(source, destination, factor, 0, height);
+    }
+}
+
+} // namespace effects
+} // namespace gamma
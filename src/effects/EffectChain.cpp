@@ -0,0 +1,82 @@
+#include "effects/EffectChain.h"
+#include <algorithm>
+#include <cstring>
+
+namespace gamma {
+namespace effects {
+
+EffectChain::EffectChain()
+    : _size(0)
+    , _nextId(1) {
+    std::fill(std::begin(_types), std::end(_types), EffectType::ColorCorrection);
+    std::fill(std::begin(_ids), std::end(_ids), 0u);
+    std::fill(std::begin(_flags), std::end(_flags), static_cast<uint8_t>(0));
+    std::fill(std::begin(_values), std::end(_values), 0.0f);
+    std::fill(std::begin(_smoothing), std::end(_smoothing), 0.0f);
+    std::fill(std::begin(_parameterEnabled), std::end(_parameterEnabled), static_cast<uint8_t>(0));
+}
+
+bool EffectChain::add(EffectType type, bool active) {
+    if (full()) {
+        return false;
+    }
+
+    const size_t slot = _size++;
+    _types[slot] = type;
+    _ids[slot] = _nextId++;
+    _flags[slot] = active ? FLAG_ACTIVE : 0;
+
+    const EffectDescriptor& descriptor = getEffectDescriptor(type);
+    for (int p = 0; p < MAX_EFFECT_PARAMETERS; ++p) {
+        bool used = p < descriptor.parameterCount;
+        _values[index(slot, p)] = used ? descriptor.getParameter(p).defaultValue : 0.0f;
+        _smoothing[index(slot, p)] = used ? descriptor.getParameter(p).smoothing : 0.0f;
+        _parameterEnabled[index(slot, p)] = used ? 1 : 0;
+    }
+    return true;
+}
+
+void EffectChain::remove(size_t slot) {
+    if (slot >= _size) {
+        return;
+    }
+
+    const size_t following = _size - slot - 1;
+    std::memmove(_types + slot, _types + slot + 1, following * sizeof(_types[0]));
+    std::memmove(_ids + slot, _ids + slot + 1, following * sizeof(_ids[0]));
+    std::memmove(_flags + slot, _flags + slot + 1, following * sizeof(_flags[0]));
+
+    const size_t begin = index(slot, 0);
+    const size_t count = following * MAX_EFFECT_PARAMETERS;
+    std::memmove(_values + begin, _values + begin + MAX_EFFECT_PARAMETERS, count * sizeof(_values[0]));
+    std::memmove(_smoothing + begin, _smoothing + begin + MAX_EFFECT_PARAMETERS, count * sizeof(_smoothing[0]));
+    std::memmove(_parameterEnabled + begin, _parameterEnabled + begin + MAX_EFFECT_PARAMETERS,
+                 count * sizeof(_parameterEnabled[0]));
+    --_size;
+}
+
+void EffectChain::resetParameter(size_t slot, int parameter) {
+    _values[index(slot, parameter)] = getDescriptor(slot).getParameter(parameter).defaultValue;
+}
+
+void EffectChain::buildSlots(std::vector<ChainSlot>& slots) const {
+    slots.resize(_size);
+
+    for (size_t i = 0; i < _size; ++i) {
+        const EffectDescriptor& descriptor = getDescriptor(i);
+        ChainSlot& slot = slots[i];
+
+        slot.type = _types[i];
+        slot.id = _ids[i];
+        slot.enabled = isActive(i) && !isBypassed(i);
+        slot.parameterCount = descriptor.parameterCount;
+        for (int p = 0; p < descriptor.parameterCount; ++p) {
+            const size_t at = index(i, p);
+            slot.parameters[p] = _parameterEnabled[at] ? _values[at] : descriptor.getParameter(p).defaultValue;
+            slot.smoothing[p] = _smoothing[at];
+        }
+    }
+}
+
+} // namespace effects
+} // namespace gamma
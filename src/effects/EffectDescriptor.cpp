@@ -0,0 +1,113 @@
+#include "effects/EffectDescriptor.h"
+
+namespace gamma {
+namespace effects {
+
+namespace {
+    // Default slew for continuous parameters: enough to hide MIDI's 7-bit steps
+    const float SMOOTHING = 0.05f;
+
+    const ParameterDescriptor PARAMETERS[] = {
+        // Color Correction
+        {"Brightness", -1.0f, 1.0f, 0.0f, SMOOTHING, false},
+        {"Contrast", 0.0f, 3.0f, 1.0f, SMOOTHING, false},
+        {"Saturation", 0.0f, 2.0f, 1.0f, SMOOTHING, false},
+        {"Hue Shift", -180.0f, 180.0f, 0.0f, SMOOTHING, false},
+        // Chromatic Aberration
+        {"Strength", 0.0f, 1.0f, 0.0f, SMOOTHING, false},
+        {"Red Offset", -50.0f, 50.0f, 0.0f, SMOOTHING, false, true},
+        {"Blue Offset", -50.0f, 50.0f, 0.0f, SMOOTHING, false, true},
+        // Datamosh
+        {"Intensity", 0.0f, 1.0f, 0.0f, SMOOTHING, false},
+        {"Block Size", 1.0f, 32.0f, 8.0f, 0.0f, true, true},
+        {"Chaos", 0.0f, 1.0f, 0.5f, SMOOTHING, false},
+        // Motion Blur
+        {"Amount", 0.0f, 1.0f, 0.0f, SMOOTHING, false},
+        {"Angle", 0.0f, 360.0f, 0.0f, SMOOTHING, false},
+        {"Samples", 1.0f, 32.0f, 8.0f, 0.0f, true},
+        // Mirror
+        {"Mode", 0.0f, 3.0f, 0.0f, 0.0f, true},    // 0=none, 1=horizontal, 2=vertical, 3=both
+        {"Center X", 0.0f, 1.0f, 0.5f, SMOOTHING, false},
+        {"Center Y", 0.0f, 1.0f, 0.5f, SMOOTHING, false},
+        // Time Echo
+        {"Delay", 0.01f, 1.0f, 0.1f, SMOOTHING, false},
+        {"Feedback", 0.0f, 0.95f, 0.5f, SMOOTHING, false},
+        {"Mix", 0.0f, 1.0f, 0.5f, SMOOTHING, false},
+        // Color LUT
+        {"Look", 0.0f, 31.0f, 0.0f, 0.0f, true},    // Index into the LUT library
+        {"Amount", 0.0f, 1.0f, 1.0f, SMOOTHING, false},
+        // Kaleidoscope
+        {"Segments", 1.0f, 16.0f, 1.0f, 0.0f, true},   // 1 = pass through
+        {"Rotation", -180.0f, 180.0f, 0.0f, SMOOTHING, false},
+        {"Center X", 0.0f, 1.0f, 0.5f, SMOOTHING, false},
+        {"Center Y", 0.0f, 1.0f, 0.5f, SMOOTHING, false},
+        // Polar
+        {"Mode", 0.0f, 2.0f, 0.0f, 0.0f, true},    // 0=none, 1=to polar, 2=to rectangular
+        {"Rotation", -180.0f, 180.0f, 0.0f, SMOOTHING, false},
+        {"Zoom", 0.25f, 4.0f, 1.0f, SMOOTHING, false},
+        // Tile
+        {"Tiles X", 1.0f, 16.0f, 1.0f, 0.0f, true},
+        {"Tiles Y", 1.0f, 16.0f, 1.0f, 0.0f, true},
+        {"Mirror", 0.0f, 1.0f, 0.0f, 0.0f, true},
+        // Warp
+        {"Amount", 0.0f, 1.0f, 0.0f, SMOOTHING, false},
+        {"Frequency", 0.5f, 16.0f, 3.0f, SMOOTHING, false},
+        {"Phase", 0.0f, 360.0f, 0.0f, SMOOTHING, false}
+    };
+
+    const EffectDescriptor EFFECTS[] = {
+        {EffectType::ColorCorrection, "Color Correction", EffectCategory::Color, 0, 4},
+        {EffectType::ChromaticAberration, "Chromatic Aberration", EffectCategory::Color, 4, 3},
+        {EffectType::Datamosh, "Datamosh", EffectCategory::Distortion, 7, 3},
+        {EffectType::MotionBlur, "Motion Blur", EffectCategory::Blur, 10, 3},
+        {EffectType::Mirror, "Mirror", EffectCategory::Geometry, 13, 3},
+        {EffectType::TimeEcho, "Time Echo", EffectCategory::Time, 16, 3},
+        {EffectType::ColorLut, "Color LUT", EffectCategory::Color, 19, 2},
+        {EffectType::Kaleidoscope, "Kaleidoscope", EffectCategory::Geometry, 21, 4},
+        {EffectType::Polar, "Polar", EffectCategory::Geometry, 25, 3},
+        {EffectType::Tile, "Tile", EffectCategory::Geometry, 28, 3},
+        {EffectType::Warp, "Warp", EffectCategory::Geometry, 31, 3}
+    };
+
+    const char* const CATEGORY_NAMES[] = {
+        "Color",
+        "Distortion",
+        "Blur",
+        "Geometry",
+        "Time"
+    };
+
+    static_assert(sizeof(EFFECTS) / sizeof(EFFECTS[0]) == static_cast<size_t>(EffectType::Count),
+                  "Every effect type needs a descriptor");
+    static_assert(sizeof(CATEGORY_NAMES) / sizeof(CATEGORY_NAMES[0]) == static_cast<size_t>(EffectCategory::Count),
+                  "Every category needs a name");
+    static_assert(sizeof(PARAMETERS) / sizeof(PARAMETERS[0]) == 34,
+                  "Parameter table out of sync with the effect descriptors");
+}
+
+const ParameterDescriptor& EffectDescriptor::getParameter(int index) const {
+    return PARAMETERS[firstParameter + index];
+}
+
+const EffectDescriptor& getEffectDescriptor(EffectType type) {
+    return EFFECTS[static_cast<size_t>(type)];
+}
+
+const ParameterDescriptor& getParameterDescriptor(ParameterId id) {
+    return PARAMETERS[id];
+}
+
+size_t getParameterDescriptorCount() {
+    return sizeof(PARAMETERS) / sizeof(PARAMETERS[0]);
+}
+
+const char* getEffectCategoryName(EffectCategory category) {
+    int index = static_cast<int>(category);
+    if (index < 0 || index >= static_cast<int>(EffectCategory::Count)) {
+        return "Unknown";
+    }
+    return CATEGORY_NAMES[index];
+}
+
+} // namespace effects
+} // namespace gamma
@@ -0,0 +1,691 @@
+#include "effects/EffectEngine.h"
+#include "effects/Downscale.h"
+#include "effects/ContentKey.h"
+#include "effects/Kernels.h"
+#include "effects/PixelRows.h"
+#include "core/Math.h"
+#include <algorithm>
+
+namespace gamma {
+namespace effects {
+
+namespace {
+    const double SMOOTHING = 0.1;   // Weight of the newest sample in the moving averages
+
+    double smooth(double average, double sample) {
+        return average + (sample - average) * SMOOTHING;
+    }
+
+    // Grey pixel of the Rec.601 luma, in 8-bit fixed point
+    void matteRow(const uint32_t* src, uint32_t* dst, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            uint32_t pixel = src[i];
+            uint32_t luma = ((pixel & 0xFF) * 77 + ((pixel >> 8) & 0xFF) * 150 + ((pixel >> 16) & 0xFF) * 29 + 128) >> 8;
+            dst[i] = packPixel(luma, luma, luma);
+        }
+    }
+
+    // Blend kernel with the weight scaled per pixel by the matte's luma
+    void blendMatteRow(const uint32_t* a, const uint32_t* b, const uint32_t* matte, uint32_t* dst,
+                       size_t count, uint32_t weight) {
+        for (size_t i = 0; i < count; ++i) {
+            uint32_t w = (weight * (matte[i] & 0xFF) + 127) / 255;
+            // Two channels per multiply: each 16-bit lane holds at most 255 * 256
+            uint32_t redBlue = ((a[i] & 0x00FF00FF) * (256 - w) + (b[i] & 0x00FF00FF) * w) >> 8;
+            uint32_t greenAlpha = ((a[i] >> 8) & 0x00FF00FF) * (256 - w) + ((b[i] >> 8) & 0x00FF00FF) * w;
+            dst[i] = (redBlue & 0x00FF00FF) | (greenAlpha & 0xFF00FF00);
+        }
+    }
+
+    // matteRow() on float pixels
+    void matteRowFloat(const float* src, float* dst, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            const float* pixel = src + i * 4;
+            float luma = pixel[0] * (77.0f / 256.0f) + pixel[1] * (150.0f / 256.0f) + pixel[2] * (29.0f / 256.0f);
+            dst[i * 4 + 0] = luma;
+            dst[i * 4 + 1] = luma;
+            dst[i * 4 + 2] = luma;
+            dst[i * 4 + 3] = 1.0f;
+        }
+    }
+
+    // blendMatteRow() on float pixels; the matte's red channel scales the weight
+    void blendMatteRowFloat(const float* a, const float* b, const float* matte, float* dst,
+                            size_t count, float weight) {
+        for (size_t i = 0; i < count; ++i) {
+            const float w = weight * std::max(0.0f, std::min(1.0f, matte[i * 4]));
+            for (size_t c = i * 4; c < i * 4 + 4; ++c) {
+                dst[c] = a[c] + (b[c] - a[c]) * w;
+            }
+        }
+    }
+}
+
+EffectEngine::EffectEngine(core::JobSystem* jobSystem)
+    : _jobSystem(jobSystem)
+    , _colorPrecompositionEnabled(true)
+    , _width(0)
+    , _height(0)
+    , _bandRows(0)
+    , _slotNanosecondsCapacity(0)
+    , _previewFactor(0)
+    , _previewSourceId(0)
+    , _frameIndex(0)
+    , _lastTime(0.0)
+    , _processTimeMs(0.0)
+    , _previewTimeMs(0.0)
+    , _intervalMs(0.0)
+    , _hasProcessed(false) {
+}
+
+EffectEngine::~EffectEngine() = default;
+
+const Frame& EffectEngine::process(const Frame& input, Frame& output, const std::vector<ChainSlot>& chain,
+                                   float masterMix, double time) {
+    _chainGraph.buildFromChain(chain, std::max(0.0f, std::min(1.0f, masterMix)));
+    _chainSources.assign(1, &input);
+    const Frame* result = &output;
+    processGraph(_chainSources, output, _chainGraph, time, &result);
+    return *result;
+}
+
+bool EffectEngine::processGraph(const std::vector<const Frame*>& sources, Frame& output,
+                                const EffectGraph& graph, double time, const Frame** result) {
+    if (sources.empty() || !sources[0]) {
+        return false;
+    }
+    const int width = sources[0]->getWidth();
+    const int height = sources[0]->getHeight();
+    for (const Frame* source : sources) {
+        if (!source || source->getWidth() != width || source->getHeight() != height) {
+            return false;
+        }
+    }
+
+    syncSlots(graph);
+    if (!_plan.compile(graph, sources, _planNodes)) {
+        return false;
+    }
+
+    const Clock::time_point start = Clock::now();
+    if (_hasProcessed) {
+        _intervalMs = smooth(_intervalMs, std::chrono::duration<double, std::milli>(start - _lastProcessStart).count());
+    }
+    _lastProcessStart = start;
+
+    _width = width;
+    _height = height;
+    output.resize(width, height, PixelFormat::RGBA8);
+
+    EffectContext context;
+    context.time = time;
+    context.deltaTime = _hasProcessed ? static_cast<float>(time - _lastTime) : 0.0f;
+    context.frameIndex = _frameIndex++;
+    context.history = &_history;
+    context.format = _plan.getFormat();
+    _lastTime = time;
+    _hasProcessed = true;
+
+    const size_t nodeCount = graph.getNodeCount();
+    for (size_t n = 0; n < nodeCount; ++n) {
+        _slotNanoseconds[n].store(0, std::memory_order_relaxed);
+    }
+
+    smoothParameters(graph, context.deltaTime);
+    _plan.computeKeys(graph, sources, _planNodes);
+    const uint64_t resultKey = _plan.getResultKey();
+
+    const Frame* resultFrame = &output;
+    if (resultKey != 0 && output.getContentId() == resultKey) {
+        // Same input, same parameters: the output already holds this frame
+        _plan.countOutputHit();
+    } else if (_plan.getStageCount() == 0) {
+        // Nothing renders: the output is one of the sources passed through,
+        // handed back as it is when the caller takes the result by reference
+        const Frame& source = *sources[static_cast<size_t>(graph.getNode(_plan.getResult()).sourceIndex)];
+        if (result) {
+            resultFrame = &source;
+        } else {
+            output.copyFrom(source);
+            output.setContentId(resultKey);
+        }
+    } else {
+        _plan.skipCachedStages();
+        _plan.foldBlends();
+        const PixelFormat format = _plan.getFormat();
+        _history.beginFrame(width, height, time, format);
+        _plan.assignBuffers(graph, sources, output);
+
+        // Per-frame constants first, in stage order; halos are known afterwards
+        const size_t stageCount = _plan.getStageCount();
+        for (size_t s = 0; s < stageCount; ++s) {
+            Stage& stage = _plan.getStage(s);
+            stage.halo = 0;
+            if (stage.kind != StageKind::Effect && stage.kind != StageKind::Fused && stage.kind != StageKind::Remap) {
+                continue;
+            }
+            for (NodeId node : stage.nodes) {
+                Slot& slot = _slots[static_cast<size_t>(node)];
+                slot.processor->setFloatPixels(format != PixelFormat::RGBA8);
+                slot.processor->prepare(*stage.inputs[0], slot.values, context);
+                stage.halo = std::max(stage.halo, slot.processor->getInputHalo(height));
+            }
+            precomposeColorRuns(stage);
+            composeRemaps(stage);
+        }
+
+        const int participants = _jobSystem ? static_cast<int>(_jobSystem->getWorkerCount()) + 1 : 1;
+        const int bandRows = std::max(MIN_BAND_ROWS,
+                                      (height + participants * BANDS_PER_THREAD - 1) / (participants * BANDS_PER_THREAD));
+
+        _tileScratch.resize(static_cast<size_t>(participants));
+        if (participants > 1 && bandRows < height) {
+            for (size_t s = 0; s < stageCount; ++s) {
+                _plan.addDependencies(s);
+            }
+            executeParallel(height, bandRows);
+        } else {
+            executeSerial(height);
+        }
+        output.setContentId(resultKey);
+    }
+
+    for (size_t n = 0; n < nodeCount; ++n) {
+        _slots[n].timeMs = smooth(_slots[n].timeMs, _slotNanoseconds[n].load(std::memory_order_relaxed) * 1e-6);
+    }
+
+    _processTimeMs = smooth(_processTimeMs, std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+
+    // The preview tap is timed on its own, after the program output
+    if (result) {
+        *result = resultFrame;
+    }
+    updatePreview(*resultFrame);
+    return true;
+}
+
+void EffectEngine::setPreviewFactor(int factor) {
+    _previewFactor = (factor >= 2) ? std::min(factor, MAX_DOWNSCALE_FACTOR) : 0;
+    _previewSourceId = 0;
+    if (_previewFactor == 0) {
+        _preview = Frame();
+    }
+}
+
+void EffectEngine::updatePreview(const Frame& result) {
+    if (_previewFactor == 0) {
+        return;
+    }
+    // A result seen before (paused clip, bypassed chain over a still source)
+    // already has its preview
+    const uint64_t sourceId = result.getContentId();
+    double elapsedMs = 0.0;
+    if (sourceId == 0 || sourceId != _previewSourceId) {
+        const Clock::time_point start = Clock::now();
+        downscaleFrame(result, _preview, _previewFactor, _jobSystem);
+        _previewSourceId = sourceId;
+        elapsedMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+    _previewTimeMs = smooth(_previewTimeMs, elapsedMs);
+}
+
+void EffectEngine::executeSerial(int height) {
+    for (size_t s = 0; s < _plan.getStageCount(); ++s) {
+        runStage(s, 0, height);
+    }
+}
+
+void EffectEngine::executeParallel(int height, int bandRows) {
+    _bandRows = bandRows;
+    const int bandCount = (height + bandRows - 1) / bandRows;
+    const size_t stageCount = _plan.getStageCount();
+
+    if (_bandTasks.size() < stageCount) {
+        _bandTasks.resize(stageCount);
+    }
+
+    for (size_t s = 0; s < stageCount; ++s) {
+        auto& tasks = _bandTasks[s];
+        tasks.resize(static_cast<size_t>(bandCount));
+
+        for (int band = 0; band < bandCount; ++band) {
+            const int yBegin = band * bandRows;
+            const int yEnd = std::min(height, yBegin + bandRows);
+
+            // Only the bands of earlier stages covering these rows (see addDependencies);
+            // stages on other branches are not waited for
+            _dependencies.clear();
+            for (const Dependency& dependency : _plan.getStage(s).dependencies) {
+                int first = std::max(0, yBegin - dependency.halo) / bandRows;
+                int last = std::min(height - 1, yEnd - 1 + dependency.halo) / bandRows;
+                for (int other = first; other <= last; ++other) {
+                    _dependencies.push_back(_bandTasks[dependency.stage][static_cast<size_t>(other)]);
+                }
+            }
+
+            // Captures stay within std::function's inline storage: no allocation beyond the task
+            const uint32_t stageIndex = static_cast<uint32_t>(s);
+            const uint32_t bandIndex = static_cast<uint32_t>(band);
+            tasks[static_cast<size_t>(band)] = _jobSystem->submitAfter(_dependencies, [this, stageIndex, bandIndex]() {
+                const int bandBegin = static_cast<int>(bandIndex) * _bandRows;
+                runStage(stageIndex, bandBegin, std::min(_height, bandBegin + _bandRows));
+            });
+        }
+    }
+
+    // Every stage feeds the output, and each band of a stage is a dependency
+    // of the same band of its readers, so the output stage finishing means
+    // everything has
+    _jobSystem->waitAll(_bandTasks[_plan.getOutputStage()]);
+
+    for (size_t s = 0; s < stageCount; ++s) {
+        for (auto& task : _bandTasks[s]) {
+            task.reset();
+        }
+    }
+}
+
+void EffectEngine::runStage(size_t stageIndex, int yBegin, int yEnd) {
+    const Stage& stage = _plan.getStage(stageIndex);
+    const size_t node = static_cast<size_t>(stage.nodes.front());
+    const size_t width = static_cast<size_t>(_width);
+
+    switch (stage.kind) {
+        case StageKind::Effect: {
+            const Clock::time_point start = Clock::now();
+            _slots[node].processor->processRows(*stage.inputs[0], *stage.target, yBegin, yEnd);
+            addSlotTime(node, start);
+            if (stage.mixNode != INVALID_NODE) {
+                mixRows(stage, *stage.inputs[MIX_BASE_INPUT], *stage.target, stage.inputs[MIX_MATTE_INPUT], yBegin, yEnd);
+            }
+            break;
+        }
+        case StageKind::Fused:
+            runFused(stage, yBegin, yEnd);
+            break;
+        case StageKind::Remap: {
+            // One sampling pass for the whole run, timed on its first effect
+            const Clock::time_point start = Clock::now();
+            remapRows(stage.grid.get(), *stage.inputs[0], *stage.target, yBegin, yEnd, _plan.getFormat() != PixelFormat::RGBA8);
+            addSlotTime(node, start);
+            if (stage.mixNode != INVALID_NODE) {
+                mixRows(stage, *stage.inputs[MIX_BASE_INPUT], *stage.target, stage.inputs[MIX_MATTE_INPUT], yBegin, yEnd);
+            }
+            break;
+        }
+        case StageKind::Blend:
+            mixRows(stage, *stage.inputs[BLEND_BASE], *stage.inputs[BLEND_LAYER], stage.inputs[BLEND_MATTE], yBegin, yEnd);
+            break;
+        case StageKind::Matte: {
+            const Clock::time_point start = Clock::now();
+            if (_plan.getFormat() == PixelFormat::RGBA8) {
+                for (int y = yBegin; y < yEnd; ++y) {
+                    matteRow(stage.inputs[0]->row(y), stage.target->row(y), width);
+                }
+            } else {
+                float* source = getRowBuffer(0, width);
+                float* result = getRowBuffer(1, width);
+                for (int y = yBegin; y < yEnd; ++y) {
+                    float* dst = getStoreTarget(*stage.target, 0, y, result);
+                    matteRowFloat(loadPixels(*stage.inputs[0], 0, y, width, source), dst, width);
+                    writePixels(dst, *stage.target, 0, y, width);
+                }
+            }
+            addSlotTime(node, start);
+            break;
+        }
+    }
+}
+
+void EffectEngine::precomposeColorRuns(Stage& stage) {
+    stage.colorRuns.clear();
+    if (stage.kind != StageKind::Fused || !_colorPrecompositionEnabled || _plan.getFormat() != PixelFormat::RGBA8) {
+        return;
+    }
+
+    const size_t runLength = stage.nodes.size();
+    size_t first = 0;
+    while (first < runLength) {
+        // Maximal run of color transforms from first
+        size_t end = first;
+        bool lookup = false;
+        uint64_t key = KEY_SEED;
+        _colorRunEffects.clear();
+        while (end < runLength) {
+            const Slot& slot = _slots[static_cast<size_t>(stage.nodes[end])];
+            PointwiseEffect* effect = slot.processor->asPointwise();
+            if (!effect->isColorTransform()) {
+                break;
+            }
+            lookup = lookup || effect->getColorStateId() != 0;
+            key = PrecomposedColorRun::addToKey(key, slot.type, *effect, slot.values);
+            _colorRunEffects.push_back(effect);
+            ++end;
+        }
+
+        // Worth a table only when the run holds one: two matrices alone are cheaper
+        const size_t count = end - first;
+        if (count >= 2 && lookup) {
+            Slot& head = _slots[static_cast<size_t>(stage.nodes[first])];
+            const ColorLut* lut = head.colorRun.update(key, _colorRunEffects.data(), count);
+            if (lut) {
+                stage.colorRuns.push_back({first, count, lut});
+            }
+        }
+        first = std::max(end, first + 1);
+    }
+}
+
+void EffectEngine::composeRemaps(Stage& stage) {
+    stage.grid.reset();
+    if (stage.kind != StageKind::Remap) {
+        return;
+    }
+
+    // Each map's key is followed frame to frame, so EffectPlan::compile can keep
+    // a moving one out of next frame's runs
+    _remapEffects.clear();
+    for (NodeId node : stage.nodes) {
+        Slot& slot = _slots[static_cast<size_t>(node)];
+        const RemapEffect* effect = slot.processor->asRemap();
+        slot.mapMoving = slot.mapKey != 0 && effect->getMapKey() != slot.mapKey;
+        slot.mapKey = effect->getMapKey();
+        _remapEffects.push_back(effect);
+    }
+
+    Slot& head = _slots[static_cast<size_t>(stage.nodes.front())];
+    if (!head.remapRun) {
+        head.remapRun = std::make_unique<ComposedRemap>();
+    }
+    stage.grid = head.remapRun->compose(_remapEffects, _width, _height, _jobSystem);
+}
+
+void EffectEngine::runFused(const Stage& stage, int yBegin, int yEnd) {
+    if (_plan.getFormat() != PixelFormat::RGBA8) {
+        runFusedFloat(stage, yBegin, yEnd);
+        return;
+    }
+
+    const Frame& source = *stage.inputs[0];
+    Frame& target = *stage.target;
+    const int width = source.getWidth();
+    const size_t rowBytes = static_cast<size_t>(width) * sizeof(uint32_t);
+    const int tileRows = std::max(1, std::min(yEnd - yBegin, static_cast<int>(TILE_BYTES / std::max<size_t>(rowBytes, 1))));
+    const size_t runLength = stage.nodes.size();
+
+    TileScratch& scratch = getTileScratch();
+    scratch.tiles[0].resize(width, tileRows, PixelFormat::RGBA8);
+    scratch.tiles[1].resize(width, tileRows, PixelFormat::RGBA8);
+
+    const KernelTable& kernels = getKernels();
+
+    for (int tileY = yBegin; tileY < yEnd; tileY += tileRows) {
+        const int rows = std::min(tileRows, yEnd - tileY);
+
+        // Source rows -> tile -> tile ... -> target rows; per-effect time is
+        // accumulated per tile so the CPU meter keeps its per-node breakdown.
+        // A precomposed color run is one pass, timed on its first effect
+        size_t nextRun = 0;
+        size_t pass = 0;
+        for (size_t k = 0; k < runLength; ++pass) {
+            const ColorRun* colorRun = nullptr;
+            if (nextRun < stage.colorRuns.size() && stage.colorRuns[nextRun].first == k) {
+                colorRun = &stage.colorRuns[nextRun++];
+            }
+            const size_t node = static_cast<size_t>(stage.nodes[k]);
+            PointwiseEffect* effect = _slots[node].processor->asPointwise();
+            k += colorRun ? colorRun->count : 1;
+            const bool last = k == runLength;
+            const Clock::time_point start = Clock::now();
+
+            for (int r = 0; r < rows; ++r) {
+                const uint32_t* src = (pass == 0) ? source.row(tileY + r) : scratch.tiles[(pass - 1) & 1].row(r);
+                uint32_t* dst = last ? target.row(tileY + r) : scratch.tiles[pass & 1].row(r);
+                if (colorRun) {
+                    kernels.applyLut(src, dst, static_cast<size_t>(width), colorRun->lut->getGrid());
+                } else {
+                    effect->processRow(src, dst, width, tileY + r);
+                }
+            }
+
+            addSlotTime(node, start);
+        }
+
+        // A folded blend mixes the rows just written, while they are still in cache
+        if (stage.mixNode != INVALID_NODE) {
+            mixRows(stage, *stage.inputs[MIX_BASE_INPUT], target, stage.inputs[MIX_MATTE_INPUT], tileY, tileY + rows);
+        }
+    }
+}
+
+void EffectEngine::runFusedFloat(const Stage& stage, int yBegin, int yEnd) {
+    const Frame& source = *stage.inputs[0];
+    Frame& target = *stage.target;
+    const int width = source.getWidth();
+    const size_t count = static_cast<size_t>(width);
+    const size_t rowBytes = count * getPixelBytes(PixelFormat::RGBA32F);
+    const int tileRows = std::max(1, std::min(yEnd - yBegin, static_cast<int>(TILE_BYTES / std::max<size_t>(rowBytes, 1))));
+    const size_t runLength = stage.nodes.size();
+
+    // Tiles are always RGBA32F: they never leave the cache, so a narrower
+    // format would only add conversions. The source is converted as the first
+    // effect reads it and the target as the last one (or a folded blend) writes it
+    const bool mixed = stage.mixNode != INVALID_NODE;
+    TileScratch& scratch = getTileScratch();
+    scratch.tiles[0].resize(width, tileRows, PixelFormat::RGBA32F);
+    scratch.tiles[1].resize(width, tileRows, PixelFormat::RGBA32F);
+    float* sourceRow = getRowBuffer(0, count);
+
+    for (int tileY = yBegin; tileY < yEnd; tileY += tileRows) {
+        const int rows = std::min(tileRows, yEnd - tileY);
+
+        for (size_t k = 0; k < runLength; ++k) {
+            const size_t node = static_cast<size_t>(stage.nodes[k]);
+            PointwiseEffect* effect = _slots[node].processor->asPointwise();
+            const bool last = k + 1 == runLength && !mixed;
+            const Clock::time_point start = Clock::now();
+
+            for (int r = 0; r < rows; ++r) {
+                const int y = tileY + r;
+                const float* src = (k == 0) ? loadPixels(source, 0, y, count, sourceRow)
+                                            : scratch.tiles[(k - 1) & 1].rowFloat(r);
+                float* dst = scratch.tiles[k & 1].rowFloat(r);
+                if (last) {
+                    dst = getStoreTarget(target, 0, y, dst);
+                }
+                effect->processRowFloat(src, dst, width, y);
+                if (last) {
+                    writePixels(dst, target, 0, y, count);
+                }
+            }
+
+            addSlotTime(node, start);
+        }
+
+        if (mixed) {
+            const Clock::time_point start = Clock::now();
+            const Frame& layer = scratch.tiles[(runLength - 1) & 1];
+            for (int r = 0; r < rows; ++r) {
+                mixRowFloat(stage, *stage.inputs[MIX_BASE_INPUT], layer.rowFloat(r), stage.inputs[MIX_MATTE_INPUT],
+                            tileY + r);
+            }
+            addSlotTime(static_cast<size_t>(stage.mixNode), start);
+        }
+    }
+}
+
+void EffectEngine::mixRows(const Stage& stage, const Frame& base, const Frame& layer, const Frame* matte,
+                           int yBegin, int yEnd) {
+    const Clock::time_point start = Clock::now();
+    const KernelTable& kernels = getKernels();
+    const size_t width = static_cast<size_t>(_width);
+    Frame& target = *stage.target;
+    if (_plan.getFormat() == PixelFormat::RGBA8) {
+        for (int y = yBegin; y < yEnd; ++y) {
+            if (matte) {
+                blendMatteRow(base.row(y), layer.row(y), matte->row(y), target.row(y), width, stage.mixWeight);
+            } else {
+                kernels.blend(base.row(y), layer.row(y), target.row(y), width, stage.mixWeight);
+            }
+        }
+    } else {
+        // The layer may be the target itself (a folded blend): rows are read before they are written
+        float* layerRow = getRowBuffer(1, width);
+        for (int y = yBegin; y < yEnd; ++y) {
+            mixRowFloat(stage, base, loadPixels(layer, 0, y, width, layerRow), matte, y);
+        }
+    }
+    addSlotTime(static_cast<size_t>(stage.getResultNode()), start);
+}
+
+void EffectEngine::mixRowFloat(const Stage& stage, const Frame& base, const float* layer, const Frame* matte, int y) {
+    const size_t width = static_cast<size_t>(_width);
+    const float weight = static_cast<float>(stage.mixWeight) / 256.0f;
+    Frame& target = *stage.target;
+
+    const float* a = loadPixels(base, 0, y, width, getRowBuffer(0, width));
+    float* dst = getStoreTarget(target, 0, y, getRowBuffer(3, width));
+    if (matte) {
+        blendMatteRowFloat(a, layer, loadPixels(*matte, 0, y, width, getRowBuffer(2, width)), dst, width, weight);
+    } else {
+        getKernels().blendFloat(a, layer, dst, width, weight);
+    }
+    writePixels(dst, target, 0, y, width);
+}
+
+EffectEngine::TileScratch& EffectEngine::getTileScratch() {
+    // Workers use their own entry; the calling thread (helping while it waits) uses the last
+    int worker = _jobSystem ? _jobSystem->getCurrentWorkerIndex() : -1;
+    size_t index = (worker >= 0 && static_cast<size_t>(worker) + 1 < _tileScratch.size())
+                 ? static_cast<size_t>(worker) : _tileScratch.size() - 1;
+    return _tileScratch[index];
+}
+
+void EffectEngine::addSlotTime(size_t slot, Clock::time_point start) {
+    int64_t elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+    _slotNanoseconds[slot].fetch_add(elapsed, std::memory_order_relaxed);
+}
+
+void EffectEngine::syncSlots(const EffectGraph& graph) {
+    const size_t nodeCount = graph.getNodeCount();
+    if (_slots.size() > nodeCount) {
+        _slots.resize(nodeCount);
+    }
+
+    for (size_t i = 0; i < nodeCount; ++i) {
+        const GraphNode& node = graph.getNode(static_cast<NodeId>(i));
+        const bool isEffect = node.kind == NodeKind::Effect;
+        if (i == _slots.size()) {
+            _slots.emplace_back();
+        } else if (_slots[i].kind == node.kind && (!isEffect || _slots[i].type == node.effect.type)) {
+            continue;
+        }
+
+        // New node, or a different one moved to this index: its history is not ours
+        Slot& slot = _slots[i];
+        slot.kind = node.kind;
+        slot.type = node.effect.type;
+        slot.processor = isEffect ? createEffectProcessor(node.effect.type) : nullptr;
+        slot.timeMs = 0.0;
+        slot.primed = false;
+        slot.colorRun.reset();
+        slot.remapRun.reset();
+        slot.mapKey = 0;
+        slot.mapMoving = false;
+        _plan.forgetResult(i);
+    }
+
+    _planNodes.resize(nodeCount);
+    for (size_t i = 0; i < nodeCount; ++i) {
+        Slot& slot = _slots[i];
+        PlanNode& node = _planNodes[i];
+        node = PlanNode();
+        if (slot.processor) {
+            node.pointwise = slot.processor->asPointwise() != nullptr;
+            node.remap = slot.processor->asRemap() != nullptr;
+            node.mapMoving = slot.mapMoving;
+            node.temporal = slot.processor->isTemporal();
+            node.values = slot.values;
+        }
+    }
+
+    if (_slotNanosecondsCapacity < nodeCount) {
+        _slotNanosecondsCapacity = std::max<size_t>(nodeCount, 16);
+        _slotNanoseconds.reset(new std::atomic<int64_t>[_slotNanosecondsCapacity]);
+    }
+}
+
+void EffectEngine::smoothParameters(const EffectGraph& graph, float deltaTime) {
+    for (size_t i = 0; i < graph.getNodeCount(); ++i) {
+        const GraphNode& node = graph.getNode(static_cast<NodeId>(i));
+        if (node.kind != NodeKind::Effect) {
+            continue;
+        }
+
+        Slot& slot = _slots[i];
+        const ChainSlot& target = node.effect;
+        if (!target.enabled) {
+            // Re-enabled effects start at their current values
+            slot.primed = false;
+            continue;
+        }
+
+        for (int p = 0; p < MAX_EFFECT_PARAMETERS; ++p) {
+            float goal = target.parameters[p];
+            float& value = slot.values[p];
+            if (!slot.primed || target.smoothing[p] <= 0.0f || deltaTime <= 0.0f) {
+                value = goal;
+                continue;
+            }
+
+            float step = 1.0f - core::exp(-deltaTime / target.smoothing[p]);
+            value += (goal - value) * step;
+            // Land exactly, so effects that test for neutral values see them
+            if (core::fabs(goal - value) <= 1e-4f * std::max(1.0f, core::fabs(goal))) {
+                value = goal;
+            }
+        }
+        slot.primed = true;
+    }
+}
+
+double EffectEngine::getSlotTimeMs(size_t slot) const {
+    return slot < _slots.size() ? _slots[slot].timeMs : 0.0;
+}
+
+double EffectEngine::getLoad() const {
+    if (_intervalMs <= 0.0) {
+        return 0.0;
+    }
+    return std::min(1.0, _processTimeMs / _intervalMs);
+}
+
+void EffectEngine::setIntermediateFormat(PixelFormat format) {
+    if (format == PixelFormat::Count) {
+        return;
+    }
+    // History frames are dropped by the next FrameHistory::beginFrame()
+    _plan.setFormat(format);
+}
+
+void EffectEngine::setColorPrecompositionEnabled(bool enabled) {
+    _colorPrecompositionEnabled = enabled;
+    if (!enabled) {
+        for (Slot& slot : _slots) {
+            slot.colorRun.reset();
+        }
+    }
+}
+
+void EffectEngine::reset() {
+    _slots.clear();
+    _frameIndex = 0;
+    _hasProcessed = false;
+    _processTimeMs = 0.0;
+    _intervalMs = 0.0;
+    _previewSourceId = 0;
+    _previewTimeMs = 0.0;
+}
+
+} // namespace effects
+} // namespace gamma
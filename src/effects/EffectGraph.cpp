@@ -0,0 +1,184 @@
+#include "effects/EffectGraph.h"
+#include <iostream>
+
+namespace gamma {
+namespace effects {
+
+EffectGraph::EffectGraph()
+    : _nodeCount(0)
+    , _output(INVALID_NODE) {
+}
+
+void EffectGraph::clear() {
+    _nodeCount = 0;
+    _output = INVALID_NODE;
+}
+
+NodeId EffectGraph::addNode(NodeKind kind) {
+    if (_nodeCount == _nodes.size()) {
+        _nodes.emplace_back();
+    }
+    GraphNode& node = _nodes[_nodeCount];
+    node = GraphNode();
+    node.kind = kind;
+    return static_cast<NodeId>(_nodeCount++);
+}
+
+NodeId EffectGraph::addSource(int sourceIndex) {
+    NodeId node = addNode(NodeKind::Source);
+    getNode(node).sourceIndex = sourceIndex;
+    return node;
+}
+
+NodeId EffectGraph::addEffect(const ChainSlot& effect) {
+    NodeId node = addNode(NodeKind::Effect);
+    getNode(node).effect = effect;
+    return node;
+}
+
+NodeId EffectGraph::addBlend(float mix) {
+    NodeId node = addNode(NodeKind::Blend);
+    getNode(node).mix = mix;
+    return node;
+}
+
+NodeId EffectGraph::addMatte() {
+    return addNode(NodeKind::Matte);
+}
+
+bool EffectGraph::connect(NodeId from, NodeId to, int port) {
+    const NodeId count = static_cast<NodeId>(_nodeCount);
+    if (from < 0 || from >= count || to < 0 || to >= count || from == to) {
+        std::cerr << "EffectGraph: invalid edge " << from << " -> " << to << std::endl;
+        return false;
+    }
+
+    GraphNode& target = getNode(to);
+    if (port < 0 || port >= getInputCount(target.kind)) {
+        std::cerr << "EffectGraph: node " << to << " has no input port " << port << std::endl;
+        return false;
+    }
+    if (getOutputType(getNode(from).kind) != getInputType(target.kind, port)) {
+        std::cerr << "EffectGraph: edge " << from << " -> " << to << ":" << port
+                  << " connects a matte and an image" << std::endl;
+        return false;
+    }
+
+    target.inputs[port] = from;
+    return true;
+}
+
+void EffectGraph::buildFromChain(const std::vector<ChainSlot>& chain, float masterMix) {
+    clear();
+
+    for (const ChainSlot& slot : chain) {
+        addEffect(slot);
+    }
+    NodeId source = addSource(0);
+
+    // Disabled slots stay in the graph (keeping node indices stable); the
+    // engine passes their input straight through
+    NodeId previous = source;
+    for (size_t i = 0; i < chain.size(); ++i) {
+        connect(previous, static_cast<NodeId>(i));
+        previous = static_cast<NodeId>(i);
+    }
+
+    NodeId mix = addBlend(masterMix);
+    connect(source, mix, BLEND_BASE);
+    connect(previous, mix, BLEND_LAYER);
+    setOutput(mix);
+}
+
+bool EffectGraph::validate() const {
+    const NodeId count = static_cast<NodeId>(_nodeCount);
+    if (_output < 0 || _output >= count) {
+        std::cerr << "EffectGraph: no output node" << std::endl;
+        return false;
+    }
+
+    for (NodeId n = 0; n < count; ++n) {
+        const GraphNode& node = getNode(n);
+        for (int port = 0; port < getInputCount(node.kind); ++port) {
+            if (node.inputs[port] == INVALID_NODE && isInputRequired(node.kind, port)) {
+                std::cerr << "EffectGraph: input " << port << " of node " << n << " is not connected" << std::endl;
+                return false;
+            }
+        }
+    }
+
+    std::vector<NodeId> order;
+    if (!sortTopologically(order)) {
+        std::cerr << "EffectGraph: graph has a cycle" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool EffectGraph::sortTopologically(std::vector<NodeId>& order) const {
+    const NodeId count = static_cast<NodeId>(_nodeCount);
+    order.clear();
+    _pending.assign(_nodeCount, 0);
+    _ready.clear();
+
+    for (NodeId n = 0; n < count; ++n) {
+        const GraphNode& node = getNode(n);
+        for (int port = 0; port < MAX_NODE_INPUTS; ++port) {
+            NodeId input = node.inputs[port];
+            if (input == INVALID_NODE) {
+                continue;
+            }
+            if (input < 0 || input >= count) {
+                return false;
+            }
+            ++_pending[static_cast<size_t>(n)];
+        }
+        if (_pending[static_cast<size_t>(n)] == 0) {
+            _ready.push_back(n);
+        }
+    }
+
+    // Kahn's algorithm; graphs are a few dozen nodes, so consumers are found
+    // by scanning rather than kept in adjacency lists
+    while (!_ready.empty()) {
+        NodeId n = _ready.back();
+        _ready.pop_back();
+        order.push_back(n);
+
+        for (NodeId consumer = 0; consumer < count; ++consumer) {
+            const GraphNode& node = getNode(consumer);
+            for (int port = 0; port < MAX_NODE_INPUTS; ++port) {
+                if (node.inputs[port] == n && --_pending[static_cast<size_t>(consumer)] == 0) {
+                    _ready.push_back(consumer);
+                }
+            }
+        }
+    }
+
+    return order.size() == _nodeCount;
+}
+
+int EffectGraph::getInputCount(NodeKind kind) {
+    switch (kind) {
+        case NodeKind::Source: return 0;
+        case NodeKind::Effect: return 1;
+        case NodeKind::Blend: return 3;
+        case NodeKind::Matte: return 1;
+    }
+    return 0;
+}
+
+bool EffectGraph::isInputRequired(NodeKind kind, int port) {
+    return !(kind == NodeKind::Blend && port == BLEND_MATTE);
+}
+
+EdgeType EffectGraph::getInputType(NodeKind kind, int port) {
+    return (kind == NodeKind::Blend && port == BLEND_MATTE) ? EdgeType::Matte : EdgeType::Image;
+}
+
+EdgeType EffectGraph::getOutputType(NodeKind kind) {
+    return kind == NodeKind::Matte ? EdgeType::Matte : EdgeType::Image;
+}
+
+} // namespace effects
+} // namespace gamma
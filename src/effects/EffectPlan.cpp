@@ -0,0 +1,404 @@
+#include "effects/EffectPlan.h"
+#include <algorithm>
+
+namespace gamma {
+namespace effects {
+
+EffectPlan::EffectPlan()
+    : _fusionEnabled(true)
+    , _memoizationEnabled(true)
+    , _format(PixelFormat::RGBA8)
+    , _width(0)
+    , _height(0)
+    , _stageCount(0)
+    , _result(INVALID_NODE) {
+}
+
+void EffectPlan::setFormat(PixelFormat format) {
+    if (format == _format) {
+        return;
+    }
+    // Cached results in the old format would never match again
+    _format = format;
+    for (NodeCache& cache : _caches) {
+        cache = NodeCache();
+    }
+    _scratch.clear();
+}
+
+EffectPlan::Stage& EffectPlan::addStage(StageKind kind, NodeId node, const GraphNode& graphNode) {
+    if (_stageCount == _stages.size()) {
+        _stages.emplace_back();
+    }
+    _nodeStage[static_cast<size_t>(node)] = static_cast<int>(_stageCount);
+    Stage& stage = _stages[_stageCount++];
+    stage.kind = kind;
+    stage.nodes.clear();
+    stage.nodes.push_back(node);
+    stage.mixNode = INVALID_NODE;
+    for (int port = 0; port < MAX_NODE_INPUTS; ++port) {
+        NodeId input = graphNode.inputs[port];
+        stage.inputNodes[port] = input == INVALID_NODE ? INVALID_NODE : _alias[static_cast<size_t>(input)];
+    }
+    stage.halo = 0;
+    stage.mixWeight = 256;
+    return stage;
+}
+
+bool EffectPlan::compile(const EffectGraph& graph, const std::vector<const Frame*>& sources,
+                         const std::vector<PlanNode>& nodes) {
+    const size_t nodeCount = graph.getNodeCount();
+    const NodeId output = graph.getOutput();
+    _stageCount = 0;
+
+    if (output < 0 || static_cast<size_t>(output) >= nodeCount ||
+        EffectGraph::getOutputType(graph.getNode(output).kind) != EdgeType::Image ||
+        !graph.sortTopologically(_order)) {
+        return false;
+    }
+    _width = sources[0]->getWidth();
+    _height = sources[0]->getHeight();
+    _caches.resize(nodeCount);
+
+    // Pass-through nodes resolve to the node whose result they forward
+    _alias.assign(nodeCount, INVALID_NODE);
+    for (NodeId n : _order) {
+        const GraphNode& node = graph.getNode(n);
+        for (int port = 0; port < EffectGraph::getInputCount(node.kind); ++port) {
+            if (node.inputs[port] == INVALID_NODE && EffectGraph::isInputRequired(node.kind, port)) {
+                return false;
+            }
+        }
+
+        NodeId& alias = _alias[static_cast<size_t>(n)];
+        alias = n;
+        switch (node.kind) {
+            case NodeKind::Source:
+                if (node.sourceIndex < 0 || static_cast<size_t>(node.sourceIndex) >= sources.size()) {
+                    return false;
+                }
+                break;
+            case NodeKind::Effect:
+                if (!node.effect.enabled) {
+                    alias = _alias[static_cast<size_t>(node.inputs[0])];
+                }
+                break;
+            case NodeKind::Blend: {
+                bool matte = node.inputs[BLEND_MATTE] != INVALID_NODE;
+                if (node.mix <= 0.0f) {
+                    alias = _alias[static_cast<size_t>(node.inputs[BLEND_BASE])];
+                } else if (node.mix >= 1.0f && !matte) {
+                    alias = _alias[static_cast<size_t>(node.inputs[BLEND_LAYER])];
+                }
+                break;
+            }
+            case NodeKind::Matte:
+                break;
+        }
+    }
+    _result = _alias[static_cast<size_t>(output)];
+
+    // Walk back from the output; only rendering nodes are ever marked
+    _live.assign(nodeCount, 0);
+    _consumers.assign(nodeCount, 0);
+    _live[static_cast<size_t>(_result)] = 1;
+    for (auto it = _order.rbegin(); it != _order.rend(); ++it) {
+        const GraphNode& node = graph.getNode(*it);
+        if (!_live[static_cast<size_t>(*it)]) {
+            continue;
+        }
+        for (int port = 0; port < EffectGraph::getInputCount(node.kind); ++port) {
+            if (node.inputs[port] != INVALID_NODE) {
+                NodeId input = _alias[static_cast<size_t>(node.inputs[port])];
+                _live[static_cast<size_t>(input)] = 1;
+                ++_consumers[static_cast<size_t>(input)];
+            }
+        }
+    }
+
+    // Stages in topological order. A point-wise effect joins the stage of
+    // its input when that stage is a point-wise run and nothing else reads
+    // the input, and a remap effect likewise joins a remap run; everything
+    // reading the run comes later in the order.
+    _nodeStage.assign(nodeCount, -1);
+    for (NodeId n : _order) {
+        const GraphNode& node = graph.getNode(n);
+        if (!_live[static_cast<size_t>(n)] || node.kind == NodeKind::Source) {
+            continue;
+        }
+
+        if (node.kind == NodeKind::Blend) {
+            addStage(StageKind::Blend, n, node).mixWeight =
+                static_cast<uint32_t>(std::max(0.0f, std::min(1.0f, node.mix)) * 256.0f + 0.5f);
+            continue;
+        }
+        if (node.kind == NodeKind::Matte) {
+            addStage(StageKind::Matte, n, node);
+            continue;
+        }
+
+        const PlanNode& effect = nodes[static_cast<size_t>(n)];
+        const NodeId input = _alias[static_cast<size_t>(node.inputs[0])];
+        const int inputStage = _nodeStage[static_cast<size_t>(input)];
+        if (effect.remap) {
+            // A map that moved last frame runs on its own: composed with the
+            // others, it would have their grid rebuilt along with its own
+            if (_fusionEnabled && inputStage >= 0 && _consumers[static_cast<size_t>(input)] == 1 &&
+                _stages[static_cast<size_t>(inputStage)].kind == StageKind::Remap &&
+                !effect.mapMoving &&
+                !nodes[static_cast<size_t>(_stages[static_cast<size_t>(inputStage)].nodes.back())].mapMoving) {
+                _stages[static_cast<size_t>(inputStage)].nodes.push_back(n);
+                _nodeStage[static_cast<size_t>(n)] = inputStage;
+                continue;
+            }
+            addStage(StageKind::Remap, n, node);
+            continue;
+        }
+        if (_fusionEnabled && effect.pointwise && inputStage >= 0 && _consumers[static_cast<size_t>(input)] == 1) {
+            Stage& stage = _stages[static_cast<size_t>(inputStage)];
+            if ((stage.kind == StageKind::Effect || stage.kind == StageKind::Fused) &&
+                nodes[static_cast<size_t>(stage.nodes.back())].pointwise) {
+                stage.nodes.push_back(n);
+                stage.kind = StageKind::Fused;
+                _nodeStage[static_cast<size_t>(n)] = inputStage;
+                continue;
+            }
+        }
+        addStage(StageKind::Effect, n, node);
+    }
+
+    return true;
+}
+
+void EffectPlan::foldBlends() {
+    if (!_fusionEnabled) {
+        return;
+    }
+
+    // A blend whose layer is the result of an effect stage read by nothing
+    // else is done by that stage, row by row, right after writing its result
+    bool folded = false;
+    for (size_t s = 0; s < _stageCount; ++s) {
+        Stage& blend = _stages[s];
+        if (blend.kind != StageKind::Blend) {
+            continue;
+        }
+        const NodeId layer = blend.inputNodes[BLEND_LAYER];
+        const int producerIndex = _nodeStage[static_cast<size_t>(layer)];
+        if (producerIndex < 0 || _consumers[static_cast<size_t>(layer)] != 1) {
+            continue;
+        }
+        Stage& producer = _stages[static_cast<size_t>(producerIndex)];
+        if ((producer.kind != StageKind::Effect && producer.kind != StageKind::Fused &&
+             producer.kind != StageKind::Remap) ||
+            producer.nodes.back() != layer || producer.mixNode != INVALID_NODE) {
+            continue;
+        }
+
+        // A float result must be mixed before it is packed into the RGBA8
+        // output; fused stages do that per row (see EffectEngine::runFusedFloat),
+        // a single effect or a remap writes its rows itself, so its blend stays a pass of its own
+        if (_format != PixelFormat::RGBA8 && producer.kind != StageKind::Fused && blend.nodes.front() == _result) {
+            continue;
+        }
+
+        // The base and matte are read by the producer now, so must be ready before it runs
+        const int baseStage = _nodeStage[static_cast<size_t>(blend.inputNodes[BLEND_BASE])];
+        const NodeId matte = blend.inputNodes[BLEND_MATTE];
+        const int matteStage = matte == INVALID_NODE ? -1 : _nodeStage[static_cast<size_t>(matte)];
+        if (baseStage >= producerIndex || matteStage >= producerIndex) {
+            continue;
+        }
+
+        producer.mixNode = blend.nodes.front();
+        producer.inputNodes[MIX_BASE_INPUT] = blend.inputNodes[BLEND_BASE];
+        producer.inputNodes[MIX_MATTE_INPUT] = matte;
+        producer.mixWeight = blend.mixWeight;
+        producer.key = blend.key;
+        blend.nodes.clear();
+        folded = true;
+    }
+
+    if (!folded) {
+        return;
+    }
+    size_t kept = 0;
+    for (size_t s = 0; s < _stageCount; ++s) {
+        if (_stages[s].nodes.empty()) {
+            continue;
+        }
+        if (kept != s) {
+            std::swap(_stages[kept], _stages[s]);
+        }
+        const Stage& stage = _stages[kept];
+        for (NodeId node : stage.nodes) {
+            _nodeStage[static_cast<size_t>(node)] = static_cast<int>(kept);
+        }
+        if (stage.mixNode != INVALID_NODE) {
+            _nodeStage[static_cast<size_t>(stage.mixNode)] = static_cast<int>(kept);
+        }
+        ++kept;
+    }
+    _stageCount = kept;
+}
+
+int EffectPlan::acquireScratch() {
+    int index;
+    if (_freeScratch.empty()) {
+        index = static_cast<int>(_scratch.size());
+        _scratch.push_back(std::make_unique<Frame>());
+    } else {
+        index = _freeScratch.back();
+        _freeScratch.pop_back();
+    }
+    _scratch[static_cast<size_t>(index)]->resize(_width, _height, _format);
+    return index;
+}
+
+void EffectPlan::assignBuffers(const EffectGraph& graph, const std::vector<const Frame*>& sources, Frame& output) {
+    const int outputBuffer = static_cast<int>(sources.size());
+    const int cacheBase = outputBuffer + 1;
+    const int scratchBase = cacheBase + static_cast<int>(graph.getNodeCount());
+
+    // Last stage reading each result
+    for (size_t s = 0; s < _stageCount; ++s) {
+        _stages[s].lastUse = s;
+    }
+    for (size_t s = 0; s < _stageCount; ++s) {
+        for (NodeId input : _stages[s].inputNodes) {
+            int producer = input == INVALID_NODE ? -1 : _nodeStage[static_cast<size_t>(input)];
+            if (producer >= 0) {
+                _stages[static_cast<size_t>(producer)].lastUse = s;
+            }
+        }
+    }
+
+    // Scratch frames go back to the pool after their last reader; the most
+    // recently freed is reused first, as it is the likeliest to be in cache
+    _freeScratch.clear();
+    for (size_t k = _scratch.size(); k > 0; --k) {
+        _freeScratch.push_back(static_cast<int>(k - 1));
+    }
+
+    for (size_t s = 0; s < _stageCount; ++s) {
+        Stage& stage = _stages[s];
+
+        // Inputs: a stage rendering this frame, a source, or a cached result
+        for (int port = 0; port < MAX_NODE_INPUTS; ++port) {
+            NodeId input = stage.inputNodes[port];
+            if (input == INVALID_NODE) {
+                stage.inputBuffers[port] = -1;
+                continue;
+            }
+            int producer = _nodeStage[static_cast<size_t>(input)];
+            if (producer >= 0) {
+                stage.inputBuffers[port] = _stages[static_cast<size_t>(producer)].targetBuffer;
+            } else if (graph.getNode(input).kind == NodeKind::Source) {
+                stage.inputBuffers[port] = graph.getNode(input).sourceIndex;
+            } else {
+                stage.inputBuffers[port] = cacheBase + input;
+            }
+        }
+
+        // Cacheable results are kept in their node's cache for the next frame;
+        // scratch is acquired before the inputs are released, as a stage
+        // never writes what it reads
+        const NodeId resultNode = stage.getResultNode();
+        if (resultNode == _result) {
+            stage.targetBuffer = outputBuffer;
+        } else if (stage.key != 0) {
+            NodeCache& cache = _caches[static_cast<size_t>(resultNode)];
+            cache.frame.resize(_width, _height, _format);
+            cache.key = stage.key;
+            stage.targetBuffer = cacheBase + resultNode;
+        } else {
+            stage.targetBuffer = scratchBase + acquireScratch();
+        }
+
+        for (int port = 0; port < MAX_NODE_INPUTS; ++port) {
+            int buffer = stage.inputBuffers[port];
+            if (buffer < scratchBase) {
+                continue;
+            }
+            Stage& producer = _stages[static_cast<size_t>(_nodeStage[static_cast<size_t>(stage.inputNodes[port])])];
+            if (producer.lastUse == s) {
+                _freeScratch.push_back(buffer - scratchBase);
+                producer.lastUse = _stageCount;     // Read on two ports: release once
+            }
+        }
+    }
+
+    _buffers.assign(sources.begin(), sources.end());
+    _buffers.push_back(&output);
+    for (size_t n = 0; n < graph.getNodeCount(); ++n) {
+        _buffers.push_back(&_caches[n].frame);
+    }
+    for (const auto& frame : _scratch) {
+        _buffers.push_back(frame.get());
+    }
+
+    for (size_t s = 0; s < _stageCount; ++s) {
+        Stage& stage = _stages[s];
+        for (int port = 0; port < MAX_NODE_INPUTS; ++port) {
+            stage.inputs[port] = stage.inputBuffers[port] >= 0 ? _buffers[static_cast<size_t>(stage.inputBuffers[port])] : nullptr;
+        }
+        if (stage.targetBuffer == outputBuffer) {
+            stage.target = &output;
+        } else if (stage.targetBuffer < scratchBase) {
+            stage.target = &_caches[static_cast<size_t>(stage.targetBuffer - cacheBase)].frame;
+        } else {
+            stage.target = _scratch[static_cast<size_t>(stage.targetBuffer - scratchBase)].get();
+        }
+    }
+
+    _bufferWriter.assign(_buffers.size(), -1);
+    if (_bufferReaders.size() < _buffers.size()) {
+        _bufferReaders.resize(_buffers.size());
+    }
+    for (auto& readers : _bufferReaders) {
+        readers.clear();
+    }
+}
+
+void EffectPlan::addDependencies(size_t stageIndex) {
+    Stage& stage = _stages[stageIndex];
+    stage.dependencies.clear();
+
+    auto depend = [&stage](size_t on, int halo) {
+        for (Dependency& dependency : stage.dependencies) {
+            if (dependency.stage == on) {
+                dependency.halo = std::max(dependency.halo, halo);
+                return;
+            }
+        }
+        stage.dependencies.push_back(Dependency{on, halo});
+    };
+
+    // Read-after-write: the rows this stage reads, with its halo, must be written
+    for (int port = 0; port < MAX_NODE_INPUTS; ++port) {
+        int buffer = stage.inputBuffers[port];
+        if (buffer < 0) {
+            continue;
+        }
+        int writer = _bufferWriter[static_cast<size_t>(buffer)];
+        if (writer >= 0) {
+            depend(static_cast<size_t>(writer), stage.halo);
+        }
+        _bufferReaders[static_cast<size_t>(buffer)].push_back(Dependency{stageIndex, stage.halo});
+    }
+
+    // Write-after-read: a recycled scratch frame may only be overwritten once
+    // the readers of its previous result are done with those rows
+    const size_t target = static_cast<size_t>(stage.targetBuffer);
+    if (_bufferWriter[target] >= 0) {
+        depend(static_cast<size_t>(_bufferWriter[target]), 0);
+    }
+    for (const Dependency& reader : _bufferReaders[target]) {
+        depend(reader.stage, reader.halo);
+    }
+    _bufferReaders[target].clear();
+    _bufferWriter[target] = static_cast<int>(stageIndex);
+}
+
+} // namespace effects
+} // namespace gamma
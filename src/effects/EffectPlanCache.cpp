@@ -0,0 +1,129 @@
+#include "effects/EffectPlan.h"
+#include "effects/ContentKey.h"
+#include <algorithm>
+
+namespace gamma {
+namespace effects {
+
+void EffectPlan::setMemoizationEnabled(bool enabled) {
+    _memoizationEnabled = enabled;
+    if (!enabled) {
+        for (NodeCache& cache : _caches) {
+            cache = NodeCache();
+        }
+    }
+}
+
+void EffectPlan::forgetResult(size_t node) {
+    if (node < _caches.size()) {
+        _caches[node].key = 0;
+    }
+}
+
+size_t EffectPlan::getCacheBytes() const {
+    size_t bytes = 0;
+    for (const NodeCache& cache : _caches) {
+        bytes += cache.frame.getByteSize();
+    }
+    return bytes;
+}
+
+void EffectPlan::computeKeys(const EffectGraph& graph, const std::vector<const Frame*>& sources,
+                             const std::vector<PlanNode>& nodes) {
+    _nodeKeys.assign(graph.getNodeCount(), 0);
+    if (!_memoizationEnabled) {
+        return;
+    }
+
+    // Live nodes only, in topological order; pass-through nodes are never read
+    for (NodeId n : _order) {
+        if (!_live[static_cast<size_t>(n)]) {
+            continue;
+        }
+
+        const GraphNode& node = graph.getNode(n);
+        uint64_t key = combineKey(KEY_SEED, static_cast<uint64_t>(node.kind));
+        bool cacheable = true;
+
+        if (node.kind == NodeKind::Source) {
+            uint64_t id = sources[static_cast<size_t>(node.sourceIndex)]->getContentId();
+            cacheable = id != 0;
+            key = combineKey(combineKey(key, id), (static_cast<uint64_t>(_width) << 32) | static_cast<uint64_t>(_height));
+            key = combineKey(key, static_cast<uint64_t>(_format));
+        }
+
+        for (int port = 0; port < EffectGraph::getInputCount(node.kind) && cacheable; ++port) {
+            NodeId input = node.inputs[port];
+            uint64_t inputKey = input == INVALID_NODE ? 0 : _nodeKeys[static_cast<size_t>(_alias[static_cast<size_t>(input)])];
+            cacheable = inputKey != 0 || input == INVALID_NODE;
+            key = combineKey(key, inputKey);
+        }
+
+        if (node.kind == NodeKind::Effect && cacheable) {
+            const PlanNode& effect = nodes[static_cast<size_t>(n)];
+            cacheable = !effect.temporal;
+            key = combineKey(key, static_cast<uint64_t>(node.effect.type));
+            for (int p = 0; p < MAX_EFFECT_PARAMETERS; ++p) {
+                key = combineKey(key, floatBits(effect.values[p]));
+            }
+        } else if (node.kind == NodeKind::Blend) {
+            key = combineKey(key, floatBits(node.mix));
+        }
+
+        _nodeKeys[static_cast<size_t>(n)] = cacheable ? (key != 0 ? key : 1) : 0;
+    }
+}
+
+void EffectPlan::skipCachedStages() {
+    const size_t outputStage = getOutputStage();
+    for (size_t s = 0; s < _stageCount; ++s) {
+        Stage& stage = _stages[s];
+        const size_t node = static_cast<size_t>(stage.nodes.back());
+        stage.key = _nodeKeys[node];
+        stage.cached = s != outputStage && stage.key != 0 && _caches[node].key == stage.key;
+        stage.needed = s == outputStage;
+    }
+
+    // Stages that render need their inputs; cached ones need nothing
+    for (size_t s = _stageCount; s > 0; --s) {
+        const Stage& stage = _stages[s - 1];
+        if (!stage.needed || stage.cached) {
+            continue;
+        }
+        for (NodeId input : stage.inputNodes) {
+            int producer = input == INVALID_NODE ? -1 : _nodeStage[static_cast<size_t>(input)];
+            if (producer >= 0) {
+                _stages[static_cast<size_t>(producer)].needed = true;
+            }
+        }
+    }
+
+    // Keep the stages that render, in order; results of the others are read
+    // from their nodes' caches
+    size_t kept = 0;
+    for (size_t s = 0; s < _stageCount; ++s) {
+        Stage& stage = _stages[s];
+        const bool renders = stage.needed && !stage.cached;
+        if (stage.needed && stage.cached) {
+            ++_cacheStats.hits;
+        } else if (renders && stage.key != 0) {
+            ++_cacheStats.misses;
+        } else if (renders) {
+            ++_cacheStats.uncached;
+        }
+
+        for (NodeId node : stage.nodes) {
+            _nodeStage[static_cast<size_t>(node)] = renders ? static_cast<int>(kept) : -1;
+        }
+        if (renders) {
+            if (kept != s) {
+                std::swap(_stages[kept], stage);
+            }
+            ++kept;
+        }
+    }
+    _stageCount = kept;
+}
+
+} // namespace effects
+} // namespace gamma
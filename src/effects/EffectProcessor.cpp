@@ -0,0 +1,120 @@
+#include "effects/EffectProcessor.h"
+#include "effects/EffectDescriptor.h"
+#include "effects/Effects.h"
+#include "effects/PixelRows.h"
+#include <cstring>
+
+namespace gamma {
+namespace effects {
+
+void EffectProcessor::process(const Frame& input, Frame& output, const float* parameters,
+                              const EffectContext& context) {
+    setFloatPixels(context.format != PixelFormat::RGBA8);
+    prepare(input, parameters, context);
+    processRows(input, output, 0, input.getHeight());
+}
+
+void PointwiseEffect::processRows(const Frame& input, Frame& output, int yBegin, int yEnd) {
+    const int width = input.getWidth();
+    if (!usesFloatPixels()) {
+        for (int y = yBegin; y < yEnd; ++y) {
+            processRow(input.row(y), output.row(y), width, y);
+        }
+        return;
+    }
+
+    const size_t count = static_cast<size_t>(width);
+    float* source = getRowBuffer(0, count);
+    float* result = getRowBuffer(1, count);
+    for (int y = yBegin; y < yEnd; ++y) {
+        float* dst = getStoreTarget(output, 0, y, result);
+        processRowFloat(loadPixels(input, 0, y, count, source), dst, width, y);
+        writePixels(dst, output, 0, y, count);
+    }
+}
+
+void RemapEffect::prepare(const Frame& input, const float* parameters, const EffectContext& /*context*/) {
+    _width = input.getWidth();
+    _height = input.getHeight();
+    _mapKey = prepareMap(_width, _height, parameters);
+    std::lock_guard<std::mutex> lock(_gridMutex);
+    _grid.reset();
+}
+
+int RemapEffect::getInputHalo(int height) const {
+    // Any row may be sampled, unless nothing moves
+    return _mapKey != 0 ? height : 0;
+}
+
+void RemapEffect::processRows(const Frame& input, Frame& output, int yBegin, int yEnd) {
+    std::shared_ptr<const RemapGrid> grid;
+    if (_mapKey != 0) {
+        // The first band builds (or finds) the grid; the others wait for it
+        std::lock_guard<std::mutex> lock(_gridMutex);
+        if (!_grid) {
+            _grid = _grids.get(_mapKey, _width, _height,
+                               [this](float* x, float* y, size_t count) { mapPoints(x, y, count); });
+        }
+        grid = _grid;
+    }
+    remapRows(grid.get(), input, output, yBegin, yEnd, usesFloatPixels());
+}
+
+uint64_t RemapEffect::hashMap(const char* name, int width, int height, std::initializer_list<float> values) {
+    // FNV-1a over the name, then the size and the values' bits
+    uint64_t key = 0xCBF29CE484222325ull;
+    auto mix = [&key](uint64_t value) {
+        for (int i = 0; i < 8; ++i) {
+            key = (key ^ ((value >> (i * 8)) & 0xFF)) * 0x100000001B3ull;
+        }
+    };
+    for (const char* c = name; *c; ++c) {
+        key = (key ^ static_cast<unsigned char>(*c)) * 0x100000001B3ull;
+    }
+    mix((static_cast<uint64_t>(static_cast<uint32_t>(width)) << 32) | static_cast<uint32_t>(height));
+    for (float value : values) {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        mix(bits);
+    }
+    return key != 0 ? key : 1;
+}
+
+std::unique_ptr<EffectProcessor> createEffectProcessor(EffectType type) {
+    switch (type) {
+        case EffectType::ColorCorrection: return std::make_unique<ColorCorrectionEffect>();
+        case EffectType::ChromaticAberration: return std::make_unique<ChromaticAberrationEffect>();
+        case EffectType::Datamosh: return std::make_unique<DatamoshEffect>();
+        case EffectType::MotionBlur: return std::make_unique<MotionBlurEffect>();
+        case EffectType::Mirror: return std::make_unique<MirrorEffect>();
+        case EffectType::TimeEcho: return std::make_unique<TimeEchoEffect>();
+        case EffectType::ColorLut: return std::make_unique<ColorLutEffect>();
+        case EffectType::Kaleidoscope: return std::make_unique<KaleidoscopeEffect>();
+        case EffectType::Polar: return std::make_unique<PolarEffect>();
+        case EffectType::Tile: return std::make_unique<TileEffect>();
+        case EffectType::Warp: return std::make_unique<WarpEffect>();
+        case EffectType::Count: break;
+    }
+    return nullptr;
+}
+
+bool findEffectType(const std::string& name, EffectType& type) {
+    for (int i = 0; i < static_cast<int>(EffectType::Count); ++i) {
+        if (name == getEffectDescriptor(static_cast<EffectType>(i)).name) {
+            type = static_cast<EffectType>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+const char* getEffectTypeName(EffectType type) {
+    int index = static_cast<int>(type);
+    if (index < 0 || index >= static_cast<int>(EffectType::Count)) {
+        return "Unknown";
+    }
+    return getEffectDescriptor(type).name;
+}
+
+} // namespace effects
+} // namespace gamma
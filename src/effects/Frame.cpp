@@ -0,0 +1,150 @@
+#include "effects/Frame.h"
+#include "effects/FramePool.h"
+#include <atomic>
+#include <cctype>
+#include <cstring>
+
+namespace gamma {
+namespace effects {
+
+namespace {
+    const size_t ROW_ALIGNMENT = 64;
+
+    const char* const FORMAT_NAMES[] = {"RGBA8", "RGBA16F", "RGBA32F"};
+
+    std::atomic<uint64_t> g_nextContentId(1);
+}
+
+uint64_t makeContentId() {
+    return g_nextContentId.fetch_add(1, std::memory_order_relaxed);
+}
+
+const char* getPixelFormatName(PixelFormat format) {
+    size_t index = static_cast<size_t>(format);
+    return index < static_cast<size_t>(PixelFormat::Count) ? FORMAT_NAMES[index] : "Unknown";
+}
+
+bool findPixelFormat(const std::string& name, PixelFormat& format) {
+    for (size_t i = 0; i < static_cast<size_t>(PixelFormat::Count); ++i) {
+        const char* candidate = FORMAT_NAMES[i];
+        size_t length = std::strlen(candidate);
+        if (name.size() != length) {
+            continue;
+        }
+        bool same = true;
+        for (size_t c = 0; c < length && same; ++c) {
+            same = std::toupper(static_cast<unsigned char>(name[c])) == candidate[c];
+        }
+        if (same) {
+            format = static_cast<PixelFormat>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+Frame::Frame()
+    : _bytes(nullptr)
+    , _width(0)
+    , _height(0)
+    , _stride(0)
+    , _capacity(0)
+    , _contentId(0)
+    , _format(PixelFormat::RGBA8) {
+}
+
+Frame::Frame(int width, int height, PixelFormat format)
+    : Frame() {
+    resize(width, height, format);
+}
+
+Frame::~Frame() {
+    release();
+}
+
+Frame::Frame(Frame&& other) noexcept
+    : _bytes(other._bytes)
+    , _width(other._width)
+    , _height(other._height)
+    , _stride(other._stride)
+    , _capacity(other._capacity)
+    , _contentId(other._contentId)
+    , _format(other._format) {
+    other._bytes = nullptr;
+    other._width = 0;
+    other._height = 0;
+    other._stride = 0;
+    other._capacity = 0;
+}
+
+Frame& Frame::operator=(Frame&& other) noexcept {
+    if (this != &other) {
+        release();
+        _bytes = other._bytes;
+        _width = other._width;
+        _height = other._height;
+        _stride = other._stride;
+        _capacity = other._capacity;
+        _contentId = other._contentId;
+        _format = other._format;
+        other._bytes = nullptr;
+        other._width = 0;
+        other._height = 0;
+        other._stride = 0;
+        other._capacity = 0;
+    }
+    return *this;
+}
+
+void Frame::resize(int width, int height) {
+    resize(width, height, _format);
+}
+
+void Frame::resize(int width, int height, PixelFormat format) {
+    if (width != _width || height != _height || format != _format) {
+        _contentId = 0;
+    }
+    _format = format;
+    if (width <= 0 || height <= 0) {
+        _width = 0;
+        _height = 0;
+        _stride = 0;
+        return;
+    }
+
+    const size_t pixelsPerLine = ROW_ALIGNMENT / getPixelBytes();
+    size_t stride = (static_cast<size_t>(width) + pixelsPerLine - 1) / pixelsPerLine * pixelsPerLine;
+    size_t required = stride * static_cast<size_t>(height) * getPixelBytes();
+    if (required > _capacity) {
+        release();
+        _bytes = static_cast<uint8_t*>(getFramePool().acquire(required, _capacity));
+    }
+
+    _width = width;
+    _height = height;
+    _stride = stride;
+}
+
+void Frame::copyFrom(const Frame& other) {
+    if (this == &other) {
+        return;
+    }
+    resize(other._width, other._height, other._format);
+    if (empty()) {
+        return;
+    }
+    // Same dimensions and format means same stride: one block copy
+    std::memcpy(_bytes, other._bytes, getByteSize());
+    _contentId = other._contentId;
+}
+
+void Frame::release() {
+    if (_bytes) {
+        getFramePool().release(_bytes);
+        _bytes = nullptr;
+    }
+    _capacity = 0;
+}
+
+} // namespace effects
+} // namespace gamma
@@ -0,0 +1,261 @@
+#include "effects/FrameHistory.h"
+#include "core/Math.h"
+#include <algorithm>
+
+namespace gamma {
+namespace effects {
+
+namespace {
+    const double DEFAULT_FRAME_INTERVAL = 1.0 / 60.0;
+    const double INTERVAL_SMOOTHING = 0.1;
+}
+
+FrameHistory::FrameHistory(size_t budgetBytes)
+    : _activeTracks(0)
+    , _frameCount(0)
+    , _frameBytes(0)
+    , _budgetBytes(budgetBytes)
+    , _width(0)
+    , _height(0)
+    , _format(PixelFormat::RGBA8)
+    , _time(0.0)
+    , _frameInterval(DEFAULT_FRAME_INTERVAL)
+    , _hasFrame(false) {
+}
+
+FrameHistory::~FrameHistory() = default;
+
+void FrameHistory::beginFrame(int width, int height, double time, PixelFormat format) {
+    bool resized = (width != _width || height != _height || format != _format);
+    bool rewound = _hasFrame && time < _time;
+
+    if (resized || rewound) {
+        for (size_t i = 0; i < _tracks.size(); ++i) {
+            clearTrack(static_cast<int>(i));
+        }
+    }
+    if (resized) {
+        _freeFrames.clear();
+        _frameCount = 0;
+        _width = width;
+        _height = height;
+        _format = format;
+        _frameBytes = static_cast<size_t>(width) * static_cast<size_t>(height) * getPixelBytes(format);
+    }
+
+    if (_hasFrame && time > _time) {
+        _frameInterval += (time - _time - _frameInterval) * INTERVAL_SMOOTHING;
+    }
+    _time = time;
+    _hasFrame = true;
+
+    for (auto& track : _tracks) {
+        track.readFrame = nullptr;
+    }
+
+    // Spare frames left over from spans that shrank: keep one per track for
+    // the next recordings and give the rest back
+    while (_freeFrames.size() > _activeTracks) {
+        _freeFrames.pop_back();
+        --_frameCount;
+    }
+}
+
+int FrameHistory::createTrack() {
+    size_t index = 0;
+    while (index < _tracks.size() && _tracks[index].active) {
+        ++index;
+    }
+    if (index == _tracks.size()) {
+        _tracks.emplace_back();
+    }
+
+    Track& track = _tracks[index];
+    track.active = true;
+    track.span = 0.0;
+    track.readFrame = nullptr;
+    ++_activeTracks;
+    return static_cast<int>(index);
+}
+
+void FrameHistory::releaseTrack(int track) {
+    clearTrack(track);
+    _tracks[track].active = false;
+    --_activeTracks;
+}
+
+void FrameHistory::clearTrack(int track) {
+    Track& entry = _tracks[track];
+    for (auto& recorded : entry.entries) {
+        recycle(recorded);
+    }
+    entry.entries.clear();
+    entry.readFrame = nullptr;
+}
+
+void FrameHistory::setSpan(int track, double seconds) {
+    _tracks[track].span = std::max(0.0, seconds);
+}
+
+double FrameHistory::getNeededFrames(const Track& track) const {
+    // Frames covering the span, plus the one being recorded and the one just past the span
+    return track.span / _frameInterval + 2.0;
+}
+
+double FrameHistory::getTrackShare() const {
+    // Tracks needing less than an equal share keep just what they need; the
+    // rest of the budget is split among the others
+    const double budgetFrames = _frameBytes > 0 ? static_cast<double>(_budgetBytes / _frameBytes) : 0.0;
+    double share = budgetFrames / static_cast<double>(std::max<size_t>(1, _activeTracks));
+
+    for (;;) {
+        double satisfiedFrames = 0.0;
+        size_t satisfiedTracks = 0;
+        for (const auto& track : _tracks) {
+            double needed = getNeededFrames(track);
+            if (track.active && needed <= share) {
+                satisfiedFrames += needed;
+                ++satisfiedTracks;
+            }
+        }
+        if (satisfiedTracks >= _activeTracks) {
+            break;
+        }
+        double widened = (budgetFrames - satisfiedFrames) / static_cast<double>(_activeTracks - satisfiedTracks);
+        if (widened <= share) {
+            break;
+        }
+        share = widened;
+    }
+    return std::max(static_cast<double>(MIN_TRACK_FRAMES), share);
+}
+
+bool FrameHistory::isRecordDue(int track) const {
+    const Track& entry = _tracks[track];
+    if (entry.entries.empty()) {
+        return true;
+    }
+
+    // Beyond the track's share of the budget, spread the share over the span
+    double needed = getNeededFrames(entry);
+    double share = core::floor(getTrackShare());
+    double interval = needed <= share ? 0.0 : entry.span / (share - 2.0);
+    return _time - entry.entries.back().time >= interval;
+}
+
+const Frame* FrameHistory::findByAge(int track, double age) {
+    Track& entry = _tracks[track];
+    const Frame* found = nullptr;
+    for (auto it = entry.entries.rbegin(); it != entry.entries.rend(); ++it) {
+        found = it->frame.get();
+        if (it->time <= _time - age) {
+            break;
+        }
+    }
+    if (found) {
+        entry.readFrame = found;
+    }
+    return found;
+}
+
+Frame* FrameHistory::record(int track) {
+    Track& entry = _tracks[track];
+    std::vector<Entry>& entries = entry.entries;
+
+    // Everything older than the newest frame past the span is no longer reachable
+    size_t keepFrom = 0;
+    for (size_t i = entries.size(); i-- > 0;) {
+        if (entries[i].time <= _time - entry.span) {
+            keepFrom = i;
+            break;
+        }
+    }
+    for (size_t i = 0; i < keepFrom; ++i) {
+        if (entries[i].frame.get() != entry.readFrame) {
+            recycle(entries[i]);
+        }
+    }
+    entries.erase(std::remove_if(entries.begin(), entries.end(),
+                                 [](const Entry& recorded) { return !recorded.frame; }),
+                  entries.end());
+
+    std::unique_ptr<Frame> frame;
+    if (!_freeFrames.empty()) {
+        frame = std::move(_freeFrames.back());
+        _freeFrames.pop_back();
+    } else if ((_frameCount + 1) * _frameBytes <= _budgetBytes || _frameCount < MIN_TRACK_FRAMES) {
+        frame = std::make_unique<Frame>(_width, _height, _format);
+        ++_frameCount;
+    } else {
+        // Over budget: shorten this track's reach rather than grow
+        for (auto& recorded : entries) {
+            if (recorded.frame.get() != entry.readFrame) {
+                frame = std::move(recorded.frame);
+                break;
+            }
+        }
+        entries.erase(std::remove_if(entries.begin(), entries.end(),
+                                     [](const Entry& recorded) { return !recorded.frame; }),
+                      entries.end());
+        if (!frame) {
+            return nullptr;
+        }
+    }
+
+    entries.push_back({std::move(frame), _time});
+    return entries.back().frame.get();
+}
+
+void FrameHistory::recycle(Entry& entry) {
+    if (entry.frame) {
+        _freeFrames.push_back(std::move(entry.frame));
+    }
+}
+
+HistoryTrack::~HistoryTrack() {
+    release();
+}
+
+bool HistoryTrack::bind(FrameHistory* history) {
+    if (history != _history) {
+        release();
+        if (history) {
+            _history = history;
+            _track = history->createTrack();
+        }
+    }
+    return _history != nullptr;
+}
+
+void HistoryTrack::release() {
+    if (_history) {
+        _history->releaseTrack(_track);
+        _history = nullptr;
+        _track = -1;
+    }
+}
+
+void HistoryTrack::clear() {
+    if (_history) {
+        _history->clearTrack(_track);
+    }
+}
+
+void HistoryTrack::setSpan(double seconds) {
+    _history->setSpan(_track, seconds);
+}
+
+bool HistoryTrack::isRecordDue() const {
+    return _history->isRecordDue(_track);
+}
+
+const Frame* HistoryTrack::findByAge(double age) {
+    return _history->findByAge(_track, age);
+}
+
+Frame* HistoryTrack::record() {
+    return _history->record(_track);
+}
+
+} // namespace effects
+} // namespace gamma
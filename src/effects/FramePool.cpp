@@ -0,0 +1,389 @@
+#include "effects/FramePool.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <new>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <malloc.h>
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+namespace gamma {
+namespace effects {
+
+namespace {
+    const size_t MIN_CLASS_SHIFT = 12;                  // Smallest class: one 4 KB page
+    const size_t CLASS_STEPS = 4;                       // Classes per power of two
+    const size_t CLASS_COUNT = (64 - MIN_CLASS_SHIFT) * CLASS_STEPS + 1;
+    const size_t PAGE_BYTES = 4096;
+
+    const char* const HUGE_PAGE_MODE_NAMES[] = {"off", "transparent", "explicit"};
+
+    size_t getClassIndex(size_t bytes) {
+        if (bytes <= (size_t(1) << MIN_CLASS_SHIFT)) {
+            return 0;
+        }
+        // bytes in (2^shift, 2^(shift+1)]: quarter steps of 2^shift above it
+        size_t shift = 0;
+        for (size_t value = bytes - 1; value > 1; value >>= 1) {
+            ++shift;
+        }
+        const size_t base = size_t(1) << shift;
+        const size_t step = base / CLASS_STEPS;
+        const size_t sub = (bytes - base + step - 1) / step;
+        return (shift - MIN_CLASS_SHIFT) * CLASS_STEPS + sub;
+    }
+
+    size_t getIndexBytes(size_t index) {
+        if (index == 0) {
+            return size_t(1) << MIN_CLASS_SHIFT;
+        }
+        const size_t shift = (index - 1) / CLASS_STEPS + MIN_CLASS_SHIFT;
+        const size_t sub = (index - 1) % CLASS_STEPS + 1;
+        const size_t base = size_t(1) << shift;
+        return base + sub * (base / CLASS_STEPS);
+    }
+
+    size_t roundUp(size_t bytes, size_t multiple) {
+        return (bytes + multiple - 1) / multiple * multiple;
+    }
+
+    // One write per page faults the buffer in now rather than mid-effect
+    void prefaultPages(void* buffer, size_t bytes) {
+        volatile uint8_t* pages = static_cast<volatile uint8_t*>(buffer);
+        for (size_t offset = 0; offset < bytes; offset += PAGE_BYTES) {
+            pages[offset] = 0;
+        }
+    }
+
+    void* allocateHeap(size_t bytes) {
+#ifdef _WIN32
+        return _aligned_malloc(bytes, FramePool::ALIGNMENT);
+#else
+        return std::aligned_alloc(FramePool::ALIGNMENT, bytes);
+#endif
+    }
+
+    void freeHeap(void* buffer) {
+#ifdef _WIN32
+        _aligned_free(buffer);
+#else
+        std::free(buffer);
+#endif
+    }
+}
+
+const char* getHugePageModeName(HugePageMode mode) {
+    size_t index = static_cast<size_t>(mode);
+    return index < 3 ? HUGE_PAGE_MODE_NAMES[index] : "unknown";
+}
+
+bool findHugePageMode(const char* name, HugePageMode& mode) {
+    for (size_t i = 0; i < 3; ++i) {
+        if (std::strcmp(name, HUGE_PAGE_MODE_NAMES[i]) == 0) {
+            mode = static_cast<HugePageMode>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+FramePool::FramePool()
+    : _pooled(CLASS_COUNT)
+    , _budgetBytes(DEFAULT_BUDGET_BYTES)
+#ifdef _WIN32
+    , _hugePageMode(HugePageMode::Off)
+#else
+    , _hugePageMode(HugePageMode::Transparent)
+#endif
+    , _prefault(true)
+    , _warnedBudget(false)
+    , _warnedHugePages(false) {
+}
+
+FramePool::~FramePool() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (const auto& entry : _blocks) {
+        freeBlock(entry.first, entry.second);
+    }
+    _blocks.clear();
+}
+
+size_t FramePool::getClassBytes(size_t bytes) {
+    return getIndexBytes(getClassIndex(bytes));
+}
+
+void* FramePool::acquire(size_t bytes, size_t& capacity) {
+    const size_t index = getClassIndex(bytes);
+    const size_t classBytes = getIndexBytes(index);
+    capacity = classBytes;
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    std::vector<void*>& pooled = _pooled[index];
+    if (!pooled.empty()) {
+        void* buffer = pooled.back();
+        pooled.pop_back();
+        _stats.pooledBuffers--;
+        _stats.pooledBytes -= classBytes;
+        _stats.liveBuffers++;
+        _stats.liveBytes += classBytes;
+        _stats.peakLiveBytes = std::max(_stats.peakLiveBytes, _stats.liveBytes);
+        _stats.reuses++;
+        return buffer;
+    }
+
+    if (!evictPooled(classBytes)) {
+        _stats.overBudget++;
+        if (!_warnedBudget) {
+            std::cerr << "Frame pool: live frames exceed the " << (_budgetBytes >> 20)
+                      << " MB budget" << std::endl;
+            _warnedBudget = true;
+        }
+    }
+
+    Block block;
+    block.classBytes = classBytes;
+    block.classIndex = index;
+    void* buffer = allocateBlock(classBytes, block);
+    if (_prefault) {
+        prefaultPages(buffer, classBytes);
+    }
+    _blocks.emplace(buffer, block);
+    _stats.systemAllocations++;
+    _stats.liveBuffers++;
+    _stats.liveBytes += classBytes;
+    _stats.peakLiveBytes = std::max(_stats.peakLiveBytes, _stats.liveBytes);
+    if (block.huge) {
+        _stats.hugePageBytes += classBytes;
+    }
+    return buffer;
+}
+
+void FramePool::release(void* buffer) {
+    if (!buffer) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto found = _blocks.find(buffer);
+    if (found == _blocks.end()) {
+        return;
+    }
+    const Block& block = found->second;
+    _stats.liveBuffers--;
+    _stats.liveBytes -= block.classBytes;
+
+    // Over budget (it was lowered, or live frames overran it): give it back
+    if (_stats.liveBytes + _stats.pooledBytes + block.classBytes > _budgetBytes) {
+        if (block.huge) {
+            _stats.hugePageBytes -= block.classBytes;
+        }
+        freeBlock(buffer, block);
+        _blocks.erase(found);
+        return;
+    }
+    _pooled[block.classIndex].push_back(buffer);
+    _stats.pooledBuffers++;
+    _stats.pooledBytes += block.classBytes;
+}
+
+void FramePool::trim() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    freePooledLocked();
+}
+
+void FramePool::setHugePageMode(HugePageMode mode) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (mode != _hugePageMode) {
+        _hugePageMode = mode;
+        _warnedHugePages = false;
+    }
+}
+
+HugePageMode FramePool::getHugePageMode() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _hugePageMode;
+}
+
+void FramePool::setPrefault(bool prefault) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _prefault = prefault;
+}
+
+bool FramePool::getPrefault() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _prefault;
+}
+
+void FramePool::setBudgetBytes(size_t budgetBytes) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _budgetBytes = budgetBytes;
+    _warnedBudget = false;
+    evictPooled(0);
+}
+
+size_t FramePool::getBudgetBytes() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _budgetBytes;
+}
+
+FramePoolStats FramePool::getStats() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _stats;
+}
+
+void* FramePool::allocateBlock(size_t classBytes, Block& block) {
+    block.mappedBytes = 0;
+    block.backing = Backing::Heap;
+    block.huge = false;
+
+    HugePageMode mode = classBytes >= HUGE_PAGE_BYTES ? _hugePageMode : HugePageMode::Off;
+    auto warnFallback = [this](const char* message) {
+        if (!_warnedHugePages) {
+            std::cerr << "Frame pool: " << message << std::endl;
+            _warnedHugePages = true;
+        }
+    };
+
+#ifdef _WIN32
+    if (mode == HugePageMode::Explicit) {
+        // Needs the "Lock pages in memory" privilege; without it this fails
+        const size_t largePage = GetLargePageMinimum();
+        if (largePage > 0) {
+            const size_t length = roundUp(classBytes, largePage);
+            void* buffer = VirtualAlloc(nullptr, length, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+            if (buffer) {
+                block.mappedBytes = length;
+                block.backing = Backing::HugeTlb;
+                block.huge = true;
+                return buffer;
+            }
+        }
+        warnFallback("large pages unavailable (lock pages privilege?), using regular pages");
+    } else if (mode == HugePageMode::Transparent) {
+        warnFallback("transparent huge pages are not supported on Windows, using regular pages");
+    }
+#else
+#ifdef MAP_HUGETLB
+    if (mode == HugePageMode::Explicit) {
+        const size_t length = roundUp(classBytes, HUGE_PAGE_BYTES);
+        void* buffer = mmap(nullptr, length, PROT_READ | PROT_WRITE,
+                            MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (buffer != MAP_FAILED) {
+            block.mappedBytes = length;
+            block.backing = Backing::HugeTlb;
+            block.huge = true;
+            return buffer;
+        }
+        warnFallback("no reserved huge pages (vm.nr_hugepages), using transparent huge pages");
+        mode = HugePageMode::Transparent;
+    }
+#endif
+#ifdef MADV_HUGEPAGE
+    if (mode == HugePageMode::Transparent) {
+        // Over-map by one huge page and trim, so the buffer starts on a 2 MB boundary
+        const size_t length = roundUp(classBytes, HUGE_PAGE_BYTES);
+        void* mapping = mmap(nullptr, length + HUGE_PAGE_BYTES, PROT_READ | PROT_WRITE,
+                             MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (mapping != MAP_FAILED) {
+            uintptr_t base = reinterpret_cast<uintptr_t>(mapping);
+            uintptr_t aligned = roundUp(base, HUGE_PAGE_BYTES);
+            if (aligned > base) {
+                munmap(mapping, aligned - base);
+            }
+            const size_t tail = base + length + HUGE_PAGE_BYTES - (aligned + length);
+            if (tail > 0) {
+                munmap(reinterpret_cast<void*>(aligned + length), tail);
+            }
+            void* buffer = reinterpret_cast<void*>(aligned);
+            // Advisory: the kernel may still use small pages (THP set to "never")
+            block.huge = madvise(buffer, length, MADV_HUGEPAGE) == 0;
+            block.mappedBytes = length;
+            block.backing = Backing::Mapped;
+            return buffer;
+        }
+    }
+#else
+    if (mode != HugePageMode::Off) {
+        warnFallback("huge pages are not supported on this platform, using regular pages");
+    }
+#endif
+#endif
+
+    void* buffer = allocateHeap(classBytes);
+    if (!buffer) {
+        throw std::bad_alloc();
+    }
+    return buffer;
+}
+
+void FramePool::freeBlock(void* buffer, const Block& block) {
+    switch (block.backing) {
+        case Backing::Heap:
+            freeHeap(buffer);
+            break;
+        case Backing::Mapped:
+        case Backing::HugeTlb:
+#ifdef _WIN32
+            VirtualFree(buffer, 0, MEM_RELEASE);
+#else
+            munmap(buffer, block.mappedBytes);
+#endif
+            break;
+    }
+}
+
+bool FramePool::evictPooled(size_t neededBytes) {
+    // Largest classes first: fewest buffers freed for the room needed
+    for (size_t index = CLASS_COUNT; index-- > 0 && _stats.pooledBuffers > 0;) {
+        std::vector<void*>& pooled = _pooled[index];
+        while (!pooled.empty() && _stats.liveBytes + _stats.pooledBytes + neededBytes > _budgetBytes) {
+            void* buffer = pooled.back();
+            pooled.pop_back();
+            auto found = _blocks.find(buffer);
+            const Block& block = found->second;
+            _stats.pooledBuffers--;
+            _stats.pooledBytes -= block.classBytes;
+            if (block.huge) {
+                _stats.hugePageBytes -= block.classBytes;
+            }
+            freeBlock(buffer, block);
+            _blocks.erase(found);
+        }
+    }
+    return _stats.liveBytes + _stats.pooledBytes + neededBytes <= _budgetBytes;
+}
+
+void FramePool::freePooledLocked() {
+    for (std::vector<void*>& pooled : _pooled) {
+        for (void* buffer : pooled) {
+            auto found = _blocks.find(buffer);
+            const Block& block = found->second;
+            if (block.huge) {
+                _stats.hugePageBytes -= block.classBytes;
+            }
+            freeBlock(buffer, block);
+            _blocks.erase(found);
+        }
+        pooled.clear();
+    }
+    _stats.pooledBuffers = 0;
+    _stats.pooledBytes = 0;
+}
+
+FramePool& getFramePool() {
+    static FramePool* pool = new FramePool();
+    return *pool;
+}
+
+} // namespace effects
+} // namespace gamma
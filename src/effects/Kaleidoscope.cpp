@@ -0,0 +1,46 @@
+#include "effects/Effects.h"
+#include "core/Math.h"
+#include <algorithm>
+
+namespace gamma {
+namespace effects {
+
+namespace {
+    const float PI = 3.14159265358979f;
+}
+
+uint64_t KaleidoscopeEffect::prepareMap(int width, int height, const float* parameters) {
+    const int segments = std::max(1, std::min(16, static_cast<int>(parameters[0] + 0.5f)));
+    if (segments == 1) {
+        return 0;
+    }
+    _rotation = parameters[1] * PI / 180.0f;
+    _centerX = parameters[2] * static_cast<float>(width);
+    _centerY = parameters[3] * static_cast<float>(height);
+    _sector = 2.0f * PI / static_cast<float>(segments);
+    return hashMap("Kaleidoscope", width, height,
+                   {static_cast<float>(segments), parameters[1], parameters[2], parameters[3]});
+}
+
+void KaleidoscopeEffect::mapPoints(float* x, float* y, size_t count) const {
+    const float halfSector = _sector * 0.5f;
+    for (size_t i = 0; i < count; ++i) {
+        const float dx = x[i] - _centerX;
+        const float dy = y[i] - _centerY;
+        const float radius = core::sqrt(dx * dx + dy * dy);
+
+        // Angle within its wedge, reflected in the second half
+        float angle = core::atan2(dy, dx) - _rotation;
+        angle -= _sector * core::floor(angle / _sector);
+        if (angle > halfSector) {
+            angle = _sector - angle;
+        }
+        angle += _rotation;
+
+        x[i] = _centerX + radius * core::cos(angle);
+        y[i] = _centerY + radius * core::sin(angle);
+    }
+}
+
+} // namespace effects
+} // namespace gamma
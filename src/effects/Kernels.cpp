@@ -0,0 +1,106 @@
+#include "effects/Kernels.h"
+#include <atomic>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+
+namespace gamma {
+namespace effects {
+
+namespace {
+    // The AVX2 table also uses F16C, present on every AVX2 CPU in practice
+    bool cpuSupportsAvx2() {
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("f16c");
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+        int info[4];
+        __cpuid(info, 0);
+        if (info[0] < 7) {
+            return false;
+        }
+        // The OS has to save YMM registers across context switches
+        __cpuid(info, 1);
+        bool osxsave = (info[2] & (1 << 27)) != 0;
+        bool f16c = (info[2] & (1 << 29)) != 0;
+        if (!osxsave || !f16c || (_xgetbv(0) & 0x6) != 0x6) {
+            return false;
+        }
+        __cpuidex(info, 7, 0);
+        return (info[1] & (1 << 5)) != 0;
+#else
+        return false;
+#endif
+    }
+
+    const KernelTable* tableFor(SimdLevel level) {
+        switch (level) {
+            case SimdLevel::AVX2: return getAvx2Kernels();
+            case SimdLevel::SSE2: return getSse2Kernels();
+            case SimdLevel::Scalar: return getScalarKernels();
+        }
+        return getScalarKernels();
+    }
+
+    SimdLevel detectSimdLevel() {
+        if (getAvx2Kernels() && cpuSupportsAvx2()) {
+            return SimdLevel::AVX2;
+        }
+        // SSE2 is part of the x86-64 baseline: compiled in means supported
+        if (getSse2Kernels()) {
+            return SimdLevel::SSE2;
+        }
+        return SimdLevel::Scalar;
+    }
+
+    std::atomic<const KernelTable*>& activeTable() {
+        static std::atomic<const KernelTable*> table(tableFor(getSupportedSimdLevel()));
+        return table;
+    }
+
+    std::atomic<bool> g_specializationEnabled(true);
+}
+
+const KernelTable& getKernels() {
+    return *activeTable().load(std::memory_order_acquire);
+}
+
+SimdLevel getSupportedSimdLevel() {
+    static const SimdLevel level = detectSimdLevel();
+    return level;
+}
+
+SimdLevel setSimdLevel(SimdLevel level) {
+    if (static_cast<int>(level) > static_cast<int>(getSupportedSimdLevel())) {
+        level = getSupportedSimdLevel();
+    }
+    // Levels below the supported one are always compiled in, except SSE2 off x86
+    const KernelTable* table = tableFor(level);
+    if (!table) {
+        table = getScalarKernels();
+    }
+    activeTable().store(table, std::memory_order_release);
+    return table->level;
+}
+
+const char* getSimdLevelName(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::AVX2: return "AVX2";
+        case SimdLevel::SSE2: return "SSE2";
+        case SimdLevel::Scalar: return "Scalar";
+    }
+    return "Unknown";
+}
+
+void setKernelSpecialization(bool enabled) {
+    g_specializationEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool isKernelSpecializationEnabled() {
+    return g_specializationEnabled.load(std::memory_order_relaxed);
+}
+
+} // namespace effects
+} // namespace gamma
@@ -0,0 +1,568 @@
+// Built with AVX2 and F16C code generation enabled (see CMakeLists.txt). Only reached
+// through the kernel table after a runtime CPU check, so nothing here may be
+// called directly, and no shared inline/template code may be instantiated in
+// this file - the linker could pick the AVX2 copy for other callers.
+#include "effects/Kernels.h"
+
+// MSVC's /arch:AVX2 implies F16C without defining __F16C__
+#if defined(__AVX2__) && (defined(__F16C__) || defined(_MSC_VER))
+#define GAMMA_HAVE_AVX2 1
+#include <immintrin.h>
+#include <utility>
+#endif
+
+namespace gamma {
+namespace effects {
+
+#ifdef GAMMA_HAVE_AVX2
+
+namespace {
+    // 8 pixels per iteration; remainders go through the scalar kernels
+
+    // The scalar kernels are built without AVX, so their SSE code would pay
+    // a transition penalty while the upper halves of the registers are
+    // dirty, and so would everything after them up to the next AVX code.
+    // The compiler only clears them on return, not before the tail jump a
+    // remainder call becomes
+    inline const KernelTable* getRemainderKernels() {
+        _mm256_zeroupper();
+        return getScalarKernels();
+    }
+
+    inline __m256i channelToInt(__m256 value) {
+        const __m256 zero = _mm256_setzero_ps();
+        const __m256 max = _mm256_set1_ps(255.0f);
+        const __m256 half = _mm256_set1_ps(0.5f);
+        value = _mm256_min_ps(_mm256_max_ps(value, zero), max);
+        return _mm256_cvttps_epi32(_mm256_add_ps(value, half));
+    }
+
+    void colorMatrix(const uint32_t* src, uint32_t* dst, size_t count, const ColorMatrix& matrix) {
+        const auto& m = matrix.m;
+        const __m256i byteMask = _mm256_set1_epi32(0xFF);
+        const __m256i alphaMask = _mm256_set1_epi32(static_cast<int>(0xFF000000u));
+        const __m256 m00 = _mm256_set1_ps(m[0][0]), m01 = _mm256_set1_ps(m[0][1]), m02 = _mm256_set1_ps(m[0][2]), m03 = _mm256_set1_ps(m[0][3]);
+        const __m256 m10 = _mm256_set1_ps(m[1][0]), m11 = _mm256_set1_ps(m[1][1]), m12 = _mm256_set1_ps(m[1][2]), m13 = _mm256_set1_ps(m[1][3]);
+        const __m256 m20 = _mm256_set1_ps(m[2][0]), m21 = _mm256_set1_ps(m[2][1]), m22 = _mm256_set1_ps(m[2][2]), m23 = _mm256_set1_ps(m[2][3]);
+
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            __m256i pixels = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+            __m256 r = _mm256_cvtepi32_ps(_mm256_and_si256(pixels, byteMask));
+            __m256 g = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(pixels, 8), byteMask));
+            __m256 b = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(pixels, 16), byteMask));
+
+            // Separate multiply and add (no FMA) keeps results identical to the other levels
+            __m256 outR = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m00, r), _mm256_mul_ps(m01, g)), _mm256_mul_ps(m02, b)), m03);
+            __m256 outG = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m10, r), _mm256_mul_ps(m11, g)), _mm256_mul_ps(m12, b)), m13);
+            __m256 outB = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m20, r), _mm256_mul_ps(m21, g)), _mm256_mul_ps(m22, b)), m23);
+
+            __m256i result = _mm256_or_si256(channelToInt(outR), _mm256_slli_epi32(channelToInt(outG), 8));
+            result = _mm256_or_si256(result, _mm256_slli_epi32(channelToInt(outB), 16));
+            result = _mm256_or_si256(result, _mm256_and_si256(pixels, alphaMask));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), result);
+        }
+        getRemainderKernels()->colorMatrix(src + i, dst + i, count - i, matrix);
+    }
+
+    void mergeChannels(const uint32_t* red, const uint32_t* green, const uint32_t* blue,
+                       uint32_t* dst, size_t count) {
+        const __m256i redMask = _mm256_set1_epi32(0x000000FF);
+        const __m256i greenMask = _mm256_set1_epi32(static_cast<int>(0xFF00FF00u));
+        const __m256i blueMask = _mm256_set1_epi32(0x00FF0000);
+
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            __m256i r = _mm256_and_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(red + i)), redMask);
+            __m256i g = _mm256_and_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(green + i)), greenMask);
+            __m256i b = _mm256_and_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(blue + i)), blueMask);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_or_si256(_mm256_or_si256(r, g), b));
+        }
+        getRemainderKernels()->mergeChannels(red + i, green + i, blue + i, dst + i, count - i);
+    }
+
+    void reverseCopy(const uint32_t* src, uint32_t* dst, size_t count) {
+        const __m256i reversed = _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0);
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            __m256i pixels = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + count - 8 - i));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_permutevar8x32_epi32(pixels, reversed));
+        }
+        getRemainderKernels()->reverseCopy(src, dst + i, count - i);
+    }
+
+    void accumulate(const uint32_t* src, uint16_t* accumulators, size_t count) {
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            // Widen 4 pixels at a time so channels stay in memory order
+            __m256i low = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)));
+            __m256i high = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 4)));
+            __m256i* acc = reinterpret_cast<__m256i*>(accumulators + i * 4);
+            _mm256_storeu_si256(acc, _mm256_add_epi16(_mm256_loadu_si256(acc), low));
+            _mm256_storeu_si256(acc + 1, _mm256_add_epi16(_mm256_loadu_si256(acc + 1), high));
+        }
+        getRemainderKernels()->accumulate(src + i, accumulators + i * 4, count - i);
+    }
+
+    void resolve(const uint16_t* accumulators, uint32_t* dst, size_t count, uint32_t scale) {
+        const __m256i factor = _mm256_set1_epi16(static_cast<short>(scale));
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            const __m256i* acc = reinterpret_cast<const __m256i*>(accumulators + i * 4);
+            __m256i low = _mm256_mulhi_epu16(_mm256_loadu_si256(acc), factor);
+            __m256i high = _mm256_mulhi_epu16(_mm256_loadu_si256(acc + 1), factor);
+            // packus works per 128-bit lane; restore pixel order afterwards
+            __m256i packed = _mm256_packus_epi16(low, high);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_permute4x64_epi64(packed, _MM_SHUFFLE(3, 1, 2, 0)));
+        }
+        getRemainderKernels()->resolve(accumulators + i * 4, dst + i, count - i, scale);
+    }
+
+    void blend(const uint32_t* a, const uint32_t* b, uint32_t* dst, size_t count, uint32_t weight) {
+        const __m256i zero = _mm256_setzero_si256();
+        const __m256i weightB = _mm256_set1_epi16(static_cast<short>(weight));
+        const __m256i weightA = _mm256_set1_epi16(static_cast<short>(256 - weight));
+
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            __m256i pa = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+            __m256i pb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+            // unpack and pack are both per-lane, so they cancel out without a permute
+            __m256i low = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpacklo_epi8(pa, zero), weightA),
+                                           _mm256_mullo_epi16(_mm256_unpacklo_epi8(pb, zero), weightB));
+            __m256i high = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpackhi_epi8(pa, zero), weightA),
+                                            _mm256_mullo_epi16(_mm256_unpackhi_epi8(pb, zero), weightB));
+            __m256i result = _mm256_packus_epi16(_mm256_srli_epi16(low, 8), _mm256_srli_epi16(high, 8));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), result);
+        }
+        getRemainderKernels()->blend(a + i, b + i, dst + i, count - i, weight);
+    }
+
+    template<int Taps>
+    void boxFilter(const uint32_t* const* sources, uint32_t* dst, size_t count, uint32_t scale) {
+        const __m256i factor = _mm256_set1_epi16(static_cast<short>(scale));
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            __m256i low = _mm256_setzero_si256();
+            __m256i high = _mm256_setzero_si256();
+            for (int t = 0; t < Taps; ++t) {
+                const uint32_t* src = sources[t] + i;
+                low = _mm256_add_epi16(low, _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src))));
+                high = _mm256_add_epi16(high, _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 4))));
+            }
+            low = _mm256_mulhi_epu16(low, factor);
+            high = _mm256_mulhi_epu16(high, factor);
+            __m256i packed = _mm256_packus_epi16(low, high);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_permute4x64_epi64(packed, _MM_SHUFFLE(3, 1, 2, 0)));
+        }
+        if (i < count) {
+            const uint32_t* rest[Taps];
+            for (int t = 0; t < Taps; ++t) {
+                rest[t] = sources[t] + i;
+            }
+            getRemainderKernels()->boxFilter[Taps](rest, dst + i, count - i, scale);
+        }
+    }
+
+    void unpackPixels(const uint32_t* src, float* dst, size_t count) {
+        const __m256 scale = _mm256_set1_ps(1.0f / 255.0f);
+
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+            __m256 low = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(pixels));
+            __m256 high = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_srli_si128(pixels, 8)));
+            _mm256_storeu_ps(dst + i * 4, _mm256_mul_ps(low, scale));
+            _mm256_storeu_ps(dst + i * 4 + 8, _mm256_mul_ps(high, scale));
+        }
+        getRemainderKernels()->unpackPixels(src + i, dst + i * 4, count - i);
+    }
+
+    void packPixels(const float* src, uint32_t* dst, size_t count) {
+        const __m256 scale = _mm256_set1_ps(255.0f);
+        // The in-lane packs leave pixels ordered 0 2 4 6 1 3 5 7
+        const __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            const float* in = src + i * 4;
+            __m256i p0 = channelToInt(_mm256_mul_ps(_mm256_loadu_ps(in), scale));
+            __m256i p1 = channelToInt(_mm256_mul_ps(_mm256_loadu_ps(in + 8), scale));
+            __m256i p2 = channelToInt(_mm256_mul_ps(_mm256_loadu_ps(in + 16), scale));
+            __m256i p3 = channelToInt(_mm256_mul_ps(_mm256_loadu_ps(in + 24), scale));
+            __m256i packed = _mm256_packus_epi16(_mm256_packs_epi32(p0, p1), _mm256_packs_epi32(p2, p3));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_permutevar8x32_epi32(packed, order));
+        }
+        getRemainderKernels()->packPixels(src + i * 4, dst + i, count - i);
+    }
+
+    void halfToFloat(const uint16_t* src, float* dst, size_t count) {
+        size_t i = 0;
+        for (; i + 2 <= count; i += 2) {
+            __m128i halves = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 4));
+            _mm256_storeu_ps(dst + i * 4, _mm256_cvtph_ps(halves));
+        }
+        getRemainderKernels()->halfToFloat(src + i * 4, dst + i * 4, count - i);
+    }
+
+    void floatToHalf(const float* src, uint16_t* dst, size_t count) {
+        size_t i = 0;
+        for (; i + 2 <= count; i += 2) {
+            __m128i halves = _mm256_cvtps_ph(_mm256_loadu_ps(src + i * 4), _MM_FROUND_TO_NEAREST_INT);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4), halves);
+        }
+        getRemainderKernels()->floatToHalf(src + i * 4, dst + i * 4, count - i);
+    }
+
+    // Two pixels per register, one per lane: out = col0 * r + col1 * g + col2 * b + col3 * a + offset
+    void colorMatrixFloat(const float* src, float* dst, size_t count, const ColorMatrix& matrix) {
+        const auto& m = matrix.m;
+        const float unit = 1.0f / 255.0f;
+        const __m256 col0 = _mm256_setr_ps(m[0][0], m[1][0], m[2][0], 0.0f, m[0][0], m[1][0], m[2][0], 0.0f);
+        const __m256 col1 = _mm256_setr_ps(m[0][1], m[1][1], m[2][1], 0.0f, m[0][1], m[1][1], m[2][1], 0.0f);
+        const __m256 col2 = _mm256_setr_ps(m[0][2], m[1][2], m[2][2], 0.0f, m[0][2], m[1][2], m[2][2], 0.0f);
+        const __m256 col3 = _mm256_setr_ps(0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f);
+        const __m256 offset = _mm256_setr_ps(m[0][3] * unit, m[1][3] * unit, m[2][3] * unit, 0.0f,
+                                             m[0][3] * unit, m[1][3] * unit, m[2][3] * unit, 0.0f);
+
+        size_t i = 0;
+        for (; i + 2 <= count; i += 2) {
+            __m256 pixels = _mm256_loadu_ps(src + i * 4);
+            __m256 r = _mm256_permute_ps(pixels, _MM_SHUFFLE(0, 0, 0, 0));
+            __m256 g = _mm256_permute_ps(pixels, _MM_SHUFFLE(1, 1, 1, 1));
+            __m256 b = _mm256_permute_ps(pixels, _MM_SHUFFLE(2, 2, 2, 2));
+            __m256 a = _mm256_permute_ps(pixels, _MM_SHUFFLE(3, 3, 3, 3));
+            __m256 out = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(col0, r), _mm256_mul_ps(col1, g)), _mm256_mul_ps(col2, b));
+            out = _mm256_add_ps(_mm256_add_ps(out, offset), _mm256_mul_ps(col3, a));
+            _mm256_storeu_ps(dst + i * 4, out);
+        }
+        getRemainderKernels()->colorMatrixFloat(src + i * 4, dst + i * 4, count - i, matrix);
+    }
+
+    void blendFloat(const float* a, const float* b, float* dst, size_t count, float weight) {
+        const __m256 w = _mm256_set1_ps(weight);
+        size_t i = 0;
+        for (; i + 2 <= count; i += 2) {
+            __m256 va = _mm256_loadu_ps(a + i * 4);
+            __m256 vb = _mm256_loadu_ps(b + i * 4);
+            _mm256_storeu_ps(dst + i * 4, _mm256_add_ps(va, _mm256_mul_ps(_mm256_sub_ps(vb, va), w)));
+        }
+        getRemainderKernels()->blendFloat(a + i * 4, b + i * 4, dst + i * 4, count - i, weight);
+    }
+
+    void boxFilterFloat(const float* const* sources, int taps, float* dst, size_t count, float scale) {
+        const __m256 s = _mm256_set1_ps(scale);
+        size_t i = 0;
+        for (; i + 2 <= count; i += 2) {
+            __m256 sum = _mm256_loadu_ps(sources[0] + i * 4);
+            for (int t = 1; t < taps; ++t) {
+                sum = _mm256_add_ps(sum, _mm256_loadu_ps(sources[t] + i * 4));
+            }
+            _mm256_storeu_ps(dst + i * 4, _mm256_mul_ps(sum, s));
+        }
+        if (i < count) {
+            const float* rest[MAX_BOX_FILTER_TAPS];
+            for (int t = 0; t < taps; ++t) {
+                rest[t] = sources[t] + i * 4;
+            }
+            getRemainderKernels()->boxFilterFloat(rest, taps, dst + i * 4, count - i, scale);
+        }
+    }
+
+    // Corners and weights of eight pixels, one per lane (see the scalar kernel
+    // for the geometry). Corners are float offsets into the grid entries
+    struct LutCells {
+        alignas(32) int32_t corners[4][8];
+        alignas(32) float weights[4][8];
+    };
+
+    void findCells(const LutGrid& lut, __m256 r, __m256 g, __m256 b, LutCells& cells) {
+        const __m256 zero = _mm256_setzero_ps();
+        const __m256 last = _mm256_set1_ps(static_cast<float>(lut.size - 1));
+        const __m256 lastCell = _mm256_set1_ps(static_cast<float>(lut.size - 2));
+        const __m256 one = _mm256_set1_ps(1.0f);
+        const float strideG = static_cast<float>(lut.size);
+        const float strideB = strideG * strideG;
+        const __m256 stepG = _mm256_set1_ps(strideG);
+        const __m256 stepB = _mm256_set1_ps(strideB);
+        const __m256 diagonal = _mm256_set1_ps(1.0f + strideG + strideB);
+
+        __m256 fractions[3];
+        __m256 base = zero;
+        const __m256 channels[3] = {r, g, b};
+        const __m256 strides[3] = {one, stepG, stepB};
+        for (int c = 0; c < 3; ++c) {
+            __m256 coordinate = _mm256_add_ps(_mm256_mul_ps(channels[c], _mm256_set1_ps(lut.scale[c])),
+                                              _mm256_set1_ps(lut.offset[c]));
+            coordinate = _mm256_min_ps(_mm256_max_ps(coordinate, zero), last);
+            __m256 index = _mm256_min_ps(_mm256_cvtepi32_ps(_mm256_cvttps_epi32(coordinate)), lastCell);
+            fractions[c] = _mm256_sub_ps(coordinate, index);
+            base = _mm256_add_ps(base, _mm256_mul_ps(index, strides[c]));
+        }
+        const __m256 fr = fractions[0];
+        const __m256 fg = fractions[1];
+        const __m256 fb = fractions[2];
+
+        const __m256 redMax = _mm256_and_ps(_mm256_cmp_ps(fr, fg, _CMP_GE_OQ), _mm256_cmp_ps(fr, fb, _CMP_GE_OQ));
+        const __m256 maxStep = _mm256_blendv_ps(_mm256_blendv_ps(stepB, stepG, _mm256_cmp_ps(fg, fb, _CMP_GE_OQ)), one, redMax);
+        const __m256 blueMin = _mm256_and_ps(_mm256_cmp_ps(fb, fg, _CMP_LE_OQ), _mm256_cmp_ps(fb, fr, _CMP_LE_OQ));
+        const __m256 minStep = _mm256_blendv_ps(_mm256_blendv_ps(one, stepG, _mm256_cmp_ps(fg, fr, _CMP_LE_OQ)), stepB, blueMin);
+        const __m256 maxFraction = _mm256_max_ps(fr, _mm256_max_ps(fg, fb));
+        const __m256 minFraction = _mm256_min_ps(fr, _mm256_min_ps(fg, fb));
+        const __m256 midFraction = _mm256_sub_ps(_mm256_sub_ps(_mm256_add_ps(_mm256_add_ps(fr, fg), fb), maxFraction),
+                                                 minFraction);
+
+        const __m256 four = _mm256_set1_ps(4.0f);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(cells.corners[0]), _mm256_cvttps_epi32(_mm256_mul_ps(base, four)));
+        _mm256_store_si256(reinterpret_cast<__m256i*>(cells.corners[1]),
+                           _mm256_cvttps_epi32(_mm256_mul_ps(_mm256_add_ps(base, maxStep), four)));
+        _mm256_store_si256(reinterpret_cast<__m256i*>(cells.corners[2]),
+                           _mm256_cvttps_epi32(_mm256_mul_ps(_mm256_sub_ps(_mm256_add_ps(base, diagonal), minStep), four)));
+        _mm256_store_si256(reinterpret_cast<__m256i*>(cells.corners[3]),
+                           _mm256_cvttps_epi32(_mm256_mul_ps(_mm256_add_ps(base, diagonal), four)));
+        _mm256_store_ps(cells.weights[0], _mm256_sub_ps(one, maxFraction));
+        _mm256_store_ps(cells.weights[1], _mm256_sub_ps(maxFraction, midFraction));
+        _mm256_store_ps(cells.weights[2], _mm256_sub_ps(midFraction, minFraction));
+        _mm256_store_ps(cells.weights[3], minFraction);
+    }
+
+    // Pixels k and k + 1 of a LutCells, as RGBA floats in the low and high half:
+    // each corner is one 16-byte load, so two pixels take eight loads where
+    // gathering them channel by channel would take 24
+    inline __m256 blendCells(const LutGrid& lut, const LutCells& cells, int k) {
+        __m256 sum = _mm256_setzero_ps();
+        for (int corner = 0; corner < 4; ++corner) {
+            const __m256 entry = _mm256_insertf128_ps(
+                _mm256_castps128_ps256(_mm_loadu_ps(lut.entries + cells.corners[corner][k])),
+                _mm_loadu_ps(lut.entries + cells.corners[corner][k + 1]), 1);
+            const __m256 weight = _mm256_insertf128_ps(
+                _mm256_castps128_ps256(_mm_broadcast_ss(&cells.weights[corner][k])),
+                _mm_broadcast_ss(&cells.weights[corner][k + 1]), 1);
+            const __m256 term = _mm256_mul_ps(entry, weight);
+            sum = corner == 0 ? term : _mm256_add_ps(sum, term);
+        }
+        return sum;
+    }
+
+    void applyLut(const uint32_t* src, uint32_t* dst, size_t count, const LutGrid& lut) {
+        const __m256i byteMask = _mm256_set1_epi32(0xFF);
+        const __m256i colorMask = _mm256_set1_epi32(0x00FFFFFF);
+        const __m256i alphaMask = _mm256_set1_epi32(static_cast<int>(0xFF000000u));
+        const __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+        const __m256 unit = _mm256_set1_ps(1.0f / 255.0f);
+        const __m256 scale = _mm256_set1_ps(255.0f);
+        LutCells cells;
+
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            __m256i pixels = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+            __m256 r = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_and_si256(pixels, byteMask)), unit);
+            __m256 g = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(pixels, 8), byteMask)), unit);
+            __m256 b = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(pixels, 16), byteMask)), unit);
+            findCells(lut, r, g, b, cells);
+
+            // Halves hold pixels (0, 1), (2, 3)...; packing interleaves the
+            // halves, so pixels come out as 0 2 4 6 1 3 5 7 and are put back in order
+            __m256i p01 = channelToInt(_mm256_mul_ps(blendCells(lut, cells, 0), scale));
+            __m256i p23 = channelToInt(_mm256_mul_ps(blendCells(lut, cells, 2), scale));
+            __m256i p45 = channelToInt(_mm256_mul_ps(blendCells(lut, cells, 4), scale));
+            __m256i p67 = channelToInt(_mm256_mul_ps(blendCells(lut, cells, 6), scale));
+            __m256i packed = _mm256_packus_epi16(_mm256_packus_epi32(p01, p23), _mm256_packus_epi32(p45, p67));
+            packed = _mm256_permutevar8x32_epi32(packed, order);
+            packed = _mm256_or_si256(_mm256_and_si256(packed, colorMask), _mm256_and_si256(pixels, alphaMask));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), packed);
+        }
+        getRemainderKernels()->applyLut(src + i, dst + i, count - i, lut);
+    }
+
+    void applyLutFloat(const float* src, float* dst, size_t count, const LutGrid& lut) {
+        LutCells cells;
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            // Pixels 0-7 to channel vectors: pair pixel k with k + 4 across the
+            // halves, then transpose each half as 4x4
+            const float* in = src + i * 4;
+            __m256 a0 = _mm256_loadu_ps(in);
+            __m256 a1 = _mm256_loadu_ps(in + 8);
+            __m256 a2 = _mm256_loadu_ps(in + 16);
+            __m256 a3 = _mm256_loadu_ps(in + 24);
+            __m256 q0 = _mm256_permute2f128_ps(a0, a2, 0x20);
+            __m256 q1 = _mm256_permute2f128_ps(a0, a2, 0x31);
+            __m256 q2 = _mm256_permute2f128_ps(a1, a3, 0x20);
+            __m256 q3 = _mm256_permute2f128_ps(a1, a3, 0x31);
+            __m256 t0 = _mm256_unpacklo_ps(q0, q1);
+            __m256 t1 = _mm256_unpackhi_ps(q0, q1);
+            __m256 t2 = _mm256_unpacklo_ps(q2, q3);
+            __m256 t3 = _mm256_unpackhi_ps(q2, q3);
+            __m256 r = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+            __m256 g = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+            __m256 b = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+            findCells(lut, r, g, b, cells);
+
+            // Results come back as interleaved pixel pairs, in the layout of
+            // the loads, so only alpha needs restoring from the source
+            const __m256 sources[4] = {a0, a1, a2, a3};
+            float* result = dst + i * 4;
+            for (int pair = 0; pair < 4; ++pair) {
+                _mm256_storeu_ps(result + pair * 8, _mm256_blend_ps(blendCells(lut, cells, pair * 2), sources[pair], 0x88));
+            }
+        }
+        getRemainderKernels()->applyLutFloat(src + i * 4, dst + i * 4, count - i, lut);
+    }
+
+    // Bilinear footprints of eight positions (see the scalar kernel): texel
+    // offset of the top left corner, the steps to its right and lower
+    // neighbours (0 on the last column and row) and the fractions
+    struct RemapLanes {
+        __m256i offset;
+        __m256i right;
+        __m256i down;
+        __m256 fx;
+        __m256 fy;
+    };
+
+    inline __m256 splitPositions(__m256 position, int size, __m256i& index) {
+        const __m256 last = _mm256_set1_ps(static_cast<float>(size - 1));
+        const __m256 lastIndex = _mm256_set1_ps(static_cast<float>(size > 2 ? size - 2 : 0));
+        __m256 p = _mm256_sub_ps(position, _mm256_set1_ps(0.5f));
+        p = _mm256_min_ps(_mm256_max_ps(p, _mm256_setzero_ps()), last);
+        index = _mm256_cvttps_epi32(_mm256_min_ps(p, lastIndex));
+        return _mm256_sub_ps(p, _mm256_cvtepi32_ps(index));
+    }
+
+    inline RemapLanes findFootprints(const RemapSource& source, const float* x, const float* y) {
+        const __m256i one = _mm256_set1_epi32(1);
+        const __m256i stride = _mm256_set1_epi32(static_cast<int>(source.stride));
+        RemapLanes lanes;
+        __m256i ix, iy;
+        lanes.fx = splitPositions(_mm256_loadu_ps(x), source.width, ix);
+        lanes.fy = splitPositions(_mm256_loadu_ps(y), source.height, iy);
+        lanes.offset = _mm256_add_epi32(_mm256_mullo_epi32(iy, stride), ix);
+        lanes.right = _mm256_and_si256(_mm256_cmpgt_epi32(_mm256_set1_epi32(source.width), _mm256_add_epi32(ix, one)), one);
+        lanes.down = _mm256_and_si256(_mm256_cmpgt_epi32(_mm256_set1_epi32(source.height), _mm256_add_epi32(iy, one)), stride);
+        return lanes;
+    }
+
+    inline __m256 lerp(__m256 a, __m256 b, __m256 t) {
+        return _mm256_add_ps(a, _mm256_mul_ps(_mm256_sub_ps(b, a), t));
+    }
+
+    void remap(const RemapSource& source, const float* x, const float* y, uint32_t* dst, size_t count) {
+        const int* pixels = static_cast<const int*>(source.pixels);
+        const __m256i byteMask = _mm256_set1_epi32(0xFF);
+
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            const RemapLanes lanes = findFootprints(source, x + i, y + i);
+            const __m256i below = _mm256_add_epi32(lanes.offset, lanes.down);
+            const __m256i c00 = _mm256_i32gather_epi32(pixels, lanes.offset, 4);
+            const __m256i c10 = _mm256_i32gather_epi32(pixels, _mm256_add_epi32(lanes.offset, lanes.right), 4);
+            const __m256i c01 = _mm256_i32gather_epi32(pixels, below, 4);
+            const __m256i c11 = _mm256_i32gather_epi32(pixels, _mm256_add_epi32(below, lanes.right), 4);
+
+            __m256i result = _mm256_setzero_si256();
+            for (int shift = 0; shift < 32; shift += 8) {
+                const __m256 top = lerp(_mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(c00, shift), byteMask)),
+                                        _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(c10, shift), byteMask)),
+                                        lanes.fx);
+                const __m256 bottom = lerp(_mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(c01, shift), byteMask)),
+                                           _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(c11, shift), byteMask)),
+                                           lanes.fx);
+                result = _mm256_or_si256(result, _mm256_slli_epi32(channelToInt(lerp(top, bottom, lanes.fy)), shift));
+            }
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), result);
+        }
+        getRemainderKernels()->remap(source, x + i, y + i, dst + i, count - i);
+    }
+
+    inline __m128 loadTexel(const RemapSource& source, int offset) {
+        const size_t index = static_cast<size_t>(offset);
+        switch (source.format) {
+        case PixelFormat::RGBA32F:
+            return _mm_loadu_ps(static_cast<const float*>(source.pixels) + index * 4);
+        case PixelFormat::RGBA16F:
+            return _mm_cvtph_ps(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(
+                static_cast<const uint16_t*>(source.pixels) + index * 4)));
+        default: {
+            const int pixel = static_cast<const int*>(source.pixels)[index];
+            return _mm_mul_ps(_mm_cvtepi32_ps(_mm_cvtepu8_epi32(_mm_cvtsi32_si128(pixel))), _mm_set1_ps(1.0f / 255.0f));
+        }
+        }
+    }
+
+    // Two pixels per register: the same corner of pixels a and b
+    inline __m256 loadTexels(const RemapSource& source, const int* offsets, int a, int b) {
+        return _mm256_set_m128(loadTexel(source, offsets[b]), loadTexel(source, offsets[a]));
+    }
+
+    void remapFloat(const RemapSource& source, const float* x, const float* y, float* dst, size_t count) {
+        alignas(32) int offsets[4][8];      // [corner][lane]
+        alignas(32) float fx[8];
+        alignas(32) float fy[8];
+
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            const RemapLanes lanes = findFootprints(source, x + i, y + i);
+            const __m256i below = _mm256_add_epi32(lanes.offset, lanes.down);
+            _mm256_store_si256(reinterpret_cast<__m256i*>(offsets[0]), lanes.offset);
+            _mm256_store_si256(reinterpret_cast<__m256i*>(offsets[1]), _mm256_add_epi32(lanes.offset, lanes.right));
+            _mm256_store_si256(reinterpret_cast<__m256i*>(offsets[2]), below);
+            _mm256_store_si256(reinterpret_cast<__m256i*>(offsets[3]), _mm256_add_epi32(below, lanes.right));
+            _mm256_store_ps(fx, lanes.fx);
+            _mm256_store_ps(fy, lanes.fy);
+
+            for (int a = 0; a < 8; a += 2) {
+                const int b = a + 1;
+                const __m256 wx = _mm256_set_m128(_mm_set1_ps(fx[b]), _mm_set1_ps(fx[a]));
+                const __m256 wy = _mm256_set_m128(_mm_set1_ps(fy[b]), _mm_set1_ps(fy[a]));
+                const __m256 top = lerp(loadTexels(source, offsets[0], a, b), loadTexels(source, offsets[1], a, b), wx);
+                const __m256 bottom = lerp(loadTexels(source, offsets[2], a, b), loadTexels(source, offsets[3], a, b), wx);
+                _mm256_storeu_ps(dst + (i + static_cast<size_t>(a)) * 4, lerp(top, bottom, wy));
+            }
+        }
+        getRemainderKernels()->remapFloat(source, x + i, y + i, dst + i * 4, count - i);
+    }
+
+    // Built here rather than shared with the other levels: see the note at the top
+    template<size_t... Index>
+    constexpr KernelTable makeTable(std::index_sequence<Index...>) {
+        return {
+            SimdLevel::AVX2,
+            &colorMatrix,
+            &mergeChannels,
+            &reverseCopy,
+            &accumulate,
+            &resolve,
+            &blend,
+            &unpackPixels,
+            &packPixels,
+            &halfToFloat,
+            &floatToHalf,
+            &colorMatrixFloat,
+            &blendFloat,
+            &boxFilterFloat,
+            &applyLut,
+            &applyLutFloat,
+            &remap,
+            &remapFloat,
+            {nullptr, nullptr, &boxFilter<static_cast<int>(Index) + 2>...}
+        };
+    }
+
+    const KernelTable AVX2_KERNELS = makeTable(std::make_index_sequence<MAX_BOX_FILTER_TAPS - 1>());
+}
+
+const KernelTable* getAvx2Kernels() {
+    return &AVX2_KERNELS;
+}
+
+#else
+
+const KernelTable* getAvx2Kernels() {
+    return nullptr;
+}
+
+#endif
+
+} // namespace effects
+} // namespace gamma
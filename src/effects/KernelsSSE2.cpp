@@ -0,0 +1,493 @@
+#include "effects/Kernels.h"
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define GAMMA_HAVE_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace gamma {
+namespace effects {
+
+#ifdef GAMMA_HAVE_SSE2
+
+namespace {
+    // 4 pixels per iteration; remainders go through the scalar kernels
+
+    inline __m128i channelToInt(__m128 value) {
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 max = _mm_set1_ps(255.0f);
+        const __m128 half = _mm_set1_ps(0.5f);
+        value = _mm_min_ps(_mm_max_ps(value, zero), max);
+        return _mm_cvttps_epi32(_mm_add_ps(value, half));
+    }
+
+    void colorMatrix(const uint32_t* src, uint32_t* dst, size_t count, const ColorMatrix& matrix) {
+        const auto& m = matrix.m;
+        const __m128i byteMask = _mm_set1_epi32(0xFF);
+        const __m128i alphaMask = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+        const __m128 m00 = _mm_set1_ps(m[0][0]), m01 = _mm_set1_ps(m[0][1]), m02 = _mm_set1_ps(m[0][2]), m03 = _mm_set1_ps(m[0][3]);
+        const __m128 m10 = _mm_set1_ps(m[1][0]), m11 = _mm_set1_ps(m[1][1]), m12 = _mm_set1_ps(m[1][2]), m13 = _mm_set1_ps(m[1][3]);
+        const __m128 m20 = _mm_set1_ps(m[2][0]), m21 = _mm_set1_ps(m[2][1]), m22 = _mm_set1_ps(m[2][2]), m23 = _mm_set1_ps(m[2][3]);
+
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+            __m128 r = _mm_cvtepi32_ps(_mm_and_si128(pixels, byteMask));
+            __m128 g = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(pixels, 8), byteMask));
+            __m128 b = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(pixels, 16), byteMask));
+
+            __m128 outR = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m00, r), _mm_mul_ps(m01, g)), _mm_mul_ps(m02, b)), m03);
+            __m128 outG = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m10, r), _mm_mul_ps(m11, g)), _mm_mul_ps(m12, b)), m13);
+            __m128 outB = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m20, r), _mm_mul_ps(m21, g)), _mm_mul_ps(m22, b)), m23);
+
+            __m128i result = _mm_or_si128(channelToInt(outR), _mm_slli_epi32(channelToInt(outG), 8));
+            result = _mm_or_si128(result, _mm_slli_epi32(channelToInt(outB), 16));
+            result = _mm_or_si128(result, _mm_and_si128(pixels, alphaMask));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), result);
+        }
+        getScalarKernels()->colorMatrix(src + i, dst + i, count - i, matrix);
+    }
+
+    void mergeChannels(const uint32_t* red, const uint32_t* green, const uint32_t* blue,
+                       uint32_t* dst, size_t count) {
+        const __m128i redMask = _mm_set1_epi32(0x000000FF);
+        const __m128i greenMask = _mm_set1_epi32(static_cast<int>(0xFF00FF00u));
+        const __m128i blueMask = _mm_set1_epi32(0x00FF0000);
+
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            __m128i r = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(red + i)), redMask);
+            __m128i g = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(green + i)), greenMask);
+            __m128i b = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(blue + i)), blueMask);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_or_si128(_mm_or_si128(r, g), b));
+        }
+        getScalarKernels()->mergeChannels(red + i, green + i, blue + i, dst + i, count - i);
+    }
+
+    void reverseCopy(const uint32_t* src, uint32_t* dst, size_t count) {
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + count - 4 - i));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_shuffle_epi32(pixels, _MM_SHUFFLE(0, 1, 2, 3)));
+        }
+        // dst[i..count) takes src[0..count-i) reversed
+        getScalarKernels()->reverseCopy(src, dst + i, count - i);
+    }
+
+    void accumulate(const uint32_t* src, uint16_t* accumulators, size_t count) {
+        const __m128i zero = _mm_setzero_si128();
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+            __m128i* acc = reinterpret_cast<__m128i*>(accumulators + i * 4);
+            __m128i low = _mm_add_epi16(_mm_loadu_si128(acc), _mm_unpacklo_epi8(pixels, zero));
+            __m128i high = _mm_add_epi16(_mm_loadu_si128(acc + 1), _mm_unpackhi_epi8(pixels, zero));
+            _mm_storeu_si128(acc, low);
+            _mm_storeu_si128(acc + 1, high);
+        }
+        getScalarKernels()->accumulate(src + i, accumulators + i * 4, count - i);
+    }
+
+    void resolve(const uint16_t* accumulators, uint32_t* dst, size_t count, uint32_t scale) {
+        const __m128i factor = _mm_set1_epi16(static_cast<short>(scale));
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            const __m128i* acc = reinterpret_cast<const __m128i*>(accumulators + i * 4);
+            __m128i low = _mm_mulhi_epu16(_mm_loadu_si128(acc), factor);
+            __m128i high = _mm_mulhi_epu16(_mm_loadu_si128(acc + 1), factor);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi16(low, high));
+        }
+        getScalarKernels()->resolve(accumulators + i * 4, dst + i, count - i, scale);
+    }
+
+    void blend(const uint32_t* a, const uint32_t* b, uint32_t* dst, size_t count, uint32_t weight) {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i weightB = _mm_set1_epi16(static_cast<short>(weight));
+        const __m128i weightA = _mm_set1_epi16(static_cast<short>(256 - weight));
+
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            __m128i pa = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+            __m128i pb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+            __m128i low = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(pa, zero), weightA),
+                                        _mm_mullo_epi16(_mm_unpacklo_epi8(pb, zero), weightB));
+            __m128i high = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(pa, zero), weightA),
+                                         _mm_mullo_epi16(_mm_unpackhi_epi8(pb, zero), weightB));
+            __m128i result = _mm_packus_epi16(_mm_srli_epi16(low, 8), _mm_srli_epi16(high, 8));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), result);
+        }
+        getScalarKernels()->blend(a + i, b + i, dst + i, count - i, weight);
+    }
+
+    template<int Taps>
+    void boxFilter(const uint32_t* const* sources, uint32_t* dst, size_t count, uint32_t scale) {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i factor = _mm_set1_epi16(static_cast<short>(scale));
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            __m128i low = zero;
+            __m128i high = zero;
+            for (int t = 0; t < Taps; ++t) {
+                __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(sources[t] + i));
+                low = _mm_add_epi16(low, _mm_unpacklo_epi8(pixels, zero));
+                high = _mm_add_epi16(high, _mm_unpackhi_epi8(pixels, zero));
+            }
+            low = _mm_mulhi_epu16(low, factor);
+            high = _mm_mulhi_epu16(high, factor);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi16(low, high));
+        }
+        if (i < count) {
+            const uint32_t* rest[Taps];
+            for (int t = 0; t < Taps; ++t) {
+                rest[t] = sources[t] + i;
+            }
+            getScalarKernels()->boxFilter[Taps](rest, dst + i, count - i, scale);
+        }
+    }
+
+    void unpackPixels(const uint32_t* src, float* dst, size_t count) {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128 scale = _mm_set1_ps(1.0f / 255.0f);
+
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+            __m128i low = _mm_unpacklo_epi8(pixels, zero);
+            __m128i high = _mm_unpackhi_epi8(pixels, zero);
+            float* out = dst + i * 4;
+            _mm_storeu_ps(out, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(low, zero)), scale));
+            _mm_storeu_ps(out + 4, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(low, zero)), scale));
+            _mm_storeu_ps(out + 8, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(high, zero)), scale));
+            _mm_storeu_ps(out + 12, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(high, zero)), scale));
+        }
+        getScalarKernels()->unpackPixels(src + i, dst + i * 4, count - i);
+    }
+
+    void packPixels(const float* src, uint32_t* dst, size_t count) {
+        const __m128 scale = _mm_set1_ps(255.0f);
+
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            const float* in = src + i * 4;
+            __m128i p0 = channelToInt(_mm_mul_ps(_mm_loadu_ps(in), scale));
+            __m128i p1 = channelToInt(_mm_mul_ps(_mm_loadu_ps(in + 4), scale));
+            __m128i p2 = channelToInt(_mm_mul_ps(_mm_loadu_ps(in + 8), scale));
+            __m128i p3 = channelToInt(_mm_mul_ps(_mm_loadu_ps(in + 12), scale));
+            // Values are 0..255 already, so the saturating packs just narrow
+            __m128i packed = _mm_packus_epi16(_mm_packs_epi32(p0, p1), _mm_packs_epi32(p2, p3));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), packed);
+        }
+        getScalarKernels()->packPixels(src + i * 4, dst + i, count - i);
+    }
+
+    // SSE2 has no half-float conversion; F16C comes with the AVX2 table
+    void halfToFloat(const uint16_t* src, float* dst, size_t count) {
+        getScalarKernels()->halfToFloat(src, dst, count);
+    }
+
+    void floatToHalf(const float* src, uint16_t* dst, size_t count) {
+        getScalarKernels()->floatToHalf(src, dst, count);
+    }
+
+    // One pixel per register: out = col0 * r + col1 * g + col2 * b + col3 * a + offset
+    void colorMatrixFloat(const float* src, float* dst, size_t count, const ColorMatrix& matrix) {
+        const auto& m = matrix.m;
+        const float unit = 1.0f / 255.0f;
+        const __m128 col0 = _mm_setr_ps(m[0][0], m[1][0], m[2][0], 0.0f);
+        const __m128 col1 = _mm_setr_ps(m[0][1], m[1][1], m[2][1], 0.0f);
+        const __m128 col2 = _mm_setr_ps(m[0][2], m[1][2], m[2][2], 0.0f);
+        const __m128 col3 = _mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f);
+        const __m128 offset = _mm_setr_ps(m[0][3] * unit, m[1][3] * unit, m[2][3] * unit, 0.0f);
+
+        for (size_t i = 0; i < count; ++i) {
+            __m128 pixel = _mm_loadu_ps(src + i * 4);
+            __m128 r = _mm_shuffle_ps(pixel, pixel, _MM_SHUFFLE(0, 0, 0, 0));
+            __m128 g = _mm_shuffle_ps(pixel, pixel, _MM_SHUFFLE(1, 1, 1, 1));
+            __m128 b = _mm_shuffle_ps(pixel, pixel, _MM_SHUFFLE(2, 2, 2, 2));
+            __m128 a = _mm_shuffle_ps(pixel, pixel, _MM_SHUFFLE(3, 3, 3, 3));
+            __m128 out = _mm_add_ps(_mm_add_ps(_mm_mul_ps(col0, r), _mm_mul_ps(col1, g)), _mm_mul_ps(col2, b));
+            out = _mm_add_ps(_mm_add_ps(out, offset), _mm_mul_ps(col3, a));
+            _mm_storeu_ps(dst + i * 4, out);
+        }
+    }
+
+    void blendFloat(const float* a, const float* b, float* dst, size_t count, float weight) {
+        const __m128 w = _mm_set1_ps(weight);
+        const size_t values = count * 4;
+        for (size_t i = 0; i < values; i += 4) {
+            __m128 va = _mm_loadu_ps(a + i);
+            __m128 vb = _mm_loadu_ps(b + i);
+            _mm_storeu_ps(dst + i, _mm_add_ps(va, _mm_mul_ps(_mm_sub_ps(vb, va), w)));
+        }
+    }
+
+    void boxFilterFloat(const float* const* sources, int taps, float* dst, size_t count, float scale) {
+        const __m128 s = _mm_set1_ps(scale);
+        const size_t values = count * 4;
+        for (size_t i = 0; i < values; i += 4) {
+            __m128 sum = _mm_loadu_ps(sources[0] + i);
+            for (int t = 1; t < taps; ++t) {
+                sum = _mm_add_ps(sum, _mm_loadu_ps(sources[t] + i));
+            }
+            _mm_storeu_ps(dst + i, _mm_mul_ps(sum, s));
+        }
+    }
+
+    // Corners and weights of four pixels' tetrahedra (see the scalar kernel),
+    // worked out four lanes at a time; corners are float offsets of entries
+    struct LutLanes {
+        alignas(16) int32_t corners[4][4];      // [corner][lane]
+        alignas(16) float weights[4][4];
+    };
+
+    inline __m128 select(__m128 mask, __m128 a, __m128 b) {
+        return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+    }
+
+    void findTetrahedra(const LutGrid& lut, __m128 r, __m128 g, __m128 b, LutLanes& lanes) {
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 last = _mm_set1_ps(static_cast<float>(lut.size - 1));
+        const __m128 lastCell = _mm_set1_ps(static_cast<float>(lut.size - 2));
+        const __m128 one = _mm_set1_ps(1.0f);
+        const float strideG = static_cast<float>(lut.size);
+        const float strideB = strideG * strideG;
+        const __m128 stepG = _mm_set1_ps(strideG);
+        const __m128 stepB = _mm_set1_ps(strideB);
+        const __m128 diagonal = _mm_set1_ps(1.0f + strideG + strideB);
+
+        __m128 fractions[3];
+        __m128 base = zero;
+        const __m128 channels[3] = {r, g, b};
+        const __m128 strides[3] = {one, stepG, stepB};
+        for (int c = 0; c < 3; ++c) {
+            __m128 coordinate = _mm_add_ps(_mm_mul_ps(channels[c], _mm_set1_ps(lut.scale[c])), _mm_set1_ps(lut.offset[c]));
+            coordinate = _mm_min_ps(_mm_max_ps(coordinate, zero), last);
+            // Non-negative, so truncation is the floor
+            __m128 index = _mm_min_ps(_mm_cvtepi32_ps(_mm_cvttps_epi32(coordinate)), lastCell);
+            fractions[c] = _mm_sub_ps(coordinate, index);
+            base = _mm_add_ps(base, _mm_mul_ps(index, strides[c]));
+        }
+        const __m128 fr = fractions[0];
+        const __m128 fg = fractions[1];
+        const __m128 fb = fractions[2];
+
+        const __m128 redMax = _mm_and_ps(_mm_cmpge_ps(fr, fg), _mm_cmpge_ps(fr, fb));
+        const __m128 maxStep = select(redMax, one, select(_mm_cmpge_ps(fg, fb), stepG, stepB));
+        const __m128 blueMin = _mm_and_ps(_mm_cmple_ps(fb, fg), _mm_cmple_ps(fb, fr));
+        const __m128 minStep = select(blueMin, stepB, select(_mm_cmple_ps(fg, fr), stepG, one));
+        const __m128 maxFraction = _mm_max_ps(fr, _mm_max_ps(fg, fb));
+        const __m128 minFraction = _mm_min_ps(fr, _mm_min_ps(fg, fb));
+        const __m128 midFraction = _mm_sub_ps(_mm_sub_ps(_mm_add_ps(_mm_add_ps(fr, fg), fb), maxFraction), minFraction);
+
+        const __m128 four = _mm_set1_ps(4.0f);
+        _mm_store_si128(reinterpret_cast<__m128i*>(lanes.corners[0]), _mm_cvttps_epi32(_mm_mul_ps(base, four)));
+        _mm_store_si128(reinterpret_cast<__m128i*>(lanes.corners[1]), _mm_cvttps_epi32(_mm_mul_ps(_mm_add_ps(base, maxStep), four)));
+        _mm_store_si128(reinterpret_cast<__m128i*>(lanes.corners[2]),
+                        _mm_cvttps_epi32(_mm_mul_ps(_mm_sub_ps(_mm_add_ps(base, diagonal), minStep), four)));
+        _mm_store_si128(reinterpret_cast<__m128i*>(lanes.corners[3]), _mm_cvttps_epi32(_mm_mul_ps(_mm_add_ps(base, diagonal), four)));
+        _mm_store_ps(lanes.weights[0], _mm_sub_ps(one, maxFraction));
+        _mm_store_ps(lanes.weights[1], _mm_sub_ps(maxFraction, midFraction));
+        _mm_store_ps(lanes.weights[2], _mm_sub_ps(midFraction, minFraction));
+        _mm_store_ps(lanes.weights[3], minFraction);
+    }
+
+    // One pixel per register: its four corner entries, weighted
+    inline __m128 blendCorners(const float* entries, const LutLanes& lanes, int lane) {
+        __m128 sum = _mm_mul_ps(_mm_loadu_ps(entries + lanes.corners[0][lane]), _mm_set1_ps(lanes.weights[0][lane]));
+        sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(entries + lanes.corners[1][lane]), _mm_set1_ps(lanes.weights[1][lane])));
+        sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(entries + lanes.corners[2][lane]), _mm_set1_ps(lanes.weights[2][lane])));
+        return _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(entries + lanes.corners[3][lane]), _mm_set1_ps(lanes.weights[3][lane])));
+    }
+
+    void applyLut(const uint32_t* src, uint32_t* dst, size_t count, const LutGrid& lut) {
+        const __m128i byteMask = _mm_set1_epi32(0xFF);
+        const __m128i alphaMask = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+        const __m128 unit = _mm_set1_ps(1.0f / 255.0f);
+        const __m128 scale = _mm_set1_ps(255.0f);
+        LutLanes lanes;
+
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+            __m128 r = _mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(pixels, byteMask)), unit);
+            __m128 g = _mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(pixels, 8), byteMask)), unit);
+            __m128 b = _mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(pixels, 16), byteMask)), unit);
+            findTetrahedra(lut, r, g, b, lanes);
+
+            __m128i p0 = channelToInt(_mm_mul_ps(blendCorners(lut.entries, lanes, 0), scale));
+            __m128i p1 = channelToInt(_mm_mul_ps(blendCorners(lut.entries, lanes, 1), scale));
+            __m128i p2 = channelToInt(_mm_mul_ps(blendCorners(lut.entries, lanes, 2), scale));
+            __m128i p3 = channelToInt(_mm_mul_ps(blendCorners(lut.entries, lanes, 3), scale));
+            __m128i packed = _mm_packus_epi16(_mm_packs_epi32(p0, p1), _mm_packs_epi32(p2, p3));
+            packed = _mm_or_si128(_mm_andnot_si128(alphaMask, packed), _mm_and_si128(pixels, alphaMask));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), packed);
+        }
+        getScalarKernels()->applyLut(src + i, dst + i, count - i, lut);
+    }
+
+    void applyLutFloat(const float* src, float* dst, size_t count, const LutGrid& lut) {
+        const __m128 alphaMask = _mm_castsi128_ps(_mm_setr_epi32(0, 0, 0, -1));
+        LutLanes lanes;
+
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            const float* in = src + i * 4;
+            __m128 pixels[4] = {_mm_loadu_ps(in), _mm_loadu_ps(in + 4), _mm_loadu_ps(in + 8), _mm_loadu_ps(in + 12)};
+            __m128 r = pixels[0], g = pixels[1], b = pixels[2], a = pixels[3];
+            _MM_TRANSPOSE4_PS(r, g, b, a);
+            findTetrahedra(lut, r, g, b, lanes);
+
+            float* out = dst + i * 4;
+            for (int lane = 0; lane < 4; ++lane) {
+                _mm_storeu_ps(out + lane * 4, select(alphaMask, pixels[lane], blendCorners(lut.entries, lanes, lane)));
+            }
+        }
+        getScalarKernels()->applyLutFloat(src + i * 4, dst + i * 4, count - i, lut);
+    }
+
+    // Bilinear footprints of four positions (see the scalar kernel): the
+    // pixel indices and fractions are worked out four lanes at a time, the
+    // texel offsets per lane
+    struct RemapLanes {
+        alignas(16) int32_t x[4];
+        alignas(16) int32_t y[4];
+        alignas(16) float fx[4];
+        alignas(16) float fy[4];
+    };
+
+    inline __m128 splitPositions(__m128 position, int size, __m128i& index) {
+        const __m128 last = _mm_set1_ps(static_cast<float>(size - 1));
+        const __m128 lastIndex = _mm_set1_ps(static_cast<float>(size > 2 ? size - 2 : 0));
+        __m128 p = _mm_sub_ps(position, _mm_set1_ps(0.5f));
+        p = _mm_min_ps(_mm_max_ps(p, _mm_setzero_ps()), last);
+        index = _mm_cvttps_epi32(_mm_min_ps(p, lastIndex));
+        return _mm_sub_ps(p, _mm_cvtepi32_ps(index));
+    }
+
+    inline void findFootprints(const RemapSource& source, const float* x, const float* y, RemapLanes& lanes) {
+        __m128i ix, iy;
+        _mm_store_ps(lanes.fx, splitPositions(_mm_loadu_ps(x), source.width, ix));
+        _mm_store_ps(lanes.fy, splitPositions(_mm_loadu_ps(y), source.height, iy));
+        _mm_store_si128(reinterpret_cast<__m128i*>(lanes.x), ix);
+        _mm_store_si128(reinterpret_cast<__m128i*>(lanes.y), iy);
+    }
+
+    inline __m128 lerp(__m128 a, __m128 b, __m128 t) {
+        return _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(b, a), t));
+    }
+
+    void remap(const RemapSource& source, const float* x, const float* y, uint32_t* dst, size_t count) {
+        const uint32_t* pixels = static_cast<const uint32_t*>(source.pixels);
+        const __m128i byteMask = _mm_set1_epi32(0xFF);
+        RemapLanes lanes;
+        int32_t texels[4][4];       // [corner][lane]
+
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            findFootprints(source, x + i, y + i, lanes);
+            for (int lane = 0; lane < 4; ++lane) {
+                const size_t offset = static_cast<size_t>(lanes.y[lane]) * source.stride + static_cast<size_t>(lanes.x[lane]);
+                const size_t right = lanes.x[lane] + 1 < source.width ? 1 : 0;
+                const size_t down = lanes.y[lane] + 1 < source.height ? source.stride : 0;
+                texels[0][lane] = static_cast<int32_t>(pixels[offset]);
+                texels[1][lane] = static_cast<int32_t>(pixels[offset + right]);
+                texels[2][lane] = static_cast<int32_t>(pixels[offset + down]);
+                texels[3][lane] = static_cast<int32_t>(pixels[offset + down + right]);
+            }
+            const __m128i c00 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(texels[0]));
+            const __m128i c10 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(texels[1]));
+            const __m128i c01 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(texels[2]));
+            const __m128i c11 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(texels[3]));
+            const __m128 fx = _mm_load_ps(lanes.fx);
+            const __m128 fy = _mm_load_ps(lanes.fy);
+
+            __m128i result = _mm_setzero_si128();
+            for (int shift = 0; shift < 32; shift += 8) {
+                const __m128 top = lerp(_mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(c00, shift), byteMask)),
+                                        _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(c10, shift), byteMask)), fx);
+                const __m128 bottom = lerp(_mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(c01, shift), byteMask)),
+                                           _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(c11, shift), byteMask)), fx);
+                result = _mm_or_si128(result, _mm_slli_epi32(channelToInt(lerp(top, bottom, fy)), shift));
+            }
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), result);
+        }
+        getScalarKernels()->remap(source, x + i, y + i, dst + i, count - i);
+    }
+
+    inline __m128 loadTexel(const RemapSource& source, size_t offset) {
+        if (source.format == PixelFormat::RGBA32F) {
+            return _mm_loadu_ps(static_cast<const float*>(source.pixels) + offset * 4);
+        }
+        const __m128i zero = _mm_setzero_si128();
+        const int pixel = static_cast<int>(static_cast<const uint32_t*>(source.pixels)[offset]);
+        const __m128i channels = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(pixel), zero), zero);
+        return _mm_mul_ps(_mm_cvtepi32_ps(channels), _mm_set1_ps(1.0f / 255.0f));
+    }
+
+    void remapFloat(const RemapSource& source, const float* x, const float* y, float* dst, size_t count) {
+        // Half floats need F16C to convert in registers
+        if (source.format == PixelFormat::RGBA16F) {
+            getScalarKernels()->remapFloat(source, x, y, dst, count);
+            return;
+        }
+        RemapLanes lanes;
+
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            findFootprints(source, x + i, y + i, lanes);
+            for (int lane = 0; lane < 4; ++lane) {
+                const size_t offset = static_cast<size_t>(lanes.y[lane]) * source.stride + static_cast<size_t>(lanes.x[lane]);
+                const size_t right = lanes.x[lane] + 1 < source.width ? 1 : 0;
+                const size_t down = lanes.y[lane] + 1 < source.height ? source.stride : 0;
+                const __m128 fx = _mm_set1_ps(lanes.fx[lane]);
+                const __m128 top = lerp(loadTexel(source, offset), loadTexel(source, offset + right), fx);
+                const __m128 bottom = lerp(loadTexel(source, offset + down), loadTexel(source, offset + down + right), fx);
+                _mm_storeu_ps(dst + (i + static_cast<size_t>(lane)) * 4, lerp(top, bottom, _mm_set1_ps(lanes.fy[lane])));
+            }
+        }
+        getScalarKernels()->remapFloat(source, x + i, y + i, dst + i * 4, count - i);
+    }
+
+    template<size_t... Index>
+    constexpr KernelTable makeTable(std::index_sequence<Index...>) {
+        return {
+            SimdLevel::SSE2,
+            &colorMatrix,
+            &mergeChannels,
+            &reverseCopy,
+            &accumulate,
+            &resolve,
+            &blend,
+            &unpackPixels,
+            &packPixels,
+            &halfToFloat,
+            &floatToHalf,
+            &colorMatrixFloat,
+            &blendFloat,
+            &boxFilterFloat,
+            &applyLut,
+            &applyLutFloat,
+            &remap,
+            &remapFloat,
+            {nullptr, nullptr, &boxFilter<static_cast<int>(Index) + 2>...}
+        };
+    }
+
+    const KernelTable SSE2_KERNELS = makeTable(std::make_index_sequence<MAX_BOX_FILTER_TAPS - 1>());
+}
+
+const KernelTable* getSse2Kernels() {
+    return &SSE2_KERNELS;
+}
+
+#else
+
+const KernelTable* getSse2Kernels() {
+    return nullptr;
+}
+
+#endif
+
+} // namespace effects
+} // namespace gamma
@@ -0,0 +1,406 @@
+#include "effects/Kernels.h"
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+namespace gamma {
+namespace effects {
+
+namespace {
+    inline uint32_t toChannel(float value) {
+        // Clamp, then round half up; the SIMD variants do the same
+        value = value < 0.0f ? 0.0f : (value > 255.0f ? 255.0f : value);
+        return static_cast<uint32_t>(value + 0.5f);
+    }
+
+    void colorMatrix(const uint32_t* src, uint32_t* dst, size_t count, const ColorMatrix& matrix) {
+        const auto& m = matrix.m;
+        for (size_t i = 0; i < count; ++i) {
+            uint32_t pixel = src[i];
+            float r = static_cast<float>(pixel & 0xFF);
+            float g = static_cast<float>((pixel >> 8) & 0xFF);
+            float b = static_cast<float>((pixel >> 16) & 0xFF);
+
+            uint32_t outR = toChannel(m[0][0] * r + m[0][1] * g + m[0][2] * b + m[0][3]);
+            uint32_t outG = toChannel(m[1][0] * r + m[1][1] * g + m[1][2] * b + m[1][3]);
+            uint32_t outB = toChannel(m[2][0] * r + m[2][1] * g + m[2][2] * b + m[2][3]);
+            dst[i] = outR | (outG << 8) | (outB << 16) | (pixel & 0xFF000000u);
+        }
+    }
+
+    void mergeChannels(const uint32_t* red, const uint32_t* green, const uint32_t* blue,
+                       uint32_t* dst, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            dst[i] = (red[i] & 0x000000FFu) | (green[i] & 0xFF00FF00u) | (blue[i] & 0x00FF0000u);
+        }
+    }
+
+    void reverseCopy(const uint32_t* src, uint32_t* dst, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            dst[i] = src[count - 1 - i];
+        }
+    }
+
+    void accumulate(const uint32_t* src, uint16_t* accumulators, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            uint32_t pixel = src[i];
+            uint16_t* acc = accumulators + i * 4;
+            acc[0] = static_cast<uint16_t>(acc[0] + (pixel & 0xFF));
+            acc[1] = static_cast<uint16_t>(acc[1] + ((pixel >> 8) & 0xFF));
+            acc[2] = static_cast<uint16_t>(acc[2] + ((pixel >> 16) & 0xFF));
+            acc[3] = static_cast<uint16_t>(acc[3] + (pixel >> 24));
+        }
+    }
+
+    void resolve(const uint16_t* accumulators, uint32_t* dst, size_t count, uint32_t scale) {
+        for (size_t i = 0; i < count; ++i) {
+            const uint16_t* acc = accumulators + i * 4;
+            dst[i] = ((acc[0] * scale) >> 16)
+                   | (((acc[1] * scale) >> 16) << 8)
+                   | (((acc[2] * scale) >> 16) << 16)
+                   | (((acc[3] * scale) >> 16) << 24);
+        }
+    }
+
+    void blend(const uint32_t* a, const uint32_t* b, uint32_t* dst, size_t count, uint32_t weight) {
+        const uint32_t inverse = 256 - weight;
+        for (size_t i = 0; i < count; ++i) {
+            uint32_t pa = a[i];
+            uint32_t pb = b[i];
+            uint32_t result = 0;
+            for (int shift = 0; shift < 32; shift += 8) {
+                uint32_t ca = (pa >> shift) & 0xFF;
+                uint32_t cb = (pb >> shift) & 0xFF;
+                result |= ((ca * inverse + cb * weight) >> 8) << shift;
+            }
+            dst[i] = result;
+        }
+    }
+
+    template<int Taps>
+    void boxFilter(const uint32_t* const* sources, uint32_t* dst, size_t count, uint32_t scale) {
+        for (size_t i = 0; i < count; ++i) {
+            // Red/blue and green/alpha summed in 16-bit lanes of two words
+            uint32_t redBlue = 0;
+            uint32_t greenAlpha = 0;
+            for (int t = 0; t < Taps; ++t) {
+                uint32_t pixel = sources[t][i];
+                redBlue += pixel & 0x00FF00FFu;
+                greenAlpha += (pixel >> 8) & 0x00FF00FFu;
+            }
+            dst[i] = (((redBlue & 0xFFFF) * scale) >> 16)
+                   | ((((greenAlpha & 0xFFFF) * scale) >> 16) << 8)
+                   | ((((redBlue >> 16) * scale) >> 16) << 16)
+                   | ((((greenAlpha >> 16) * scale) >> 16) << 24);
+        }
+    }
+
+    const float CHANNEL_SCALE = 1.0f / 255.0f;
+
+    void unpackPixels(const uint32_t* src, float* dst, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            uint32_t pixel = src[i];
+            for (int c = 0; c < 4; ++c) {
+                dst[i * 4 + c] = static_cast<float>((pixel >> (c * 8)) & 0xFF) * CHANNEL_SCALE;
+            }
+        }
+    }
+
+    void packPixels(const float* src, uint32_t* dst, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            const float* pixel = src + i * 4;
+            dst[i] = toChannel(pixel[0] * 255.0f)
+                   | (toChannel(pixel[1] * 255.0f) << 8)
+                   | (toChannel(pixel[2] * 255.0f) << 16)
+                   | (toChannel(pixel[3] * 255.0f) << 24);
+        }
+    }
+
+    // IEEE binary16 conversions matching F16C (round to nearest even)
+    float halfBitsToFloat(uint16_t half) {
+        const uint32_t sign = static_cast<uint32_t>(half & 0x8000) << 16;
+        const uint32_t exponent = (half >> 10) & 0x1F;
+        const uint32_t mantissa = half & 0x3FF;
+        uint32_t bits;
+        if (exponent == 0) {
+            // Zero or subnormal: mantissa * 2^-24, exact in a float
+            float value = static_cast<float>(mantissa) * (1.0f / 16777216.0f);
+            std::memcpy(&bits, &value, sizeof(bits));
+            bits |= sign;
+        } else if (exponent == 0x1F) {
+            bits = sign | 0x7F800000u | (mantissa << 13);
+        } else {
+            bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+        }
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    uint16_t floatToHalfBits(float value) {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        const uint32_t sign = (bits >> 16) & 0x8000;
+        bits &= 0x7FFFFFFFu;
+
+        uint32_t half;
+        if (bits >= 0x47800000u) {
+            // Beyond the half range: infinity, or a quiet NaN
+            half = bits > 0x7F800000u ? 0x7E00u : 0x7C00u;
+        } else if (bits < 0x38800000u) {
+            // Subnormal or zero: adding 0.5 lines the mantissa up with the
+            // half's lowest bit and lets the float adder do the rounding
+            float magnitude;
+            std::memcpy(&magnitude, &bits, sizeof(magnitude));
+            magnitude += 0.5f;
+            std::memcpy(&bits, &magnitude, sizeof(bits));
+            half = bits - 0x3F000000u;
+        } else {
+            const uint32_t odd = (bits >> 13) & 1;
+            bits += (static_cast<uint32_t>(15 - 127) << 23) + 0xFFF + odd;
+            half = bits >> 13;
+        }
+        return static_cast<uint16_t>(half | sign);
+    }
+
+    void halfToFloat(const uint16_t* src, float* dst, size_t count) {
+        for (size_t i = 0; i < count * 4; ++i) {
+            dst[i] = halfBitsToFloat(src[i]);
+        }
+    }
+
+    void floatToHalf(const float* src, uint16_t* dst, size_t count) {
+        for (size_t i = 0; i < count * 4; ++i) {
+            dst[i] = floatToHalfBits(src[i]);
+        }
+    }
+
+    void colorMatrixFloat(const float* src, float* dst, size_t count, const ColorMatrix& matrix) {
+        const auto& m = matrix.m;
+        const float offsetR = m[0][3] * CHANNEL_SCALE;
+        const float offsetG = m[1][3] * CHANNEL_SCALE;
+        const float offsetB = m[2][3] * CHANNEL_SCALE;
+        for (size_t i = 0; i < count; ++i) {
+            const float* pixel = src + i * 4;
+            float r = pixel[0];
+            float g = pixel[1];
+            float b = pixel[2];
+            float a = pixel[3];
+            dst[i * 4 + 0] = m[0][0] * r + m[0][1] * g + m[0][2] * b + offsetR;
+            dst[i * 4 + 1] = m[1][0] * r + m[1][1] * g + m[1][2] * b + offsetG;
+            dst[i * 4 + 2] = m[2][0] * r + m[2][1] * g + m[2][2] * b + offsetB;
+            dst[i * 4 + 3] = a;
+        }
+    }
+
+    void blendFloat(const float* a, const float* b, float* dst, size_t count, float weight) {
+        for (size_t i = 0; i < count * 4; ++i) {
+            dst[i] = a[i] + (b[i] - a[i]) * weight;
+        }
+    }
+
+    void boxFilterFloat(const float* const* sources, int taps, float* dst, size_t count, float scale) {
+        for (size_t i = 0; i < count * 4; ++i) {
+            float sum = 0.0f;
+            for (int t = 0; t < taps; ++t) {
+                sum += sources[t][i];
+            }
+            dst[i] = sum * scale;
+        }
+    }
+
+    // Grid coordinate of one channel, clamped to the grid and split into the
+    // lattice index below it (at most size - 2, so the cell is whole) and the fraction
+    inline int splitCoordinate(float coordinate, int last, float& fraction) {
+        coordinate = coordinate < 0.0f ? 0.0f : (coordinate > static_cast<float>(last) ? static_cast<float>(last) : coordinate);
+        int index = std::min(static_cast<int>(coordinate), last - 1);
+        fraction = coordinate - static_cast<float>(index);
+        return index;
+    }
+
+    // Tetrahedral interpolation: the cell is cut along its black-white diagonal
+    // into six tetrahedra, and the order of the fractions picks the one holding
+    // the point. Its corners are the cell's first and last entries, the first
+    // plus a step along the axis of the largest fraction, and the last minus a
+    // step along the axis of the smallest; the weights are the gaps between
+    // the sorted fractions. The SIMD variants pick the axes with the same ties
+    inline void sampleLut(const LutGrid& lut, float r, float g, float b, float* out) {
+        const int last = lut.size - 1;
+        float fr, fg, fb;
+        const int ir = splitCoordinate(r * lut.scale[0] + lut.offset[0], last, fr);
+        const int ig = splitCoordinate(g * lut.scale[1] + lut.offset[1], last, fg);
+        const int ib = splitCoordinate(b * lut.scale[2] + lut.offset[2], last, fb);
+
+        const size_t strideG = static_cast<size_t>(lut.size);
+        const size_t strideB = strideG * strideG;
+        const size_t diagonal = 1 + strideG + strideB;
+        const size_t maxStep = (fr >= fg && fr >= fb) ? 1 : (fg >= fb ? strideG : strideB);
+        const size_t minStep = (fb <= fg && fb <= fr) ? strideB : (fg <= fr ? strideG : 1);
+        const float maxFraction = std::max(fr, std::max(fg, fb));
+        const float minFraction = std::min(fr, std::min(fg, fb));
+        const float midFraction = fr + fg + fb - maxFraction - minFraction;
+
+        const float* c0 = lut.entries + (static_cast<size_t>(ir) + static_cast<size_t>(ig) * strideG +
+                                         static_cast<size_t>(ib) * strideB) * 4;
+        const float* c1 = c0 + maxStep * 4;
+        const float* c2 = c0 + (diagonal - minStep) * 4;
+        const float* c3 = c0 + diagonal * 4;
+        const float w0 = 1.0f - maxFraction;
+        const float w1 = maxFraction - midFraction;
+        const float w2 = midFraction - minFraction;
+        const float w3 = minFraction;
+        for (int c = 0; c < 3; ++c) {
+            out[c] = c0[c] * w0 + c1[c] * w1 + c2[c] * w2 + c3[c] * w3;
+        }
+    }
+
+    void applyLut(const uint32_t* src, uint32_t* dst, size_t count, const LutGrid& lut) {
+        const float unit = 1.0f / 255.0f;
+        float out[3];
+        for (size_t i = 0; i < count; ++i) {
+            const uint32_t pixel = src[i];
+            sampleLut(lut, static_cast<float>(pixel & 0xFF) * unit, static_cast<float>((pixel >> 8) & 0xFF) * unit,
+                      static_cast<float>((pixel >> 16) & 0xFF) * unit, out);
+            dst[i] = toChannel(out[0] * 255.0f) | (toChannel(out[1] * 255.0f) << 8) |
+                     (toChannel(out[2] * 255.0f) << 16) | (pixel & 0xFF000000u);
+        }
+    }
+
+    void applyLutFloat(const float* src, float* dst, size_t count, const LutGrid& lut) {
+        for (size_t i = 0; i < count; ++i) {
+            const float* pixel = src + i * 4;
+            const float alpha = pixel[3];
+            sampleLut(lut, pixel[0], pixel[1], pixel[2], dst + i * 4);
+            dst[i * 4 + 3] = alpha;
+        }
+    }
+
+    // Position along one axis to the pixel left of (or above) it and the
+    // fraction towards the next; pixel centers are at +0.5 and positions
+    // clamp to the frame (NaN to the first pixel, as the SIMD min/max do),
+    // so the last pixel extends with a fraction of 1
+    inline int splitPosition(float position, int size, float& fraction) {
+        const float last = static_cast<float>(size - 1);
+        float p = position - 0.5f;
+        p = p > 0.0f ? (p < last ? p : last) : 0.0f;
+        const int index = static_cast<int>(std::min(p, static_cast<float>(std::max(size - 2, 0))));
+        fraction = p - static_cast<float>(index);
+        return index;
+    }
+
+    // Bilinear footprint: top-left texel and the steps to its neighbours (0 at the edges)
+    struct Footprint {
+        size_t offset;
+        size_t right;
+        size_t down;
+        float fx;
+        float fy;
+    };
+
+    inline Footprint findFootprint(const RemapSource& source, float x, float y) {
+        Footprint footprint;
+        const int ix = splitPosition(x, source.width, footprint.fx);
+        const int iy = splitPosition(y, source.height, footprint.fy);
+        footprint.offset = static_cast<size_t>(iy) * source.stride + static_cast<size_t>(ix);
+        footprint.right = ix + 1 < source.width ? 1 : 0;
+        footprint.down = iy + 1 < source.height ? source.stride : 0;
+        return footprint;
+    }
+
+    inline float bilinear(float c00, float c10, float c01, float c11, float fx, float fy) {
+        const float top = c00 + (c10 - c00) * fx;
+        const float bottom = c01 + (c11 - c01) * fx;
+        return top + (bottom - top) * fy;
+    }
+
+    void remap(const RemapSource& source, const float* x, const float* y, uint32_t* dst, size_t count) {
+        const uint32_t* pixels = static_cast<const uint32_t*>(source.pixels);
+        for (size_t i = 0; i < count; ++i) {
+            const Footprint f = findFootprint(source, x[i], y[i]);
+            const uint32_t* texel = pixels + f.offset;
+            const uint32_t c00 = texel[0];
+            const uint32_t c10 = texel[f.right];
+            const uint32_t c01 = texel[f.down];
+            const uint32_t c11 = texel[f.down + f.right];
+            uint32_t result = 0;
+            for (int shift = 0; shift < 32; shift += 8) {
+                result |= toChannel(bilinear(static_cast<float>((c00 >> shift) & 0xFF),
+                                             static_cast<float>((c10 >> shift) & 0xFF),
+                                             static_cast<float>((c01 >> shift) & 0xFF),
+                                             static_cast<float>((c11 >> shift) & 0xFF), f.fx, f.fy)) << shift;
+            }
+            dst[i] = result;
+        }
+    }
+
+    // One texel as four floats, whatever the source format
+    inline void loadTexel(const RemapSource& source, size_t offset, float* texel) {
+        switch (source.format) {
+            case PixelFormat::RGBA32F:
+                std::memcpy(texel, static_cast<const float*>(source.pixels) + offset * 4, 4 * sizeof(float));
+                break;
+            case PixelFormat::RGBA16F: {
+                const uint16_t* half = static_cast<const uint16_t*>(source.pixels) + offset * 4;
+                for (int c = 0; c < 4; ++c) {
+                    texel[c] = halfBitsToFloat(half[c]);
+                }
+                break;
+            }
+            default: {
+                const uint32_t pixel = static_cast<const uint32_t*>(source.pixels)[offset];
+                for (int c = 0; c < 4; ++c) {
+                    texel[c] = static_cast<float>((pixel >> (c * 8)) & 0xFF) * CHANNEL_SCALE;
+                }
+                break;
+            }
+        }
+    }
+
+    void remapFloat(const RemapSource& source, const float* x, const float* y, float* dst, size_t count) {
+        float c00[4], c10[4], c01[4], c11[4];
+        for (size_t i = 0; i < count; ++i) {
+            const Footprint f = findFootprint(source, x[i], y[i]);
+            loadTexel(source, f.offset, c00);
+            loadTexel(source, f.offset + f.right, c10);
+            loadTexel(source, f.offset + f.down, c01);
+            loadTexel(source, f.offset + f.down + f.right, c11);
+            for (int c = 0; c < 4; ++c) {
+                dst[i * 4 + c] = bilinear(c00[c], c10[c], c01[c], c11[c], f.fx, f.fy);
+            }
+        }
+    }
+
+    template<size_t... Index>
+    constexpr KernelTable makeTable(std::index_sequence<Index...>) {
+        return {
+            SimdLevel::Scalar,
+            &colorMatrix,
+            &mergeChannels,
+            &reverseCopy,
+            &accumulate,
+            &resolve,
+            &blend,
+            &unpackPixels,
+            &packPixels,
+            &halfToFloat,
+            &floatToHalf,
+            &colorMatrixFloat,
+            &blendFloat,
+            &boxFilterFloat,
+            &applyLut,
+            &applyLutFloat,
+            &remap,
+            &remapFloat,
+            {nullptr, nullptr, &boxFilter<static_cast<int>(Index) + 2>...}
+        };
+    }
+
+    const KernelTable SCALAR_KERNELS = makeTable(std::make_index_sequence<MAX_BOX_FILTER_TAPS - 1>());
+}
+
+const KernelTable* getScalarKernels() {
+    return &SCALAR_KERNELS;
+}
+
+} // namespace effects
+} // namespace gamma
@@ -0,0 +1,144 @@
+#include "effects/Effects.h"
+#include "effects/PixelRows.h"
+#include <algorithm>
+#include <cstring>
+
+namespace gamma {
+namespace effects {
+
+namespace {
+    enum MirrorMode {
+        MIRROR_NONE = 0,
+        MIRROR_HORIZONTAL = 1,
+        MIRROR_VERTICAL = 2,
+        MIRROR_BOTH = 3
+    };
+
+    // Right of the axis shows the left side reflected; columns without a
+    // reflected source (axis left of center) repeat the first column
+    void mirrorRow(const KernelTable& kernels, const uint32_t* src, uint32_t* dst, int width, int axis) {
+        std::memcpy(dst, src, static_cast<size_t>(axis) * sizeof(uint32_t));
+
+        int reflected = std::min(axis, width - axis);
+        kernels.reverseCopy(src + axis - reflected, dst + axis, static_cast<size_t>(reflected));
+        std::fill(dst + axis + reflected, dst + width, src[0]);
+    }
+
+    void mirrorRowFloat(const float* src, float* dst, int width, int axis) {
+        std::memcpy(dst, src, static_cast<size_t>(axis) * 4 * sizeof(float));
+
+        int reflected = std::min(axis, width - axis);
+        for (int i = 0; i < reflected; ++i) {
+            std::memcpy(dst + static_cast<size_t>(axis + i) * 4, src + static_cast<size_t>(axis - 1 - i) * 4,
+                        4 * sizeof(float));
+        }
+        for (int x = axis + reflected; x < width; ++x) {
+            std::memcpy(dst + static_cast<size_t>(x) * 4, src, 4 * sizeof(float));
+        }
+    }
+}
+
+void MirrorEffect::prepare(const Frame& input, const float* parameters, const EffectContext& /*context*/) {
+    int mode = std::max(0, std::min(3, static_cast<int>(parameters[0] + 0.5f)));
+    const int width = input.getWidth();
+    const int height = input.getHeight();
+
+    _horizontal = (mode == MIRROR_HORIZONTAL || mode == MIRROR_BOTH);
+    _vertical = (mode == MIRROR_VERTICAL || mode == MIRROR_BOTH);
+
+    // Axes are at least one pixel in, so there is always something to reflect
+    _axisX = std::max(1, std::min(width, static_cast<int>(parameters[1] * width + 0.5f)));
+    _axisY = std::max(1, std::min(height, static_cast<int>(parameters[2] * height + 0.5f)));
+    _kernels = &getKernels();
+
+    static const RowsFunction MODE_FUNCTIONS[4] = {
+        &MirrorEffect::mirrorRows<false, false>,
+        &MirrorEffect::mirrorRows<true, false>,
+        &MirrorEffect::mirrorRows<false, true>,
+        &MirrorEffect::mirrorRows<true, true>
+    };
+    _rowsFunction = isKernelSpecializationEnabled() ? MODE_FUNCTIONS[mode] : nullptr;
+}
+
+int MirrorEffect::getInputHalo(int height) const {
+    // Reflected rows can come from anywhere above the axis
+    return _vertical ? height : 0;
+}
+
+template<bool Horizontal, bool Vertical>
+void MirrorEffect::mirrorRows(const Frame& input, Frame& output, int yBegin, int yEnd) const {
+    const int width = input.getWidth();
+    const size_t rowBytes = static_cast<size_t>(width) * sizeof(uint32_t);
+
+    // Rows above the vertical axis, then the reflected ones; no per-row mode checks
+    int directEnd = Vertical ? std::min(yEnd, _axisY) : yEnd;
+    for (int y = yBegin; y < directEnd; ++y) {
+        if (Horizontal) {
+            mirrorRow(*_kernels, input.row(y), output.row(y), width, _axisX);
+        } else {
+            std::memcpy(output.row(y), input.row(y), rowBytes);
+        }
+    }
+    if (Vertical) {
+        for (int y = std::max(yBegin, _axisY); y < yEnd; ++y) {
+            const uint32_t* src = input.row(std::max(0, 2 * _axisY - 1 - y));
+            if (Horizontal) {
+                mirrorRow(*_kernels, src, output.row(y), width, _axisX);
+            } else {
+                std::memcpy(output.row(y), src, rowBytes);
+            }
+        }
+    }
+}
+
+void MirrorEffect::mirrorRowsFloat(const Frame& input, Frame& output, int yBegin, int yEnd) const {
+    const int width = input.getWidth();
+    const size_t count = static_cast<size_t>(width);
+    float* source = getRowBuffer(0, count);
+    float* result = getRowBuffer(1, count);
+
+    for (int y = yBegin; y < yEnd; ++y) {
+        int sourceY = y;
+        if (_vertical && y >= _axisY) {
+            sourceY = std::max(0, 2 * _axisY - 1 - y);
+        }
+
+        if (_horizontal) {
+            float* dst = getStoreTarget(output, 0, y, result);
+            mirrorRowFloat(loadPixels(input, 0, sourceY, count, source), dst, width, _axisX);
+            writePixels(dst, output, 0, y, count);
+        } else {
+            copyRow(input, sourceY, output, y);
+        }
+    }
+}
+
+void MirrorEffect::processRows(const Frame& input, Frame& output, int yBegin, int yEnd) {
+    if (usesFloatPixels()) {
+        mirrorRowsFloat(input, output, yBegin, yEnd);
+        return;
+    }
+    if (_rowsFunction) {
+        (this->*_rowsFunction)(input, output, yBegin, yEnd);
+        return;
+    }
+
+    const int width = input.getWidth();
+    const size_t rowBytes = static_cast<size_t>(width) * sizeof(uint32_t);
+
+    for (int y = yBegin; y < yEnd; ++y) {
+        int sourceY = y;
+        if (_vertical && y >= _axisY) {
+            sourceY = std::max(0, 2 * _axisY - 1 - y);
+        }
+
+        if (_horizontal) {
+            mirrorRow(*_kernels, input.row(sourceY), output.row(y), width, _axisX);
+        } else {
+            std::memcpy(output.row(y), input.row(sourceY), rowBytes);
+        }
+    }
+}
+
+} // namespace effects
+} // namespace gamma
@@ -0,0 +1,253 @@
+#include "effects/Effects.h"
+#include "effects/PixelRows.h"
+#include "core/Math.h"
+#include <algorithm>
+#include <cstdlib>
+
+namespace gamma {
+namespace effects {
+
+namespace {
+    const float PI = 3.14159265358979f;
+    const float MAX_LENGTH_FRACTION = 0.05f;    // Blur length at Amount = 1, relative to width
+
+    // Add src[clamp(x + dx)] for every x in [0, width); the in-range middle
+    // goes through the kernel, the clamped ends repeat the edge pixel
+    void accumulateShifted(const KernelTable& kernels, const uint32_t* src, uint16_t* acc, int width, int dx) {
+        int begin = std::max(0, -dx);
+        int end = std::min(width, width - dx);
+        if (begin >= end) {
+            // Shift larger than the row: everything reads one edge pixel
+            begin = end = (dx > 0) ? 0 : width;
+        } else {
+            kernels.accumulate(src + begin + dx, acc + static_cast<size_t>(begin) * 4, static_cast<size_t>(end - begin));
+        }
+
+        for (int x = 0; x < begin; ++x) {
+            kernels.accumulate(src, acc + static_cast<size_t>(x) * 4, 1);
+        }
+        for (int x = end; x < width; ++x) {
+            kernels.accumulate(src + width - 1, acc + static_cast<size_t>(x) * 4, 1);
+        }
+    }
+}
+
+void MotionBlurEffect::prepare(const Frame& input, const float* parameters, const EffectContext& /*context*/) {
+    float amount = std::max(0.0f, std::min(1.0f, parameters[0]));
+    float angle = parameters[1] * PI / 180.0f;
+    _samples = std::max(1, std::min(MAX_SAMPLES, static_cast<int>(parameters[2] + 0.5f)));
+
+    float length = amount * MAX_LENGTH_FRACTION * static_cast<float>(input.getWidth());
+    _passThrough = (_samples < 2 || length < 1.0f);
+    _kernels = &getKernels();
+    if (_passThrough) {
+        return;
+    }
+
+    // Sample positions centered on the pixel, rounded to whole pixels
+    float directionX = core::cos(angle);
+    float directionY = core::sin(angle);
+    for (int s = 0; s < _samples; ++s) {
+        float t = (static_cast<float>(s) / static_cast<float>(_samples - 1) - 0.5f) * length;
+        _offsets[s].dx = static_cast<int>(core::lround(directionX * t));
+        _offsets[s].dy = static_cast<int>(core::lround(directionY * t));
+    }
+
+    // Rounded up so a full sum of 255s resolves to exactly 255
+    _scale = (65536u + static_cast<uint32_t>(_samples) - 1) / static_cast<uint32_t>(_samples);
+
+    int minDx = 0;
+    int maxDx = 0;
+    for (int s = 0; s < _samples; ++s) {
+        minDx = std::min(minDx, _offsets[s].dx);
+        maxDx = std::max(maxDx, _offsets[s].dx);
+    }
+    _interiorBegin = -minDx;
+    _interiorEnd = input.getWidth() - maxDx;
+
+    _boxFilter = nullptr;
+    if (isKernelSpecializationEnabled() && _interiorBegin < _interiorEnd) {
+        _boxFilter = _kernels->boxFilter[_samples];
+    }
+}
+
+int MotionBlurEffect::getInputHalo(int /*height*/) const {
+    if (_passThrough) {
+        return 0;
+    }
+    int halo = 0;
+    for (int s = 0; s < _samples; ++s) {
+        halo = std::max(halo, std::abs(_offsets[s].dy));
+    }
+    return halo;
+}
+
+void MotionBlurEffect::processRows(const Frame& input, Frame& output, int yBegin, int yEnd) {
+    if (_passThrough) {
+        for (int y = yBegin; y < yEnd; ++y) {
+            copyRow(input, y, output, y);
+        }
+    } else if (usesFloatPixels()) {
+        filterRowsFloat(input, output, yBegin, yEnd);
+    } else if (_boxFilter) {
+        filterRows(input, output, yBegin, yEnd);
+    } else {
+        accumulateRows(input, output, yBegin, yEnd);
+    }
+}
+
+void MotionBlurEffect::filterRows(const Frame& input, Frame& output, int yBegin, int yEnd) const {
+    const int width = input.getWidth();
+    const int height = input.getHeight();
+    const uint32_t* rows[MAX_SAMPLES];
+    const uint32_t* sources[MAX_SAMPLES];
+
+    for (int y = yBegin; y < yEnd; ++y) {
+        uint32_t* dst = output.row(y);
+        for (int s = 0; s < _samples; ++s) {
+            rows[s] = input.row(std::max(0, std::min(height - 1, y + _offsets[s].dy)));
+            sources[s] = rows[s] + _interiorBegin + _offsets[s].dx;
+        }
+
+        // Edge columns clamp their reads; same arithmetic as the kernels
+        auto filterClamped = [&](int x) {
+            uint32_t sums[4] = {0, 0, 0, 0};
+            for (int s = 0; s < _samples; ++s) {
+                uint32_t pixel = rows[s][std::max(0, std::min(width - 1, x + _offsets[s].dx))];
+                for (int c = 0; c < 4; ++c) {
+                    sums[c] += (pixel >> (c * 8)) & 0xFF;
+                }
+            }
+            uint32_t result = 0;
+            for (int c = 0; c < 4; ++c) {
+                result |= ((sums[c] * _scale) >> 16) << (c * 8);
+            }
+            dst[x] = result;
+        };
+
+        for (int x = 0; x < _interiorBegin; ++x) {
+            filterClamped(x);
+        }
+        _boxFilter(sources, dst + _interiorBegin, static_cast<size_t>(_interiorEnd - _interiorBegin), _scale);
+        for (int x = _interiorEnd; x < width; ++x) {
+            filterClamped(x);
+        }
+    }
+}
+
+void MotionBlurEffect::accumulateRows(const Frame& input, Frame& output, int yBegin, int yEnd) const {
+    const int width = input.getWidth();
+    const int height = input.getHeight();
+
+    // One accumulator row per thread, reused across frames and instances
+    thread_local std::vector<uint16_t> accumulators;
+    accumulators.resize(static_cast<size_t>(width) * 4);
+
+    for (int y = yBegin; y < yEnd; ++y) {
+        std::fill(accumulators.begin(), accumulators.end(), static_cast<uint16_t>(0));
+        for (int s = 0; s < _samples; ++s) {
+            int sourceY = std::max(0, std::min(height - 1, y + _offsets[s].dy));
+            accumulateShifted(*_kernels, input.row(sourceY), accumulators.data(), width, _offsets[s].dx);
+        }
+        _kernels->resolve(accumulators.data(), output.row(y), static_cast<size_t>(width), _scale);
+    }
+}
+
+void MotionBlurEffect::filterRowsFloat(const Frame& input, Frame& output, int yBegin, int yEnd) const {
+    const int width = input.getWidth();
+    const int height = input.getHeight();
+    const size_t count = static_cast<size_t>(width);
+    float* result = getRowBuffer(1, count);
+
+    // RGBA8 input (a source, in the first pass): exact integer sums, scaled
+    // to float once per row instead of converting every sample
+    if (input.getFormat() == PixelFormat::RGBA8) {
+        thread_local std::vector<uint16_t> accumulators;
+        accumulators.resize(count * 4);
+        const float scale = 1.0f / (255.0f * static_cast<float>(_samples));
+
+        for (int y = yBegin; y < yEnd; ++y) {
+            std::fill(accumulators.begin(), accumulators.end(), static_cast<uint16_t>(0));
+            for (int s = 0; s < _samples; ++s) {
+                int sourceY = std::max(0, std::min(height - 1, y + _offsets[s].dy));
+                accumulateShifted(*_kernels, input.row(sourceY), accumulators.data(), width, _offsets[s].dx);
+            }
+            float* dst = getStoreTarget(output, 0, y, result);
+            for (size_t i = 0; i < count * 4; ++i) {
+                dst[i] = static_cast<float>(accumulators[i]) * scale;
+            }
+            writePixels(dst, output, 0, y, count);
+        }
+        return;
+    }
+
+    // RGBA16F input: each source row is converted once per band into a ring
+    // covering the rows the samples span, instead of once per sample
+    int minDy = 0;
+    int maxDy = 0;
+    for (int s = 0; s < _samples; ++s) {
+        minDy = std::min(minDy, _offsets[s].dy);
+        maxDy = std::max(maxDy, _offsets[s].dy);
+    }
+    const bool direct = input.getFormat() == PixelFormat::RGBA32F;
+    const size_t ringRows = direct ? 0 : static_cast<size_t>(maxDy - minDy + 1);
+    thread_local std::vector<float> ring;
+    thread_local std::vector<int> ringTags;
+    ring.resize(ringRows * count * 4);
+    ringTags.assign(ringRows, -1);
+
+    auto sourceRow = [&](int sourceY) -> const float* {
+        if (direct) {
+            return input.rowFloat(sourceY);
+        }
+        const size_t slot = static_cast<size_t>(sourceY) % ringRows;
+        float* row = ring.data() + slot * count * 4;
+        if (ringTags[slot] != sourceY) {
+            readPixels(input, 0, sourceY, count, row);
+            ringTags[slot] = sourceY;
+        }
+        return row;
+    };
+
+    const float scale = 1.0f / static_cast<float>(_samples);
+    const float* rows[MAX_SAMPLES];
+    const float* sources[MAX_SAMPLES];
+
+    for (int y = yBegin; y < yEnd; ++y) {
+        for (int s = 0; s < _samples; ++s) {
+            rows[s] = sourceRow(std::max(0, std::min(height - 1, y + _offsets[s].dy)));
+        }
+        float* dst = getStoreTarget(output, 0, y, result);
+
+        auto filterClamped = [&](int x) {
+            float sums[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+            for (int s = 0; s < _samples; ++s) {
+                const float* pixel = rows[s] + static_cast<size_t>(std::max(0, std::min(width - 1, x + _offsets[s].dx))) * 4;
+                for (int c = 0; c < 4; ++c) {
+                    sums[c] += pixel[c];
+                }
+            }
+            for (int c = 0; c < 4; ++c) {
+                dst[static_cast<size_t>(x) * 4 + c] = sums[c] * scale;
+            }
+        };
+
+        for (int x = 0; x < std::min(_interiorBegin, width); ++x) {
+            filterClamped(x);
+        }
+        if (_interiorBegin < _interiorEnd) {
+            for (int s = 0; s < _samples; ++s) {
+                sources[s] = rows[s] + static_cast<size_t>(_interiorBegin + _offsets[s].dx) * 4;
+            }
+            _kernels->boxFilterFloat(sources, _samples, dst + static_cast<size_t>(_interiorBegin) * 4,
+                                     static_cast<size_t>(_interiorEnd - _interiorBegin), scale);
+        }
+        for (int x = std::max(_interiorBegin, _interiorEnd); x < width; ++x) {
+            filterClamped(x);
+        }
+        writePixels(dst, output, 0, y, count);
+    }
+}
+
+} // namespace effects
+} // namespace gamma
@@ -0,0 +1,30 @@
+#include "effects/ParameterBlock.h"
+
+namespace gamma {
+namespace effects {
+
+ParameterBlock::ParameterBlock()
+    : _back(0)
+    , _front(1)
+    , _spare(2)
+    , _sequence(0) {
+}
+
+void ParameterBlock::publish() {
+    _buffers[_back].sequence = ++_sequence;
+
+    // Release: the snapshot's contents become visible with the index
+    uint8_t previous = _spare.exchange(static_cast<uint8_t>(_back | FRESH), std::memory_order_acq_rel);
+    _back = previous & INDEX_MASK;
+}
+
+const ChainParameters& ParameterBlock::acquire() {
+    if (_spare.load(std::memory_order_relaxed) & FRESH) {
+        uint8_t previous = _spare.exchange(_front, std::memory_order_acq_rel);
+        _front = previous & INDEX_MASK;
+    }
+    return _buffers[_front];
+}
+
+} // namespace effects
+} // namespace gamma
@@ -0,0 +1,81 @@
+#include "effects/PixelRows.h"
+#include "effects/Kernels.h"
+#include <cstring>
+#include <vector>
+
+namespace gamma {
+namespace effects {
+
+float* getRowBuffer(int index, size_t count) {
+    thread_local std::vector<float> buffers[ROW_BUFFER_COUNT];
+    std::vector<float>& buffer = buffers[index];
+    if (buffer.size() < count * 4) {
+        buffer.resize(count * 4);
+    }
+    return buffer.data();
+}
+
+void readPixels(const Frame& frame, int x, int y, size_t count, float* dst) {
+    switch (frame.getFormat()) {
+        case PixelFormat::RGBA32F:
+            std::memcpy(dst, frame.rowFloat(y) + static_cast<size_t>(x) * 4, count * 4 * sizeof(float));
+            break;
+        case PixelFormat::RGBA16F:
+            getKernels().halfToFloat(frame.rowHalf(y) + static_cast<size_t>(x) * 4, dst, count);
+            break;
+        default:
+            getKernels().unpackPixels(frame.row(y) + x, dst, count);
+            break;
+    }
+}
+
+const float* loadPixels(const Frame& frame, int x, int y, size_t count, float* scratch) {
+    if (frame.getFormat() == PixelFormat::RGBA32F) {
+        return frame.rowFloat(y) + static_cast<size_t>(x) * 4;
+    }
+    readPixels(frame, x, y, count, scratch);
+    return scratch;
+}
+
+float* getStoreTarget(Frame& frame, int x, int y, float* scratch) {
+    if (frame.getFormat() == PixelFormat::RGBA32F) {
+        return frame.rowFloat(y) + static_cast<size_t>(x) * 4;
+    }
+    return scratch;
+}
+
+void writePixels(const float* src, Frame& frame, int x, int y, size_t count) {
+    switch (frame.getFormat()) {
+        case PixelFormat::RGBA32F: {
+            float* dst = frame.rowFloat(y) + static_cast<size_t>(x) * 4;
+            if (dst != src) {
+                std::memcpy(dst, src, count * 4 * sizeof(float));
+            }
+            break;
+        }
+        case PixelFormat::RGBA16F:
+            getKernels().floatToHalf(src, frame.rowHalf(y) + static_cast<size_t>(x) * 4, count);
+            break;
+        default:
+            getKernels().packPixels(src, frame.row(y) + x, count);
+            break;
+    }
+}
+
+void copyRow(const Frame& source, int sourceY, Frame& destination, int y) {
+    const size_t count = static_cast<size_t>(source.getWidth());
+    if (source.getFormat() == destination.getFormat()) {
+        std::memcpy(destination.rowData(y), source.rowData(sourceY), count * source.getPixelBytes());
+        return;
+    }
+    if (source.getFormat() == PixelFormat::RGBA32F) {
+        writePixels(source.rowFloat(sourceY), destination, 0, y, count);
+        return;
+    }
+    float* pixels = getStoreTarget(destination, 0, y, getRowBuffer(0, count));
+    readPixels(source, 0, sourceY, count, pixels);
+    writePixels(pixels, destination, 0, y, count);
+}
+
+} // namespace effects
+} // namespace gamma
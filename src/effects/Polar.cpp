@@ -0,0 +1,56 @@
+#include "effects/Effects.h"
+#include "core/Math.h"
+#include <algorithm>
+
+namespace gamma {
+namespace effects {
+
+namespace {
+    const float PI = 3.14159265358979f;
+
+    enum PolarMode {
+        POLAR_NONE = 0,
+        POLAR_TO_POLAR = 1,
+        POLAR_TO_RECTANGULAR = 2
+    };
+}
+
+uint64_t PolarEffect::prepareMap(int width, int height, const float* parameters) {
+    _mode = std::max(0, std::min(2, static_cast<int>(parameters[0] + 0.5f)));
+    if (_mode == POLAR_NONE) {
+        return 0;
+    }
+    const float zoom = std::max(0.25f, std::min(4.0f, parameters[2]));
+    _width = static_cast<float>(width);
+    _height = static_cast<float>(height);
+    _rotation = parameters[1] * PI / 180.0f;
+    _radius = 0.5f * core::sqrt(_width * _width + _height * _height) / zoom;
+    return hashMap("Polar", width, height, {static_cast<float>(_mode), parameters[1], zoom});
+}
+
+void PolarEffect::mapPoints(float* x, float* y, size_t count) const {
+    const float centerX = _width * 0.5f;
+    const float centerY = _height * 0.5f;
+    if (_mode == POLAR_TO_POLAR) {
+        // Across is the angle, down the distance from the center
+        for (size_t i = 0; i < count; ++i) {
+            const float angle = x[i] / _width * 2.0f * PI + _rotation;
+            const float radius = y[i] / _height * _radius;
+            x[i] = centerX + radius * core::cos(angle);
+            y[i] = centerY + radius * core::sin(angle);
+        }
+        return;
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        const float dx = x[i] - centerX;
+        const float dy = y[i] - centerY;
+        float angle = core::atan2(dy, dx) - _rotation;
+        angle -= 2.0f * PI * core::floor(angle / (2.0f * PI));
+        x[i] = angle / (2.0f * PI) * _width;
+        y[i] = core::sqrt(dx * dx + dy * dy) / _radius * _height;
+    }
+}
+
+} // namespace effects
+} // namespace gamma
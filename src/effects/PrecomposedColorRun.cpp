@@ -0,0 +1,86 @@
+#include "effects/PrecomposedColorRun.h"
+#include "effects/ContentKey.h"
+#include <algorithm>
+#include <vector>
+
+namespace gamma {
+namespace effects {
+
+uint64_t PrecomposedColorRun::addToKey(uint64_t key, EffectType type, const PointwiseEffect& effect,
+                                       const float* values) {
+    key = combineKey(key, static_cast<uint64_t>(type));
+    key = combineKey(key, effect.getColorStateId());
+    for (int p = 0; p < MAX_EFFECT_PARAMETERS; ++p) {
+        key = combineKey(key, floatBits(values[p]));
+    }
+    return key;
+}
+
+const ColorLut* PrecomposedColorRun::update(uint64_t key, PointwiseEffect* const* effects, size_t count) {
+    key = combineKey(key, count);
+    if (_key == key) {
+        ++_stableFrames;
+    } else {
+        _key = key;
+        _stableFrames = 0;
+    }
+    if (_stableFrames < STABLE_FRAMES) {
+        return nullptr;
+    }
+
+    if (_lutKey != key) {
+        if (!_lut) {
+            _lut = std::make_unique<ColorLut>(LUT_SIZE);
+        }
+        bake(effects, count, *_lut);
+        _lutKey = key;
+    }
+    return _lut.get();
+}
+
+void PrecomposedColorRun::reset() {
+    _key = 0;
+    _stableFrames = 0;
+    _lut.reset();
+    _lutKey = 0;
+}
+
+void PrecomposedColorRun::bake(PointwiseEffect* const* effects, size_t count, ColorLut& lut) {
+    const int size = lut.getSize();
+    const size_t pixels = static_cast<size_t>(size);
+    std::vector<float> rows[2];
+    rows[0].resize(pixels * 4);
+    rows[1].resize(pixels * 4);
+
+    for (int b = 0; b < size; ++b) {
+        for (int g = 0; g < size; ++g) {
+            float* row = rows[0].data();
+            for (int r = 0; r < size; ++r) {
+                row[r * 4 + 0] = lut.getLatticeValue(0, r);
+                row[r * 4 + 1] = lut.getLatticeValue(1, g);
+                row[r * 4 + 2] = lut.getLatticeValue(2, b);
+                row[r * 4 + 3] = 1.0f;
+            }
+
+            for (size_t k = 0; k < count; ++k) {
+                float* src = rows[k & 1].data();
+                float* dst = rows[(k + 1) & 1].data();
+                effects[k]->processRowFloat(src, dst, size, 0);
+                for (size_t i = 0; i < pixels * 4; ++i) {
+                    dst[i] = std::max(0.0f, std::min(1.0f, dst[i]));
+                }
+            }
+
+            const float* result = rows[count & 1].data();
+            for (int r = 0; r < size; ++r) {
+                float* value = lut.entry(r, g, b);
+                value[0] = result[r * 4 + 0];
+                value[1] = result[r * 4 + 1];
+                value[2] = result[r * 4 + 2];
+            }
+        }
+    }
+}
+
+} // namespace effects
+} // namespace gamma
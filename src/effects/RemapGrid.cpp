@@ -0,0 +1,341 @@
+#include "effects/RemapGrid.h"
+#include "effects/Kernels.h"
+#include "effects/PixelRows.h"
+#include "core/Math.h"
+#include <algorithm>
+#include <cstring>
+
+namespace gamma {
+namespace effects {
+
+namespace {
+    const float INVERSE_SPACING = 1.0f / RemapGrid::SPACING;
+
+    // Where a cell is checked against the map, as fractions of the cell: the
+    // center, the middle of each edge and the quarter points. A seam crossing
+    // the cell almost always separates one of them from its neighbours
+    const float CHECK_POINTS[][2] = {
+        {0.5f, 0.5f},
+        {0.5f, 0.0f}, {0.0f, 0.5f}, {1.0f, 0.5f}, {0.5f, 1.0f},
+        {0.25f, 0.25f}, {0.75f, 0.25f}, {0.25f, 0.75f}, {0.75f, 0.75f}
+    };
+    const int CHECK_POINT_COUNT = sizeof(CHECK_POINTS) / sizeof(CHECK_POINTS[0]);
+
+    inline float lerp(float a, float b, float t) {
+        return a + (b - a) * t;
+    }
+
+    // Whether the corners (top left, top right, bottom left, bottom right)
+    // interpolate to within tolerance of the map's value at (u, v); a NaN
+    // anywhere fails
+    inline bool fits(const float* cornersX, const float* cornersY, float u, float v, float x, float y) {
+        const float fitX = lerp(lerp(cornersX[0], cornersX[1], u), lerp(cornersX[2], cornersX[3], u), v);
+        const float fitY = lerp(lerp(cornersY[0], cornersY[1], u), lerp(cornersY[2], cornersY[3], u), v);
+        return core::fabs(fitX - x) <= RemapGrid::TOLERANCE && core::fabs(fitY - y) <= RemapGrid::TOLERANCE;
+    }
+
+    // Points per task when a batch is spread across workers: enough that the
+    // map's own setup and the hand-off are noise
+    const size_t MAP_GRAIN = 4096;
+    // Cells per task for the per-cell passes
+    const size_t CELL_GRAIN = 256;
+
+    // map over a batch, in chunks on the workers if there are any
+    void evaluate(const RemapFunction& map, float* x, float* y, size_t count, core::JobSystem* jobSystem) {
+        if (!jobSystem || count <= MAP_GRAIN) {
+            map(x, y, count);
+            return;
+        }
+        jobSystem->parallelFor(0, count, MAP_GRAIN, [&](size_t begin, size_t end) {
+            map(x + begin, y + begin, end - begin);
+        });
+    }
+
+    void forEachCell(size_t count, core::JobSystem* jobSystem, const core::JobSystem::RangeFunction& body) {
+        if (!jobSystem || count <= CELL_GRAIN) {
+            body(0, count);
+            return;
+        }
+        jobSystem->parallelFor(0, count, CELL_GRAIN, body);
+    }
+}
+
+void RemapGrid::build(int width, int height, const RemapFunction& map, core::JobSystem* jobSystem) {
+    _width = std::max(0, width);
+    _height = std::max(0, height);
+    _columns = (std::max(1, _width) - 1) / SPACING + 2;
+    _rows = (std::max(1, _height) - 1) / SPACING + 2;
+    const int cellColumns = _columns - 1;
+    const size_t cellCount = static_cast<size_t>(cellColumns) * static_cast<size_t>(_rows - 1);
+
+    // Nodes at pixel centers, every SPACING pixels from the first
+    const size_t nodeCount = static_cast<size_t>(_columns) * static_cast<size_t>(_rows);
+    _nodeX.resize(nodeCount);
+    _nodeY.resize(nodeCount);
+    for (int j = 0; j < _rows; ++j) {
+        for (int i = 0; i < _columns; ++i) {
+            const size_t n = static_cast<size_t>(j) * _columns + static_cast<size_t>(i);
+            _nodeX[n] = static_cast<float>(i * SPACING) + 0.5f;
+            _nodeY[n] = static_cast<float>(j * SPACING) + 0.5f;
+        }
+    }
+    evaluate(map, _nodeX.data(), _nodeY.data(), nodeCount, jobSystem);
+
+    // The map at every cell's check points, in one batch
+    std::vector<float> checkX(cellCount * CHECK_POINT_COUNT);
+    std::vector<float> checkY(cellCount * CHECK_POINT_COUNT);
+    for (size_t cell = 0; cell < cellCount; ++cell) {
+        const float originX = static_cast<float>((static_cast<int>(cell) % cellColumns) * SPACING) + 0.5f;
+        const float originY = static_cast<float>((static_cast<int>(cell) / cellColumns) * SPACING) + 0.5f;
+        for (int k = 0; k < CHECK_POINT_COUNT; ++k) {
+            checkX[cell * CHECK_POINT_COUNT + k] = originX + CHECK_POINTS[k][0] * SPACING;
+            checkY[cell * CHECK_POINT_COUNT + k] = originY + CHECK_POINTS[k][1] * SPACING;
+        }
+    }
+    evaluate(map, checkX.data(), checkY.data(), checkX.size(), jobSystem);
+
+    // Cells are checked independently, then numbered in order
+    std::vector<uint8_t> fails(cellCount, 0);
+    forEachCell(cellCount, jobSystem, [&](size_t begin, size_t end) {
+        for (size_t cell = begin; cell < end; ++cell) {
+            const size_t n = (cell / cellColumns) * _columns + cell % cellColumns;
+            const float cornersX[4] = {_nodeX[n], _nodeX[n + 1], _nodeX[n + _columns], _nodeX[n + _columns + 1]};
+            const float cornersY[4] = {_nodeY[n], _nodeY[n + 1], _nodeY[n + _columns], _nodeY[n + _columns + 1]};
+            for (int k = 0; k < CHECK_POINT_COUNT; ++k) {
+                const size_t check = cell * CHECK_POINT_COUNT + k;
+                if (!fits(cornersX, cornersY, CHECK_POINTS[k][0], CHECK_POINTS[k][1], checkX[check], checkY[check])) {
+                    fails[cell] = 1;
+                    break;
+                }
+            }
+        }
+    });
+    _cellIndex.assign(cellCount, -1);
+    std::vector<size_t> failing;
+    for (size_t cell = 0; cell < cellCount; ++cell) {
+        if (fails[cell]) {
+            _cellIndex[cell] = static_cast<int32_t>(failing.size());
+            failing.push_back(cell);
+        }
+    }
+
+    // Those get a node every REFINED_SPACING pixels, checked at the center
+    // and the top and left edges of every sub-cell
+    const int subNodes = SPACING / REFINED_SPACING + 1;
+    const int subCells = SPACING / REFINED_SPACING;
+    const size_t pointsPerCell = static_cast<size_t>(subNodes * subNodes + subCells * subCells * 3);
+    std::vector<float> refineX(failing.size() * pointsPerCell);
+    std::vector<float> refineY(failing.size() * pointsPerCell);
+    for (size_t f = 0; f < failing.size(); ++f) {
+        const float originX = static_cast<float>((static_cast<int>(failing[f]) % cellColumns) * SPACING) + 0.5f;
+        const float originY = static_cast<float>((static_cast<int>(failing[f]) / cellColumns) * SPACING) + 0.5f;
+        float* x = &refineX[f * pointsPerCell];
+        float* y = &refineY[f * pointsPerCell];
+        for (int b = 0; b < subNodes; ++b) {
+            for (int a = 0; a < subNodes; ++a) {
+                *x++ = originX + static_cast<float>(a * REFINED_SPACING);
+                *y++ = originY + static_cast<float>(b * REFINED_SPACING);
+            }
+        }
+        for (int b = 0; b < subCells; ++b) {
+            for (int a = 0; a < subCells; ++a) {
+                for (int k = 0; k < 3; ++k) {
+                    *x++ = originX + (static_cast<float>(a) + (k == 2 ? 0.0f : 0.5f)) * REFINED_SPACING;
+                    *y++ = originY + (static_cast<float>(b) + (k == 1 ? 0.0f : 0.5f)) * REFINED_SPACING;
+                }
+            }
+        }
+    }
+    evaluate(map, refineX.data(), refineY.data(), refineX.size(), jobSystem);
+
+    // Cells the finer nodes fit are interpolated from them, the rest (seams)
+    // hold the map itself at every pixel
+    const size_t cellPixels = static_cast<size_t>(SPACING) * SPACING;
+    _denseX.resize(failing.size() * cellPixels);
+    _denseY.resize(failing.size() * cellPixels);
+    std::vector<uint8_t> unrefined(failing.size(), 0);
+    forEachCell(failing.size(), jobSystem, [&](size_t begin, size_t end) {
+        for (size_t f = begin; f < end; ++f) {
+            const float* nodeX = &refineX[f * pointsPerCell];
+            const float* nodeY = &refineY[f * pointsPerCell];
+            const float* checksX = nodeX + subNodes * subNodes;
+            const float* checksY = nodeY + subNodes * subNodes;
+            bool refined = true;
+            for (int b = 0; b < subCells && refined; ++b) {
+                for (int a = 0; a < subCells && refined; ++a) {
+                    const int n = b * subNodes + a;
+                    const float cornersX[4] = {nodeX[n], nodeX[n + 1], nodeX[n + subNodes], nodeX[n + subNodes + 1]};
+                    const float cornersY[4] = {nodeY[n], nodeY[n + 1], nodeY[n + subNodes], nodeY[n + subNodes + 1]};
+                    const int check = (b * subCells + a) * 3;
+                    refined = fits(cornersX, cornersY, 0.5f, 0.5f, checksX[check], checksY[check]) &&
+                              fits(cornersX, cornersY, 0.5f, 0.0f, checksX[check + 1], checksY[check + 1]) &&
+                              fits(cornersX, cornersY, 0.0f, 0.5f, checksX[check + 2], checksY[check + 2]);
+                }
+            }
+            if (!refined) {
+                unrefined[f] = 1;
+                continue;
+            }
+            float* x = &_denseX[f * cellPixels];
+            float* y = &_denseY[f * cellPixels];
+            for (int v = 0; v < SPACING; ++v) {
+                const int b = v / REFINED_SPACING;
+                const float t = static_cast<float>(v - b * REFINED_SPACING) / REFINED_SPACING;
+                for (int u = 0; u < SPACING; ++u) {
+                    const int a = u / REFINED_SPACING;
+                    const float s = static_cast<float>(u - a * REFINED_SPACING) / REFINED_SPACING;
+                    const int n = b * subNodes + a;
+                    *x++ = lerp(lerp(nodeX[n], nodeX[n + 1], s), lerp(nodeX[n + subNodes], nodeX[n + subNodes + 1], s), t);
+                    *y++ = lerp(lerp(nodeY[n], nodeY[n + 1], s), lerp(nodeY[n + subNodes], nodeY[n + subNodes + 1], s), t);
+                }
+            }
+        }
+    });
+
+    // The rest get the map at every pixel, in one more batch
+    std::vector<size_t> exact;
+    for (size_t f = 0; f < failing.size(); ++f) {
+        if (unrefined[f]) {
+            exact.push_back(f);
+        }
+    }
+    std::vector<float> exactX(exact.size() * cellPixels);
+    std::vector<float> exactY(exact.size() * cellPixels);
+    for (size_t e = 0; e < exact.size(); ++e) {
+        const int originX = (static_cast<int>(failing[exact[e]]) % cellColumns) * SPACING;
+        const int originY = (static_cast<int>(failing[exact[e]]) / cellColumns) * SPACING;
+        for (int v = 0; v < SPACING; ++v) {
+            for (int u = 0; u < SPACING; ++u) {
+                exactX[e * cellPixels + static_cast<size_t>(v * SPACING + u)] = static_cast<float>(originX + u) + 0.5f;
+                exactY[e * cellPixels + static_cast<size_t>(v * SPACING + u)] = static_cast<float>(originY + v) + 0.5f;
+            }
+        }
+    }
+    evaluate(map, exactX.data(), exactY.data(), exactX.size(), jobSystem);
+    for (size_t e = 0; e < exact.size(); ++e) {
+        std::memcpy(&_denseX[exact[e] * cellPixels], &exactX[e * cellPixels], cellPixels * sizeof(float));
+        std::memcpy(&_denseY[exact[e] * cellPixels], &exactY[e * cellPixels], cellPixels * sizeof(float));
+    }
+    _denseCount = failing.size();
+    _exactCount = exact.size();
+}
+
+void RemapGrid::getRow(int y, float* x, float* yOut) const {
+    const int j = y / SPACING;
+    const int within = y - j * SPACING;
+    const float t = static_cast<float>(within) * INVERSE_SPACING;
+    const float* topX = &_nodeX[static_cast<size_t>(j) * _columns];
+    const float* topY = &_nodeY[static_cast<size_t>(j) * _columns];
+    const float* bottomX = topX + _columns;
+    const float* bottomY = topY + _columns;
+    const int32_t* cells = &_cellIndex[static_cast<size_t>(j) * (_columns - 1)];
+
+    for (int c = 0, x0 = 0; x0 < _width; ++c, x0 += SPACING) {
+        const int count = std::min(SPACING, _width - x0);
+        if (cells[c] >= 0) {
+            const size_t offset = static_cast<size_t>(cells[c]) * SPACING * SPACING + static_cast<size_t>(within) * SPACING;
+            std::memcpy(x + x0, &_denseX[offset], static_cast<size_t>(count) * sizeof(float));
+            std::memcpy(yOut + x0, &_denseY[offset], static_cast<size_t>(count) * sizeof(float));
+            continue;
+        }
+        // Down both edges of the cell, then across
+        const float leftX = lerp(topX[c], bottomX[c], t);
+        const float leftY = lerp(topY[c], bottomY[c], t);
+        const float stepX = (lerp(topX[c + 1], bottomX[c + 1], t) - leftX) * INVERSE_SPACING;
+        const float stepY = (lerp(topY[c + 1], bottomY[c + 1], t) - leftY) * INVERSE_SPACING;
+        for (int k = 0; k < count; ++k) {
+            x[x0 + k] = leftX + stepX * static_cast<float>(k);
+            yOut[x0 + k] = leftY + stepY * static_cast<float>(k);
+        }
+    }
+}
+
+size_t RemapGrid::getBytes() const {
+    return (_nodeX.size() + _nodeY.size() + _denseX.size() + _denseY.size()) * sizeof(float) +
+           _cellIndex.size() * sizeof(int32_t);
+}
+
+std::shared_ptr<const RemapGrid> RemapGridCache::find(uint64_t key, int width, int height) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return findLocked(key, width, height);
+}
+
+std::shared_ptr<const RemapGrid> RemapGridCache::findLocked(uint64_t key, int width, int height) {
+    for (size_t i = 0; i < _entries.size(); ++i) {
+        const Entry& entry = _entries[i];
+        if (entry.key == key && entry.grid->getWidth() == width && entry.grid->getHeight() == height) {
+            std::rotate(_entries.begin(), _entries.begin() + static_cast<std::ptrdiff_t>(i),
+                        _entries.begin() + static_cast<std::ptrdiff_t>(i) + 1);
+            return _entries.front().grid;
+        }
+    }
+    return nullptr;
+}
+
+std::shared_ptr<const RemapGrid> RemapGridCache::get(uint64_t key, int width, int height, const RemapFunction& map,
+                                                     core::JobSystem* jobSystem) {
+    if (auto grid = find(key, width, height)) {
+        return grid;
+    }
+
+    // Built without the lock, so lookups of other keys (and sampling of grids
+    // already handed out) are never held up behind a build; if two callers
+    // race to build the same key, the first one stored is kept
+    auto grid = std::make_shared<RemapGrid>();
+    grid->build(width, height, map, jobSystem);
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (auto stored = findLocked(key, width, height)) {
+        return stored;
+    }
+    ++_builds;
+    _entries.insert(_entries.begin(), Entry{key, grid});
+    if (_entries.size() > CAPACITY) {
+        _entries.pop_back();
+    }
+    return grid;
+}
+
+void RemapGridCache::clear() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _entries.clear();
+}
+
+void remapRows(const RemapGrid* grid, const Frame& input, Frame& output, int yBegin, int yEnd, bool floatPixels) {
+    if (!grid) {
+        for (int y = yBegin; y < yEnd; ++y) {
+            copyRow(input, y, output, y);
+        }
+        return;
+    }
+
+    const size_t count = static_cast<size_t>(input.getWidth());
+    if (count == 0) {
+        return;
+    }
+    // One buffer holds both coordinate rows: it has room for four floats a pixel
+    float* x = getRowBuffer(2, count);
+    float* y = x + count;
+    const KernelTable& kernels = getKernels();
+    const RemapSource source = {input.rowData(0), input.getStride(), input.getWidth(), input.getHeight(),
+                                input.getFormat()};
+
+    if (!floatPixels) {
+        for (int row = yBegin; row < yEnd; ++row) {
+            grid->getRow(row, x, y);
+            kernels.remap(source, x, y, output.row(row), count);
+        }
+        return;
+    }
+
+    float* result = getRowBuffer(3, count);
+    for (int row = yBegin; row < yEnd; ++row) {
+        grid->getRow(row, x, y);
+        float* dst = getStoreTarget(output, 0, row, result);
+        kernels.remapFloat(source, x, y, dst, count);
+        writePixels(dst, output, 0, row, count);
+    }
+}
+
+} // namespace effects
+} // namespace gamma
@@ -0,0 +1,76 @@
+#include "effects/TestPattern.h"
+#include <algorithm>
+#include <cstring>
+
+namespace gamma {
+namespace effects {
+
+namespace {
+    const double SWEEP_SECONDS = 4.0;
+
+    const uint32_t BAR_COLORS[] = {
+        packPixel(192, 192, 192),   // Gray
+        packPixel(192, 192, 0),     // Yellow
+        packPixel(0, 192, 192),     // Cyan
+        packPixel(0, 192, 0),       // Green
+        packPixel(192, 0, 192),     // Magenta
+        packPixel(192, 0, 0),       // Red
+        packPixel(0, 0, 192),       // Blue
+        packPixel(16, 16, 16)       // Black
+    };
+    const int BAR_COUNT = sizeof(BAR_COLORS) / sizeof(BAR_COLORS[0]);
+
+    // Content ids of the pattern sit above anything makeContentId() hands out;
+    // the moving bar's position is all that changes between frames
+    const uint64_t CONTENT_ID_BASE = 0x8000000000000000ull;
+}
+
+void renderTestPattern(Frame& frame, double time) {
+    const int width = frame.getWidth();
+    const int height = frame.getHeight();
+    if (frame.empty()) {
+        return;
+    }
+
+    const int barsHeight = height * 2 / 3;
+    const size_t rowBytes = static_cast<size_t>(width) * sizeof(uint32_t);
+
+    // Build one row of each band, then copy it down
+    uint32_t* barsRow = frame.row(0);
+    for (int x = 0; x < width; ++x) {
+        barsRow[x] = BAR_COLORS[static_cast<int64_t>(x) * BAR_COUNT / width];
+    }
+    for (int y = 1; y < barsHeight; ++y) {
+        std::memcpy(frame.row(y), barsRow, rowBytes);
+    }
+
+    if (barsHeight < height) {
+        uint32_t* rampRow = frame.row(barsHeight);
+        for (int x = 0; x < width; ++x) {
+            uint32_t level = static_cast<uint32_t>(static_cast<int64_t>(x) * 255 / std::max(1, width - 1));
+            rampRow[x] = packPixel(level, level, level);
+        }
+        for (int y = barsHeight + 1; y < height; ++y) {
+            std::memcpy(frame.row(y), rampRow, rowBytes);
+        }
+    }
+
+    // Moving bar
+    double phase = time / SWEEP_SECONDS;
+    phase -= static_cast<double>(static_cast<int64_t>(phase));
+    if (phase < 0.0) {
+        phase += 1.0;
+    }
+    const int barWidth = std::max(1, width / 32);
+    const int barX = static_cast<int>(phase * (width - barWidth));
+    const uint32_t white = packPixel(255, 255, 255);
+    for (int y = 0; y < height; ++y) {
+        std::fill(frame.row(y) + barX, frame.row(y) + barX + barWidth, white);
+    }
+
+    frame.setContentId(CONTENT_ID_BASE | (static_cast<uint64_t>(width) << 40) |
+                       (static_cast<uint64_t>(height) << 20) | static_cast<uint64_t>(barX));
+}
+
+} // namespace effects
+} // namespace gamma
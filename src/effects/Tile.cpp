@@ -0,0 +1,41 @@
+#include "effects/Effects.h"
+#include "core/Math.h"
+#include <algorithm>
+
+namespace gamma {
+namespace effects {
+
+namespace {
+    // Position within its tile along one axis; odd tiles reflected when mirroring
+    inline float foldTile(float position, float tiles, float size, bool mirror) {
+        const float scaled = position * tiles;
+        const float tile = core::floor(scaled / size);
+        const float local = scaled - tile * size;
+        const bool odd = core::fmod(tile, 2.0f) != 0.0f;
+        return mirror && odd ? size - local : local;
+    }
+}
+
+uint64_t TileEffect::prepareMap(int width, int height, const float* parameters) {
+    const int tilesX = std::max(1, std::min(16, static_cast<int>(parameters[0] + 0.5f)));
+    const int tilesY = std::max(1, std::min(16, static_cast<int>(parameters[1] + 0.5f)));
+    if (tilesX == 1 && tilesY == 1) {
+        return 0;
+    }
+    _width = static_cast<float>(width);
+    _height = static_cast<float>(height);
+    _tilesX = static_cast<float>(tilesX);
+    _tilesY = static_cast<float>(tilesY);
+    _mirror = parameters[2] >= 0.5f;
+    return hashMap("Tile", width, height, {_tilesX, _tilesY, _mirror ? 1.0f : 0.0f});
+}
+
+void TileEffect::mapPoints(float* x, float* y, size_t count) const {
+    for (size_t i = 0; i < count; ++i) {
+        x[i] = foldTile(x[i], _tilesX, _width, _mirror);
+        y[i] = foldTile(y[i], _tilesY, _height, _mirror);
+    }
+}
+
+} // namespace effects
+} // namespace gamma
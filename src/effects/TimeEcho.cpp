@@ -0,0 +1,76 @@
+#include "effects/Effects.h"
+#include "effects/PixelRows.h"
+#include <algorithm>
+#include <cstring>
+
+namespace gamma {
+namespace effects {
+
+void TimeEchoEffect::prepare(const Frame& /*input*/, const float* parameters, const EffectContext& context) {
+    float delay = std::max(0.0f, parameters[0]);
+    float feedback = std::max(0.0f, std::min(0.95f, parameters[1]));
+    float mix = std::max(0.0f, std::min(1.0f, parameters[2]));
+
+    _delayed = nullptr;
+    _recorded = nullptr;
+    if (_history.bind(context.history)) {
+        // Newest recorded frame at least `delay` old, or the oldest one we have
+        _history.setSpan(delay);
+        _delayed = _history.findByAge(delay);
+        if (_history.isRecordDue()) {
+            _recorded = _history.record();
+        }
+    }
+
+    _mix = mix;
+    _feedback = feedback;
+    _mixWeight = static_cast<uint32_t>(mix * 256.0f + 0.5f);
+    _feedbackWeight = static_cast<uint32_t>(feedback * 256.0f + 0.5f);
+    _kernels = &getKernels();
+}
+
+void TimeEchoEffect::processRow(const uint32_t* src, uint32_t* dst, int width, int y) {
+    const size_t count = static_cast<size_t>(width);
+    if (!_delayed) {
+        std::copy(src, src + count, dst);
+        if (_recorded) {
+            std::copy(src, src + count, _recorded->row(y));
+        }
+        return;
+    }
+
+    const uint32_t* echo = _delayed->row(y);
+    _kernels->blend(src, echo, dst, count, _mixWeight);
+    if (_recorded) {
+        _kernels->blend(src, echo, _recorded->row(y), count, _feedbackWeight);
+    }
+}
+
+void TimeEchoEffect::processRowFloat(const float* src, float* dst, int width, int y) {
+    const size_t count = static_cast<size_t>(width);
+    if (!_delayed) {
+        std::memcpy(dst, src, count * 4 * sizeof(float));
+        if (_recorded) {
+            writePixels(src, *_recorded, 0, y, count);
+        }
+        return;
+    }
+
+    // History frames are in the engine's intermediate format
+    const float* echo = loadPixels(*_delayed, 0, y, count, getRowBuffer(2, count));
+    _kernels->blendFloat(src, echo, dst, count, _mix);
+    if (_recorded) {
+        float* recorded = getStoreTarget(*_recorded, 0, y, getRowBuffer(3, count));
+        _kernels->blendFloat(src, echo, recorded, count, _feedback);
+        writePixels(recorded, *_recorded, 0, y, count);
+    }
+}
+
+void TimeEchoEffect::reset() {
+    _history.clear();
+    _delayed = nullptr;
+    _recorded = nullptr;
+}
+
+} // namespace effects
+} // namespace gamma
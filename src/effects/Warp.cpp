@@ -0,0 +1,36 @@
+#include "effects/Effects.h"
+#include "core/Math.h"
+#include <algorithm>
+
+namespace gamma {
+namespace effects {
+
+namespace {
+    const float PI = 3.14159265358979f;
+    const float MAX_DISPLACEMENT = 0.05f;   // Of the shorter side, at Amount 1
+}
+
+uint64_t WarpEffect::prepareMap(int width, int height, const float* parameters) {
+    const float amount = std::max(0.0f, std::min(1.0f, parameters[0]));
+    if (amount <= 0.0f) {
+        return 0;
+    }
+    const float frequency = std::max(0.5f, std::min(16.0f, parameters[1]));
+    _amplitude = amount * MAX_DISPLACEMENT * static_cast<float>(std::min(width, height));
+    _waveX = 2.0f * PI * frequency / static_cast<float>(width);
+    _waveY = 2.0f * PI * frequency / static_cast<float>(height);
+    _phase = parameters[2] * PI / 180.0f;
+    return hashMap("Warp", width, height, {amount, frequency, parameters[2]});
+}
+
+void WarpEffect::mapPoints(float* x, float* y, size_t count) const {
+    for (size_t i = 0; i < count; ++i) {
+        const float sourceX = x[i] + _amplitude * core::sin(y[i] * _waveY + _phase);
+        const float sourceY = y[i] + _amplitude * core::sin(x[i] * _waveX + _phase);
+        x[i] = sourceX;
+        y[i] = sourceY;
+    }
+}
+
+} // namespace effects
+} // namespace gamma
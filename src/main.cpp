@@ -1,42 +1,137 @@
 #include <iostream>
+#include <string>
+#include <cstdlib>
 #include "core/Application.h"
+#include "effects/ColorLut.h"
+#include "effects/EffectProcessor.h"
+#include "effects/FramePool.h"
+
+namespace {
+    // Effect names separated by commas, in chain order
+    bool parseChain(const std::string& list, std::vector<gamma::effects::EffectType>& effects) {
+        size_t begin = 0;
+        while (begin <= list.size()) {
+            size_t end = list.find(',', begin);
+            if (end == std::string::npos) {
+                end = list.size();
+            }
+            const std::string name = list.substr(begin, end - begin);
+            gamma::effects::EffectType type;
+            if (!gamma::effects::findEffectType(name, type)) {
+                std::cerr << "Unknown effect: \"" << name << "\"" << std::endl;
+                return false;
+            }
+            effects.push_back(type);
+            begin = end + 1;
+        }
+        return true;
+    }
+
+    void printUsage() {
+        std::cout << "Usage: GammaArray [options]" << std::endl;
+        std::cout << "  -w, --windowed        Run in windowed mode (default)" << std::endl;
+        std::cout << "  -f, --fullscreen      Request fullscreen (currently disabled)" << std::endl;
+        std::cout << "  --headless            Run without window, OpenGL or ImGui" << std::endl;
+        std::cout << "  --rate <hz>           Headless update rate (0 = as fast as possible)" << std::endl;
+        std::cout << "  --duration <seconds>  Headless run duration (0 = until replay ends)" << std::endl;
+        std::cout << "  --replay <file.csv>   Replay an exported MIDI log in headless mode" << std::endl;
+        std::cout << "  --chain <effects>     Headless effect chain, comma-separated names" << std::endl;
+        std::cout << "                        (e.g. \"Color Correction,Warp,Kaleidoscope\")" << std::endl;
+        std::cout << "  --pixel-format <name> Effect intermediates: RGBA8 (default), RGBA16F, RGBA32F" << std::endl;
+        std::cout << "  --huge-pages <mode>   Frame memory: off, transparent (default on Linux), explicit" << std::endl;
+        std::cout << "  --luts <directory>    Load the .cube looks of a directory for Color LUT" << std::endl;
+        std::cout << "  -h, --help            Show this help" << std::endl;
+    }
+}
 
 int main(int argc, char* argv[]) {
     std::cout << "=== Gamma Array - VJ Application ===" << std::endl;
     std::cout << "Version: Development Build" << std::endl;
     std::cout << "=====================================" << std::endl;
-    
+
     // Force windowed mode (fullscreen capability disabled)
     bool fullscreen = false;  // Always windowed
-    if (argc > 1) {
-        std::string arg = argv[1];
+    bool headless = false;
+    gamma::core::HeadlessOptions headlessOptions;
+    gamma::effects::PixelFormat pixelFormat = gamma::effects::PixelFormat::RGBA8;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = (i + 1 < argc);
+
         if (arg == "--fullscreen" || arg == "-f") {
             std::cout << "Fullscreen mode requested but disabled - using windowed mode" << std::endl;
         } else if (arg == "--windowed" || arg == "-w") {
             std::cout << "Windowed mode requested via command line" << std::endl;
+        } else if (arg == "--headless") {
+            headless = true;
+        } else if (arg == "--rate" && hasValue) {
+            headlessOptions.updateRate = static_cast<float>(std::atof(argv[++i]));
+        } else if (arg == "--duration" && hasValue) {
+            headlessOptions.duration = static_cast<float>(std::atof(argv[++i]));
+        } else if (arg == "--replay" && hasValue) {
+            headlessOptions.replayFile = argv[++i];
+        } else if (arg == "--chain" && hasValue) {
+            if (!parseChain(argv[++i], headlessOptions.effects)) {
+                printUsage();
+                return -1;
+            }
+        } else if (arg == "--pixel-format" && hasValue) {
+            if (!gamma::effects::findPixelFormat(argv[++i], pixelFormat)) {
+                std::cerr << "Unknown pixel format: " << argv[i] << std::endl;
+                printUsage();
+                return -1;
+            }
+        } else if (arg == "--huge-pages" && hasValue) {
+            gamma::effects::HugePageMode mode;
+            if (!gamma::effects::findHugePageMode(argv[++i], mode)) {
+                std::cerr << "Unknown huge page mode: " << argv[i] << std::endl;
+                printUsage();
+                return -1;
+            }
+            gamma::effects::getFramePool().setHugePageMode(mode);
+        } else if (arg == "--luts" && hasValue) {
+            gamma::effects::getLutLibrary().loadDirectory(argv[++i]);
+        } else if (arg == "--help" || arg == "-h") {
+            printUsage();
+            return 0;
+        } else {
+            std::cerr << "Unknown or incomplete option: " << arg << std::endl;
+            printUsage();
+            return -1;
         }
-        // Note: fullscreen remains false regardless of arguments
     }
-    
+    // Note: fullscreen remains false regardless of arguments
+
+    if (!headless && (!headlessOptions.replayFile.empty() || headlessOptions.updateRate > 0.0f ||
+                      !headlessOptions.effects.empty())) {
+        std::cout << "--rate/--replay/--chain only apply with --headless - ignoring" << std::endl;
+    }
+
     try {
         // Create application instance
         gamma::core::Application app;
-        
+        app.setEffectPixelFormat(pixelFormat);
+
         // Initialize the application
-        if (!app.initialize(fullscreen)) {
+        bool initialized = headless ? app.initializeHeadless(headlessOptions)
+                                    : app.initialize(fullscreen);
+        if (!initialized) {
             std::cerr << "Failed to initialize application" << std::endl;
             return -1;
         }
-        
-        std::cout << "Press ESC to exit" << std::endl;
-        
+
+        if (!headless) {
+            std::cout << "Press ESC to exit" << std::endl;
+        }
+
         // Run the main loop
         app.run();
-        
+
         // Cleanup is handled by destructor
         std::cout << "Application exited normally" << std::endl;
         return 0;
-        
+
     } catch (const std::exception& e) {
         std::cerr << "Application error: " << e.what() << std::endl;
         return -1;
@@ -44,4 +139,4 @@ int main(int argc, char* argv[]) {
         std::cerr << "Unknown application error occurred" << std::endl;
         return -1;
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,105 @@
+#include "midi/MidiLogRing.h"
+#include <cstdio>
+
+namespace gamma {
+namespace midi {
+
+void MidiLogRing::IndexRing::push(uint64_t sequence) {
+    if (count == slots.size()) {
+        // Full: unroll into a larger buffer, oldest first
+        std::vector<uint64_t> grown(slots.empty() ? 256 : slots.size() * 2);
+        for (size_t i = 0; i < count; ++i) {
+            grown[i] = at(i);
+        }
+        slots.swap(grown);
+        head = 0;
+    }
+    slots[(head + count) % slots.size()] = sequence;
+    ++count;
+}
+
+void MidiLogRing::IndexRing::popFront() {
+    if (count > 0) {
+        head = (head + 1) % slots.size();
+        --count;
+    }
+}
+
+MidiLogRing::MidiLogRing(size_t capacity)
+    : _capacity(capacity > 0 ? capacity : 1)
+    , _nextSequence(0)
+    , _entryCount(0) {
+}
+
+void MidiLogRing::clear() {
+    // Storage is kept for reuse; sequence numbers restart so slots line up again
+    _nextSequence = 0;
+    _entryCount = 0;
+    for (auto& index : _typeIndex) {
+        index.head = 0;
+        index.count = 0;
+    }
+}
+
+void MidiLogRing::append(const MidiMessage& message) {
+    size_t slot = static_cast<size_t>(_nextSequence % _capacity);
+
+    if (_entryCount == _capacity) {
+        // Overwriting the oldest entry: it is also the oldest of its type
+        _typeIndex[_entries[slot].type].popFront();
+        --_entryCount;
+    }
+    if (slot == _entries.size()) {
+        _entries.emplace_back();
+    }
+
+    Entry& entry = _entries[slot];
+    entry.type = static_cast<uint8_t>(classify(message));
+    const int length = std::snprintf(entry.text, TEXT_CAPACITY, "[%.3f] %s", message.timestamp,
+                                     message.description.c_str());
+    entry.length = length > 0 ? static_cast<uint32_t>(length) : 0;
+    if (entry.length >= TEXT_CAPACITY) {
+        // Did not fit: format again into the entry's overflow string
+        if (!entry.overflow) {
+            entry.overflow = std::make_unique<std::string>();
+        }
+        entry.overflow->resize(entry.length);
+        std::snprintf(&(*entry.overflow)[0], entry.length + 1, "[%.3f] %s", message.timestamp,
+                      message.description.c_str());
+    }
+
+    _typeIndex[entry.type].push(_nextSequence);
+    ++_nextSequence;
+    ++_entryCount;
+}
+
+const MidiLogRing::Entry& MidiLogRing::getNewest(int type, size_t fromNewest) const {
+    if (type < 0) {
+        return entryAt(_nextSequence - 1 - fromNewest);
+    }
+    const IndexRing& index = _typeIndex[type];
+    return entryAt(index.at(index.count - 1 - fromNewest));
+}
+
+MidiLogRing::MessageType MidiLogRing::classify(const MidiMessage& message) {
+    if (message.data.empty()) {
+        return TYPE_OTHER;
+    }
+
+    switch (message.data[0] & 0xF0) {
+        case 0x80:
+        case 0x90:
+            return TYPE_NOTE;
+        case 0xB0:
+            return TYPE_CONTROL_CHANGE;
+        case 0xE0:
+            return TYPE_PITCH_BEND;
+        case 0xF0:
+            return TYPE_SYSTEM;
+        default:
+            return TYPE_OTHER;
+    }
+}
+
+} // namespace midi
+} // namespace gamma
@@ -14,7 +14,10 @@ MidiManager::MidiManager()
     : _midiIn(nullptr)
     , _isInitialized(false)
     , _isConnected(false)
-    , _connectedDeviceIndex(-1) {
+    , _connectedDeviceIndex(-1)
+    , _consoleEcho(true)
+    , _messagesLogged(0)
+    , _logClearCount(0) {
 }
 
 MidiManager::~MidiManager() {
@@ -103,6 +106,7 @@ bool MidiManager::connectToDevice(int deviceIndex) {
             std::lock_guard<std::mutex> lock(_messageLogMutex);
             _messageLog.emplace_back(std::vector<unsigned char>(), 0.0, 
                 "Connected to: " + _connectedDeviceName);
+            ++_messagesLogged;
         }
         
         return true;
@@ -124,6 +128,7 @@ void MidiManager::disconnect() {
                 std::lock_guard<std::mutex> lock(_messageLogMutex);
                 _messageLog.emplace_back(std::vector<unsigned char>(), 0.0, 
                     "Disconnected from: " + _connectedDeviceName);
+                ++_messagesLogged;
             }
         } catch (RtMidiError& error) {
             std::cerr << "MIDI disconnection error: " << error.getMessage() << std::endl;
@@ -152,9 +157,30 @@ std::vector<MidiMessage> MidiManager::getRecentMessages(size_t maxMessages) {
     return messages;
 }
 
+uint64_t MidiManager::getMessagesSince(uint64_t sequence, std::vector<MidiMessage>& out) {
+    std::lock_guard<std::mutex> lock(_messageLogMutex);
+
+    uint64_t oldestRetained = _messagesLogged - _messageLog.size();
+    if (sequence < oldestRetained) {
+        sequence = oldestRetained;
+    }
+
+    for (uint64_t i = sequence; i < _messagesLogged; ++i) {
+        out.push_back(_messageLog[static_cast<size_t>(i - oldestRetained)]);
+    }
+
+    return _messagesLogged;
+}
+
+uint64_t MidiManager::getLogClearCount() {
+    std::lock_guard<std::mutex> lock(_messageLogMutex);
+    return _logClearCount;
+}
+
 void MidiManager::clearMessageLog() {
     std::lock_guard<std::mutex> lock(_messageLogMutex);
     _messageLog.clear();
+    ++_logClearCount;
 }
 
 void MidiManager::setJogWheelCallback(std::function<void(int, float)> callback) {
@@ -224,6 +250,10 @@ void MidiManager::refreshDevices() {
     }
 }
 
+void MidiManager::injectMessage(const std::vector<unsigned char>& message, double timestamp) {
+    processMidiMessage(message, timestamp);
+}
+
 void MidiManager::midiInputCallback(double deltatime, std::vector<unsigned char>* message, void* userData) {
     MidiManager* manager = static_cast<MidiManager*>(userData);
     if (manager && message) {
@@ -292,6 +322,7 @@ void MidiManager::processMidiMessage(const std::vector<unsigned char>& message,
     {
         std::lock_guard<std::mutex> lock(_messageLogMutex);
         _messageLog.emplace_back(message, timestamp, description);
+        ++_messagesLogged;
         
         // Keep log size manageable
         if (_messageLog.size() > MAX_LOG_SIZE) {
@@ -300,6 +331,9 @@ void MidiManager::processMidiMessage(const std::vector<unsigned char>& message,
     }
 
     // Debug output only for non-jog wheel messages to avoid console spam
+    if (!_consoleEcho) {
+        return;
+    }
     if (!isJogMessage) {
         std::cout << "MIDI: " << description << std::endl;
     } else {
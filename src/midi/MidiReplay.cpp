@@ -0,0 +1,94 @@
+#include "midi/MidiReplay.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <cstdlib>
+
+namespace gamma {
+namespace midi {
+
+MidiReplay::MidiReplay()
+    : _nextEvent(0) {
+}
+
+bool MidiReplay::load(const std::string& filename) {
+    std::ifstream csvFile(filename);
+    if (!csvFile.is_open()) {
+        _events.clear();
+        _nextEvent = 0;
+        std::cerr << "Failed to open MIDI replay file: " << filename << std::endl;
+        return false;
+    }
+
+    parse(csvFile);
+    std::cout << "Loaded MIDI replay: " << filename << " (" << _events.size() << " messages, "
+              << getDuration() << "s)" << std::endl;
+    return !_events.empty();
+}
+
+bool MidiReplay::parse(std::istream& input) {
+    _events.clear();
+    _nextEvent = 0;
+
+    std::string line;
+    double playbackTime = 0.0;
+    bool firstLine = true;
+
+    while (std::getline(input, line)) {
+        // Skip header row
+        if (firstLine) {
+            firstLine = false;
+            if (line.compare(0, 9, "Timestamp") == 0) {
+                continue;
+            }
+        }
+
+        // Layout: Timestamp,"Raw_Bytes","Description",...
+        size_t firstComma = line.find(',');
+        if (firstComma == std::string::npos) {
+            continue;
+        }
+
+        size_t bytesStart = line.find('"', firstComma);
+        size_t bytesEnd = (bytesStart != std::string::npos) ? line.find('"', bytesStart + 1) : std::string::npos;
+        if (bytesEnd == std::string::npos) {
+            continue;
+        }
+
+        ReplayEvent event;
+        event.delta = std::strtod(line.c_str(), nullptr);
+
+        std::istringstream bytes(line.substr(bytesStart + 1, bytesEnd - bytesStart - 1));
+        std::string byteStr;
+        while (bytes >> byteStr) {
+            event.data.push_back(static_cast<unsigned char>(std::strtoul(byteStr.c_str(), nullptr, 16)));
+        }
+
+        // Connection/disconnection entries have no bytes - nothing to replay
+        if (event.data.empty()) {
+            continue;
+        }
+
+        playbackTime += event.delta;
+        event.time = playbackTime;
+        _events.push_back(std::move(event));
+    }
+
+    return !_events.empty();
+}
+
+size_t MidiReplay::advance(double elapsedSeconds, const InjectFunction& inject) {
+    size_t injected = 0;
+
+    while (_nextEvent < _events.size() && _events[_nextEvent].time <= elapsedSeconds) {
+        const ReplayEvent& event = _events[_nextEvent];
+        inject(event.data, event.delta);
+        ++_nextEvent;
+        ++injected;
+    }
+
+    return injected;
+}
+
+} // namespace midi
+} // namespace gamma
@@ -1,7 +1,10 @@
 #include "ui/EffectsPanel.h"
 #include "ui/WorkspaceManager.h"
+#include "core/FrameArena.h"
+#include "effects/ColorLut.h"
+#include "effects/FramePool.h"
 #include "imgui.h"
-#include <cmath>
+#include <algorithm>
 
 namespace gamma {
 namespace ui {
@@ -9,52 +12,17 @@ namespace ui {
 EffectsPanel::EffectsPanel()
     : WorkspacePanel("Effects")
     , _selectedEffect(-1)
-    , _selectedCategory("All")
+    , _selectedCategory(-1)
     , _bypassAll(false)
     , _masterMix(1.0f)
-    , _cpuUsage(0.0f) {
-    
-    // Initialize categories
-    _categories = {"All", "Color", "Distortion", "Blur", "Geometry", "Time"};
-    
-    // Initialize available effects
-    _availableEffects = {
-        {"Color Correction", "Color", false, false, {
-            {"Brightness", 0.0f, -1.0f, 1.0f, 0.0f, true},
-            {"Contrast", 1.0f, 0.0f, 3.0f, 1.0f, true},
-            {"Saturation", 1.0f, 0.0f, 2.0f, 1.0f, true},
-            {"Hue Shift", 0.0f, -180.0f, 180.0f, 0.0f, true}
-        }},
-        {"Chromatic Aberration", "Color", false, false, {
-            {"Strength", 0.0f, 0.0f, 1.0f, 0.0f, true},
-            {"Red Offset", 0.0f, -50.0f, 50.0f, 0.0f, true},
-            {"Blue Offset", 0.0f, -50.0f, 50.0f, 0.0f, true}
-        }},
-        {"Datamosh", "Distortion", false, false, {
-            {"Intensity", 0.0f, 0.0f, 1.0f, 0.0f, true},
-            {"Block Size", 8.0f, 1.0f, 32.0f, 8.0f, true},
-            {"Chaos", 0.5f, 0.0f, 1.0f, 0.5f, true}
-        }},
-        {"Motion Blur", "Blur", false, false, {
-            {"Amount", 0.0f, 0.0f, 1.0f, 0.0f, true},
-            {"Angle", 0.0f, 0.0f, 360.0f, 0.0f, true},
-            {"Samples", 8.0f, 1.0f, 32.0f, 8.0f, true}
-        }},
-        {"Mirror", "Geometry", false, false, {
-            {"Mode", 0.0f, 0.0f, 3.0f, 0.0f, true}, // 0=none, 1=horizontal, 2=vertical, 3=both
-            {"Center X", 0.5f, 0.0f, 1.0f, 0.5f, true},
-            {"Center Y", 0.5f, 0.0f, 1.0f, 0.5f, true}
-        }},
-        {"Time Echo", "Time", false, false, {
-            {"Delay", 0.1f, 0.01f, 1.0f, 0.1f, true},
-            {"Feedback", 0.5f, 0.0f, 0.95f, 0.5f, true},
-            {"Mix", 0.5f, 0.0f, 1.0f, 0.5f, true}
-        }}
-    };
+    , _cpuUsage(0.0f)
+    , _effectEngine(nullptr) {
     
     // Start with a few effects active
-    _activeEffects.push_back(_availableEffects[0]); // Color Correction
-    _activeEffects.back().isActive = true;
+    _chain.add(gamma::effects::EffectType::ColorCorrection, true);
+
+    // update() only reads the CPU meter from the engine
+    setUpdatePolicy(UpdatePolicy::FixedRate, 20.0f);
 }
 
 void EffectsPanel::render() {
@@ -78,7 +46,7 @@ void EffectsPanel::render() {
                             ImGuiWindowFlags_NoCollapse |
                             ImGuiWindowFlags_NoTitleBar;
     
-    if (ImGui::Begin("Effects", &_visible, flags)) {
+    if (beginWindow("Effects", flags)) {
         renderEffectControls();
         ImGui::Separator();
         
@@ -105,13 +73,20 @@ void EffectsPanel::render() {
     ImGui::End();
 }
 
-void EffectsPanel::update(float deltaTime) {
-    // Simulate CPU usage based on active effects
-    float targetCPU = _activeEffects.size() * 0.15f;
-    if (_bypassAll) targetCPU = 0.0f;
-    
-    _cpuUsage += (targetCPU - _cpuUsage) * deltaTime * 5.0f;
-    _cpuUsage = std::max(0.0f, std::min(1.0f, _cpuUsage));
+void EffectsPanel::update(float /*deltaTime*/) {
+    // Share of the frame interval the engine spent processing (already smoothed)
+    _cpuUsage = _effectEngine ? static_cast<float>(_effectEngine->getLoad()) : 0.0f;
+}
+
+void EffectsPanel::buildChain(std::vector<gamma::effects::ChainSlot>& chain) const {
+    _chain.buildSlots(chain);
+}
+
+void EffectsPanel::publishChain(gamma::effects::ParameterBlock& block) const {
+    gamma::effects::ChainParameters& parameters = block.beginWrite();
+    buildChain(parameters.slots);
+    parameters.masterMix = getMasterMix();
+    block.publish();
 }
 
 void EffectsPanel::renderEffectControls() {
@@ -125,23 +100,46 @@ void EffectsPanel::renderEffectControls() {
     ImGui::Text("Master Mix:");
     ImGui::SliderFloat("##MasterMix", &_masterMix, 0.0f, 1.0f, "%.2f");
     
-    // CPU usage indicator
-    ImGui::Text("CPU: %.1f%%", _cpuUsage * 100.0f);
+    // CPU usage indicator: processing time relative to the frame interval
+    if (_effectEngine) {
+        ImGui::Text("CPU: %.1f%% (%.2f ms/frame)", _cpuUsage * 100.0f, _effectEngine->getProcessTimeMs());
+    } else {
+        ImGui::Text("CPU: %.1f%%", _cpuUsage * 100.0f);
+    }
     ImGui::ProgressBar(_cpuUsage, ImVec2(-1, 0));
+
+    // Results reused from earlier frames (paused or unchanged input)
+    if (_effectEngine) {
+        const gamma::effects::EffectEngine::CacheStats& cache = _effectEngine->getCacheStats();
+        ImGui::TextDisabled("Cache: %llu hits, %llu misses",
+                            static_cast<unsigned long long>(cache.hits),
+                            static_cast<unsigned long long>(cache.misses));
+
+        // Pixel memory of every frame in the process (see FramePool)
+        const gamma::effects::FramePoolStats frames = gamma::effects::getFramePool().getStats();
+        const double megabyte = 1024.0 * 1024.0;
+        ImGui::TextDisabled("Frames: %.0f MB live (peak %.0f), %.0f MB pooled",
+                            frames.liveBytes / megabyte, frames.peakLiveBytes / megabyte,
+                            frames.pooledBytes / megabyte);
+    }
 }
 
 void EffectsPanel::renderEffectChain() {
-    ImGui::Text("Effect Chain (%d active)", static_cast<int>(_activeEffects.size()));
+    ImGui::Text("Effect Chain (%d active)", static_cast<int>(_chain.size()));
     
     if (ImGui::BeginChild("EffectChain", ImVec2(0, -60))) {
-        for (int i = 0; i < static_cast<int>(_activeEffects.size()); ++i) {
-            auto& effect = _activeEffects[i];
+        for (int i = 0; i < static_cast<int>(_chain.size()); ++i) {
+            const gamma::effects::EffectDescriptor& descriptor = _chain.getDescriptor(i);
+            const bool isActive = _chain.isActive(i);
+            const bool isBypassed = _chain.isBypassed(i);
+            const char* category = gamma::effects::getEffectCategoryName(descriptor.category);
             
             ImGui::PushID(i);
             
             // Effect header with controls
             bool isSelected = (_selectedEffect == i);
-            if (ImGui::Selectable(("##effect" + std::to_string(i)).c_str(), isSelected, 0, ImVec2(0, 30))) {
+            // Unique through PushID(i), no per-frame label formatting needed
+            if (ImGui::Selectable("##effect", isSelected, 0, ImVec2(0, 30))) {
                 _selectedEffect = i;
             }
             
@@ -150,25 +148,32 @@ void EffectsPanel::renderEffectChain() {
             ImDrawList* drawList = ImGui::GetWindowDrawList();
             
             // Effect name
-            ImU32 textColor = effect.isActive ? IM_COL32(255, 255, 255, 255) : IM_COL32(128, 128, 128, 255);
-            if (effect.isBypassed) textColor = IM_COL32(255, 128, 0, 255); // Orange for bypassed
+            ImU32 textColor = isActive ? IM_COL32(255, 255, 255, 255) : IM_COL32(128, 128, 128, 255);
+            if (isBypassed) textColor = IM_COL32(255, 128, 0, 255); // Orange for bypassed
             
-            drawList->AddText(ImVec2(pos.x + 5, pos.y + 5), textColor, effect.name.c_str());
-            drawList->AddText(ImVec2(pos.x + 5, pos.y + 18), IM_COL32(150, 150, 150, 255), effect.category.c_str());
+            drawList->AddText(ImVec2(pos.x + 5, pos.y + 5), textColor, descriptor.name);
+            drawList->AddText(ImVec2(pos.x + 5, pos.y + 18), IM_COL32(150, 150, 150, 255), category);
+
+            // Measured cost of this slot
+            if (_effectEngine && isActive && !isBypassed) {
+                const char* cost = gamma::core::getFrameArena().format("%.2f ms", _effectEngine->getSlotTimeMs(static_cast<size_t>(i)));
+                float categoryWidth = ImGui::CalcTextSize(category).x;
+                drawList->AddText(ImVec2(pos.x + 15 + categoryWidth, pos.y + 18), IM_COL32(0, 200, 255, 255), cost);
+            }
             
             // Control buttons (right side)
             ImGui::SetCursorPos(ImVec2(ImGui::GetCursorPosX() + ImGui::GetContentRegionAvail().x - 80, ImGui::GetCursorPosY() - 25));
             
-            if (ImGui::SmallButton(effect.isActive ? "ON" : "OFF")) {
-                effect.isActive = !effect.isActive;
+            if (ImGui::SmallButton(isActive ? "ON" : "OFF")) {
+                _chain.setActive(i, !isActive);
             }
             ImGui::SameLine();
             if (ImGui::SmallButton("BYP")) {
-                effect.isBypassed = !effect.isBypassed;
+                _chain.setBypassed(i, !isBypassed);
             }
             ImGui::SameLine();
             if (ImGui::SmallButton("X")) {
-                _activeEffects.erase(_activeEffects.begin() + i);
+                _chain.remove(i);
                 if (_selectedEffect >= i) _selectedEffect--;
                 ImGui::PopID();
                 break;
@@ -181,13 +186,17 @@ void EffectsPanel::renderEffectChain() {
     
     // Drop target for new effects
     ImGui::Separator();
-    ImGui::Text("Drop effects here or use Library tab");
+    if (_chain.full()) {
+        ImGui::TextDisabled("Chain is full (%d effects)", static_cast<int>(gamma::effects::EffectChain::MAX_SLOTS));
+    } else {
+        ImGui::Text("Drop effects here or use Library tab");
+    }
     
     if (ImGui::BeginDragDropTarget()) {
         if (const ImGuiPayload* payload = ImGui::AcceptDragDropPayload("EFFECT")) {
             int effectIndex = *static_cast<const int*>(payload->Data);
-            if (effectIndex >= 0 && effectIndex < static_cast<int>(_availableEffects.size())) {
-                _activeEffects.push_back(_availableEffects[effectIndex]);
+            if (effectIndex >= 0 && effectIndex < static_cast<int>(gamma::effects::EffectType::Count)) {
+                _chain.add(static_cast<gamma::effects::EffectType>(effectIndex), false);
             }
         }
         ImGui::EndDragDropTarget();
@@ -198,11 +207,15 @@ void EffectsPanel::renderEffectLibrary() {
     ImGui::Text("Effect Library");
     
     // Category filter
+    const int categoryCount = static_cast<int>(gamma::effects::EffectCategory::Count);
+    const char* selectedName = _selectedCategory < 0 ? "All"
+        : gamma::effects::getEffectCategoryName(static_cast<gamma::effects::EffectCategory>(_selectedCategory));
     ImGui::SetNextItemWidth(-1);
-    if (ImGui::BeginCombo("##Category", _selectedCategory.c_str())) {
-        for (const auto& category : _categories) {
-            bool isSelected = (_selectedCategory == category);
-            if (ImGui::Selectable(category.c_str(), isSelected)) {
+    if (ImGui::BeginCombo("##Category", selectedName)) {
+        for (int category = -1; category < categoryCount; ++category) {
+            const char* name = category < 0 ? "All"
+                : gamma::effects::getEffectCategoryName(static_cast<gamma::effects::EffectCategory>(category));
+            if (ImGui::Selectable(name, _selectedCategory == category)) {
                 _selectedCategory = category;
             }
         }
@@ -213,34 +226,35 @@ void EffectsPanel::renderEffectLibrary() {
     
     // Available effects
     if (ImGui::BeginChild("AvailableEffects")) {
-        for (int i = 0; i < static_cast<int>(_availableEffects.size()); ++i) {
-            const auto& effect = _availableEffects[i];
+        for (int i = 0; i < static_cast<int>(gamma::effects::EffectType::Count); ++i) {
+            const gamma::effects::EffectDescriptor& effect =
+                gamma::effects::getEffectDescriptor(static_cast<gamma::effects::EffectType>(i));
             
             // Filter by category
-            if (_selectedCategory != "All" && effect.category != _selectedCategory) {
+            if (_selectedCategory >= 0 && static_cast<int>(effect.category) != _selectedCategory) {
                 continue;
             }
             
             ImGui::PushID(i);
             
-            if (ImGui::Button(("+ " + effect.name).c_str(), ImVec2(-1, 0))) {
-                _activeEffects.push_back(effect);
-                _activeEffects.back().isActive = true;
+            const char* label = gamma::core::getFrameArena().format("+ %s", effect.name);
+            if (ImGui::Button(label, ImVec2(-1, 0))) {
+                _chain.add(effect.type, true);
             }
             
             // Drag source
             if (ImGui::BeginDragDropSource()) {
                 ImGui::SetDragDropPayload("EFFECT", &i, sizeof(int));
-                ImGui::Text("Adding: %s", effect.name.c_str());
+                ImGui::Text("Adding: %s", effect.name);
                 ImGui::EndDragDropSource();
             }
             
             // Show effect info on hover
             if (ImGui::IsItemHovered()) {
                 ImGui::BeginTooltip();
-                ImGui::Text("Effect: %s", effect.name.c_str());
-                ImGui::Text("Category: %s", effect.category.c_str());
-                ImGui::Text("Parameters: %d", static_cast<int>(effect.parameters.size()));
+                ImGui::Text("Effect: %s", effect.name);
+                ImGui::Text("Category: %s", gamma::effects::getEffectCategoryName(effect.category));
+                ImGui::Text("Parameters: %d", effect.parameterCount);
                 ImGui::EndTooltip();
             }
             
@@ -251,40 +265,54 @@ void EffectsPanel::renderEffectLibrary() {
 }
 
 void EffectsPanel::renderParameterControls() {
-    if (_selectedEffect >= 0 && _selectedEffect < static_cast<int>(_activeEffects.size())) {
-        auto& effect = _activeEffects[_selectedEffect];
+    if (_selectedEffect >= 0 && _selectedEffect < static_cast<int>(_chain.size())) {
+        const size_t slot = static_cast<size_t>(_selectedEffect);
+        const gamma::effects::EffectDescriptor& effect = _chain.getDescriptor(slot);
         
-        ImGui::Text("Parameters: %s", effect.name.c_str());
+        ImGui::Text("Parameters: %s", effect.name);
         ImGui::Separator();
         
         if (ImGui::BeginChild("Parameters")) {
-            for (auto& param : effect.parameters) {
-                ImGui::PushID(&param);
+            for (int p = 0; p < effect.parameterCount; ++p) {
+                const gamma::effects::ParameterDescriptor& param = effect.getParameter(p);
+                float& value = _chain.value(slot, p);
+                ImGui::PushID(p);
                 
-                if (param.isEnabled) {
-                    ImGui::Text("%s:", param.name.c_str());
+                if (_chain.isParameterEnabled(slot, p)) {
+                    ImGui::Text("%s:", param.name);
                     
-                    // Different control types based on parameter range
-                    if (param.maxValue - param.minValue <= 5.0f && param.minValue >= 0.0f) {
-                        // Integer slider for small ranges
-                        int intValue = static_cast<int>(param.value);
+                    if (param.discrete) {
+                        // Modes and counts: whole numbers only
+                        int intValue = static_cast<int>(value);
                         if (ImGui::SliderInt("##param", &intValue, 
                                            static_cast<int>(param.minValue), 
                                            static_cast<int>(param.maxValue))) {
-                            param.value = static_cast<float>(intValue);
+                            value = static_cast<float>(intValue);
                         }
                     } else {
                         // Float slider
-                        ImGui::SliderFloat("##param", &param.value, param.minValue, param.maxValue);
+                        ImGui::SliderFloat("##param", &value, param.minValue, param.maxValue);
                     }
                     
                     // Reset button
                     ImGui::SameLine();
                     if (ImGui::SmallButton("R")) {
-                        param.value = param.defaultValue;
+                        _chain.resetParameter(slot, p);
+                    }
+
+                    // Looks are picked by index into the LUT library
+                    if (effect.type == gamma::effects::EffectType::ColorLut && p == 0) {
+                        const std::string look = gamma::effects::getLutLibrary().getName(static_cast<int>(value + 0.5f));
+                        ImGui::TextDisabled("%s", look.empty() ? "(no look loaded)" : look.c_str());
+                    }
+
+                    // Engine-side slew towards new values
+                    if (!param.discrete) {
+                        ImGui::SetNextItemWidth(-1);
+                        ImGui::SliderFloat("##smoothing", &_chain.smoothing(slot, p), 0.0f, 1.0f, "Smoothing %.2f s");
                     }
                 } else {
-                    ImGui::TextDisabled("%s: (disabled)", param.name.c_str());
+                    ImGui::TextDisabled("%s: (disabled)", param.name);
                 }
                 
                 ImGui::PopID();
@@ -1,6 +1,9 @@
 #include "ui/ImportPanel.h"
 #include "ui/WorkspaceManager.h"
+#include "core/FrameArena.h"
 #include "imgui.h"
+#include <algorithm>
+#include <cctype>
 #include <filesystem>
 
 namespace gamma {
@@ -9,10 +12,12 @@ namespace ui {
 ImportPanel::ImportPanel()
     : WorkspacePanel("Import")
     , _selectedItem(-1)
+    , _searchBuffer()
     , _currentPath("C:\\")
     , _autoLoadMedia(true)
     , _showPreview(true)
-    , _previewVolume(0.5f) {
+    , _previewVolume(0.5f)
+    , _loadedCount(0) {
     
     // Populate sample media items
     _mediaItems = {
@@ -25,6 +30,9 @@ ImportPanel::ImportPanel()
     
     // Initialize directory contents
     _directoryContents = {"Videos\\", "Audio\\", "Effects\\", "Textures\\", "sample.mp4", "test.wav"};
+
+    // The lists only change on edits, which mark the panel dirty
+    setUpdatePolicy(UpdatePolicy::OnChange);
 }
 
 void ImportPanel::render() {
@@ -48,7 +56,7 @@ void ImportPanel::render() {
                             ImGuiWindowFlags_NoCollapse |
                             ImGuiWindowFlags_NoTitleBar;
     
-    if (ImGui::Begin("Import", &_visible, flags)) {
+    if (beginWindow("Import", flags)) {
         renderImportControls();
         ImGui::Separator();
         
@@ -75,8 +83,32 @@ void ImportPanel::render() {
     ImGui::End();
 }
 
-void ImportPanel::update(float deltaTime) {
-    // Update any preview animations or loading states
+void ImportPanel::update(float /*deltaTime*/) {
+    // Library items matching the search, case-insensitively
+    const std::string search = _searchBuffer;
+    auto matches = [&search](const std::string& name) {
+        auto it = std::search(name.begin(), name.end(), search.begin(), search.end(), [](char a, char b) {
+            return std::tolower(static_cast<unsigned char>(a)) == std::tolower(static_cast<unsigned char>(b));
+        });
+        return it != name.end() || search.empty();
+    };
+    _visibleItems.clear();
+    _loadedCount = 0;
+    for (int i = 0; i < static_cast<int>(_mediaItems.size()); ++i) {
+        if (matches(_mediaItems[i].name)) {
+            _visibleItems.push_back(i);
+        }
+        if (_mediaItems[i].isLoaded) {
+            ++_loadedCount;
+        }
+    }
+
+    // Browser labels, formatted once rather than every frame
+    _directoryLabels.resize(_directoryContents.size());
+    for (size_t i = 0; i < _directoryContents.size(); ++i) {
+        const std::string& item = _directoryContents[i];
+        _directoryLabels[i] = (!item.empty() && item.back() == '\\' ? "[DIR] " : "[FILE] ") + item;
+    }
 }
 
 void ImportPanel::renderImportControls() {
@@ -97,15 +129,19 @@ void ImportPanel::renderMediaLibrary() {
     ImGui::Text("Media Library (%d items)", static_cast<int>(_mediaItems.size()));
     
     // Filter/search bar
-    static char searchBuffer[256] = "";
     ImGui::SetNextItemWidth(-1);
-    ImGui::InputTextWithHint("##search", "Search media...", searchBuffer, sizeof(searchBuffer));
+    if (ImGui::InputTextWithHint("##search", "Search media...", _searchBuffer, sizeof(_searchBuffer))) {
+        markDirty();
+    }
     
     ImGui::Separator();
     
-    // Media items list
+    // Media items list (as filtered by update())
     if (ImGui::BeginChild("MediaList", ImVec2(0, -60))) {
-        for (int i = 0; i < static_cast<int>(_mediaItems.size()); ++i) {
+        for (int i : _visibleItems) {
+            if (i >= static_cast<int>(_mediaItems.size())) {
+                continue;
+            }
             const auto& item = _mediaItems[i];
             
             bool isSelected = (_selectedItem == i);
@@ -137,16 +173,25 @@ void ImportPanel::renderMediaLibrary() {
             if (ImGui::BeginPopupContextItem()) {
                 if (ImGui::MenuItem("Load")) {
                     _mediaItems[i].isLoaded = true;
+                    markDirty();
                 }
                 if (ImGui::MenuItem("Unload")) {
                     _mediaItems[i].isLoaded = false;
+                    markDirty();
                 }
                 ImGui::Separator();
+                bool removed = false;
                 if (ImGui::MenuItem("Remove")) {
                     _mediaItems.erase(_mediaItems.begin() + i);
                     if (_selectedItem >= i) _selectedItem--;
+                    markDirty();
+                    removed = true;
                 }
                 ImGui::EndPopup();
+                if (removed) {
+                    // Later indices have shifted; the list is rebuilt next frame
+                    break;
+                }
             }
         }
     }
@@ -154,11 +199,7 @@ void ImportPanel::renderMediaLibrary() {
     
     // Status bar
     ImGui::Separator();
-    int loadedCount = 0;
-    for (const auto& item : _mediaItems) {
-        if (item.isLoaded) loadedCount++;
-    }
-    ImGui::Text("Loaded: %d/%d", loadedCount, static_cast<int>(_mediaItems.size()));
+    ImGui::Text("Loaded: %d/%d", _loadedCount, static_cast<int>(_mediaItems.size()));
 }
 
 void ImportPanel::renderFileExplorer() {
@@ -172,6 +213,7 @@ void ImportPanel::renderFileExplorer() {
         size_t lastSlash = _currentPath.find_last_of("\\/");
         if (lastSlash != std::string::npos) {
             _currentPath = _currentPath.substr(0, lastSlash + 1);
+            markDirty();
         }
     }
     
@@ -179,17 +221,20 @@ void ImportPanel::renderFileExplorer() {
     
     // Directory contents
     if (ImGui::BeginChild("FileList")) {
-        for (const auto& item : _directoryContents) {
-            bool isDirectory = item.back() == '\\';
+        const size_t count = std::min(_directoryContents.size(), _directoryLabels.size());
+        for (size_t i = 0; i < count; ++i) {
+            const std::string& item = _directoryContents[i];
+            bool isDirectory = !item.empty() && item.back() == '\\';
             
             if (isDirectory) {
                 ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(1.0f, 1.0f, 0.0f, 1.0f)); // Yellow for folders
-                if (ImGui::Selectable(("[DIR] " + item).c_str())) {
+                if (ImGui::Selectable(_directoryLabels[i].c_str())) {
                     _currentPath += item;
+                    markDirty();
                 }
                 ImGui::PopStyleColor();
             } else {
-                if (ImGui::Selectable(("[FILE] " + item).c_str())) {
+                if (ImGui::Selectable(_directoryLabels[i].c_str())) {
                     // TODO: Add to import queue or preview
                 }
                 
@@ -226,7 +271,7 @@ void ImportPanel::renderMediaPreview() {
             drawList->AddText(ImVec2(previewStart.x + 10, previewStart.y + 10), 
                              IM_COL32(200, 200, 200, 255), "Video Preview");
             drawList->AddText(ImVec2(previewStart.x + 10, previewStart.y + 30), 
-                             IM_COL32(150, 150, 150, 255), ("Duration: " + std::to_string(item.duration) + "s").c_str());
+                             IM_COL32(150, 150, 150, 255), gamma::core::getFrameArena().format("Duration: %fs", item.duration));
         } else {
             drawList->AddText(ImVec2(previewStart.x + 10, previewStart.y + 10), 
                              IM_COL32(200, 200, 200, 255), "Audio Waveform");
@@ -1,15 +1,16 @@
 #include "ui/MainContainer.h"
 #include "ui/WorkspaceManager.h"
 #include "core/Application.h"
-#include "midi/MidiManager.h"
+#include "core/Math.h"
+#include "ui/MidiSetupView.h"
+#include "effects/Frame.h"
 #include "imgui.h"
-#include <cmath>
+#include <GLFW/glfw3.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
 #include <iostream>
 
-#ifndef M_PI
-#define M_PI 3.14159265358979323846
-#endif
-
 namespace gamma {
 namespace ui {
 
@@ -19,22 +20,21 @@ MainContainer::MainContainer()
     , _showWaveform(true)
     , _showMonitoring(true)
     , _outputLevel(0.75f)
-    , _selectedDevice(0)
-    , _isConnected(false)
-    , _jogWheelLeftRotation(0.0f)
-    , _jogWheelRightRotation(0.0f) {
+    , _midiViewModel(nullptr) {
+    // update() only animates the output level meter
+    setUpdatePolicy(UpdatePolicy::FixedRate, 30.0f);
+}
+
+MainContainer::~MainContainer() {
+    releaseTextures();
 }
 
 void MainContainer::setApplication(gamma::core::Application* app) {
     _application = app;
-    
-    // Set up jog wheel callback with MIDI manager
-    if (_application && _application->getMidiManager()) {
-        auto callback = [this](int channel, float deltaRotation) {
-            this->updateJogWheelRotation(channel, deltaRotation);
-        };
-        _application->getMidiManager()->setJogWheelCallback(callback);
-    }
+}
+
+void MainContainer::setMidiViewModel(MidiViewModel* viewModel) {
+    _midiViewModel = viewModel;
 }
 
 void MainContainer::render() {
@@ -64,7 +64,7 @@ void MainContainer::render() {
                             ImGuiWindowFlags_NoCollapse |
                             ImGuiWindowFlags_NoTitleBar;
     
-    if (ImGui::Begin("Main Container", &_visible, flags)) {
+    if (beginWindow("Main Container", flags)) {
         // Create tabbed interface
         if (ImGui::BeginTabBar("MainTabs", ImGuiTabBarFlags_None)) {
             
@@ -90,7 +90,7 @@ void MainContainer::update(float deltaTime) {
     // Simulate output level fluctuation
     static float time = 0.0f;
     time += deltaTime;
-    _outputLevel = 0.5f + 0.3f * sinf(time * 2.0f);
+    _outputLevel = 0.5f + 0.3f * core::sin(time * 2.0f);
 }
 
 void MainContainer::renderOutputControls() {
@@ -119,20 +119,36 @@ void MainContainer::renderOutputControls() {
 
 void MainContainer::renderVideoOutput() {
     // Get available content area
-    ImVec2 contentStart = ImGui::GetCursorPos();
     ImVec2 contentSize = ImGui::GetContentRegionAvail();
     contentSize.y -= 60; // Leave space for overlays
     
     // Create an invisible button to define the video area
     ImGui::InvisibleButton("VideoArea", contentSize);
     
-    // Draw video placeholder using draw list
     ImVec2 videoStart = ImGui::GetItemRectMin();
     ImVec2 videoEnd = ImGui::GetItemRectMax();
     ImDrawList* drawList = ImGui::GetWindowDrawList();
     
     // Background
     drawList->AddRectFilled(videoStart, videoEnd, IM_COL32(20, 20, 20, 255));
+
+    const gamma::effects::EffectEngine* engine = _application ? _application->getEffectEngine() : nullptr;
+    if (engine && !engine->getPreview().empty()) {
+        // The monitor shows the engine's preview tap, letterboxed to the area
+        const gamma::effects::Frame& preview = _application->getEffectPreview();
+        uploadFrame(_previewTexture, preview);
+
+        const float scale = std::min(contentSize.x / static_cast<float>(preview.getWidth()),
+                                     contentSize.y / static_cast<float>(preview.getHeight()));
+        const ImVec2 imageSize(preview.getWidth() * scale, preview.getHeight() * scale);
+        const ImVec2 imageStart(videoStart.x + (contentSize.x - imageSize.x) * 0.5f,
+                                videoStart.y + (contentSize.y - imageSize.y) * 0.5f);
+        drawList->AddImage((ImTextureID)(intptr_t)_previewTexture.id, imageStart,
+                           ImVec2(imageStart.x + imageSize.x, imageStart.y + imageSize.y));
+
+        renderThumbnails(videoStart.x, videoStart.y, videoEnd.x, videoEnd.y);
+        return;
+    }
     
     // Video placeholder content
     ImVec2 center = ImVec2(videoStart.x + contentSize.x * 0.5f, 
@@ -156,6 +172,90 @@ void MainContainer::renderVideoOutput() {
                      "Awaiting video input...");
 }
 
+void MainContainer::renderThumbnails(float left, float top, float right, float bottom) {
+    const gamma::effects::ChainThumbnails& thumbnails = _application->getEffectThumbnails();
+    const size_t count = thumbnails.getCount();
+    _thumbnailTextures.resize(std::max(count, _thumbnailTextures.size()));
+    if (count == 0) {
+        return;
+    }
+
+    // A strip along the bottom edge, one thumbnail per slot in chain order
+    const float margin = 6.0f;
+    const float thumbnailHeight = std::min(72.0f, (bottom - top) * 0.2f);
+    const gamma::effects::Frame& first = thumbnails.getThumbnail(0);
+    if (first.empty() || thumbnailHeight < 16.0f) {
+        return;
+    }
+    const float thumbnailWidth = thumbnailHeight * first.getWidth() / static_cast<float>(first.getHeight());
+
+    ImDrawList* drawList = ImGui::GetWindowDrawList();
+    ImVec2 position(left + margin, bottom - margin - thumbnailHeight);
+    for (size_t slot = 0; slot < count; ++slot) {
+        if (position.x + thumbnailWidth > right - margin) {
+            break;
+        }
+        uploadFrame(_thumbnailTextures[slot], thumbnails.getThumbnail(slot));
+
+        const ImVec2 end(position.x + thumbnailWidth, position.y + thumbnailHeight);
+        drawList->AddImage((ImTextureID)(intptr_t)_thumbnailTextures[slot].id, position, end);
+        drawList->AddRect(position, end, IM_COL32(0, 200, 255, 160));
+
+        char label[24];
+        std::snprintf(label, sizeof(label), "%zu", slot + 1);
+        drawList->AddText(ImVec2(position.x + 3.0f, position.y + 2.0f), IM_COL32(255, 255, 255, 220), label);
+        position.x += thumbnailWidth + margin;
+    }
+}
+
+void MainContainer::uploadFrame(FrameTexture& texture, const gamma::effects::Frame& frame) {
+    // Engine outputs are RGBA8; float intermediates never reach the screen
+    if (frame.empty() || frame.getFormat() != gamma::effects::PixelFormat::RGBA8) {
+        return;
+    }
+    const bool resized = frame.getWidth() != texture.width || frame.getHeight() != texture.height;
+    if (texture.id != 0 && !resized && frame.getContentId() != 0 && frame.getContentId() == texture.contentId) {
+        return;
+    }
+
+    if (texture.id == 0) {
+        glGenTextures(1, &texture.id);
+        glBindTexture(GL_TEXTURE_2D, texture.id);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    } else {
+        glBindTexture(GL_TEXTURE_2D, texture.id);
+    }
+
+    // Frame pixels are RGBA bytes in memory; rows are padded to the frame's stride
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, static_cast<int>(frame.getStride()));
+    if (resized) {
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, frame.getWidth(), frame.getHeight(), 0,
+                     GL_RGBA, GL_UNSIGNED_BYTE, frame.data());
+    } else {
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, frame.getWidth(), frame.getHeight(),
+                        GL_RGBA, GL_UNSIGNED_BYTE, frame.data());
+    }
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+
+    texture.width = frame.getWidth();
+    texture.height = frame.getHeight();
+    texture.contentId = frame.getContentId();
+}
+
+void MainContainer::releaseTextures() {
+    if (_previewTexture.id != 0) {
+        glDeleteTextures(1, &_previewTexture.id);
+    }
+    _previewTexture = FrameTexture();
+    for (FrameTexture& texture : _thumbnailTextures) {
+        if (texture.id != 0) {
+            glDeleteTextures(1, &texture.id);
+        }
+    }
+    _thumbnailTextures.clear();
+}
+
 void MainContainer::renderWaveformOverlay() {
     ImGui::Text("[WAV] Audio Waveform");
     ImGui::SameLine();
@@ -176,7 +276,7 @@ void MainContainer::renderWaveformOverlay() {
     // Draw simple waveform
     for (int i = 0; i < static_cast<int>(waveSize.x); i += 2) {
         float phase = i * 0.1f;
-        float amplitude = _outputLevel * sinf(phase) * 10.0f;
+        float amplitude = _outputLevel * core::sin(phase) * 10.0f;
         float y = waveStart.y + waveSize.y * 0.5f + amplitude;
         
         drawList->AddLine(ImVec2(waveStart.x + i, waveStart.y + waveSize.y * 0.5f),
@@ -195,7 +295,19 @@ void MainContainer::renderMonitoringInfo() {
     try {
         ImGui::Text("[INFO] Output Level: %.1f%%", _outputLevel * 100.0f);
         ImGui::SameLine();
-        ImGui::Text("| FPS: 60 | Res: 3440x1440 | Format: RGB24");
+        const gamma::effects::EffectEngine* engine = _application ? _application->getEffectEngine() : nullptr;
+        if (engine) {
+            // Program, preview tap and thumbnails are costed separately
+            const gamma::effects::Frame& program = _application->getEffectOutput();
+            const gamma::effects::Frame& preview = engine->getPreview();
+            ImGui::Text("| FPS: %.0f | Program: %dx%d %.2f ms | Preview: %dx%d %.2f ms | Thumbnails: %.2f ms | Format: %s",
+                        ImGui::GetIO().Framerate, program.getWidth(), program.getHeight(), engine->getProcessTimeMs(),
+                        preview.getWidth(), preview.getHeight(), engine->getPreviewTimeMs(),
+                        _application->getEffectThumbnails().getRenderTimeMs(),
+                        gamma::effects::getPixelFormatName(engine->getIntermediateFormat()));
+        } else {
+            ImGui::Text("| FPS: %.0f | No effect engine", ImGui::GetIO().Framerate);
+        }
     } catch (...) {
         // Fallback if there's any rendering issue
         ImGui::Text("[INFO] Monitoring data unavailable");
@@ -228,262 +340,10 @@ void MainContainer::renderMidiSetupTab() {
     
     ImGui::Separator();
     
-    // Get MIDI manager if available
-    gamma::midi::MidiManager* midiManager = nullptr;
-    if (_application) {
-        midiManager = _application->getMidiManager();
-    }
-    
-    // Create child regions for organized layout
-    ImVec2 availableSize = ImGui::GetContentRegionAvail();
-    float leftPanelWidth = availableSize.x * 0.4f;
-    float rightPanelWidth = availableSize.x * 0.6f - 10.0f; // 10px spacing
-    
-    // Left panel - Device and control info
-    if (ImGui::BeginChild("MidiLeftPanel", ImVec2(leftPanelWidth, 0), true)) {
-        renderMidiDeviceSelection();
-        ImGui::Spacing();
-        renderMidiControlMapping();
-        ImGui::Spacing();
-        renderMidiStatus();
-        ImGui::Spacing();
-        renderMidiConfigButtons();
-    }
-    ImGui::EndChild();
-    
-    ImGui::SameLine();
-    
-    // Right panel - Signal log
-    if (ImGui::BeginChild("MidiRightPanel", ImVec2(rightPanelWidth, 0), true)) {
-        renderMidiSignalLog();
-    }
-    ImGui::EndChild();
-}
-
-void MainContainer::renderMidiDeviceSelection() {
-    ImGui::TextColored(ImVec4(0.8f, 0.8f, 0.8f, 1.0f), "Device Selection:");
-    
-    // Get available devices from MIDI manager
-    gamma::midi::MidiManager* midiManager = nullptr;
-    if (_application) {
-        midiManager = _application->getMidiManager();
-    }
-    
-    std::vector<std::string> deviceNames;
-    if (midiManager) {
-        deviceNames = midiManager->getAvailableDevices();
-    }
-    
-    if (deviceNames.empty()) {
-        deviceNames.push_back("No devices detected");
-    }
-    
-    // Convert to const char* array for ImGui combo
-    std::vector<const char*> deviceCStrs;
-    for (const auto& name : deviceNames) {
-        deviceCStrs.push_back(name.c_str());
-    }
-    
-    if (ImGui::Combo("MIDI Device", &_selectedDevice, deviceCStrs.data(), static_cast<int>(deviceCStrs.size()))) {
-        // Device selection changed
-        _isConnected = false;
-    }
-    
-    ImGui::SameLine();
-    if (ImGui::Button("Refresh")) {
-        if (midiManager) {
-            midiManager->refreshDevices();
-        }
-    }
-    
-    ImGui::SameLine();
-    if (ImGui::Button(_isConnected ? "Disconnect" : "Connect")) {
-        if (midiManager && !deviceNames.empty() && _selectedDevice < static_cast<int>(deviceNames.size())) {
-            if (!_isConnected) {
-                std::string deviceName = deviceNames[_selectedDevice];
-                if (deviceName != "No devices detected") {
-                    _isConnected = midiManager->connectToDevice(deviceName);
-                }
-            } else {
-                midiManager->disconnect();
-                _isConnected = false;
-            }
-        }
-    }
-}
-
-void MainContainer::renderMidiControlMapping() {
-    ImGui::TextColored(ImVec4(0.8f, 0.8f, 0.8f, 1.0f), "Jog Wheel Visualization:");
-    
-    // Create columns for side-by-side wheels
-    ImGui::Columns(2, "JogWheels", false);
-    
-    // Left jog wheel (Channel 1)
-    ImGui::Text("Left Wheel (Ch1):");
-    ImVec2 leftCenter = ImGui::GetCursorScreenPos();
-    leftCenter.x += 80;
-    leftCenter.y += 80;
-    float radius = 60.0f;
-    
-    ImDrawList* drawList = ImGui::GetWindowDrawList();
-    
-    // Draw left wheel
-    drawList->AddCircle(leftCenter, radius, IM_COL32(100, 100, 100, 255), 32, 3.0f);
-    drawList->AddCircleFilled(leftCenter, radius - 10, IM_COL32(30, 30, 30, 255), 32);
-    
-    // Left wheel rotation indicator
-    float leftRotationRad = _jogWheelLeftRotation * (M_PI / 180.0f);
-    ImVec2 leftIndicatorPos = ImVec2(
-        leftCenter.x + cos(leftRotationRad - M_PI/2) * (radius - 20),
-        leftCenter.y + sin(leftRotationRad - M_PI/2) * (radius - 20)
-    );
-    
-    drawList->AddLine(leftCenter, leftIndicatorPos, IM_COL32(0, 200, 255, 255), 3.0f);
-    drawList->AddCircleFilled(leftIndicatorPos, 4.0f, IM_COL32(0, 255, 200, 255), 12);
-    
-    // Reserve space for the left wheel
-    ImGui::Dummy(ImVec2(160, 160));
-    ImGui::Text("%.1f°", _jogWheelLeftRotation);
-    
-    // Move to right column
-    ImGui::NextColumn();
-    
-    // Right jog wheel (Channel 2)
-    ImGui::Text("Right Wheel (Ch2):");
-    ImVec2 rightCenter = ImGui::GetCursorScreenPos();
-    rightCenter.x += 80;
-    rightCenter.y += 80;
-    
-    // Draw right wheel
-    drawList->AddCircle(rightCenter, radius, IM_COL32(100, 100, 100, 255), 32, 3.0f);
-    drawList->AddCircleFilled(rightCenter, radius - 10, IM_COL32(30, 30, 30, 255), 32);
-    
-    // Right wheel rotation indicator
-    float rightRotationRad = _jogWheelRightRotation * (M_PI / 180.0f);
-    ImVec2 rightIndicatorPos = ImVec2(
-        rightCenter.x + cos(rightRotationRad - M_PI/2) * (radius - 20),
-        rightCenter.y + sin(rightRotationRad - M_PI/2) * (radius - 20)
-    );
-    
-    drawList->AddLine(rightCenter, rightIndicatorPos, IM_COL32(255, 100, 0, 255), 3.0f);
-    drawList->AddCircleFilled(rightIndicatorPos, 4.0f, IM_COL32(255, 150, 0, 255), 12);
-    
-    // Reserve space for the right wheel
-    ImGui::Dummy(ImVec2(160, 160));
-    ImGui::Text("%.1f°", _jogWheelRightRotation);
-    
-    // End columns
-    ImGui::Columns(1);
-}
-
-void MainContainer::renderMidiStatus() {
-    ImGui::TextColored(ImVec4(0.8f, 0.8f, 0.8f, 1.0f), "Status:");
-    
-    if (_isConnected) {
-        ImGui::TextColored(ImVec4(0.3f, 1.0f, 0.3f, 1.0f), "● Connected");
-        ImGui::Text("Ready for MIDI input");
+    if (_midiViewModel) {
+        MidiSetupView::render(*_midiViewModel);
     } else {
-        ImGui::TextColored(ImVec4(1.0f, 0.3f, 0.3f, 1.0f), "● Disconnected");
-        ImGui::Text("Select and connect a device");
-    }
-}
-
-void MainContainer::renderMidiSignalLog() {
-    ImGui::TextColored(ImVec4(0.8f, 0.8f, 0.8f, 1.0f), "MIDI Signal Log:");
-    
-    // Create scrolling region for MIDI messages
-    if (ImGui::BeginChild("MidiLog", ImVec2(0, -30), false, ImGuiWindowFlags_HorizontalScrollbar)) {
-        gamma::midi::MidiManager* midiManager = nullptr;
-        if (_application) {
-            midiManager = _application->getMidiManager();
-        }
-        
-        if (midiManager) {
-            auto recentMessages = midiManager->getRecentMessages();
-            
-            if (recentMessages.empty()) {
-                ImGui::TextColored(ImVec4(0.6f, 0.6f, 0.6f, 1.0f), "No MIDI messages received yet...");
-                ImGui::TextColored(ImVec4(0.6f, 0.6f, 0.6f, 1.0f), "Connect a device and move some controls!");
-            } else {
-                // Display messages in reverse order (newest first)
-                for (auto it = recentMessages.rbegin(); it != recentMessages.rend(); ++it) {
-                    const auto& msg = *it;
-                    
-                    // Color code by message type
-                    ImVec4 color = ImVec4(1.0f, 1.0f, 1.0f, 1.0f); // Default white
-                    if (!msg.data.empty()) {
-                        unsigned char msgType = msg.data[0] & 0xF0; // Extract message type
-                        
-                        if (msgType == 0x90 || msgType == 0x80) { // Note on/off
-                            color = ImVec4(0.3f, 1.0f, 0.3f, 1.0f); // Green for notes
-                        } else if (msgType == 0xB0) { // Control change
-                            color = ImVec4(0.3f, 0.8f, 1.0f, 1.0f); // Cyan for CCs
-                        } else if (msgType == 0xE0) { // Pitch bend
-                            color = ImVec4(1.0f, 0.8f, 0.3f, 1.0f); // Orange for pitch bend
-                        }
-                    }
-                    
-                    // Format timestamp as string
-                    char timeStr[32];
-                    snprintf(timeStr, sizeof(timeStr), "%.3f", msg.timestamp);
-                    
-                    // Create message string for display
-                    std::string fullMessage = "[" + std::string(timeStr) + "] " + msg.description;
-                    
-                    // Simple colored text that can be selected normally
-                    ImGui::PushStyleColor(ImGuiCol_Text, color);
-                    ImGui::TextUnformatted(fullMessage.c_str());
-                    ImGui::PopStyleColor();
-                }
-                
-                // Auto-scroll to bottom for new messages
-                if (ImGui::GetScrollY() >= ImGui::GetScrollMaxY()) {
-                    ImGui::SetScrollHereY(1.0f);
-                }
-            }
-        } else {
-            ImGui::TextColored(ImVec4(1.0f, 0.3f, 0.3f, 1.0f), "MIDI system not available");
-        }
-    }
-    ImGui::EndChild();
-}
-
-void MainContainer::renderMidiConfigButtons() {
-    // Simplified controls - clear log and export CSV
-    if (ImGui::Button("Clear Log", ImVec2(-1, 0))) {
-        if (_application && _application->getMidiManager()) {
-            _application->getMidiManager()->clearMessageHistory();
-        }
-    }
-    
-    if (ImGui::Button("Export CSV", ImVec2(-1, 0))) {
-        if (_application && _application->getMidiManager()) {
-            _application->getMidiManager()->exportToCSV();
-        }
-    }
-}
-
-void MainContainer::updateJogWheelRotation(int channel, float deltaRotation) {
-    if (channel == 1) {
-        _jogWheelLeftRotation += deltaRotation;
-        
-        // Keep rotation in 0-360 degree range
-        while (_jogWheelLeftRotation >= 360.0f) {
-            _jogWheelLeftRotation -= 360.0f;
-        }
-        while (_jogWheelLeftRotation < 0.0f) {
-            _jogWheelLeftRotation += 360.0f;
-        }
-    } else if (channel == 2) {
-        _jogWheelRightRotation += deltaRotation;
-        
-        // Keep rotation in 0-360 degree range
-        while (_jogWheelRightRotation >= 360.0f) {
-            _jogWheelRightRotation -= 360.0f;
-        }
-        while (_jogWheelRightRotation < 0.0f) {
-            _jogWheelRightRotation += 360.0f;
-        }
+        ImGui::TextColored(ImVec4(1.0f, 0.3f, 0.3f, 1.0f), "MIDI system not available");
     }
 }
 
@@ -0,0 +1,127 @@
+#include "ui/MidiSetupView.h"
+#include "core/Math.h"
+#include "imgui.h"
+
+namespace gamma {
+namespace ui {
+
+void MidiSetupView::render(MidiViewModel& viewModel) {
+    // Create child regions for organized layout
+    ImVec2 availableSize = ImGui::GetContentRegionAvail();
+    float leftPanelWidth = availableSize.x * 0.4f;
+    float rightPanelWidth = availableSize.x * 0.6f - 10.0f; // 10px spacing
+    
+    // Left panel - Device and control info
+    if (ImGui::BeginChild("MidiLeftPanel", ImVec2(leftPanelWidth, 0), true)) {
+        renderDeviceSelection(viewModel);
+        ImGui::Spacing();
+        renderJogWheels(viewModel);
+        ImGui::Spacing();
+        renderStatus(viewModel);
+        ImGui::Spacing();
+        renderConfigButtons(viewModel);
+    }
+    ImGui::EndChild();
+    
+    ImGui::SameLine();
+    
+    // Right panel - Signal log
+    if (ImGui::BeginChild("MidiRightPanel", ImVec2(rightPanelWidth, 0), true)) {
+        viewModel.getSignalLog().render(viewModel.isAvailable());
+    }
+    ImGui::EndChild();
+}
+
+void MidiSetupView::renderDeviceSelection(MidiViewModel& viewModel) {
+    ImGui::TextColored(ImVec4(0.8f, 0.8f, 0.8f, 1.0f), "Device Selection:");
+    
+    int selectedDevice = viewModel.getSelectedDevice();
+    if (ImGui::Combo("MIDI Device", &selectedDevice, viewModel.getDeviceNameList(), viewModel.getDeviceCount())) {
+        viewModel.setSelectedDevice(selectedDevice);
+    }
+    
+    ImGui::SameLine();
+    if (ImGui::Button("Refresh")) {
+        viewModel.refreshDevices();
+    }
+    
+    ImGui::SameLine();
+    if (ImGui::Button(viewModel.isConnected() ? "Disconnect" : "Connect")) {
+        if (viewModel.isConnected()) {
+            viewModel.disconnect();
+        } else if (viewModel.hasDevices()) {
+            viewModel.connectSelectedDevice();
+        }
+    }
+}
+
+void MidiSetupView::renderJogWheels(const MidiViewModel& viewModel) {
+    ImGui::TextColored(ImVec4(0.8f, 0.8f, 0.8f, 1.0f), "Jog Wheel Visualization:");
+    
+    // Create columns for side-by-side wheels
+    ImGui::Columns(2, "JogWheels", false);
+    renderJogWheel("Left Wheel (Ch1):", viewModel.getJogAngle(1), IM_COL32(0, 200, 255, 255), IM_COL32(0, 255, 200, 255));
+    ImGui::NextColumn();
+    renderJogWheel("Right Wheel (Ch2):", viewModel.getJogAngle(2), IM_COL32(255, 100, 0, 255), IM_COL32(255, 150, 0, 255));
+    ImGui::Columns(1);
+}
+
+void MidiSetupView::renderJogWheel(const char* label, float angleDegrees, unsigned int lineColor, unsigned int tipColor) {
+    ImGui::Text("%s", label);
+    ImVec2 center = ImGui::GetCursorScreenPos();
+    center.x += 80;
+    center.y += 80;
+    float radius = 60.0f;
+    
+    ImDrawList* drawList = ImGui::GetWindowDrawList();
+    
+    // Draw wheel
+    drawList->AddCircle(center, radius, IM_COL32(100, 100, 100, 255), 32, 3.0f);
+    drawList->AddCircleFilled(center, radius - 10, IM_COL32(30, 30, 30, 255), 32);
+    
+    // Rotation indicator
+    float rotationRad = angleDegrees * static_cast<float>(core::PI / 180.0);
+    ImVec2 indicatorPos = ImVec2(
+        center.x + core::cos(rotationRad - static_cast<float>(core::PI / 2)) * (radius - 20),
+        center.y + core::sin(rotationRad - static_cast<float>(core::PI / 2)) * (radius - 20)
+    );
+    
+    drawList->AddLine(center, indicatorPos, lineColor, 3.0f);
+    drawList->AddCircleFilled(indicatorPos, 4.0f, tipColor, 12);
+    
+    // Reserve space for the wheel
+    ImGui::Dummy(ImVec2(160, 160));
+    ImGui::Text("%.1f°", angleDegrees);
+}
+
+void MidiSetupView::renderStatus(const MidiViewModel& viewModel) {
+    ImGui::TextColored(ImVec4(0.8f, 0.8f, 0.8f, 1.0f), "Status:");
+    
+    if (viewModel.isConnected()) {
+        ImGui::TextColored(ImVec4(0.3f, 1.0f, 0.3f, 1.0f), "● Connected");
+        ImGui::Text("%s", viewModel.getConnectedDeviceName().c_str());
+    } else {
+        ImGui::TextColored(ImVec4(1.0f, 0.3f, 0.3f, 1.0f), "● Disconnected");
+        ImGui::Text("Select and connect a device");
+    }
+    
+    ImGui::Text("Messages: %llu (%.0f/s)",
+                static_cast<unsigned long long>(viewModel.getMessagesReceived()), viewModel.getMessageRate());
+    ImGui::Text("Jog ticks: L %llu | R %llu",
+                static_cast<unsigned long long>(viewModel.getJogTicks(1)),
+                static_cast<unsigned long long>(viewModel.getJogTicks(2)));
+}
+
+void MidiSetupView::renderConfigButtons(MidiViewModel& viewModel) {
+    // Simplified controls - clear log and export CSV
+    if (ImGui::Button("Clear Log", ImVec2(-1, 0))) {
+        viewModel.clearLog();
+    }
+    
+    if (ImGui::Button("Export CSV", ImVec2(-1, 0))) {
+        viewModel.exportLog();
+    }
+}
+
+} // namespace ui
+} // namespace gamma
@@ -0,0 +1,101 @@
+#include "ui/MidiSignalLog.h"
+#include "imgui.h"
+
+namespace gamma {
+namespace ui {
+
+namespace {
+    const char* FILTER_NAMES[] = {"All", "Notes", "CC", "Pitch Bend", "System", "Other"};
+
+    // Indexed by message type; matches the colors the log has always used
+    const ImVec4 TYPE_COLORS[] = {
+        ImVec4(0.3f, 1.0f, 0.3f, 1.0f),   // Notes: green
+        ImVec4(0.3f, 0.8f, 1.0f, 1.0f),   // Control change: cyan
+        ImVec4(1.0f, 0.8f, 0.3f, 1.0f),   // Pitch bend: orange
+        ImVec4(1.0f, 1.0f, 1.0f, 1.0f),   // System: white
+        ImVec4(1.0f, 1.0f, 1.0f, 1.0f)    // Other: white
+    };
+}
+
+MidiSignalLog::MidiSignalLog(size_t capacity)
+    : _ring(capacity)
+    , _managerSequence(0)
+    , _managerClearCount(0)
+    , _filter(-1) {
+}
+
+void MidiSignalLog::update(gamma::midi::MidiManager& midiManager) {
+    uint64_t clearCount = midiManager.getLogClearCount();
+    if (clearCount != _managerClearCount) {
+        _managerClearCount = clearCount;
+        clear();
+    }
+
+    _incoming.clear();
+    _managerSequence = midiManager.getMessagesSince(_managerSequence, _incoming);
+    for (const auto& message : _incoming) {
+        _ring.append(message);
+    }
+}
+
+void MidiSignalLog::clear() {
+    _ring.clear();
+}
+
+void MidiSignalLog::render(bool midiAvailable) {
+    ImGui::TextColored(ImVec4(0.8f, 0.8f, 0.8f, 1.0f), "MIDI Signal Log:");
+
+    // Type filter
+    ImGui::SameLine();
+    int filterItem = _filter + 1;
+    ImGui::SetNextItemWidth(110.0f);
+    const int filterCount = static_cast<int>(gamma::midi::MidiLogRing::TYPE_COUNT) + 1;
+    if (ImGui::Combo("##MidiLogFilter", &filterItem, FILTER_NAMES, filterCount)) {
+        _filter = filterItem - 1;
+    }
+
+    const size_t rowCount = _ring.getCount(_filter);
+    ImGui::SameLine();
+    ImGui::TextDisabled("%llu / %llu", static_cast<unsigned long long>(rowCount),
+                        static_cast<unsigned long long>(_ring.size()));
+
+    // Create scrolling region for MIDI messages
+    if (ImGui::BeginChild("MidiLog", ImVec2(0, -30), false, ImGuiWindowFlags_HorizontalScrollbar)) {
+        if (!midiAvailable) {
+            ImGui::TextColored(ImVec4(1.0f, 0.3f, 0.3f, 1.0f), "MIDI system not available");
+        } else if (_ring.size() == 0) {
+            ImGui::TextColored(ImVec4(0.6f, 0.6f, 0.6f, 1.0f), "No MIDI messages received yet...");
+            ImGui::TextColored(ImVec4(0.6f, 0.6f, 0.6f, 1.0f), "Connect a device and move some controls!");
+        } else {
+            // Newest first; only the rows inside the visible range are submitted
+            ImGuiListClipper clipper;
+            clipper.Begin(static_cast<int>(rowCount));
+            while (clipper.Step()) {
+                int currentType = -1;
+                for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row) {
+                    const gamma::midi::MidiLogRing::Entry& entry =
+                        _ring.getNewest(_filter, static_cast<size_t>(row));
+
+                    // Consecutive rows of the same type share one style push
+                    if (entry.type != currentType) {
+                        if (currentType >= 0) {
+                            ImGui::PopStyleColor();
+                        }
+                        ImGui::PushStyleColor(ImGuiCol_Text, TYPE_COLORS[entry.type]);
+                        currentType = entry.type;
+                    }
+                    const char* text = entry.getText();
+                    ImGui::TextUnformatted(text, text + entry.length);
+                }
+                if (currentType >= 0) {
+                    ImGui::PopStyleColor();
+                }
+            }
+            clipper.End();
+        }
+    }
+    ImGui::EndChild();
+}
+
+} // namespace ui
+} // namespace gamma
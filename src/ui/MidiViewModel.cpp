@@ -0,0 +1,171 @@
+#include "ui/MidiViewModel.h"
+#include "midi/MidiManager.h"
+
+namespace gamma {
+namespace ui {
+
+namespace {
+    // Device enumeration is comparatively expensive; poll for hot-plugged devices slowly
+    const float DEVICE_POLL_INTERVAL = 2.0f;
+    const float MESSAGE_RATE_WINDOW = 1.0f;
+    const char* NO_DEVICES_LABEL = "No devices detected";
+}
+
+MidiViewModel::MidiViewModel()
+    : _midiManager(nullptr)
+    , _devicePollTimer(0.0f)
+    , _selectedDevice(0)
+    , _isConnected(false)
+    , _messagesReceived(0)
+    , _rateWindowStartCount(0)
+    , _rateWindowTime(0.0f)
+    , _messageRate(0.0f) {
+    for (int i = 0; i < JOG_CHANNELS; ++i) {
+        _pendingJogDelta[i] = 0.0f;
+        _pendingJogTicks[i] = 0;
+        _jogAngle[i] = 0.0f;
+        _jogTicks[i] = 0;
+    }
+    _deviceNameList.push_back(NO_DEVICES_LABEL);
+}
+
+MidiViewModel::~MidiViewModel() {
+    setMidiManager(nullptr);
+}
+
+void MidiViewModel::setMidiManager(gamma::midi::MidiManager* midiManager) {
+    if (_midiManager) {
+        _midiManager->setJogWheelCallback(nullptr);
+    }
+
+    _midiManager = midiManager;
+    _devicePollTimer = 0.0f;     // Enumerate on the next update
+
+    if (_midiManager) {
+        _midiManager->setJogWheelCallback([this](int channel, float deltaRotation) {
+            onJogWheel(channel, deltaRotation);
+        });
+    }
+}
+
+void MidiViewModel::update(float deltaTime) {
+    // Jog wheels
+    {
+        std::lock_guard<std::mutex> lock(_jogMutex);
+        for (int i = 0; i < JOG_CHANNELS; ++i) {
+            if (_pendingJogTicks[i] == 0) {
+                continue;
+            }
+            // Keep rotation in 0-360 degree range
+            _jogAngle[i] += _pendingJogDelta[i];
+            _jogAngle[i] -= 360.0f * static_cast<float>(static_cast<int>(_jogAngle[i] / 360.0f));
+            if (_jogAngle[i] < 0.0f) {
+                _jogAngle[i] += 360.0f;
+            }
+            _jogTicks[i] += _pendingJogTicks[i];
+            _pendingJogDelta[i] = 0.0f;
+            _pendingJogTicks[i] = 0;
+        }
+    }
+
+    if (!_midiManager) {
+        return;
+    }
+
+    // Devices
+    _devicePollTimer -= deltaTime;
+    if (_devicePollTimer <= 0.0f) {
+        queryDevices();
+    }
+
+    // Connection
+    bool connected = _midiManager->isConnected();
+    if (connected != _isConnected) {
+        _isConnected = connected;
+        _connectedDeviceName = connected ? _midiManager->getConnectedDeviceName() : std::string();
+    }
+
+    // Log and counters
+    _signalLog.update(*_midiManager);
+    _messagesReceived = _signalLog.getMessagesSeen();
+
+    _rateWindowTime += deltaTime;
+    if (_rateWindowTime >= MESSAGE_RATE_WINDOW) {
+        _messageRate = static_cast<float>(_messagesReceived - _rateWindowStartCount) / _rateWindowTime;
+        _rateWindowStartCount = _messagesReceived;
+        _rateWindowTime = 0.0f;
+    }
+}
+
+float MidiViewModel::getJogAngle(int channel) const {
+    return (channel >= 1 && channel <= JOG_CHANNELS) ? _jogAngle[channel - 1] : 0.0f;
+}
+
+uint64_t MidiViewModel::getJogTicks(int channel) const {
+    return (channel >= 1 && channel <= JOG_CHANNELS) ? _jogTicks[channel - 1] : 0;
+}
+
+void MidiViewModel::connectSelectedDevice() {
+    if (!_midiManager || _selectedDevice < 0 || _selectedDevice >= static_cast<int>(_deviceNames.size())) {
+        return;
+    }
+    _midiManager->connectToDevice(_deviceNames[_selectedDevice]);
+}
+
+void MidiViewModel::disconnect() {
+    if (_midiManager) {
+        _midiManager->disconnect();
+    }
+}
+
+void MidiViewModel::refreshDevices() {
+    if (_midiManager) {
+        _midiManager->refreshDevices();
+        queryDevices();
+    }
+}
+
+void MidiViewModel::clearLog() {
+    if (_midiManager) {
+        _midiManager->clearMessageHistory();
+    }
+}
+
+void MidiViewModel::exportLog() {
+    if (_midiManager) {
+        _midiManager->exportToCSV();
+    }
+}
+
+void MidiViewModel::onJogWheel(int channel, float deltaRotation) {
+    if (channel < 1 || channel > JOG_CHANNELS) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(_jogMutex);
+    _pendingJogDelta[channel - 1] += deltaRotation;
+    ++_pendingJogTicks[channel - 1];
+}
+
+void MidiViewModel::queryDevices() {
+    _devicePollTimer = DEVICE_POLL_INTERVAL;
+
+    std::vector<std::string> names = _midiManager->getAvailableDevices();
+    if (names == _deviceNames) {
+        return;
+    }
+
+    _deviceNames.swap(names);
+    _deviceNameList.clear();
+    for (const auto& name : _deviceNames) {
+        _deviceNameList.push_back(name.c_str());
+    }
+    if (_deviceNameList.empty()) {
+        _deviceNameList.push_back(NO_DEVICES_LABEL);
+    }
+    if (_selectedDevice >= static_cast<int>(_deviceNameList.size())) {
+        _selectedDevice = 0;
+    }
+}
+
+} // namespace ui
+} // namespace gamma
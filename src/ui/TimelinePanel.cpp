@@ -11,6 +11,8 @@ TimelinePanel::TimelinePanel()
     , _totalDuration(100.0f)
     , _isPlaying(false)
     , _isScrubbing(false) {
+    // Playback time advances whether or not the timeline is shown
+    setUpdateWhenHidden(true);
 }
 
 void TimelinePanel::render() {
@@ -32,7 +34,7 @@ void TimelinePanel::render() {
                             ImGuiWindowFlags_NoCollapse |
                             ImGuiWindowFlags_NoTitleBar;
     
-    if (ImGui::Begin("Timeline", &_visible, flags)) {
+    if (beginWindow("Timeline", flags)) {
         // Panel header
         ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(0.8f, 0.8f, 0.8f, 1.0f));
         ImGui::Text("Timeline & Scratching Interface");
@@ -1,10 +1,19 @@
 #include "ui/WorkspaceManager.h"
 #include "core/Application.h"
 #include "imgui.h"
+#include <chrono>
 
 namespace gamma {
 namespace ui {
 
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    float elapsedMs(Clock::time_point start) {
+        return std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+    }
+}
+
 WorkspaceManager::WorkspaceManager()
     : _isFullscreen(false)
     , _layoutDirty(true)
@@ -17,7 +26,7 @@ WorkspaceManager::~WorkspaceManager() {
     shutdown();
 }
 
-void WorkspaceManager::initialize(gamma::core::Application* application) {
+void WorkspaceManager::createPanels() {
     // Create panel instances
     _timelinePanel = std::make_unique<TimelinePanel>();
     _mainContainer = std::make_unique<MainContainer>();
@@ -32,15 +41,9 @@ void WorkspaceManager::initialize(gamma::core::Application* application) {
     _importPanel->setWorkspaceManager(this);
     _effectsPanel->setWorkspaceManager(this);
     
-    // Set application reference on panels that need it
-    if (application) {
-        if (_mainContainer) {
-            _mainContainer->setApplication(application);
-        }
-        if (_midiControlPanel) {
-            _midiControlPanel->setApplication(application);
-        }
-    }
+    // Both MIDI views render from the same view-model
+    _mainContainer->setMidiViewModel(&_midiViewModel);
+    _midiControlPanel->setMidiViewModel(&_midiViewModel);
     
     // Initialize panels
     _timelinePanel->setVisible(true);
@@ -48,6 +51,20 @@ void WorkspaceManager::initialize(gamma::core::Application* application) {
     _midiControlPanel->setVisible(false); // Start hidden, can be toggled
     _importPanel->setVisible(true);
     _effectsPanel->setVisible(true);
+}
+
+void WorkspaceManager::initialize(gamma::core::Application* application) {
+    if (!_timelinePanel) {
+        createPanels();
+    }
+    
+    // Set application reference on panels that need it
+    if (application) {
+        if (_mainContainer) {
+            _mainContainer->setApplication(application);
+        }
+        _midiViewModel.setMidiManager(application->getMidiManager());
+    }
     
     calculateLayout();
 }
@@ -58,27 +75,53 @@ void WorkspaceManager::render() {
         _layoutDirty = false;
     }
     
-    // Render all panels
-    if (_importPanel) _importPanel->render();
-    if (_mainContainer) _mainContainer->render();
-    if (_midiControlPanel) _midiControlPanel->render();
-    if (_effectsPanel) _effectsPanel->render();
-    if (_timelinePanel) _timelinePanel->render();
+    // Render visible panels
+    renderPanel(_importPanel.get());
+    renderPanel(_mainContainer.get());
+    renderPanel(_midiControlPanel.get());
+    renderPanel(_effectsPanel.get());
+    renderPanel(_timelinePanel.get());
     
     // Render workspace status overlay
     renderWorkspaceOverlay();
 }
 
 void WorkspaceManager::update(float deltaTime) {
-    // Update all panels
-    if (_timelinePanel) _timelinePanel->update(deltaTime);
-    if (_mainContainer) _mainContainer->update(deltaTime);
-    if (_midiControlPanel) _midiControlPanel->update(deltaTime);
-    if (_importPanel) _importPanel->update(deltaTime);
-    if (_effectsPanel) _effectsPanel->update(deltaTime);
+    // Shared MIDI state first, so every panel sees the same frame
+    _midiViewModel.update(deltaTime);
+    
+    // Update panels whose policy says they are due
+    updatePanel(_timelinePanel.get(), deltaTime);
+    updatePanel(_mainContainer.get(), deltaTime);
+    updatePanel(_midiControlPanel.get(), deltaTime);
+    updatePanel(_importPanel.get(), deltaTime);
+    updatePanel(_effectsPanel.get(), deltaTime);
+}
+
+void WorkspaceManager::updatePanel(WorkspacePanel* panel, float deltaTime) {
+    if (!panel) return;
+
+    float updateDelta = 0.0f;
+    if (!panel->scheduleUpdate(deltaTime, updateDelta)) {
+        panel->recordSkippedUpdate();
+        return;
+    }
+
+    auto start = Clock::now();
+    panel->update(updateDelta);
+    panel->recordUpdateTime(elapsedMs(start));
+}
+
+void WorkspaceManager::renderPanel(WorkspacePanel* panel) {
+    if (!panel || !panel->isVisible()) return;
+
+    auto start = Clock::now();
+    panel->render();
+    panel->recordRenderTime(elapsedMs(start));
 }
 
 void WorkspaceManager::shutdown() {
+    _midiViewModel.setMidiManager(nullptr);
     _timelinePanel.reset();
     _mainContainer.reset();
     _midiControlPanel.reset();
@@ -169,10 +212,9 @@ void WorkspaceManager::renderWorkspaceOverlay() {
     ImGuiViewport* viewport = ImGui::GetMainViewport();
     
     ImVec2 overlayPos = ImVec2(viewport->Size.x - 200, _navBarHeight + 10);
-    ImVec2 overlaySize = ImVec2(180, 100);
     
+    // Sized by content (AlwaysAutoResize)
     ImGui::SetNextWindowPos(overlayPos);
-    ImGui::SetNextWindowSize(overlaySize);
     
     ImGuiWindowFlags overlayFlags = ImGuiWindowFlags_NoTitleBar |
                                    ImGuiWindowFlags_NoResize |
@@ -196,6 +238,24 @@ void WorkspaceManager::renderWorkspaceOverlay() {
         ImGui::Text("Import: %s", _importPanel && _importPanel->isVisible() ? "ON" : "OFF");
         ImGui::Text("Effects: %s", _effectsPanel && _effectsPanel->isVisible() ? "ON" : "OFF");
         
+        // Per-panel cost; hover for update counts
+        ImGui::Separator();
+        ImGui::Text("Panel      upd ms  rnd ms");
+        const WorkspacePanel* panels[] = {
+            _timelinePanel.get(), _mainContainer.get(), _midiControlPanel.get(),
+            _importPanel.get(), _effectsPanel.get()
+        };
+        for (const WorkspacePanel* panel : panels) {
+            if (!panel) continue;
+            const WorkspacePanel::Timing& timing = panel->getTiming();
+            ImGui::Text("%-9.9s %7.3f %7.3f", panel->getName(), timing.updateMs, timing.renderMs);
+            if (ImGui::IsItemHovered()) {
+                ImGui::SetTooltip("%llu updates run, %llu skipped",
+                                  static_cast<unsigned long long>(timing.updatesRun),
+                                  static_cast<unsigned long long>(timing.updatesSkipped));
+            }
+        }
+        
         // Add toggle button for MIDI control panel
         if (ImGui::Button("MIDI Controls")) {
             if (_midiControlPanel) {
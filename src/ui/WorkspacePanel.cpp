@@ -1,16 +1,92 @@
 #include "ui/WorkspacePanel.h"
+#include "imgui.h"
 
 namespace gamma {
 namespace ui {
 
+namespace {
+    // Weight of the newest sample in the smoothed timings
+    const float TIMING_SMOOTHING = 0.05f;
+}
+
 WorkspacePanel::WorkspacePanel(const char* name) 
     : _name(name)
     , _visible(true)
-    , _workspaceManager(nullptr) {
-}void WorkspacePanel::update(float deltaTime) {
+    , _workspaceManager(nullptr)
+    , _updatePolicy(UpdatePolicy::EveryFrame)
+    , _updateInterval(0.0f)
+    , _pendingTime(0.0f)
+    , _updateWhenHidden(false)
+    , _dirty(true)
+    , _occluded(false) {
+}
+
+void WorkspacePanel::update(float deltaTime) {
     // Default implementation - panels can override if needed
     (void)deltaTime; // Suppress unused parameter warning
 }
 
+void WorkspacePanel::setVisible(bool visible) {
+    if (visible && !_visible) {
+        // Catch up on anything that changed while hidden
+        _dirty = true;
+        _occluded = false;
+    }
+    _visible = visible;
+}
+
+void WorkspacePanel::setUpdatePolicy(UpdatePolicy policy, float rateHz) {
+    _updatePolicy = policy;
+    _updateInterval = (policy == UpdatePolicy::FixedRate && rateHz > 0.0f) ? 1.0f / rateHz : 0.0f;
+}
+
+bool WorkspacePanel::scheduleUpdate(float deltaTime, float& updateDelta) {
+    if (!_updateWhenHidden && (!_visible || _occluded)) {
+        // Nothing to show; resume from the current state instead of catching up
+        _pendingTime = 0.0f;
+        return false;
+    }
+
+    _pendingTime += deltaTime;
+
+    bool due = false;
+    switch (_updatePolicy) {
+        case UpdatePolicy::EveryFrame:
+            due = true;
+            break;
+        case UpdatePolicy::OnChange:
+            due = _dirty;
+            break;
+        case UpdatePolicy::FixedRate:
+            due = _pendingTime >= _updateInterval;
+            break;
+    }
+
+    if (!due) {
+        return false;
+    }
+
+    updateDelta = _pendingTime;
+    _pendingTime = 0.0f;
+    _dirty = false;
+    return true;
+}
+
+void WorkspacePanel::recordUpdateTime(float milliseconds) {
+    _timing.updateMs += (milliseconds - _timing.updateMs) * TIMING_SMOOTHING;
+    ++_timing.updatesRun;
+}
+
+void WorkspacePanel::recordRenderTime(float milliseconds) {
+    _timing.renderMs += (milliseconds - _timing.renderMs) * TIMING_SMOOTHING;
+}
+
+bool WorkspacePanel::beginWindow(const char* title, int flags) {
+    // Begin returns false when the window is collapsed or clipped away entirely
+    bool open = ImGui::Begin(title, &_visible, flags);
+    _occluded = !open;
+    return open;
+}
+
 } // namespace ui
-} // namespace gamma
\ No newline at end of file
+} // namespace gamma
@@ -0,0 +1,80 @@
+#include "Test.h"
+#include "effects/ColorLut.h"
+#include <string>
+
+namespace gamma {
+namespace test {
+
+namespace {
+
+// Rows of a size-2 identity table, red varying fastest
+std::string identityRows(int count) {
+    std::string rows;
+    for (int i = 0; i < count; ++i) {
+        const int r = i & 1;
+        const int g = (i >> 1) & 1;
+        const int b = (i >> 2) & 1;
+        rows += std::to_string(r) + " " + std::to_string(g) + " " + std::to_string(b) + "\n";
+    }
+    return rows;
+}
+
+/**
+ * @brief Parsing text must fail and leave a loaded table as it was
+ */
+void checkRejected(const std::string& text) {
+    effects::ColorLut lut;
+    CHECK(lut.parseCube("TITLE \"Before\"\nLUT_3D_SIZE 2\n" + identityRows(8), "valid"));
+    const uint64_t id = lut.getId();
+
+    CHECK(!lut.parseCube(text, "invalid"));
+    CHECK(lut.getSize() == 2);
+    CHECK(lut.getTitle() == "Before");
+    CHECK(lut.getId() == id);
+}
+
+void testValid() {
+    effects::ColorLut lut;
+    const std::string text =
+        "# Comment\n"
+        "TITLE \"Identity\"\n"
+        "LUT_3D_SIZE 2\n"
+        "DOMAIN_MIN 0 0 0\n"
+        "DOMAIN_MAX 2 2 2   # Trailing comment\n"
+        "\n" + identityRows(8);
+    CHECK(lut.parseCube(text, "identity"));
+    CHECK(lut.getSize() == 2);
+    CHECK(lut.getTitle() == "Identity");
+    CHECK(lut.getGrid().size == 2);
+    CHECK(lut.getLatticeValue(0, 1) == 2.0f);
+    const float* corner = lut.entry(1, 0, 1);
+    CHECK(corner[0] == 1.0f && corner[1] == 0.0f && corner[2] == 1.0f);
+
+    // LUT_3D_INPUT_RANGE sets the same domain on every channel
+    CHECK(lut.parseCube("LUT_3D_SIZE 2\nLUT_3D_INPUT_RANGE 0 4\n" + identityRows(8), "range"));
+    CHECK(lut.getLatticeValue(2, 1) == 4.0f);
+}
+
+void testErrors() {
+    checkRejected(identityRows(8));                                 // No size before the values
+    checkRejected("TITLE \"Empty\"\n");                             // No LUT_3D_SIZE at all
+    checkRejected("LUT_3D_SIZE 2\n" + identityRows(9));             // Too many rows
+    checkRejected("LUT_3D_SIZE 2\n" + identityRows(7));             // Too few rows
+    checkRejected("LUT_3D_SIZE 1\n" + identityRows(1));             // Size below the minimum
+    checkRejected("LUT_3D_SIZE 66\n");                              // Size above the maximum
+    checkRejected("LUT_1D_SIZE 2\n0 0 0\n1 1 1\n");                 // 1D tables
+    checkRejected("LUT_3D_SIZE 2\n0 0\n" + identityRows(7));        // Short row
+    checkRejected("LUT_3D_SIZE 2\nDOMAIN_MIN 0 0 0\nDOMAIN_MAX 1 0 1\n" + identityRows(8));  // Empty domain
+    checkRejected("LUT_3D_SIZE 2\nLUT_3D_INPUT_RANGE 1 1\n" + identityRows(8));
+    checkRejected("LUT_3D_SIZE 2\nDOMAIN_MAX 1 1\n" + identityRows(8));     // Bad domain
+}
+
+} // namespace
+
+void runColorLutTests() {
+    testValid();
+    testErrors();
+}
+
+} // namespace test
+} // namespace gamma
@@ -0,0 +1,265 @@
+#include "Test.h"
+#include "Benchmark.h"
+#include "core/JobSystem.h"
+#include "effects/ChainThumbnails.h"
+#include "effects/Downscale.h"
+#include "effects/EffectEngine.h"
+#include "effects/TestPattern.h"
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace gamma {
+namespace test {
+
+namespace {
+
+// Odd sizes, so rows end in partial vectors
+const int WIDTH = 157;
+const int HEIGHT = 91;
+const int FRAMES = 3;
+const int RAMP_WIDTH = 256;
+
+bool samePixels(const effects::Frame& a, const effects::Frame& b) {
+    if (a.getWidth() != b.getWidth() || a.getHeight() != b.getHeight()) {
+        return false;
+    }
+    for (int y = 0; y < a.getHeight(); ++y) {
+        if (!std::equal(a.row(y), a.row(y) + a.getWidth(), b.row(y))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void testMemoization() {
+    effects::Frame input(WIDTH, HEIGHT);
+    effects::renderTestPattern(input, 0.0);
+    // Stateless effects, so every result can be cached
+    std::vector<effects::ChainSlot> chain = bench::makeFixtureChain();
+
+    effects::EffectEngine cached;
+    effects::EffectEngine uncached;
+    uncached.setMemoizationEnabled(false);
+    effects::Frame cachedOutput;
+    effects::Frame uncachedOutput;
+
+    // Same input and parameters: from the second frame on, the output is reused
+    for (int frame = 0; frame < FRAMES; ++frame) {
+        const double time = frame / 60.0;
+        const effects::Frame& a = cached.process(input, cachedOutput, chain, 1.0f, time);
+        const effects::Frame& b = uncached.process(input, uncachedOutput, chain, 1.0f, time);
+        CHECK(samePixels(a, b));
+    }
+    CHECK(cached.getCacheStats().hits == FRAMES - 1);
+    CHECK(uncached.getCacheStats().hits == 0);
+    CHECK(cached.getCacheBytes() > 0);
+    CHECK(uncached.getCacheBytes() == 0);
+
+    // A parameter change re-renders, and still matches the uncached result
+    cached.resetCacheStats();
+    chain.back().parameters[1] = 4.0f;
+    const effects::Frame& edited = cached.process(input, cachedOutput, chain, 1.0f, 1.0);
+    CHECK(cached.getCacheStats().misses > 0);
+    CHECK(samePixels(edited, uncached.process(input, uncachedOutput, chain, 1.0f, 1.0)));
+
+    // So does new input content
+    cached.resetCacheStats();
+    effects::renderTestPattern(input, 0.5);
+    input.setContentId(effects::makeContentId());
+    const effects::Frame& live = cached.process(input, cachedOutput, chain, 1.0f, 1.1);
+    CHECK(cached.getCacheStats().hits == 0);
+    CHECK(samePixels(live, uncached.process(input, uncachedOutput, chain, 1.0f, 1.1)));
+
+    // Nothing applies at mix 0: the input itself is the result
+    CHECK(&cached.process(input, cachedOutput, chain, 0.0f, 1.2) == &input);
+}
+
+/**
+ * @brief Band tasks on four workers give the serial result, frame after frame
+ */
+void testParallel() {
+    const int look = effects::getLutLibrary().add("engine test", bench::makeLook(9));
+    CHECK(look >= 0);
+
+    std::vector<std::vector<effects::ChainSlot>> chains;
+    std::vector<effects::ChainSlot> everyEffect;
+    for (int i = 0; i < static_cast<int>(effects::EffectType::Count); ++i) {
+        const effects::ChainSlot slot = bench::makeEffectSlot(static_cast<effects::EffectType>(i), look);
+        chains.push_back({slot});
+        everyEffect.push_back(slot);
+    }
+    chains.push_back(everyEffect);
+
+    const effects::PixelFormat formats[] = {
+        effects::PixelFormat::RGBA8, effects::PixelFormat::RGBA16F, effects::PixelFormat::RGBA32F
+    };
+    core::JobSystem jobs(4);
+    effects::Frame input(WIDTH, HEIGHT);
+    for (effects::PixelFormat format : formats) {
+        for (const auto& chain : chains) {
+            effects::EffectEngine serial;
+            effects::EffectEngine parallel(&jobs);
+            serial.setIntermediateFormat(format);
+            parallel.setIntermediateFormat(format);
+            effects::Frame serialOutput;
+            effects::Frame parallelOutput;
+
+            // New content every frame, so temporal effects have history to read
+            bool same = true;
+            for (int frame = 0; frame < 4; ++frame) {
+                const double time = frame / 60.0;
+                effects::renderTestPattern(input, time);
+                input.setContentId(effects::makeContentId());
+                same = same && samePixels(serial.process(input, serialOutput, chain, 1.0f, time),
+                                          parallel.process(input, parallelOutput, chain, 1.0f, time));
+            }
+            if (!CHECK(same)) {
+                std::cerr << "  " << (chain.size() > 1 ? "every effect" : effects::getEffectTypeName(chain[0].type))
+                          << ", " << effects::getPixelFormatName(format) << std::endl;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Float intermediates keep what RGBA8 rounds away, and output stays RGBA8
+ */
+void testFormats() {
+    const effects::PixelFormat formats[] = {
+        effects::PixelFormat::RGBA8, effects::PixelFormat::RGBA16F, effects::PixelFormat::RGBA32F
+    };
+
+    // A ramp wide enough for every level, crushed to a quarter and stretched back
+    effects::Frame ramp(RAMP_WIDTH, 8);
+    bench::renderRamp(ramp);
+    const std::vector<effects::ChainSlot> crush = bench::makeCrushChain();
+    size_t levels[3];
+
+    // The graded test pattern, against the RGBA32F result
+    effects::Frame input(WIDTH, HEIGHT);
+    effects::renderTestPattern(input, 0.0);
+    const std::vector<effects::ChainSlot> grade = bench::makeFixtureChain();
+    effects::Frame graded[3];
+
+    for (size_t f = 0; f < 3; ++f) {
+        effects::EffectEngine engine;
+        engine.setIntermediateFormat(formats[f]);
+        CHECK(engine.getIntermediateFormat() == formats[f]);
+
+        effects::Frame output;
+        const effects::Frame& banded = engine.process(ramp, output, crush, 1.0f, 0.0);
+        CHECK(banded.getFormat() == effects::PixelFormat::RGBA8);
+        levels[f] = bench::countLevels(banded);
+
+        graded[f].copyFrom(engine.process(input, output, grade, 1.0f, 0.0));
+        CHECK(graded[f].getFormat() == effects::PixelFormat::RGBA8);
+    }
+    CHECK(levels[0] <= 64);
+    CHECK(levels[1] >= 250);
+    CHECK(levels[2] == 256);
+
+    int maxError = 0;
+    CHECK(bench::computePsnr(graded[1], graded[2], &maxError) > 50.0);
+    CHECK(maxError <= 2);
+    CHECK(bench::computePsnr(graded[0], graded[2]) > 35.0);
+}
+
+/**
+ * @brief The preview tap is the downscaled result, rebuilt only when the result changes
+ */
+void testPreview() {
+    const int factor = 4;
+    effects::Frame input(WIDTH, HEIGHT);
+    effects::renderTestPattern(input, 0.0);
+    input.setContentId(effects::makeContentId());
+    const std::vector<effects::ChainSlot> chain = bench::makeFixtureChain();
+
+    core::JobSystem jobs(4);
+    effects::EffectEngine serial;
+    effects::EffectEngine parallel(&jobs);
+    CHECK(serial.getPreview().empty());
+    serial.setPreviewFactor(factor);
+    parallel.setPreviewFactor(factor);
+    CHECK(serial.getPreviewFactor() == factor);
+
+    effects::Frame output;
+    effects::Frame parallelOutput;
+    effects::Frame expected;
+    const effects::Frame& result = serial.process(input, output, chain, 1.0f, 0.0);
+    effects::downscaleFrame(result, expected, factor);
+    const effects::Frame& preview = serial.getPreview();
+    CHECK(preview.getWidth() == effects::getDownscaledSize(WIDTH, factor));
+    CHECK(preview.getHeight() == effects::getDownscaledSize(HEIGHT, factor));
+    CHECK(samePixels(preview, expected));
+    parallel.process(input, parallelOutput, chain, 1.0f, 0.0);
+    CHECK(samePixels(parallel.getPreview(), expected));
+
+    // An unchanged result keeps its preview; new content replaces it
+    const uint64_t previewId = preview.getContentId();
+    serial.process(input, output, chain, 1.0f, 1.0 / 60.0);
+    CHECK(preview.getContentId() == previewId);
+    effects::renderTestPattern(input, 0.5);
+    input.setContentId(effects::makeContentId());
+    serial.process(input, output, chain, 1.0f, 2.0 / 60.0);
+    CHECK(preview.getContentId() != previewId);
+
+    // At mix 0 the input is the result, and the preview shows it
+    serial.process(input, output, chain, 0.0f, 3.0 / 60.0);
+    effects::downscaleFrame(input, expected, factor);
+    CHECK(samePixels(preview, expected));
+
+    // Factors are clamped to the downscaler's range; below 2 the tap is off
+    serial.setPreviewFactor(100);
+    CHECK(serial.getPreviewFactor() == effects::MAX_DOWNSCALE_FACTOR);
+    serial.setPreviewFactor(1);
+    CHECK(serial.getPreviewFactor() == 0);
+    CHECK(serial.getPreview().empty());
+    serial.process(input, output, chain, 1.0f, 4.0 / 60.0);
+    CHECK(serial.getPreview().empty());
+}
+
+/**
+ * @brief Thumbnails on the program engine's workers and format match the serial ones
+ */
+void testThumbnails() {
+    effects::Frame input(WIDTH, HEIGHT);
+    const std::vector<effects::ChainSlot> chain = bench::makeFixtureChain();
+
+    // Large enough a reduction to leave several bands per thumbnail
+    core::JobSystem jobs(4);
+    effects::ChainThumbnails serial;
+    effects::ChainThumbnails parallel(&jobs);
+    serial.setFactor(2);
+    parallel.setFactor(2);
+    serial.setIntermediateFormat(effects::PixelFormat::RGBA16F);
+    parallel.setIntermediateFormat(effects::PixelFormat::RGBA16F);
+    CHECK(parallel.getIntermediateFormat() == effects::PixelFormat::RGBA16F);
+
+    for (int frame = 0; frame < FRAMES; ++frame) {
+        const double time = frame / 60.0;
+        effects::renderTestPattern(input, time);
+        input.setContentId(effects::makeContentId());
+        serial.render(input, chain, time);
+        parallel.render(input, chain, time);
+        if (CHECK(serial.getCount() == chain.size() && parallel.getCount() == chain.size())) {
+            for (size_t slot = 0; slot < chain.size(); ++slot) {
+                CHECK(samePixels(serial.getThumbnail(slot), parallel.getThumbnail(slot)));
+            }
+        }
+    }
+}
+
+} // namespace
+
+void runEffectEngineTests() {
+    testMemoization();
+    testParallel();
+    testFormats();
+    testPreview();
+    testThumbnails();
+}
+
+} // namespace test
+} // namespace gamma
@@ -0,0 +1,311 @@
+#include "Test.h"
+#include "effects/EffectPlan.h"
+#include <vector>
+
+namespace gamma {
+namespace test {
+
+namespace {
+
+using effects::EffectGraph;
+using effects::EffectPlan;
+using effects::Frame;
+using effects::NodeId;
+using effects::PlanNode;
+
+const int WIDTH = 16;
+const int HEIGHT = 8;
+
+/**
+ * @brief A plan over a linear chain, with the flags and values of its effect nodes
+ */
+struct ChainFixture {
+    EffectGraph graph;
+    std::vector<PlanNode> nodes;
+    std::vector<std::vector<float>> values;
+    Frame source;
+    Frame output;
+    std::vector<const Frame*> sources;
+
+    ChainFixture(size_t effectCount, float mix)
+        : source(WIDTH, HEIGHT)
+        , output(WIDTH, HEIGHT) {
+        std::vector<effects::ChainSlot> chain(effectCount);
+        graph.buildFromChain(chain, mix);
+        nodes.resize(graph.getNodeCount());
+        values.assign(effectCount, std::vector<float>(effects::MAX_EFFECT_PARAMETERS, 0.5f));
+        for (size_t i = 0; i < effectCount; ++i) {
+            nodes[i].values = values[i].data();
+        }
+        sources.push_back(&source);
+    }
+
+    NodeId getSourceNode() const { return static_cast<NodeId>(values.size()); }
+};
+
+/**
+ * @brief Plan one frame the way EffectEngine does, up to the buffers
+ */
+bool planFrame(EffectPlan& plan, const EffectGraph& graph, const std::vector<const Frame*>& sources,
+               const std::vector<PlanNode>& nodes, Frame& output) {
+    if (!plan.compile(graph, sources, nodes)) {
+        return false;
+    }
+    plan.computeKeys(graph, sources, nodes);
+    if (plan.getStageCount() == 0) {
+        return true;
+    }
+    plan.skipCachedStages();
+    plan.foldBlends();
+    plan.assignBuffers(graph, sources, output);
+    return true;
+}
+
+bool readsOwnTarget(const EffectPlan::Stage& stage) {
+    for (const Frame* input : stage.inputs) {
+        if (input == stage.target) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool hasDependency(const EffectPlan::Stage& stage, size_t on, int halo) {
+    for (const EffectPlan::Dependency& dependency : stage.dependencies) {
+        if (dependency.stage == on && dependency.halo == halo) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void testStageGrouping() {
+    // Two point-wise effects, two remaps and one effect of neither kind
+    ChainFixture fixture(5, 1.0f);
+    fixture.nodes[0].pointwise = true;
+    fixture.nodes[1].pointwise = true;
+    fixture.nodes[2].remap = true;
+    fixture.nodes[3].remap = true;
+
+    EffectPlan plan;
+    CHECK(plan.compile(fixture.graph, fixture.sources, fixture.nodes));
+    if (!CHECK(plan.getStageCount() == 3)) {
+        return;
+    }
+    CHECK(plan.getStage(0).kind == EffectPlan::StageKind::Fused);
+    CHECK(plan.getStage(0).nodes.size() == 2);
+    CHECK(plan.getStage(1).kind == EffectPlan::StageKind::Remap);
+    CHECK(plan.getStage(1).nodes.size() == 2);
+    CHECK(plan.getStage(2).kind == EffectPlan::StageKind::Effect);
+    CHECK(plan.getResult() == 4);     // The blend at mix 1 passes its layer on
+
+    // A moving map stays out of the run
+    fixture.nodes[3].mapMoving = true;
+    CHECK(plan.compile(fixture.graph, fixture.sources, fixture.nodes));
+    CHECK(plan.getStageCount() == 4);
+    fixture.nodes[3].mapMoving = false;
+
+    plan.setFusionEnabled(false);
+    CHECK(plan.compile(fixture.graph, fixture.sources, fixture.nodes));
+    CHECK(plan.getStageCount() == 5);
+}
+
+void testPassThrough() {
+    ChainFixture fixture(3, 1.0f);
+    fixture.graph.getNode(1).effect.enabled = false;
+
+    EffectPlan plan;
+    CHECK(plan.compile(fixture.graph, fixture.sources, fixture.nodes));
+    if (CHECK(plan.getStageCount() == 2)) {
+        CHECK(plan.getStage(1).nodes.front() == 2);
+        CHECK(plan.getStage(1).inputNodes[0] == 0);    // Reads through the disabled effect
+    }
+
+    // At mix 0 the output is the source itself
+    ChainFixture dry(3, 0.0f);
+    CHECK(plan.compile(dry.graph, dry.sources, dry.nodes));
+    CHECK(plan.getStageCount() == 0);
+    CHECK(plan.getResult() == dry.getSourceNode());
+
+    // An output port left unconnected cannot run
+    EffectGraph broken;
+    NodeId effect = broken.addEffect(effects::ChainSlot());
+    broken.setOutput(effect);
+    std::vector<PlanNode> brokenNodes(1);
+    CHECK(!plan.compile(broken, dry.sources, brokenNodes));
+}
+
+void testLinearBuffers() {
+    ChainFixture fixture(4, 1.0f);
+    EffectPlan plan;
+    plan.setMemoizationEnabled(false);
+    CHECK(planFrame(plan, fixture.graph, fixture.sources, fixture.nodes, fixture.output));
+    if (!CHECK(plan.getStageCount() == 4)) {
+        return;
+    }
+
+    // Two scratch frames ping-pong; the last stage writes the output
+    CHECK(plan.getScratchFrameCount() == 2);
+    CHECK(plan.getStage(0).inputs[0] == &fixture.source);
+    CHECK(plan.getStage(0).target != plan.getStage(1).target);
+    CHECK(plan.getStage(0).target == plan.getStage(2).target);
+    CHECK(plan.getStage(3).target == &fixture.output);
+    CHECK(plan.getOutputStage() == 3);
+    for (size_t s = 0; s < plan.getStageCount(); ++s) {
+        CHECK(!readsOwnTarget(plan.getStage(s)));
+        CHECK(plan.getStage(s).target->getWidth() == WIDTH);
+    }
+
+    // Halos set by the caller, then dependencies in stage order
+    const int halos[] = {0, 5, 2, 0};
+    for (size_t s = 0; s < plan.getStageCount(); ++s) {
+        plan.getStage(s).halo = halos[s];
+        plan.addDependencies(s);
+    }
+    CHECK(plan.getStage(0).dependencies.empty());
+
+    CHECK(plan.getStage(1).dependencies.size() == 1);
+    CHECK(hasDependency(plan.getStage(1), 0, 5));
+
+    // Stage 2 reads stage 1 and overwrites stage 0's frame, which stage 1
+    // reads 5 rows beyond each band
+    CHECK(plan.getStage(2).dependencies.size() == 2);
+    CHECK(hasDependency(plan.getStage(2), 1, 5));
+    CHECK(hasDependency(plan.getStage(2), 0, 0));
+
+    CHECK(plan.getStage(3).dependencies.size() == 1);
+    CHECK(hasDependency(plan.getStage(3), 2, 0));
+}
+
+void testBranchBuffers() {
+    // source -> e0 -> {e1, e2} -> blend(base e2, layer e1); e1 sorts after e2,
+    // so its stage can take in the blend
+    EffectGraph graph;
+    NodeId source = graph.addSource(0);
+    NodeId e0 = graph.addEffect(effects::ChainSlot());
+    NodeId e1 = graph.addEffect(effects::ChainSlot());
+    NodeId e2 = graph.addEffect(effects::ChainSlot());
+    NodeId blend = graph.addBlend(0.5f);
+    CHECK(graph.connect(source, e0));
+    CHECK(graph.connect(e0, e1));
+    CHECK(graph.connect(e0, e2));
+    CHECK(graph.connect(e2, blend, effects::BLEND_BASE));
+    CHECK(graph.connect(e1, blend, effects::BLEND_LAYER));
+    graph.setOutput(blend);
+
+    std::vector<float> values(effects::MAX_EFFECT_PARAMETERS, 0.0f);
+    std::vector<PlanNode> nodes(graph.getNodeCount());
+    for (PlanNode& node : nodes) {
+        node.values = values.data();
+    }
+    Frame input(WIDTH, HEIGHT);
+    Frame output(WIDTH, HEIGHT);
+    std::vector<const Frame*> sources = {&input};
+
+    // e0's result lives until both branches have read it: three frames at once
+    EffectPlan plan;
+    plan.setMemoizationEnabled(false);
+    plan.setFusionEnabled(false);
+    CHECK(planFrame(plan, graph, sources, nodes, output));
+    if (CHECK(plan.getStageCount() == 4)) {
+        CHECK(plan.getScratchFrameCount() == 3);
+        CHECK(plan.getStage(1).inputs[0] == plan.getStage(0).target);
+        CHECK(plan.getStage(2).inputs[0] == plan.getStage(0).target);
+        CHECK(plan.getStage(3).kind == EffectPlan::StageKind::Blend);
+        CHECK(plan.getStage(3).mixWeight == 128);
+        CHECK(plan.getStage(3).target == &output);
+    }
+
+    // Folded into e1, the blend writes the output directly
+    EffectPlan folded;
+    folded.setMemoizationEnabled(false);
+    CHECK(planFrame(folded, graph, sources, nodes, output));
+    if (CHECK(folded.getStageCount() == 3)) {
+        const EffectPlan::Stage& last = folded.getStage(2);
+        CHECK(last.mixNode == blend);
+        CHECK(last.inputs[EffectPlan::MIX_BASE_INPUT] == folded.getStage(1).target);
+        CHECK(last.target == &output);
+        CHECK(folded.getScratchFrameCount() == 2);
+        for (size_t s = 0; s < folded.getStageCount(); ++s) {
+            CHECK(!readsOwnTarget(folded.getStage(s)));
+        }
+    }
+}
+
+void testMemoization() {
+    ChainFixture fixture(3, 1.0f);
+    fixture.source.setContentId(effects::makeContentId());
+    EffectPlan plan;
+
+    // First frame renders everything
+    CHECK(planFrame(plan, fixture.graph, fixture.sources, fixture.nodes, fixture.output));
+    CHECK(plan.getStageCount() == 3);
+    CHECK(plan.getResultKey() != 0);
+    CHECK(plan.getCacheStats().misses == 3);
+    CHECK(plan.getCacheBytes() == 2 * fixture.source.getByteSize());
+    const uint64_t firstKey = plan.getResultKey();
+
+    // Same input and parameters: only the output stage runs, from e1's cached result
+    plan.resetCacheStats();
+    CHECK(planFrame(plan, fixture.graph, fixture.sources, fixture.nodes, fixture.output));
+    CHECK(plan.getResultKey() == firstKey);
+    CHECK(plan.getStageCount() == 1);
+    CHECK(plan.getCacheStats().hits == 1);
+    CHECK(plan.getCacheStats().misses == 1);
+    CHECK(plan.getStageCount() == 0 || plan.getStage(0).inputs[0] != &fixture.source);
+
+    // A parameter change invalidates its node and everything after it
+    fixture.values[1][0] = 0.75f;
+    plan.resetCacheStats();
+    CHECK(planFrame(plan, fixture.graph, fixture.sources, fixture.nodes, fixture.output));
+    CHECK(plan.getResultKey() != firstKey);
+    CHECK(plan.getStageCount() == 2);
+    CHECK(plan.getCacheStats().hits == 1);
+    CHECK(plan.getCacheStats().misses == 2);
+
+    // New source content invalidates everything
+    fixture.source.setContentId(effects::makeContentId());
+    plan.resetCacheStats();
+    CHECK(planFrame(plan, fixture.graph, fixture.sources, fixture.nodes, fixture.output));
+    CHECK(plan.getStageCount() == 3);
+    CHECK(plan.getCacheStats().hits == 0);
+
+    // A node at the same index with other history must not reuse the old result
+    plan.forgetResult(1);
+    plan.resetCacheStats();
+    CHECK(planFrame(plan, fixture.graph, fixture.sources, fixture.nodes, fixture.output));
+    CHECK(plan.getStageCount() == 2);
+    CHECK(plan.getCacheStats().hits == 1);
+
+    // A temporal effect is never cached, nor is anything reading it
+    fixture.nodes[1].temporal = true;
+    plan.resetCacheStats();
+    CHECK(planFrame(plan, fixture.graph, fixture.sources, fixture.nodes, fixture.output));
+    CHECK(plan.getResultKey() == 0);
+    CHECK(plan.getStageCount() == 2);
+    CHECK(plan.getCacheStats().uncached == 2);
+    fixture.nodes[1].temporal = false;
+
+    // Nor is a source without an id
+    fixture.source.setContentId(0);
+    CHECK(planFrame(plan, fixture.graph, fixture.sources, fixture.nodes, fixture.output));
+    CHECK(plan.getResultKey() == 0);
+    CHECK(plan.getStageCount() == 3);
+
+    // Turning memoization off drops the cached frames
+    plan.setMemoizationEnabled(false);
+    CHECK(plan.getCacheBytes() == 0);
+}
+
+} // namespace
+
+void runEffectPlanTests() {
+    testStageGrouping();
+    testPassThrough();
+    testLinearBuffers();
+    testBranchBuffers();
+    testMemoization();
+}
+
+} // namespace test
+} // namespace gamma
@@ -0,0 +1,84 @@
+#include "Test.h"
+#include "core/FrameArena.h"
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+namespace gamma {
+namespace test {
+
+namespace {
+
+const size_t BLOCK_SIZE = 256;
+
+bool isAligned(const void* pointer, size_t alignment) {
+    return reinterpret_cast<uintptr_t>(pointer) % alignment == 0;
+}
+
+void testAllocate() {
+    core::FrameArena arena(BLOCK_SIZE);
+    CHECK(arena.getCapacity() == BLOCK_SIZE);
+
+    arena.allocate(1, 1);
+    CHECK(isAligned(arena.allocate(8, 64), 64));
+    double* values = arena.allocateArray<double>(4);
+    CHECK(isAligned(values, alignof(double)));
+
+    const char* copied = arena.copy("label##id", 5);
+    CHECK(std::strcmp(copied, "label") == 0);
+    CHECK(arena.getCapacity() == BLOCK_SIZE);
+}
+
+void testFormat() {
+    core::FrameArena arena(BLOCK_SIZE);
+    const char* text = arena.format("%s %d", "Slot", 12);
+    CHECK(std::strcmp(text, "Slot 12") == 0);
+    CHECK(arena.getBytesUsed() == 8);
+
+    // Too long for what is left of the block: formatted again into a new one
+    arena.allocate(BLOCK_SIZE - 16, 1);
+    const std::string longText(100, 'x');
+    const char* spilled = arena.format("[%s]", longText.c_str());
+    CHECK(std::string(spilled) == "[" + longText + "]");
+    CHECK(arena.getCapacity() > BLOCK_SIZE);
+    CHECK(std::strcmp(text, "Slot 12") == 0);
+
+    // Longer than a whole block
+    const std::string hugeText(3 * BLOCK_SIZE, 'y');
+    CHECK(std::string(arena.format("%s", hugeText.c_str())) == hugeText);
+}
+
+void testReset() {
+    core::FrameArena arena(BLOCK_SIZE);
+    for (int i = 0; i < 20; ++i) {
+        arena.format("Entry %d of a frame that does not fit one block", i);
+    }
+    const size_t used = arena.getBytesUsed();
+    const size_t capacity = arena.getCapacity();
+    CHECK(capacity > BLOCK_SIZE);
+
+    // The spilled blocks become one, which the same frame then fits
+    arena.reset();
+    CHECK(arena.getBytesUsed() == 0);
+    CHECK(arena.getPeakBytesUsed() == used);
+    CHECK(arena.getCapacity() == capacity);
+    for (int i = 0; i < 20; ++i) {
+        arena.format("Entry %d of a frame that does not fit one block", i);
+    }
+    CHECK(arena.getBytesUsed() == used);
+    CHECK(arena.getCapacity() == capacity);
+
+    arena.reset();
+    CHECK(arena.getCapacity() == capacity);
+}
+
+} // namespace
+
+void runFrameArenaTests() {
+    testAllocate();
+    testFormat();
+    testReset();
+}
+
+} // namespace test
+} // namespace gamma
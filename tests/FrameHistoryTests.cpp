@@ -0,0 +1,196 @@
+#include "Test.h"
+#include "effects/FrameHistory.h"
+
+namespace gamma {
+namespace test {
+
+namespace {
+
+using effects::Frame;
+using effects::FrameHistory;
+using effects::HistoryTrack;
+
+const int WIDTH = 8;
+const int HEIGHT = 4;
+const double FRAME_INTERVAL = 1.0 / 60.0;
+const size_t FRAME_BYTES = WIDTH * HEIGHT * 4;
+
+double frameTime(int frame) {
+    return frame * FRAME_INTERVAL;
+}
+
+/**
+ * @brief Record a frame when due, marking it with its number
+ */
+void recordFrame(HistoryTrack& track, int frame) {
+    if (track.isRecordDue()) {
+        if (Frame* recorded = track.record()) {
+            recorded->data()[0] = static_cast<uint32_t>(frame);
+        }
+    }
+}
+
+int marker(const Frame* frame) {
+    return frame ? static_cast<int>(frame->data()[0]) : -1;
+}
+
+void testLookup() {
+    FrameHistory history;
+    HistoryTrack track;
+    CHECK(!track.bind(nullptr));
+    CHECK(track.bind(&history));
+    CHECK(history.getTrackCount() == 1);
+
+    history.beginFrame(WIDTH, HEIGHT, 0.0);
+    track.setSpan(0.1);
+    CHECK(track.getNewest() == nullptr);
+
+    for (int frame = 0; frame < 120; ++frame) {
+        history.beginFrame(WIDTH, HEIGHT, frameTime(frame));
+        recordFrame(track, frame);
+    }
+    CHECK(marker(track.getNewest()) == 119);
+    CHECK(marker(track.findByAge(3.5 * FRAME_INTERVAL)) == 115);
+    CHECK(marker(track.findByAge(0.1)) <= 113);
+
+    // Older than the span: the oldest kept frame
+    CHECK(marker(track.findByAge(10.0)) >= 119 - 8);
+
+    // Recording stopped growing the pool once the span was covered
+    const size_t frames = history.getFrameCount();
+    CHECK(frames <= static_cast<size_t>(0.1 / FRAME_INTERVAL) + 3);
+    for (int frame = 120; frame < 240; ++frame) {
+        history.beginFrame(WIDTH, HEIGHT, frameTime(frame));
+        recordFrame(track, frame);
+    }
+    CHECK(history.getFrameCount() == frames);
+    CHECK(history.getAllocatedBytes() == frames * FRAME_BYTES);
+}
+
+void testReadFrameKept() {
+    FrameHistory history;
+    HistoryTrack track;
+    track.bind(&history);
+    history.beginFrame(WIDTH, HEIGHT, 0.0);
+    track.setSpan(0.0);
+
+    // A frame handed out this frame is never the buffer given for recording
+    for (int frame = 0; frame < 10; ++frame) {
+        history.beginFrame(WIDTH, HEIGHT, frameTime(frame));
+        const Frame* previous = track.getNewest();
+        Frame* recorded = track.record();
+        CHECK(recorded != nullptr && recorded != previous);
+        if (recorded) {
+            recorded->data()[0] = static_cast<uint32_t>(frame);
+        }
+        CHECK(frame == 0 || marker(previous) == frame - 1);
+    }
+}
+
+void testSharedPool() {
+    FrameHistory history;
+    HistoryTrack first;
+    HistoryTrack second;
+    first.bind(&history);
+    second.bind(&history);
+    history.beginFrame(WIDTH, HEIGHT, 0.0);
+    first.setSpan(0.2);
+    second.setSpan(0.2);
+    for (int frame = 0; frame < 60; ++frame) {
+        history.beginFrame(WIDTH, HEIGHT, frameTime(frame));
+        recordFrame(first, frame);
+        recordFrame(second, frame);
+    }
+    const size_t frames = history.getFrameCount();
+
+    // A released track's frames go to the other track, not to the heap
+    {
+        HistoryTrack third;
+        third.bind(&history);
+        third.setSpan(0.1);
+        second.clear();
+        for (int frame = 60; frame < 120; ++frame) {
+            history.beginFrame(WIDTH, HEIGHT, frameTime(frame));
+            recordFrame(first, frame);
+            recordFrame(third, frame);
+        }
+        CHECK(history.getTrackCount() == 3);
+        CHECK(history.getFrameCount() <= frames);
+    }
+    CHECK(history.getTrackCount() == 2);
+
+    // Spares beyond one per track are given back at the next frame
+    second.clear();
+    first.clear();
+    history.beginFrame(WIDTH, HEIGHT, frameTime(120));
+    CHECK(history.getFrameCount() == 2);
+}
+
+void testBudget() {
+    // Room for eight frames, but the span needs sixty
+    FrameHistory history(8 * FRAME_BYTES);
+    HistoryTrack track;
+    track.bind(&history);
+    history.beginFrame(WIDTH, HEIGHT, 0.0);
+    track.setSpan(1.0);
+
+    int recordings = 0;
+    for (int frame = 0; frame < 180; ++frame) {
+        history.beginFrame(WIDTH, HEIGHT, frameTime(frame));
+        if (track.isRecordDue()) {
+            ++recordings;
+        }
+        recordFrame(track, frame);
+    }
+    CHECK(history.getAllocatedBytes() <= history.getBudgetBytes());
+    CHECK(recordings < 180 / 4);
+
+    // The full span is still reachable, at a coarser step
+    const int reached = marker(track.findByAge(1.0));
+    CHECK(reached >= 0);
+    CHECK(179 - reached >= 60);
+    CHECK(179 - reached <= 60 + 12);
+}
+
+void testReset() {
+    FrameHistory history;
+    HistoryTrack track;
+    track.bind(&history);
+    history.beginFrame(WIDTH, HEIGHT, 0.0);
+    track.setSpan(0.1);
+    for (int frame = 0; frame < 10; ++frame) {
+        history.beginFrame(WIDTH, HEIGHT, frameTime(frame));
+        recordFrame(track, frame);
+    }
+
+    // A clock going backwards (a seek) drops what was recorded
+    history.beginFrame(WIDTH, HEIGHT, frameTime(2));
+    CHECK(track.getNewest() == nullptr);
+    recordFrame(track, 2);
+    CHECK(marker(track.getNewest()) == 2);
+
+    // So do another size and another format, which also free the pool
+    history.beginFrame(WIDTH * 2, HEIGHT, frameTime(3));
+    CHECK(track.getNewest() == nullptr);
+    CHECK(history.getFrameCount() == 0);
+    Frame* recorded = track.record();
+    CHECK(recorded != nullptr && recorded->getWidth() == WIDTH * 2);
+
+    history.beginFrame(WIDTH * 2, HEIGHT, frameTime(4), effects::PixelFormat::RGBA16F);
+    CHECK(track.getNewest() == nullptr);
+    recorded = track.record();
+    CHECK(recorded != nullptr && recorded->getFormat() == effects::PixelFormat::RGBA16F);
+}
+
+} // namespace
+
+void runFrameHistoryTests() {
+    testLookup();
+    testReadFrameKept();
+    testSharedPool();
+    testBudget();
+    testReset();
+}
+
+} // namespace test
+} // namespace gamma
@@ -0,0 +1,108 @@
+#include "Test.h"
+#include "effects/FramePool.h"
+#include <cstdint>
+
+namespace gamma {
+namespace test {
+
+namespace {
+
+const size_t KB = 1024;
+
+bool isAligned(const void* buffer) {
+    return reinterpret_cast<uintptr_t>(buffer) % effects::FramePool::ALIGNMENT == 0;
+}
+
+void testSizeClasses() {
+    using effects::FramePool;
+    CHECK(FramePool::getClassBytes(1) == 4 * KB);
+    CHECK(FramePool::getClassBytes(4 * KB) == 4 * KB);
+    CHECK(FramePool::getClassBytes(4 * KB + 1) == 5 * KB);
+    CHECK(FramePool::getClassBytes(7 * KB + 1) == 8 * KB);
+    CHECK(FramePool::getClassBytes(8 * KB) == 8 * KB);
+    CHECK(FramePool::getClassBytes(8 * KB + 1) == 10 * KB);
+
+    // Classes cover every request, waste at most a quarter and never shrink
+    bool covers = true;
+    bool tight = true;
+    bool monotonic = true;
+    size_t previous = 0;
+    for (size_t bytes = 1; bytes < 256 * 1024 * KB; bytes += bytes / 7 + 1) {
+        const size_t classBytes = FramePool::getClassBytes(bytes);
+        covers = covers && classBytes >= bytes;
+        tight = tight && (bytes <= 4 * KB || classBytes - bytes <= bytes / 4);
+        monotonic = monotonic && classBytes >= previous;
+        previous = classBytes;
+    }
+    CHECK(covers);
+    CHECK(tight);
+    CHECK(monotonic);
+}
+
+void testReuseAndBudget() {
+    effects::FramePool pool;
+    pool.setPrefault(false);
+    pool.setHugePageMode(effects::HugePageMode::Off);
+    pool.setBudgetBytes(64 * KB);
+
+    size_t capacity = 0;
+    void* a = pool.acquire(15 * KB, capacity);
+    CHECK(capacity == 16 * KB);
+    CHECK(isAligned(a));
+    void* b = pool.acquire(16 * KB, capacity);
+    void* c = pool.acquire(8 * KB, capacity);
+    CHECK(pool.getStats().liveBytes == 40 * KB);
+    CHECK(pool.getStats().systemAllocations == 3);
+
+    pool.release(a);
+    pool.release(b);
+    pool.release(c);
+    effects::FramePoolStats stats = pool.getStats();
+    CHECK(stats.liveBuffers == 0);
+    CHECK(stats.pooledBuffers == 3);
+    CHECK(stats.pooledBytes == 40 * KB);
+    CHECK(stats.peakLiveBytes == 40 * KB);
+
+    // Same class: served from the pool
+    void* reused = pool.acquire(16 * KB, capacity);
+    CHECK(reused == a || reused == b);
+    CHECK(pool.getStats().reuses == 1);
+    CHECK(pool.getStats().systemAllocations == 3);
+    pool.release(reused);
+
+    // Lowering the budget evicts pooled buffers, largest classes first
+    pool.setBudgetBytes(20 * KB);
+    stats = pool.getStats();
+    CHECK(stats.pooledBuffers == 1);
+    CHECK(stats.pooledBytes == 8 * KB);
+
+    // Room is made by evicting the rest; past that, requests still succeed
+    void* first = pool.acquire(16 * KB, capacity);
+    CHECK(pool.getStats().pooledBuffers == 0);
+    CHECK(pool.getStats().overBudget == 0);
+    void* second = pool.acquire(16 * KB, capacity);
+    CHECK(second != nullptr);
+    CHECK(pool.getStats().overBudget == 1);
+
+    // Released over budget, a buffer is freed instead of pooled
+    pool.release(first);
+    CHECK(pool.getStats().pooledBuffers == 0);
+    pool.release(second);
+    CHECK(pool.getStats().pooledBuffers == 1);
+
+    pool.trim();
+    stats = pool.getStats();
+    CHECK(stats.pooledBuffers == 0);
+    CHECK(stats.pooledBytes == 0);
+    CHECK(stats.liveBytes == 0);
+}
+
+} // namespace
+
+void runFramePoolTests() {
+    testSizeClasses();
+    testReuseAndBudget();
+}
+
+} // namespace test
+} // namespace gamma
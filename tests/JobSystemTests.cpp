@@ -0,0 +1,121 @@
+#include "Test.h"
+#include "core/JobSystem.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace gamma {
+namespace test {
+
+namespace {
+
+using core::JobSystem;
+
+void spinUntil(const std::atomic<bool>& flag) {
+    while (!flag.load()) {
+        std::this_thread::yield();
+    }
+}
+
+void testDependencies() {
+    JobSystem jobs(2);
+    std::atomic<int> clock(0);
+    std::atomic<bool> release(false);
+    int first = -1, second = -1, joined = -1, continued = -1;
+
+    // The first dependency is held back until the whole graph is wired up
+    JobSystem::TaskHandle a = jobs.submit([&]() { spinUntil(release); first = clock++; });
+    JobSystem::TaskHandle b = jobs.submit([&]() { second = clock++; });
+    JobSystem::TaskHandle c = jobs.submitAfter({a, nullptr, b}, [&]() { joined = clock++; });
+    JobSystem::TaskHandle d = jobs.then(c, [&]() { continued = clock++; });
+    CHECK(!JobSystem::isDone(c));
+    CHECK(!JobSystem::isDone(d));
+
+    release = true;
+    jobs.wait(d);
+    CHECK(JobSystem::isDone(a) && JobSystem::isDone(b) && JobSystem::isDone(c));
+    CHECK(joined > first && joined > second);
+    CHECK(continued > joined);
+    CHECK(clock == 4);
+
+    // A continuation of finished work runs right away; null handles count as done
+    bool late = false;
+    jobs.wait(jobs.then(d, [&]() { late = true; }));
+    CHECK(late);
+    CHECK(JobSystem::isDone(nullptr));
+}
+
+void testParallelFor() {
+    JobSystem jobs(3);
+    const size_t grainSizes[] = {0, 1, 7, 1000, 5000};
+    for (size_t grainSize : grainSizes) {
+        std::vector<int> visits(1000, 0);
+        jobs.parallelFor(0, visits.size(), grainSize, [&visits](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                ++visits[i];
+            }
+        });
+        bool once = true;
+        for (int count : visits) {
+            once = once && count == 1;
+        }
+        CHECK(once);
+    }
+
+    // An offset range, and an empty one
+    std::atomic<size_t> sum(0);
+    jobs.parallelFor(10, 20, 3, [&sum](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            sum += i;
+        }
+    });
+    CHECK(sum == 145);
+    bool called = false;
+    jobs.parallelFor(5, 5, 1, [&called](size_t, size_t) { called = true; });
+    CHECK(!called);
+}
+
+void testWaitHelpsFrameCritical() {
+    JobSystem jobs(1);
+    const std::thread::id caller = std::this_thread::get_id();
+    CHECK(jobs.getCurrentWorkerIndex() == -1);
+
+    // Keep the only worker busy so queued work can only run on the waiting thread
+    std::atomic<bool> started(false);
+    std::atomic<bool> release(false);
+    int blockerIndex = -2;
+    JobSystem::TaskHandle blocker = jobs.submit([&]() {
+        blockerIndex = jobs.getCurrentWorkerIndex();
+        started = true;
+        spinUntil(release);
+    });
+    spinUntil(started);
+
+    std::thread::id backgroundThread;
+    std::thread::id criticalThread;
+    JobSystem::TaskHandle background = jobs.submit([&]() { backgroundThread = std::this_thread::get_id(); },
+                                                   core::TaskPriority::Background);
+    JobSystem::TaskHandle critical = jobs.submit([&]() { criticalThread = std::this_thread::get_id(); });
+
+    // The waiting thread runs the frame-critical task itself, and leaves the background one
+    jobs.wait(critical);
+    CHECK(criticalThread == caller);
+    CHECK(!JobSystem::isDone(background));
+
+    release = true;
+    jobs.wait(background);
+    CHECK(backgroundThread != caller);
+    CHECK(blockerIndex == 0);
+    jobs.wait(blocker);
+}
+
+} // namespace
+
+void runJobSystemTests() {
+    testDependencies();
+    testParallelFor();
+    testWaitHelpsFrameCritical();
+}
+
+} // namespace test
+} // namespace gamma
@@ -0,0 +1,324 @@
+#include "Test.h"
+#include "effects/ColorLut.h"
+#include "effects/Frame.h"
+#include "effects/Kernels.h"
+#include <algorithm>
+#include <vector>
+
+namespace gamma {
+namespace test {
+
+namespace {
+
+// Span lengths covering every tail a vector loop can leave
+const size_t COUNTS[] = {1, 3, 7, 8, 17, 64, 1001};
+const size_t MAX_COUNT = 1001;
+
+struct Variant {
+    const char* name;
+    const effects::KernelTable* table;
+};
+
+// Scalar first, as the reference; then every variant compiled in and supported by this CPU
+std::vector<Variant> getVariants() {
+    std::vector<Variant> variants;
+    variants.push_back({"scalar", effects::getScalarKernels()});
+    const effects::SimdLevel supported = effects::getSupportedSimdLevel();
+    if (effects::getSse2Kernels() && supported >= effects::SimdLevel::SSE2) {
+        variants.push_back({"SSE2", effects::getSse2Kernels()});
+    }
+    if (effects::getAvx2Kernels() && supported >= effects::SimdLevel::AVX2) {
+        variants.push_back({"AVX2", effects::getAvx2Kernels()});
+    }
+    return variants;
+}
+
+std::vector<uint32_t> randomPixels(Random& random, size_t count) {
+    std::vector<uint32_t> pixels(count);
+    for (uint32_t& pixel : pixels) {
+        pixel = random.nextPixel();
+    }
+    return pixels;
+}
+
+std::vector<float> randomFloats(Random& random, size_t count, float low, float high) {
+    std::vector<float> values(count);
+    for (float& value : values) {
+        value = random.nextFloat(low, high);
+    }
+    return values;
+}
+
+// Float kernels may order their arithmetic differently; a few ulps apart is equal
+bool nearlyEqual(const float* a, const float* b, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        const float tolerance = 1e-5f * std::max(1.0f, std::max(a[i] < 0 ? -a[i] : a[i], b[i] < 0 ? -b[i] : b[i]));
+        const float difference = a[i] - b[i];
+        if (difference > tolerance || difference < -tolerance) {
+            return false;
+        }
+    }
+    return true;
+}
+
+const effects::ColorMatrix MATRIX = {{
+    {1.10f, 0.05f, -0.02f, -8.0f},
+    {-0.10f, 0.90f, 0.20f, 12.5f},
+    {0.03f, -0.25f, 1.30f, 3.0f}
+}};
+
+void testColorMatrix(const std::vector<Variant>& variants, Random& random) {
+    const std::vector<uint32_t> src = randomPixels(random, MAX_COUNT);
+    const std::vector<float> srcFloat = randomFloats(random, MAX_COUNT * 4, -0.2f, 1.2f);
+    for (size_t count : COUNTS) {
+        std::vector<uint32_t> expected(count);
+        std::vector<float> expectedFloat(count * 4);
+        variants[0].table->colorMatrix(src.data(), expected.data(), count, MATRIX);
+        variants[0].table->colorMatrixFloat(srcFloat.data(), expectedFloat.data(), count, MATRIX);
+        for (size_t v = 1; v < variants.size(); ++v) {
+            std::vector<uint32_t> result(count);
+            std::vector<float> resultFloat(count * 4);
+            variants[v].table->colorMatrix(src.data(), result.data(), count, MATRIX);
+            variants[v].table->colorMatrixFloat(srcFloat.data(), resultFloat.data(), count, MATRIX);
+            CHECK(result == expected);
+            CHECK(nearlyEqual(resultFloat.data(), expectedFloat.data(), count * 4));
+        }
+    }
+}
+
+void testCopies(const std::vector<Variant>& variants, Random& random) {
+    const std::vector<uint32_t> red = randomPixels(random, MAX_COUNT);
+    const std::vector<uint32_t> green = randomPixels(random, MAX_COUNT);
+    const std::vector<uint32_t> blue = randomPixels(random, MAX_COUNT);
+    for (size_t count : COUNTS) {
+        std::vector<uint32_t> expectedMerge(count);
+        std::vector<uint32_t> expectedReverse(count);
+        variants[0].table->mergeChannels(red.data(), green.data(), blue.data(), expectedMerge.data(), count);
+        variants[0].table->reverseCopy(red.data(), expectedReverse.data(), count);
+        CHECK(expectedReverse.front() == red[count - 1]);
+        for (size_t v = 1; v < variants.size(); ++v) {
+            std::vector<uint32_t> merged(count);
+            std::vector<uint32_t> reversed(count);
+            variants[v].table->mergeChannels(red.data(), green.data(), blue.data(), merged.data(), count);
+            variants[v].table->reverseCopy(red.data(), reversed.data(), count);
+            CHECK(merged == expectedMerge);
+            CHECK(reversed == expectedReverse);
+        }
+    }
+}
+
+void testBlend(const std::vector<Variant>& variants, Random& random) {
+    const std::vector<uint32_t> a = randomPixels(random, MAX_COUNT);
+    const std::vector<uint32_t> b = randomPixels(random, MAX_COUNT);
+    const std::vector<float> aFloat = randomFloats(random, MAX_COUNT * 4, 0.0f, 1.0f);
+    const std::vector<float> bFloat = randomFloats(random, MAX_COUNT * 4, 0.0f, 1.0f);
+    const uint32_t weights[] = {0, 1, 100, 255, 256};
+    for (uint32_t weight : weights) {
+        for (size_t count : COUNTS) {
+            std::vector<uint32_t> expected(count);
+            std::vector<float> expectedFloat(count * 4);
+            variants[0].table->blend(a.data(), b.data(), expected.data(), count, weight);
+            variants[0].table->blendFloat(aFloat.data(), bFloat.data(), expectedFloat.data(), count, weight / 256.0f);
+            if (weight == 0) {
+                CHECK(std::equal(expected.begin(), expected.end(), a.begin()));
+            }
+            for (size_t v = 1; v < variants.size(); ++v) {
+                std::vector<uint32_t> result(count);
+                variants[v].table->blend(a.data(), b.data(), result.data(), count, weight);
+                CHECK(result == expected);
+
+                // In place, as a folded blend runs
+                std::vector<uint32_t> inPlace(b.begin(), b.begin() + static_cast<std::ptrdiff_t>(count));
+                variants[v].table->blend(a.data(), inPlace.data(), inPlace.data(), count, weight);
+                CHECK(inPlace == expected);
+
+                std::vector<float> resultFloat(count * 4);
+                variants[v].table->blendFloat(aFloat.data(), bFloat.data(), resultFloat.data(), count, weight / 256.0f);
+                CHECK(nearlyEqual(resultFloat.data(), expectedFloat.data(), count * 4));
+            }
+        }
+    }
+}
+
+void testConversions(const std::vector<Variant>& variants, Random& random) {
+    const std::vector<uint32_t> pixels = randomPixels(random, MAX_COUNT);
+    // Out of range on purpose: packing clamps
+    const std::vector<float> floats = randomFloats(random, MAX_COUNT * 4, -0.25f, 1.25f);
+    const std::vector<float> wide = randomFloats(random, MAX_COUNT * 4, -70.0f, 70.0f);
+    for (size_t count : COUNTS) {
+        std::vector<float> expectedUnpacked(count * 4);
+        std::vector<uint32_t> expectedPacked(count);
+        std::vector<uint16_t> expectedHalves(count * 4);
+        std::vector<float> expectedWidened(count * 4);
+        const effects::KernelTable& reference = *variants[0].table;
+        reference.unpackPixels(pixels.data(), expectedUnpacked.data(), count);
+        reference.packPixels(floats.data(), expectedPacked.data(), count);
+        reference.floatToHalf(wide.data(), expectedHalves.data(), count);
+        reference.halfToFloat(expectedHalves.data(), expectedWidened.data(), count);
+
+        // Unpacking then packing is lossless
+        std::vector<uint32_t> roundTrip(count);
+        reference.packPixels(expectedUnpacked.data(), roundTrip.data(), count);
+        CHECK(std::equal(roundTrip.begin(), roundTrip.end(), pixels.begin()));
+
+        for (size_t v = 1; v < variants.size(); ++v) {
+            const effects::KernelTable& kernels = *variants[v].table;
+            std::vector<float> unpacked(count * 4);
+            std::vector<uint32_t> packed(count);
+            std::vector<uint16_t> halves(count * 4);
+            std::vector<float> widened(count * 4);
+            kernels.unpackPixels(pixels.data(), unpacked.data(), count);
+            kernels.packPixels(floats.data(), packed.data(), count);
+            kernels.floatToHalf(wide.data(), halves.data(), count);
+            kernels.halfToFloat(expectedHalves.data(), widened.data(), count);
+            CHECK(nearlyEqual(unpacked.data(), expectedUnpacked.data(), count * 4));
+            CHECK(packed == expectedPacked);
+            CHECK(halves == expectedHalves);
+            CHECK(widened == expectedWidened);
+        }
+    }
+}
+
+void testBoxFilters(const std::vector<Variant>& variants, Random& random) {
+    std::vector<std::vector<uint32_t>> rows;
+    std::vector<std::vector<float>> floatRows;
+    std::vector<const uint32_t*> sources;
+    std::vector<const float*> floatSources;
+    for (int t = 0; t < effects::MAX_BOX_FILTER_TAPS; ++t) {
+        rows.push_back(randomPixels(random, MAX_COUNT));
+        floatRows.push_back(randomFloats(random, MAX_COUNT * 4, 0.0f, 1.0f));
+    }
+    for (int t = 0; t < effects::MAX_BOX_FILTER_TAPS; ++t) {
+        sources.push_back(rows[static_cast<size_t>(t)].data());
+        floatSources.push_back(floatRows[static_cast<size_t>(t)].data());
+    }
+
+    const int tapCounts[] = {2, 3, 5, 8, 16, effects::MAX_BOX_FILTER_TAPS};
+    for (int taps : tapCounts) {
+        const uint32_t scale = 65536u / static_cast<uint32_t>(taps);
+        for (size_t count : COUNTS) {
+            // The reference is the generic path the specialized filters must match
+            std::vector<uint16_t> accumulators(count * 4, 0);
+            for (int t = 0; t < taps; ++t) {
+                variants[0].table->accumulate(sources[static_cast<size_t>(t)], accumulators.data(), count);
+            }
+            std::vector<uint32_t> expected(count);
+            variants[0].table->resolve(accumulators.data(), expected.data(), count, scale);
+            std::vector<float> expectedFloat(count * 4);
+            variants[0].table->boxFilterFloat(floatSources.data(), taps, expectedFloat.data(), count, 1.0f / taps);
+
+            for (const Variant& variant : variants) {
+                std::vector<uint32_t> filtered(count);
+                variant.table->boxFilter[taps](sources.data(), filtered.data(), count, scale);
+                CHECK(filtered == expected);
+
+                std::vector<uint16_t> sums(count * 4, 0);
+                for (int t = 0; t < taps; ++t) {
+                    variant.table->accumulate(sources[static_cast<size_t>(t)], sums.data(), count);
+                }
+                CHECK(sums == accumulators);
+
+                std::vector<float> filteredFloat(count * 4);
+                variant.table->boxFilterFloat(floatSources.data(), taps, filteredFloat.data(), count, 1.0f / taps);
+                CHECK(nearlyEqual(filteredFloat.data(), expectedFloat.data(), count * 4));
+            }
+        }
+    }
+}
+
+void testLut(const std::vector<Variant>& variants, Random& random) {
+    // A curved table, so interpolation weights matter
+    effects::ColorLut lut(17);
+    for (int b = 0; b < lut.getSize(); ++b) {
+        for (int g = 0; g < lut.getSize(); ++g) {
+            for (int r = 0; r < lut.getSize(); ++r) {
+                const float red = lut.getLatticeValue(0, r);
+                const float green = lut.getLatticeValue(1, g);
+                const float blue = lut.getLatticeValue(2, b);
+                float* value = lut.entry(r, g, b);
+                value[0] = red * red * 0.8f + blue * 0.2f;
+                value[1] = green * (1.0f - 0.3f * red);
+                value[2] = 1.0f - blue * blue;
+            }
+        }
+    }
+
+    const std::vector<uint32_t> src = randomPixels(random, MAX_COUNT);
+    const std::vector<float> srcFloat = randomFloats(random, MAX_COUNT * 4, 0.0f, 1.0f);
+    for (size_t count : COUNTS) {
+        std::vector<uint32_t> expected(count);
+        std::vector<float> expectedFloat(count * 4);
+        variants[0].table->applyLut(src.data(), expected.data(), count, lut.getGrid());
+        variants[0].table->applyLutFloat(srcFloat.data(), expectedFloat.data(), count, lut.getGrid());
+        CHECK((expected[0] >> 24) == (src[0] >> 24));   // Alpha copied
+        for (size_t v = 1; v < variants.size(); ++v) {
+            std::vector<uint32_t> result(count);
+            std::vector<float> resultFloat(count * 4);
+            variants[v].table->applyLut(src.data(), result.data(), count, lut.getGrid());
+            variants[v].table->applyLutFloat(srcFloat.data(), resultFloat.data(), count, lut.getGrid());
+            CHECK(result == expected);
+            CHECK(nearlyEqual(resultFloat.data(), expectedFloat.data(), count * 4));
+        }
+    }
+}
+
+void testRemap(const std::vector<Variant>& variants, Random& random) {
+    effects::Frame frame(40, 30);
+    for (int y = 0; y < frame.getHeight(); ++y) {
+        for (int x = 0; x < frame.getWidth(); ++x) {
+            frame.row(y)[x] = random.nextPixel();
+        }
+    }
+    const effects::RemapSource source = {frame.rowData(0), frame.getStride(), frame.getWidth(), frame.getHeight(),
+                                         frame.getFormat()};
+
+    // Positions beyond every edge too: edge pixels extend
+    const std::vector<float> x = randomFloats(random, MAX_COUNT, -5.0f, 45.0f);
+    const std::vector<float> y = randomFloats(random, MAX_COUNT, -5.0f, 35.0f);
+    for (size_t count : COUNTS) {
+        std::vector<uint32_t> expected(count);
+        std::vector<float> expectedFloat(count * 4);
+        variants[0].table->remap(source, x.data(), y.data(), expected.data(), count);
+        variants[0].table->remapFloat(source, x.data(), y.data(), expectedFloat.data(), count);
+        for (size_t v = 1; v < variants.size(); ++v) {
+            std::vector<uint32_t> result(count);
+            std::vector<float> resultFloat(count * 4);
+            variants[v].table->remap(source, x.data(), y.data(), result.data(), count);
+            variants[v].table->remapFloat(source, x.data(), y.data(), resultFloat.data(), count);
+            CHECK(result == expected);
+            CHECK(nearlyEqual(resultFloat.data(), expectedFloat.data(), count * 4));
+        }
+    }
+
+    // At pixel centers the sample is the pixel itself
+    const float centerX[] = {0.5f, 10.5f, 39.5f};
+    const float centerY[] = {0.5f, 20.5f, 29.5f};
+    for (const Variant& variant : variants) {
+        uint32_t sampled[3];
+        variant.table->remap(source, centerX, centerY, sampled, 3);
+        CHECK(sampled[0] == frame.row(0)[0]);
+        CHECK(sampled[1] == frame.row(20)[10]);
+        CHECK(sampled[2] == frame.row(29)[39]);
+    }
+}
+
+} // namespace
+
+void runKernelTests() {
+    const std::vector<Variant> variants = getVariants();
+    if (!CHECK(variants[0].table != nullptr)) {
+        return;
+    }
+
+    Random random;
+    testColorMatrix(variants, random);
+    testCopies(variants, random);
+    testBlend(variants, random);
+    testConversions(variants, random);
+    testBoxFilters(variants, random);
+    testLut(variants, random);
+    testRemap(variants, random);
+}
+
+} // namespace test
+} // namespace gamma
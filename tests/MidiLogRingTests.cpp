@@ -0,0 +1,123 @@
+#include "Test.h"
+#include "midi/MidiLogRing.h"
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace gamma {
+namespace test {
+
+namespace {
+
+using midi::MidiLogRing;
+
+midi::MidiMessage makeMessage(unsigned char status, int number) {
+    return midi::MidiMessage({status, 0x10, 0x20}, number * 0.5, "Message " + std::to_string(number));
+}
+
+std::string expectedText(int number) {
+    char text[64];
+    std::snprintf(text, sizeof(text), "[%.3f] Message %d", number * 0.5, number);
+    return text;
+}
+
+void testTypeIndex() {
+    MidiLogRing ring(8);
+    const unsigned char statuses[] = {0x90, 0xB0, 0x80, 0xE0, 0xF0};
+    for (int i = 0; i < 5; ++i) {
+        ring.append(makeMessage(statuses[i], i));
+    }
+    ring.append(midi::MidiMessage({}, 3.0, "Device connected"));
+
+    CHECK(ring.size() == 6);
+    CHECK(ring.getCount(-1) == 6);
+    CHECK(ring.getCount(MidiLogRing::TYPE_NOTE) == 2);
+    CHECK(ring.getCount(MidiLogRing::TYPE_CONTROL_CHANGE) == 1);
+    CHECK(ring.getCount(MidiLogRing::TYPE_PITCH_BEND) == 1);
+    CHECK(ring.getCount(MidiLogRing::TYPE_SYSTEM) == 1);
+    CHECK(ring.getCount(MidiLogRing::TYPE_OTHER) == 1);
+
+    // Newest first, across all types and within one
+    CHECK(std::string(ring.getNewest(-1, 0).getText()) == "[3.000] Device connected");
+    CHECK(ring.getNewest(-1, 5).getText() == expectedText(0));
+    CHECK(ring.getNewest(MidiLogRing::TYPE_NOTE, 0).getText() == expectedText(2));
+    CHECK(ring.getNewest(MidiLogRing::TYPE_NOTE, 1).getText() == expectedText(0));
+
+    ring.clear();
+    CHECK(ring.size() == 0);
+    CHECK(ring.getCount(MidiLogRing::TYPE_NOTE) == 0);
+    ring.append(makeMessage(0xB0, 9));
+    CHECK(ring.getNewest(MidiLogRing::TYPE_CONTROL_CHANGE, 0).getText() == expectedText(9));
+}
+
+void testOverwrite() {
+    // Three notes for every control change, through the ring several times
+    const size_t capacity = 10;
+    MidiLogRing ring(capacity);
+    std::vector<int> notes;
+    std::vector<int> changes;
+    for (int i = 0; i < 37; ++i) {
+        const bool change = i % 4 == 3;
+        ring.append(makeMessage(change ? 0xB0 : 0x90, i));
+        (change ? changes : notes).push_back(i);
+    }
+    CHECK(ring.size() == capacity);
+
+    // Only the last ten messages remain, and each type index holds exactly its own of them
+    size_t remainingNotes = 0;
+    size_t remainingChanges = 0;
+    for (int i = 37 - static_cast<int>(capacity); i < 37; ++i) {
+        (i % 4 == 3 ? remainingChanges : remainingNotes)++;
+    }
+    if (CHECK(ring.getCount(MidiLogRing::TYPE_NOTE) == remainingNotes)) {
+        for (size_t i = 0; i < remainingNotes; ++i) {
+            CHECK(ring.getNewest(MidiLogRing::TYPE_NOTE, i).getText() == expectedText(notes[notes.size() - 1 - i]));
+        }
+    }
+    if (CHECK(ring.getCount(MidiLogRing::TYPE_CONTROL_CHANGE) == remainingChanges)) {
+        for (size_t i = 0; i < remainingChanges; ++i) {
+            CHECK(ring.getNewest(MidiLogRing::TYPE_CONTROL_CHANGE, i).getText() ==
+                  expectedText(changes[changes.size() - 1 - i]));
+        }
+    }
+    CHECK(ring.getNewest(-1, capacity - 1).getText() == expectedText(27));
+}
+
+void testIndexGrowth() {
+    // Past the index ring's first allocation, with entries dropped while it grows
+    MidiLogRing ring(300);
+    for (int i = 0; i < 700; ++i) {
+        ring.append(makeMessage(0x90, i));
+    }
+    CHECK(ring.getCount(MidiLogRing::TYPE_NOTE) == 300);
+    CHECK(ring.getNewest(MidiLogRing::TYPE_NOTE, 0).getText() == expectedText(699));
+    CHECK(ring.getNewest(MidiLogRing::TYPE_NOTE, 299).getText() == expectedText(400));
+}
+
+void testLongText() {
+    MidiLogRing ring(2);
+    const std::string dump(3 * MidiLogRing::TEXT_CAPACITY, 'F');
+    ring.append(midi::MidiMessage({0xF0, 0x7E}, 1.0, dump));
+    const MidiLogRing::Entry& entry = ring.getNewest(-1, 0);
+    CHECK(entry.length >= MidiLogRing::TEXT_CAPACITY);
+    CHECK(std::string(entry.getText()) == "[1.000] " + dump);
+
+    // The slot is reused for short text, which is inline again
+    ring.append(makeMessage(0x90, 1));
+    ring.append(makeMessage(0x90, 2));
+    CHECK(ring.getNewest(-1, 0).length < MidiLogRing::TEXT_CAPACITY);
+    CHECK(ring.getNewest(-1, 0).getText() == expectedText(2));
+    CHECK(ring.getCount(MidiLogRing::TYPE_SYSTEM) == 0);
+}
+
+} // namespace
+
+void runMidiLogRingTests() {
+    testTypeIndex();
+    testOverwrite();
+    testIndexGrowth();
+    testLongText();
+}
+
+} // namespace test
+} // namespace gamma
@@ -0,0 +1,86 @@
+#include "Test.h"
+#include "midi/MidiReplay.h"
+#include <sstream>
+#include <vector>
+
+namespace gamma {
+namespace test {
+
+namespace {
+
+// As MidiManager::exportToCSV writes it: delta times, hex bytes in quotes
+const char* const LOG =
+    "Timestamp,Raw_Bytes,Description,Status,Channel,Data1,Data2,Message_Type\n"
+    "0.000000,\"\",\"Device connected\",,,,,Connection\n"
+    "0.100000,\"B0 07 64\",\"Control Change\",B0,1,7,100,CC\n"
+    "0.250000,\"90 3C 7F\",\"Note On\",90,1,60,127,Note\n"
+    "garbage without a comma\n"
+    "0.500000,no quoted bytes\n"
+    "0.050000,\"80 3C 00\",\"Note Off\",80,1,60,0,Note\n";
+
+struct Injected {
+    std::vector<unsigned char> message;
+    double timestamp;
+};
+
+void testParse() {
+    midi::MidiReplay replay;
+    std::istringstream input(LOG);
+    CHECK(replay.parse(input));
+    CHECK(replay.getMessageCount() == 3);
+    CHECK(replay.getDuration() > 0.3999 && replay.getDuration() < 0.4001);
+    CHECK(!replay.isFinished());
+
+    std::vector<Injected> injected;
+    auto collect = [&injected](const std::vector<unsigned char>& message, double timestamp) {
+        injected.push_back({message, timestamp});
+    };
+
+    // Messages come due at their cumulative times
+    CHECK(replay.advance(0.05, collect) == 0);
+    CHECK(replay.advance(0.1, collect) == 1);
+    CHECK(replay.advance(0.3, collect) == 0);
+    CHECK(replay.advance(1.0, collect) == 2);
+    CHECK(replay.isFinished());
+    CHECK(replay.advance(2.0, collect) == 0);
+
+    if (CHECK(injected.size() == 3)) {
+        CHECK((injected[0].message == std::vector<unsigned char>{0xB0, 0x07, 0x64}));
+        CHECK(injected[0].timestamp == 0.1);
+        CHECK((injected[1].message == std::vector<unsigned char>{0x90, 0x3C, 0x7F}));
+        CHECK(injected[1].timestamp == 0.25);
+        CHECK((injected[2].message == std::vector<unsigned char>{0x80, 0x3C, 0x00}));
+    }
+
+    // Rewinding replays from the start
+    replay.rewind();
+    CHECK(!replay.isFinished());
+    CHECK(replay.advance(1.0, collect) == 3);
+}
+
+void testEmpty() {
+    midi::MidiReplay replay;
+    std::istringstream headerOnly("Timestamp,Raw_Bytes,Description\n0.1,\"\",\"Device connected\"\n");
+    CHECK(!replay.parse(headerOnly));
+    CHECK(replay.getMessageCount() == 0);
+    CHECK(replay.isFinished());
+    CHECK(replay.getDuration() == 0.0);
+
+    // A log without the header is read from its first row
+    std::istringstream noHeader("0.2,\"C0 05\",\"Program Change\"\n");
+    CHECK(replay.parse(noHeader));
+    CHECK(replay.getMessageCount() == 1);
+
+    CHECK(!replay.load("/nonexistent/midi_log.csv"));
+    CHECK(replay.getMessageCount() == 0);
+}
+
+} // namespace
+
+void runMidiReplayTests() {
+    testParse();
+    testEmpty();
+}
+
+} // namespace test
+} // namespace gamma
@@ -0,0 +1,105 @@
+#include "Test.h"
+#include "effects/ParameterBlock.h"
+#include <thread>
+
+namespace gamma {
+namespace test {
+
+namespace {
+
+const int PUBLISH_COUNT = 20000;
+
+// Snapshot i holds 1 + i % 5 slots, each with its first parameter at i
+void fillSnapshot(effects::ChainParameters& parameters, int i) {
+    parameters.slots.resize(static_cast<size_t>(1 + i % 5));
+    for (effects::ChainSlot& slot : parameters.slots) {
+        slot.parameters[0] = static_cast<float>(i);
+    }
+    parameters.masterMix = static_cast<float>(i);
+}
+
+bool isConsistent(const effects::ChainParameters& parameters) {
+    const int i = static_cast<int>(parameters.masterMix);
+    if (parameters.sequence != static_cast<uint64_t>(i) + 1 ||
+        parameters.slots.size() != static_cast<size_t>(1 + i % 5)) {
+        return false;
+    }
+    for (const effects::ChainSlot& slot : parameters.slots) {
+        if (slot.parameters[0] != parameters.masterMix) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void testSingleThread() {
+    effects::ParameterBlock block;
+    CHECK(block.acquire().sequence == 0);       // Nothing published yet
+
+    fillSnapshot(block.beginWrite(), 0);
+    block.publish();
+    const effects::ChainParameters& first = block.acquire();
+    CHECK(first.sequence == 1);
+    CHECK(isConsistent(first));
+
+    // Nothing new: the same snapshot again
+    CHECK(&block.acquire() == &first);
+    CHECK(block.acquire().sequence == 1);
+
+    // Only the newest of several publishes is seen
+    for (int i = 1; i <= 3; ++i) {
+        fillSnapshot(block.beginWrite(), i);
+        block.publish();
+    }
+    const effects::ChainParameters& newest = block.acquire();
+    CHECK(newest.sequence == 4);
+    CHECK(isConsistent(newest));
+
+    // The producer never writes into the snapshot the consumer holds
+    CHECK(&block.beginWrite() != &newest);
+}
+
+void testHandOff() {
+    effects::ParameterBlock block;
+
+    std::thread producer([&block]() {
+        for (int i = 0; i < PUBLISH_COUNT; ++i) {
+            fillSnapshot(block.beginWrite(), i);
+            block.publish();
+        }
+    });
+
+    // Every snapshot seen is whole, and none is older than the one before
+    bool consistent = true;
+    bool ordered = true;
+    uint64_t lastSequence = 0;
+    uint64_t acquired = 0;
+    while (lastSequence < static_cast<uint64_t>(PUBLISH_COUNT)) {
+        const effects::ChainParameters& parameters = block.acquire();
+        if (parameters.sequence == 0) {
+            continue;
+        }
+        consistent = consistent && isConsistent(parameters);
+        ordered = ordered && parameters.sequence >= lastSequence;
+        if (parameters.sequence != lastSequence) {
+            ++acquired;
+        }
+        lastSequence = parameters.sequence;
+    }
+    producer.join();
+
+    CHECK(consistent);
+    CHECK(ordered);
+    CHECK(acquired > 0);
+    CHECK(block.acquire().sequence == static_cast<uint64_t>(PUBLISH_COUNT));
+}
+
+} // namespace
+
+void runParameterBlockTests() {
+    testSingleThread();
+    testHandOff();
+}
+
+} // namespace test
+} // namespace gamma
@@ -0,0 +1,154 @@
+#include "Test.h"
+#include "core/JobSystem.h"
+#include "core/Math.h"
+#include "effects/RemapGrid.h"
+#include <algorithm>
+#include <vector>
+
+namespace gamma {
+namespace test {
+
+namespace {
+
+// Not multiples of SPACING, so the last cells are partial
+const int WIDTH = 100;
+const int HEIGHT = 70;
+
+/**
+ * @brief Largest distance between the grid's positions and the map's own, over every pixel
+ */
+float measureError(const effects::RemapGrid& grid, const effects::RemapFunction& map) {
+    std::vector<float> x(WIDTH);
+    std::vector<float> y(WIDTH);
+    std::vector<float> exactX(WIDTH);
+    std::vector<float> exactY(WIDTH);
+    float error = 0.0f;
+    for (int row = 0; row < HEIGHT; ++row) {
+        grid.getRow(row, x.data(), y.data());
+        for (int i = 0; i < WIDTH; ++i) {
+            exactX[static_cast<size_t>(i)] = static_cast<float>(i) + 0.5f;
+            exactY[static_cast<size_t>(i)] = static_cast<float>(row) + 0.5f;
+        }
+        map(exactX.data(), exactY.data(), WIDTH);
+        for (size_t i = 0; i < x.size(); ++i) {
+            error = std::max(error, std::max(core::fabs(x[i] - exactX[i]), core::fabs(y[i] - exactY[i])));
+        }
+    }
+    return error;
+}
+
+bool sameRows(const effects::RemapGrid& a, const effects::RemapGrid& b) {
+    std::vector<float> ax(WIDTH), ay(WIDTH), bx(WIDTH), by(WIDTH);
+    for (int row = 0; row < HEIGHT; ++row) {
+        a.getRow(row, ax.data(), ay.data());
+        b.getRow(row, bx.data(), by.data());
+        if (ax != bx || ay != by) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void affine(float* x, float* y, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        const float u = x[i];
+        x[i] = 0.9f * u + 0.2f * y[i] + 3.0f;
+        y[i] = -0.1f * u + 1.1f * y[i] - 2.0f;
+    }
+}
+
+// A gentle swirl: smooth, but not linear within a cell
+void warp(float* x, float* y, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        const float u = x[i];
+        x[i] = u + 6.0f * core::sin(y[i] * 0.05f);
+        y[i] = y[i] + 6.0f * core::cos(u * 0.04f);
+    }
+}
+
+// Mirror about the vertical center line: a crease
+void fold(float* x, float*, size_t count) {
+    const float center = WIDTH * 0.5f;
+    for (size_t i = 0; i < count; ++i) {
+        x[i] = center - core::fabs(x[i] - center);
+    }
+}
+
+// Two tiles across: a jump of half the width
+void tile(float* x, float*, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        x[i] = core::fmod(x[i] * 2.0f, static_cast<float>(WIDTH));
+    }
+}
+
+void testAffine() {
+    effects::RemapGrid grid;
+    grid.build(WIDTH, HEIGHT, affine);
+    CHECK(grid.getWidth() == WIDTH);
+    CHECK(grid.getHeight() == HEIGHT);
+    CHECK(grid.getCellCount() == 7 * 5);
+    CHECK(grid.getDenseCellCount() == 0);
+    CHECK(measureError(grid, affine) < 1e-3f);
+}
+
+void testTolerance() {
+    const effects::RemapFunction maps[] = {warp, fold, tile};
+    for (const effects::RemapFunction& map : maps) {
+        effects::RemapGrid grid;
+        grid.build(WIDTH, HEIGHT, map);
+        CHECK(measureError(grid, map) <= effects::RemapGrid::TOLERANCE);
+        CHECK(grid.getDenseCellCount() > 0);
+        CHECK(grid.getDenseCellCount() < grid.getCellCount());
+    }
+
+    // A smooth map fits finer interpolation; a crease or a jump only the map itself
+    effects::RemapGrid warped;
+    warped.build(WIDTH, HEIGHT, warp);
+    CHECK(warped.getExactCellCount() == 0);
+    effects::RemapGrid creased;
+    creased.build(WIDTH, HEIGHT, fold);
+    CHECK(creased.getExactCellCount() == creased.getDenseCellCount());
+    effects::RemapGrid tiled;
+    tiled.build(WIDTH, HEIGHT, tile);
+    CHECK(tiled.getExactCellCount() == tiled.getDenseCellCount());
+}
+
+void testParallelBuild() {
+    core::JobSystem jobs(2);
+    effects::RemapGrid serial;
+    effects::RemapGrid parallel;
+    serial.build(WIDTH, HEIGHT, warp);
+    parallel.build(WIDTH, HEIGHT, warp, &jobs);
+    CHECK(parallel.getDenseCellCount() == serial.getDenseCellCount());
+    CHECK(sameRows(serial, parallel));
+}
+
+void testCache() {
+    effects::RemapGridCache cache;
+    std::shared_ptr<const effects::RemapGrid> first = cache.get(1, WIDTH, HEIGHT, warp);
+    CHECK(cache.get(1, WIDTH, HEIGHT, warp) == first);
+    CHECK(cache.getBuildCount() == 1);
+
+    // Another size is another grid
+    CHECK(cache.find(1, WIDTH / 2, HEIGHT) == nullptr);
+
+    // The least recently used grid is evicted past CAPACITY
+    for (uint64_t key = 2; key <= effects::RemapGridCache::CAPACITY + 1; ++key) {
+        cache.get(key, WIDTH, HEIGHT, affine);
+    }
+    CHECK(cache.find(1, WIDTH, HEIGHT) == nullptr);
+    CHECK(cache.find(2, WIDTH, HEIGHT) != nullptr);
+    CHECK(cache.getBuildCount() == effects::RemapGridCache::CAPACITY + 1);
+}
+
+} // namespace
+
+void runRemapGridTests() {
+    testAffine();
+    testTolerance();
+    testParallelBuild();
+    testCache();
+}
+
+} // namespace test
+} // namespace gamma
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace gamma {
+namespace test {
+
+/**
+ * @brief Record one check; a failure is printed with its location
+ * @return passed, so callers can stop early on a failure
+ */
+bool check(bool passed, const char* expression, const char* file, int line);
+
+/**
+ * @brief Checks failed since the start of the run
+ */
+int getFailureCount();
+
+/**
+ * @brief Deterministic pseudo-random numbers (xorshift64*), the same on every platform
+ */
+class Random {
+public:
+    explicit Random(uint64_t seed = 0x9E3779B97F4A7C15ull) : _state(seed ? seed : 1) {}
+
+    uint64_t next() {
+        _state ^= _state >> 12;
+        _state ^= _state << 25;
+        _state ^= _state >> 27;
+        return _state * 0x2545F4914F6CDD1Dull;
+    }
+
+    uint32_t nextPixel() { return static_cast<uint32_t>(next() >> 32); }
+
+    /**
+     * @brief Uniform in [low, high)
+     */
+    float nextFloat(float low, float high) {
+        return low + (high - low) * static_cast<float>(next() >> 40) / static_cast<float>(1u << 24);
+    }
+
+private:
+    uint64_t _state;
+};
+
+// Test suites (one translation unit each)
+void runKernelTests();
+void runEffectPlanTests();
+void runEffectEngineTests();
+void runParameterBlockTests();
+void runFramePoolTests();
+void runColorLutTests();
+void runRemapGridTests();
+void runMidiReplayTests();
+void runJobSystemTests();
+void runFrameArenaTests();
+void runMidiLogRingTests();
+void runFrameHistoryTests();
+
+} // namespace test
+} // namespace gamma
+
+/**
+ * @brief Check a condition, continuing the suite when it fails
+ */
+#define CHECK(expression) ::gamma::test::check(static_cast<bool>(expression), #expression, __FILE__, __LINE__)
@@ -0,0 +1,83 @@
+#include "Test.h"
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+    struct Suite {
+        const char* name;
+        void (*run)();
+    };
+
+    const Suite SUITES[] = {
+        {"kernels", &gamma::test::runKernelTests},
+        {"plan", &gamma::test::runEffectPlanTests},
+        {"engine", &gamma::test::runEffectEngineTests},
+        {"parameters", &gamma::test::runParameterBlockTests},
+        {"pool", &gamma::test::runFramePoolTests},
+        {"lut", &gamma::test::runColorLutTests},
+        {"remap", &gamma::test::runRemapGridTests},
+        {"replay", &gamma::test::runMidiReplayTests},
+        {"jobs", &gamma::test::runJobSystemTests},
+        {"arena", &gamma::test::runFrameArenaTests},
+        {"midilog", &gamma::test::runMidiLogRingTests},
+        {"history", &gamma::test::runFrameHistoryTests},
+    };
+
+    int g_checks = 0;
+    int g_failures = 0;
+}
+
+namespace gamma {
+namespace test {
+
+bool check(bool passed, const char* expression, const char* file, int line) {
+    ++g_checks;
+    if (!passed) {
+        ++g_failures;
+        std::cerr << file << ":" << line << ": check failed: " << expression << std::endl;
+    }
+    return passed;
+}
+
+int getFailureCount() {
+    return g_failures;
+}
+
+} // namespace test
+} // namespace gamma
+
+// Usage: gamma_tests [suite...]   (all suites without arguments)
+int main(int argc, char* argv[]) {
+    std::vector<std::string> selectedSuites(argv + 1, argv + argc);
+
+    bool ranAny = false;
+    for (const auto& suite : SUITES) {
+        bool selected = selectedSuites.empty();
+        for (const auto& name : selectedSuites) {
+            if (name == suite.name) {
+                selected = true;
+            }
+        }
+
+        if (selected) {
+            const int failuresBefore = g_failures;
+            const int checksBefore = g_checks;
+            suite.run();
+            std::cout << suite.name << ": " << (g_checks - checksBefore) << " checks, "
+                      << (g_failures - failuresBefore) << " failed" << std::endl;
+            ranAny = true;
+        }
+    }
+
+    if (!ranAny) {
+        std::cerr << "No matching suite. Available:";
+        for (const auto& suite : SUITES) {
+            std::cerr << " " << suite.name;
+        }
+        std::cerr << std::endl;
+        return 1;
+    }
+
+    return g_failures == 0 ? 0 : 1;
+}